@@ -51,9 +51,20 @@ struct Action
 		return id.isValid();
 	}
 
-	bool isVolumeEnvelope() const
+	/* isAutomation
+	Automation actions are breakpoints of an AutomationCurve: the parameter is
+	stored in the second byte of the event, its normalized value in the
+	high-resolution velocity. Plug-in parameters also use 'pluginId' and
+	'pluginParam'. */
+
+	bool isAutomation() const
+	{
+		return event.getStatus() == MidiEvent::CHANNEL_AUTOMATION;
+	}
+
+	AutomationParam getAutomationParam() const
 	{
-		return event.getStatus() == MidiEvent::CHANNEL_CC && pluginId.isValid();
+		return static_cast<AutomationParam>(event.getNote());
 	}
 };
 } // namespace giada::m
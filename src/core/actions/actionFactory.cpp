@@ -25,7 +25,9 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/actions/actionFactory.h"
+#include "src/core/const.h"
 #include "src/core/midiEvent.h"
+#include <algorithm>
 #include <cassert>
 
 namespace giada::m::actionFactory
@@ -46,9 +48,9 @@ void reset()
 
 /* -------------------------------------------------------------------------- */
 
-Action makeAction(ID id, ID channelId, Scene scene, Frame frame, MidiEvent e)
+Action makeAction(ID id, ID channelId, Scene scene, Frame frame, MidiEvent e, ID pluginId, int pluginParam)
 {
-	Action out{actionId_.generate(id), channelId, scene, frame, e, {}, -1};
+	Action out{actionId_.generate(id), channelId, scene, frame, e, pluginId, pluginParam};
 	actionId_.set(id);
 	return out;
 }
@@ -56,8 +58,16 @@ Action makeAction(ID id, ID channelId, Scene scene, Frame frame, MidiEvent e)
 Action makeAction(const Patch::Action& a)
 {
 	actionId_.set(a.id);
-	return Action{a.id, a.channelId, Scene{a.scene}, a.frame,
-	    MidiEvent::makeFromRaw(a.event, /*numBytes=*/3), {}, -1, a.prevId, a.nextId};
+
+	/* The raw event holds a 7-bit velocity only: restore the high-resolution
+	one if the patch has it. */
+
+	MidiEvent event = MidiEvent::makeFromRaw(a.event, /*numBytes=*/3);
+	if (a.value >= 0.0f)
+		event.setVelocityFloat(std::min(a.value, G_MAX_VELOCITY_FLOAT));
+
+	return Action{a.id, a.channelId, Scene{a.scene}, a.frame, event, a.pluginId, a.pluginParam,
+	    a.prevId, a.nextId};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -69,33 +79,35 @@ ID getNewActionId()
 
 /* -------------------------------------------------------------------------- */
 
-model::Actions::Map deserializeActions(const std::vector<Patch::Action>& pactions)
+std::vector<Action> deserializeActions(const std::vector<Patch::Action>& pactions)
 {
-	model::Actions::Map out;
+	std::vector<Action> out;
+	out.reserve(pactions.size());
 	for (const Patch::Action& paction : pactions)
-		out[paction.frame].push_back(makeAction(paction));
+		out.push_back(makeAction(paction));
 	return out;
 }
 
 /* -------------------------------------------------------------------------- */
 
-std::vector<Patch::Action> serializeActions(const model::Actions::Map& actions)
+std::vector<Patch::Action> serializeActions(const std::vector<Action>& actions)
 {
 	std::vector<Patch::Action> out;
-	for (const auto& [_, actionsInFrame] : actions)
+	out.reserve(actions.size());
+	for (const Action& a : actions)
 	{
-		for (const Action& a : actionsInFrame)
-		{
-			out.push_back({
-			    a.id,
-			    a.channelId,
-			    a.scene.getIndex(),
-			    a.frame,
-			    a.event.getRaw(),
-			    a.prevId,
-			    a.nextId,
-			});
-		}
+		out.push_back({
+		    a.id,
+		    a.channelId,
+		    a.scene.getIndex(),
+		    a.frame,
+		    a.event.getRaw(),
+		    a.prevId,
+		    a.nextId,
+		    a.pluginId,
+		    a.pluginParam,
+		    a.event.getVelocityFloat(),
+		});
 	}
 	return out;
 }
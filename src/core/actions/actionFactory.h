@@ -40,9 +40,10 @@ Resets internal ID generator. */
 void reset();
 
 /* makeAction
-Makes a new action given some data. */
+Makes a new action given some data. Plug-in data is only meaningful for
+automation actions targeting plug-in parameters. */
 
-Action makeAction(ID id, ID channelId, Scene, Frame frame, MidiEvent e);
+Action makeAction(ID id, ID channelId, Scene, Frame frame, MidiEvent e, ID pluginId = {}, int pluginParam = -1);
 Action makeAction(const Patch::Action&);
 
 /* getNewActionId
@@ -53,8 +54,8 @@ ID getNewActionId();
 /* (de)serializeActions
 Creates new Actions given the patch raw data and vice versa. */
 
-model::Actions::Map        deserializeActions(const std::vector<Patch::Action>&);
-std::vector<Patch::Action> serializeActions(const model::Actions::Map&);
+std::vector<Action>        deserializeActions(const std::vector<Patch::Action>&);
+std::vector<Patch::Action> serializeActions(const std::vector<Action>&);
 } // namespace giada::m::actionFactory
 
 #endif
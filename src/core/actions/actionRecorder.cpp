@@ -27,6 +27,7 @@
 #include "src/core/actions/actionRecorder.h"
 #include "src/core/actions/action.h"
 #include "src/core/actions/actionFactory.h"
+#include "src/core/actions/automationCurve.h"
 #include "src/core/const.h"
 #include "src/core/model/actions.h"
 #include "src/core/model/model.h"
@@ -39,6 +40,7 @@
 #include <cmath>
 #include <cstddef>
 #include <unordered_map>
+#include <utility>
 
 namespace utils = mcl::utils;
 
@@ -151,7 +153,7 @@ void ActionRecorder::copyActionsToScene(ID channelId, Scene src, Scene dst)
 
 void ActionRecorder::liveRec(ID channelId, Scene scene, MidiEvent e, Frame globalFrame)
 {
-	assert(e.isNoteOnOff()); // Can't record any other kind of events for now
+	assert(e.isNoteOnOff() || e.getStatus() == MidiEvent::CHANNEL_AUTOMATION); // Can't record any other kind of events for now
 
 	/* TODO - this might allocate on the MIDI thread */
 	if (m_liveActions.size() >= m_liveActions.capacity())
@@ -196,6 +198,16 @@ void ActionRecorder::recordSampleAction(ID channelId, Scene scene, int type, Fra
 
 /* -------------------------------------------------------------------------- */
 
+void ActionRecorder::recordAutomationAction(ID channelId, Scene scene, AutomationParam param, Frame f, float value,
+    Frame framesInLoop, ID pluginId, int pluginParam)
+{
+	m_model.get().actions.rec(channelId, scene, sanitizeFrame_(f, framesInLoop),
+	    AutomationCurve::makeEvent(param, value), pluginId, pluginParam);
+	m_model.swap(model::SwapType::HARD);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ActionRecorder::deleteMidiAction(const Action& a)
 {
 	assert(a.isValid());
@@ -225,6 +237,14 @@ void ActionRecorder::deleteSampleAction(const Action& a)
 
 /* -------------------------------------------------------------------------- */
 
+void ActionRecorder::deleteAutomationAction(const Action& a)
+{
+	assert(a.isAutomation());
+	deleteAction(a.id);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ActionRecorder::updateMidiAction(ID channelId, Scene scene, const Action& a, int note, float velocity,
     Frame f1, Frame f2, Frame framesInLoop)
 {
@@ -246,6 +266,15 @@ void ActionRecorder::updateSampleAction(ID channelId, Scene scene, const Action&
 
 /* -------------------------------------------------------------------------- */
 
+void ActionRecorder::updateAutomationAction(ID channelId, Scene scene, const Action& a, Frame f, float value,
+    Frame framesInLoop)
+{
+	deleteAction(a.id);
+	recordAutomationAction(channelId, scene, a.getAutomationParam(), f, value, framesInLoop, a.pluginId, a.pluginParam);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ActionRecorder::updateVelocity(const Action& a, float value)
 {
 	MidiEvent event(a.event);
@@ -306,7 +335,7 @@ Frame ActionRecorder::fixVerticalEnvActions(Frame f, const Action& a1, const Act
 
 bool ActionRecorder::isSinglePressMode(ID channelId) const
 {
-	return m_model.get().tracks.getChannel(channelId).sampleChannel->mode == SamplePlayerMode::SINGLE_PRESS;
+	return std::as_const(m_model.get().tracks).getChannel(channelId).sampleChannel->mode == SamplePlayerMode::SINGLE_PRESS;
 }
 
 /* -------------------------------------------------------------------------- */
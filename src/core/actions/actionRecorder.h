@@ -75,7 +75,8 @@ public:
 	void copyActionsToScene(ID channelId, Scene src, Scene dst);
 
 	/* liveRec
-	Records a user-generated action. NOTE_ON or NOTE_OFF only for now. */
+	Records a user-generated action. NOTE_ON, NOTE_OFF or automation only for
+	now. */
 
 	void liveRec(ID channelId, Scene, MidiEvent e, Frame global);
 
@@ -83,16 +84,20 @@ public:
 
 	void recordMidiAction(ID channelId, Scene, int note, float velocity, Frame f1, Frame f2, Frame framesInLoop);
 	void recordSampleAction(ID channelId, Scene, int type, Frame f1, Frame f2, Frame framesInLoop);
+	void recordAutomationAction(ID channelId, Scene, AutomationParam, Frame f, float value, Frame framesInLoop,
+	    ID pluginId = {}, int pluginParam = -1);
 
 	/* delete*Action */
 
 	void deleteMidiAction(const Action&);
 	void deleteSampleAction(const Action&);
+	void deleteAutomationAction(const Action&);
 
 	/* update*Action */
 
 	void updateMidiAction(ID channelId, Scene, const Action&, int note, float velocity, Frame f1, Frame f2, Frame framesInLoop);
 	void updateSampleAction(ID channelId, Scene, const Action&, int type, Frame f1, Frame f2, Frame framesInLoop);
+	void updateAutomationAction(ID channelId, Scene, const Action&, Frame f, float value, Frame framesInLoop);
 	void updateVelocity(const Action&, float value);
 
 	/* consolidate
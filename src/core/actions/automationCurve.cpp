@@ -0,0 +1,161 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "src/core/actions/automationCurve.h"
+#include "src/deps/mcl-utils/src/math.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace math = mcl::utils::math;
+
+namespace giada::m
+{
+MidiEvent AutomationCurve::makeEvent(AutomationParam param, float value)
+{
+	MidiEvent e = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_AUTOMATION, static_cast<int>(param), 0);
+	e.setVelocityFloat(std::clamp(value, 0.0f, G_MAX_VELOCITY_FLOAT));
+	return e;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float AutomationCurve::toParamValue(AutomationParam param, float value)
+{
+	if (param == AutomationParam::PITCH)
+		return math::map(value, 0.0f, 1.0f, G_MIN_PITCH, G_MAX_PITCH);
+	return value;
+}
+
+float AutomationCurve::fromParamValue(AutomationParam param, float value)
+{
+	if (param == AutomationParam::PITCH)
+		return math::map(value, G_MIN_PITCH, G_MAX_PITCH, 0.0f, 1.0f);
+	return value;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+AutomationCurve::AutomationCurve(const Action& a)
+: channelId(a.channelId)
+, scene(a.scene)
+, param(a.getAutomationParam())
+, pluginId(a.pluginId)
+, pluginParam(a.pluginParam)
+{
+	assert(a.isAutomation());
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool AutomationCurve::matches(const Action& a) const
+{
+	if (!a.isAutomation() || a.channelId != channelId || a.scene != scene || a.getAutomationParam() != param)
+		return false;
+	return param != AutomationParam::PLUGIN || (a.pluginId == pluginId && a.pluginParam == pluginParam);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void AutomationCurve::add(Frame f, float value)
+{
+	assert(m_frames.empty() || m_frames.back() <= f);
+
+	m_frames.push_back(f);
+	m_values.push_back(value);
+}
+
+/* -------------------------------------------------------------------------- */
+
+float AutomationCurve::valueAt(Frame f) const
+{
+	return interpolate(getNext(f), f);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void AutomationCurve::getSegments(Frame start, int frames, Frame framesInLoop, Segments& out) const
+{
+	out.clear();
+
+	if (m_frames.empty())
+		return;
+
+	const auto wrap = [framesInLoop](Frame f)
+	{ return framesInLoop > 0 ? f % framesInLoop : f; };
+
+	for (int i = 0; i < frames;)
+	{
+		const Frame       f    = wrap(start + i);
+		const std::size_t next = getNext(f);
+
+		/* No room left: the last segment goes straight to the end of the
+		block. */
+
+		if (out.size() + 1 == G_MAX_AUTOMATION_SEGS)
+		{
+			out.push_back({i, frames, interpolate(next, f), valueAt(wrap(start + frames))});
+			return;
+		}
+
+		/* A segment ends on the next breakpoint, on the loop boundary or at the
+		end of the block, whichever comes first. */
+
+		Frame end = f + (frames - i);
+		if (framesInLoop > 0)
+			end = std::min(end, framesInLoop);
+		if (next < m_frames.size())
+			end = std::min(end, m_frames[next]);
+
+		out.push_back({i, i + (end - f), interpolate(next, f), interpolate(next, end)});
+		i += end - f;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t AutomationCurve::getNext(Frame f) const
+{
+	return std::upper_bound(m_frames.begin(), m_frames.end(), f) - m_frames.begin();
+}
+
+/* -------------------------------------------------------------------------- */
+
+float AutomationCurve::interpolate(std::size_t next, Frame f) const
+{
+	assert(!m_frames.empty());
+
+	if (next == 0)
+		return m_values.front();
+	if (next == m_frames.size())
+		return m_values.back();
+
+	const Frame a = m_frames[next - 1];
+	const Frame b = m_frames[next];
+	return math::map(static_cast<float>(f), static_cast<float>(a), static_cast<float>(b), m_values[next - 1], m_values[next]);
+}
+} // namespace giada::m
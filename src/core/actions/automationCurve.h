@@ -0,0 +1,126 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_AUTOMATION_CURVE_H
+#define G_AUTOMATION_CURVE_H
+
+#include "src/core/actions/action.h"
+#include "src/core/const.h"
+#include "src/core/midiEvent.h"
+#include "src/core/ringBuffer.h"
+#include "src/core/types.h"
+#include <cstddef>
+#include <vector>
+
+namespace giada::m
+{
+/* AutomationCurve
+Breakpoint curve of a parameter automated on a Channel, built from the
+automation actions recorded on it (see Action::isAutomation). Breakpoints live
+in two parallel columns sorted by frame, with values normalized to [0.0, 1.0].
+The curve is linear between breakpoints and holds the first and the last value
+outside them. */
+
+class AutomationCurve final
+{
+public:
+	/* Segment
+	Linear stretch of the curve within a block: the value moves from 'from' to
+	'to' across the frames [a, b) of the block. */
+
+	struct Segment
+	{
+		int   a    = 0;
+		int   b    = 0;
+		float from = 0.0f;
+		float to   = 0.0f;
+	};
+
+	using Segments = RingBuffer<Segment, G_MAX_AUTOMATION_SEGS>;
+
+	/* makeEvent
+	Makes the event of an automation action for parameter 'param', with
+	normalized value 'value'. */
+
+	static MidiEvent makeEvent(AutomationParam param, float value);
+
+	/* toParamValue, fromParamValue
+	Map a normalized value to the range of parameter 'param' and vice versa. */
+
+	static float toParamValue(AutomationParam param, float value);
+	static float fromParamValue(AutomationParam param, float value);
+
+	/* AutomationCurve
+	Creates an empty curve for the parameter automated by action 'a'. */
+
+	AutomationCurve(const Action& a);
+
+	/* matches
+	Tells whether action 'a' is a breakpoint of this curve. */
+
+	bool matches(const Action& a) const;
+
+	/* add
+	Appends a breakpoint. Breakpoints must be appended sorted by frame. */
+
+	void add(Frame f, float value);
+
+	/* valueAt
+	Returns the normalized value of the curve at frame 'f'. */
+
+	float valueAt(Frame f) const;
+
+	/* getSegments
+	Splits the block of 'frames' frames starting at frame 'start' into linear
+	segments, wrapping around at 'framesInLoop' like the sequencer does. If the
+	block contains more breakpoints than Segments can hold, the last segment
+	straightens the rest of the block. Doesn't allocate: realtime thread safe. */
+
+	void getSegments(Frame start, int frames, Frame framesInLoop, Segments& out) const;
+
+	ID              channelId;
+	Scene           scene;
+	AutomationParam param;
+	ID              pluginId;
+	int             pluginParam;
+
+private:
+	/* getNext
+	Returns the index of the first breakpoint past frame 'f'. */
+
+	std::size_t getNext(Frame f) const;
+
+	/* interpolate
+	Returns the value at frame 'f', which lies right before breakpoint 'next'. */
+
+	float interpolate(std::size_t next, Frame f) const;
+
+	std::vector<Frame> m_frames;
+	std::vector<float> m_values;
+};
+} // namespace giada::m
+
+#endif
@@ -103,6 +103,27 @@ void ActionEditorApi::deleteSampleAction(const Action& a)
 
 /* -------------------------------------------------------------------------- */
 
+void ActionEditorApi::recordAutomationAction(ID channelId, AutomationParam param, Frame f, float value)
+{
+	m_actionRecorder.recordAutomationAction(channelId, m_sequencer.getCurrentScene(), param, f, value, m_sequencer.getFramesInLoop());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionEditorApi::updateAutomationAction(ID channelId, const Action& a, Frame f, float value)
+{
+	m_actionRecorder.updateAutomationAction(channelId, m_sequencer.getCurrentScene(), a, f, value, m_sequencer.getFramesInLoop());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionEditorApi::deleteAutomationAction(const Action& a)
+{
+	m_actionRecorder.deleteAutomationAction(a);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ActionEditorApi::updateVelocity(const Action& a, float value)
 {
 	m_actionRecorder.updateVelocity(a, value);
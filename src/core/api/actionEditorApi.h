@@ -51,6 +51,9 @@ public:
 	void recordSampleAction(ID channelId, int type, Frame f1, Frame f2);
 	void updateSampleAction(ID channelId, const Action&, int type, Frame f1, Frame f2);
 	void deleteSampleAction(const Action&);
+	void recordAutomationAction(ID channelId, AutomationParam, Frame f, float value);
+	void updateAutomationAction(ID channelId, const Action&, Frame f, float value);
+	void deleteAutomationAction(const Action&);
 	void updateVelocity(const Action&, float value);
 
 private:
@@ -25,12 +25,14 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/api/channelsApi.h"
+#include "src/core/actions/automationCurve.h"
 #include "src/core/channels/channelManager.h"
 #include "src/core/engine.h"
 #include "src/core/kernelAudio.h"
 #include "src/core/midiSynchronizer.h"
 #include "src/core/mixer.h"
 #include "src/utils/fs.h"
+#include <utility>
 
 namespace giada::m
 {
@@ -73,9 +75,9 @@ bool ChannelsApi::hasActions(ID channelId) const
 
 /* -------------------------------------------------------------------------- */
 
-Channel& ChannelsApi::get(ID channelId)
+const Channel& ChannelsApi::get(ID channelId) const
 {
-	return m_channelManager.getChannel(channelId);
+	return std::as_const(m_channelManager).getChannel(channelId);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -129,7 +131,8 @@ int ChannelsApi::loadSampleChannel(ID channelId, const std::string& filePath)
 	const Scene              scene       = m_sequencer.getCurrentScene();
 	const int                sampleRate  = m_kernelAudio.getSampleRate();
 	const Resampler::Quality rsmpQuality = m_model.get().kernelAudio.rsmpQuality;
-	return m_channelManager.loadSampleChannel(channelId, filePath, sampleRate, rsmpQuality, scene);
+	const int                threshold   = m_model.get().kernelAudio.streamingThreshold;
+	return m_channelManager.loadSampleChannel(channelId, filePath, sampleRate, rsmpQuality, threshold, scene);
 }
 
 void ChannelsApi::loadSampleChannel(ID channelId, Wave& wave)
@@ -141,7 +144,7 @@ void ChannelsApi::loadSampleChannel(ID channelId, Wave& wave)
 
 void ChannelsApi::remove(ID channelId)
 {
-	const std::vector<Plugin*> plugins  = m_channelManager.getChannel(channelId).plugins;
+	const std::vector<Plugin*> plugins  = std::as_const(m_channelManager).getChannel(channelId).plugins;
 	const bool                 hasSolos = m_channelManager.hasSolos();
 
 	m_actionRecorder.clearChannel(channelId, {});
@@ -169,7 +172,7 @@ void ChannelsApi::clone(ID channelId)
 	/* Plug-in cloning must be done in the main thread, due to JUCE and VST3
 	internal workings. */
 
-	const Channel&             ch            = m_channelManager.getChannel(channelId);
+	const Channel&             ch            = std::as_const(m_channelManager).getChannel(channelId);
 	const Scene                scene         = m_sequencer.getCurrentScene();
 	const int                  bufferSize    = m_kernelAudio.getBufferSize();
 	const int                  sampleRate    = m_kernelAudio.getSampleRate();
@@ -184,13 +187,12 @@ void ChannelsApi::clone(ID channelId)
 
 void ChannelsApi::copyToScene(ID channelId, Scene dstScene)
 {
-	const Channel& ch       = m_channelManager.getChannel(channelId);
+	const Channel& ch       = std::as_const(m_channelManager).getChannel(channelId);
 	const Scene    srcScene = m_sequencer.getCurrentScene();
 
 	if (ch.type == ChannelType::GROUP)
-		for (const Channel& child : getTracks().getByChannel(ch.id).getChannels().getAll())
-			if (child.type != ChannelType::GROUP)
-				copyToScene(child.id, dstScene);
+		for (const ID childId : std::as_const(getTracks()).getByChannel(ch.id).getChildrenIds())
+			copyToScene(childId, dstScene);
 
 	m_channelManager.copyChannelToScene(channelId, srcScene, dstScene);
 	m_actionRecorder.copyActionsToScene(channelId, srcScene, dstScene);
@@ -225,23 +227,26 @@ void ChannelsApi::kill(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelsApi::setVolume(ID channelId, float v)
+void ChannelsApi::setVolume(ID channelId, float v, Thread t)
 {
-	m_channelManager.setVolume(channelId, v);
+	m_channelManager.setVolume(channelId, v, t);
+	recordAutomation(channelId, AutomationParam::VOLUME, v);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelsApi::setPitch(ID channelId, float v)
+void ChannelsApi::setPitch(ID channelId, float v, Thread t)
 {
-	m_channelManager.setPitch(channelId, v, m_sequencer.getCurrentScene());
+	m_channelManager.setPitch(channelId, v, m_sequencer.getCurrentScene(), t);
+	recordAutomation(channelId, AutomationParam::PITCH, v);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelsApi::setPan(ID channelId, float v)
+void ChannelsApi::setPan(ID channelId, float v, Thread t)
 {
-	m_channelManager.setPan(channelId, v);
+	m_channelManager.setPan(channelId, v, t);
+	recordAutomation(channelId, AutomationParam::PAN, v);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -370,4 +375,18 @@ bool ChannelsApi::saveSample(ID channelId, const std::string& filePath)
 {
 	return m_channelManager.saveSample(channelId, filePath, m_sequencer.getCurrentScene());
 }
+/* -------------------------------------------------------------------------- */
+
+void ChannelsApi::recordAutomation(ID channelId, AutomationParam param, float value)
+{
+	if (!m_recorder.canRecordActions())
+		return;
+
+	const ChannelType type = get(channelId).type;
+	if (type != ChannelType::SAMPLE && type != ChannelType::MIDI && type != ChannelType::GROUP)
+		return;
+
+	const MidiEvent e = AutomationCurve::makeEvent(param, AutomationCurve::fromParamValue(param, value));
+	m_actionRecorder.liveRec(channelId, m_sequencer.getCurrentScene(), e, m_sequencer.getCurrentFrame());
+}
 } // namespace giada::m
@@ -72,7 +72,7 @@ public:
 	bool canRemoveTrack(std::size_t trackIndex) const;
 	bool hasActions(ID channelId) const;
 
-	Channel&       get(ID);
+	const Channel& get(ID) const;
 	model::Tracks& getTracks();
 
 	void     addTrack();
@@ -90,9 +90,9 @@ public:
 	void press(ID, float velocity);
 	void release(ID);
 	void kill(ID);
-	void setVolume(ID, float);
-	void setPitch(ID, float);
-	void setPan(ID, float);
+	void setVolume(ID, float, Thread);
+	void setPitch(ID, float, Thread);
+	void setPan(ID, float, Thread);
 	void toggleMute(ID);
 	void toggleSolo(ID);
 	void toggleArm(ID);
@@ -113,6 +113,13 @@ public:
 	bool saveSample(ID, const std::string& filePath);
 
 private:
+	/* recordAutomation
+	Records the new value of a continuous parameter as an automation action, if
+	actions are being recorded. Only channels driven by the sequencer can
+	be automated. */
+
+	void recordAutomation(ID, AutomationParam, float value);
+
 	model::Model&       m_model;
 	KernelAudio&        m_kernelAudio;
 	Mixer&              m_mixer;
@@ -30,11 +30,13 @@
 #include "src/core/kernelAudio.h"
 #include "src/core/midiSynchronizer.h"
 #include "src/core/mixer.h"
+#include "src/core/waveLoader.h"
+#include <fstream>
 
 namespace giada::m
 {
 MainApi::MainApi(KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms,
-    ChannelManager& cm, Recorder& r, rendering::Reactor& re)
+    ChannelManager& cm, Recorder& r, rendering::Reactor& re, WaveLoader& wl, Profiler& p, CallbackMonitor& cbm)
 : m_kernelAudio(ka)
 , m_mixer(m)
 , m_sequencer(s)
@@ -42,6 +44,9 @@ MainApi::MainApi(KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms,
 , m_channelManager(cm)
 , m_recorder(r)
 , m_reactor(re)
+, m_waveLoader(wl)
+, m_profiler(p)
+, m_callbackMonitor(cbm)
 {
 }
 
@@ -130,6 +135,38 @@ Mixer::RecordInfo MainApi::getRecordInfo() const
 
 /* -------------------------------------------------------------------------- */
 
+WaveStream::Stats MainApi::getStreamingStats() const
+{
+	return WaveStream::getStats();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Stats MainApi::getCpuStats(Profiler::Section section, ID id) const
+{
+	return m_profiler.getStats(section, id);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool MainApi::saveCpuProfile(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file.good())
+		return false;
+	file << m_profiler.toJson();
+	return file.good();
+}
+
+/* -------------------------------------------------------------------------- */
+
+CallbackMonitor::Stats MainApi::getCallbackStats() const
+{
+	return m_callbackMonitor.getStats();
+}
+
+/* -------------------------------------------------------------------------- */
+
 int MainApi::getBeats() const
 {
 	return m_sequencer.getBeats();
@@ -215,14 +252,14 @@ void MainApi::toggleMetronome()
 
 /* -------------------------------------------------------------------------- */
 
-void MainApi::setMasterInVolume(float v)
+void MainApi::setMasterInVolume(float v, Thread t)
 {
-	m_channelManager.setVolume(MASTER_IN_CHANNEL_ID, v);
+	m_channelManager.setVolume(MASTER_IN_CHANNEL_ID, v, t);
 }
 
-void MainApi::setMasterOutVolume(float v)
+void MainApi::setMasterOutVolume(float v, Thread t)
 {
-	m_channelManager.setVolume(MASTER_OUT_CHANNEL_ID, v);
+	m_channelManager.setVolume(MASTER_OUT_CHANNEL_ID, v, t);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -350,6 +387,7 @@ void MainApi::startActionRecOnCallback()
 
 void MainApi::setScene(Scene scene)
 {
+	m_waveLoader.prioritize(scene);
 	m_sequencer.setScene(scene);
 	m_reactor.setScene(scene);
 }
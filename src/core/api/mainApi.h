@@ -27,7 +27,12 @@
 #ifndef G_MAIN_API_H
 #define G_MAIN_API_H
 
+#include "src/core/callbackMonitor.h"
 #include "src/core/mixer.h"
+#include "src/core/profiler.h"
+#include "src/core/types.h"
+#include "src/core/waveStream.h"
+#include <string>
 
 namespace giada::m::rendering
 {
@@ -42,11 +47,12 @@ class Sequencer;
 class MidiSynchronizer;
 class ChannelManager;
 class Recorder;
+class WaveLoader;
 class MainApi
 {
 public:
 	MainApi(KernelAudio&, Mixer&, Sequencer&, MidiSynchronizer&, ChannelManager&, Recorder&,
-	    rendering::Reactor&);
+	    rendering::Reactor&, WaveLoader&, Profiler&, CallbackMonitor&);
 
 	bool              isRecordingInput() const;
 	bool              isRecordingActions() const;
@@ -76,9 +82,31 @@ public:
 	Scene             getNextScene() const;
 	SceneStatus       getSceneStatus() const;
 
+	/* getStreamingStats
+	Returns the number of samples streamed from disk and how many times the
+	disk couldn't keep up with playback. */
+
+	WaveStream::Stats getStreamingStats() const;
+
+	/* getCpuStats
+	Returns the time spent by the audio rendering in a Channel, a plug-in, the
+	Sequencer or the Mixer (see Profiler::Section). */
+
+	Profiler::Stats getCpuStats(Profiler::Section, ID = {}) const;
+
+	/* saveCpuProfile
+	Writes all CPU statistics to a JSON file. Returns false on failure. */
+
+	bool saveCpuProfile(const std::string& path) const;
+
+	/* getCallbackStats
+	Returns DSP load, jitter and xruns of the audio callback. */
+
+	CallbackMonitor::Stats getCallbackStats() const;
+
 	void toggleMetronome();
-	void setMasterInVolume(float);
-	void setMasterOutVolume(float);
+	void setMasterInVolume(float, Thread);
+	void setMasterOutVolume(float, Thread);
 	void setBpm(float);
 	void setBeats(int beats, int bars);
 	void multiplyBeats();
@@ -97,6 +125,10 @@ public:
 	void stopInputRecording();
 	void toggleInputRecording();
 	void startActionRecOnCallback();
+	/* setScene
+	Selects a new scene. Its samples are loaded first, if still loading in
+	background. */
+
 	void setScene(Scene);
 
 private:
@@ -107,6 +139,9 @@ private:
 	ChannelManager&     m_channelManager;
 	Recorder&           m_recorder;
 	rendering::Reactor& m_reactor;
+	WaveLoader&         m_waveLoader;
+	Profiler&           m_profiler;
+	CallbackMonitor&    m_callbackMonitor;
 };
 } // namespace giada::m
 
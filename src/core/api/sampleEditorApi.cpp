@@ -32,6 +32,7 @@
 #include "src/core/waveFactory.h"
 #include "src/core/waveFx.h"
 #include "src/utils/log.h"
+#include <utility>
 
 namespace giada::m
 {
@@ -93,14 +94,14 @@ void SampleEditorApi::togglePreview()
 
 Frame SampleEditorApi::getPreviewTracker()
 {
-	return m_channelManager.getChannel(PREVIEW_CHANNEL_ID).shared->tracker.load();
+	return std::as_const(m_channelManager).getChannel(PREVIEW_CHANNEL_ID).shared->tracker.load();
 }
 
 /* -------------------------------------------------------------------------- */
 
 ChannelStatus SampleEditorApi::getPreviewStatus()
 {
-	return m_channelManager.getChannel(PREVIEW_CHANNEL_ID).shared->playStatus.load();
+	return std::as_const(m_channelManager).getChannel(PREVIEW_CHANNEL_ID).shared->playStatus.load();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -208,7 +209,7 @@ void SampleEditorApi::trim(ID channelId, Frame a, Frame b)
 
 void SampleEditorApi::shift(ID channelId, Frame offset)
 {
-	const Channel& ch       = m_channelManager.getChannel(channelId);
+	const Channel& ch       = std::as_const(m_channelManager).getChannel(channelId);
 	const Scene    scene    = m_sequencer.getCurrentScene();
 	const Frame    oldShift = ch.sampleChannel->getShift(scene);
 
@@ -250,15 +251,23 @@ void SampleEditorApi::reload(ID channelId)
 	const int                sampleRate  = m_kernelAudio.getSampleRate();
 	const Resampler::Quality rsmpQuality = m_model.get().kernelAudio.rsmpQuality;
 	// TODO - error checking
-	m_channelManager.loadSampleChannel(channelId, getWave(channelId).getPath(), sampleRate, rsmpQuality, Scene{0});
+	m_channelManager.loadSampleChannel(channelId, getWave(channelId).getPath(), sampleRate, rsmpQuality,
+	    /*streamingThreshold=*/0, Scene{0});
 	loadPreviewChannel(channelId); // Refresh preview channel properties
 }
 
 /* -------------------------------------------------------------------------- */
 
+void SampleEditorApi::loadInMemory(ID channelId)
+{
+	m_channelManager.loadWaveInMemory(getWave(channelId));
+}
+
+/* -------------------------------------------------------------------------- */
+
 Wave& SampleEditorApi::getWave(ID channelId) const
 {
 	const Scene currentScene = m_sequencer.getCurrentScene();
-	return *m_channelManager.getChannel(channelId).sampleChannel->getWave(currentScene);
+	return *std::as_const(m_channelManager).getChannel(channelId).sampleChannel->getWave(currentScene);
 }
 } // namespace giada::m
@@ -70,6 +70,7 @@ public:
 	void           setRange(ID channelId, SampleRange);
 	void           resetRange(ID channelId);
 	void           reload(ID channelId);
+	void           loadInMemory(ID channelId);
 
 private:
 	Wave& getWave(ID channelId) const;
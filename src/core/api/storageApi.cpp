@@ -33,6 +33,7 @@
 #include "src/core/patchFactory.h"
 #include "src/core/plugins/pluginFactory.h"
 #include "src/core/waveFactory.h"
+#include "src/core/waveLoader.h"
 #include "src/deps/mcl-utils/src/fs.hpp"
 #include "src/utils/log.h"
 
@@ -41,7 +42,7 @@ namespace utils = mcl::utils;
 namespace giada::m
 {
 StorageApi::StorageApi(Engine& e, model::Model& m, PluginManager& pm, MidiSynchronizer& ms,
-    Mixer& mx, ChannelManager& cm, KernelAudio& ka, Sequencer& s, ActionRecorder& ar)
+    Mixer& mx, ChannelManager& cm, KernelAudio& ka, Sequencer& s, ActionRecorder& ar, WaveLoader& wl, Bouncer& b)
 : m_engine(e)
 , m_model(m)
 , m_pluginManager(pm)
@@ -51,6 +52,8 @@ StorageApi::StorageApi(Engine& e, model::Model& m, PluginManager& pm, MidiSynchr
 , m_kernelAudio(ka)
 , m_sequencer(s)
 , m_actionRecorder(ar)
+, m_waveLoader(wl)
+, m_bouncer(b)
 {
 }
 
@@ -69,6 +72,10 @@ bool StorageApi::storeProject(const std::string& projectPath, const v::Model& ui
 
 	u::log::print("[StorageApi::storeProject] Project dir created: {}\n", projectPath);
 
+	/* Samples still loading in background have no audio data to write yet. */
+
+	m_waveLoader.wait();
+
 	progress(0.3f);
 
 	/* Write Model into Patch, then into file. */
@@ -109,7 +116,7 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, std::fu
 	if (patch.status != G_FILE_OK)
 		return {};
 
-	progress(0.3f);
+	progress(0.1f);
 
 	/* Then suspend Mixer, MIDI synch and reset the engine. */
 
@@ -117,14 +124,18 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, std::fu
 	m_mixer.disable();
 	m_engine.reset();
 
-	/* Load the patch into Model. */
+	/* Load the patch into Model. Sample loading takes most of the time: map
+	its progress to the 0.1 - 0.9 range. With lazy loading it just reads the
+	file headers, the WaveLoader takes care of the rest after the project is
+	open. */
+
+	const auto wavesProgress = [&progress](float p)
+	{ progress(0.1f + p * 0.8f); };
 
 	const int                sampleRate  = m_kernelAudio.getSampleRate();
 	const int                bufferSize  = m_kernelAudio.getBufferSize();
 	const Resampler::Quality rsmpQuality = m_kernelAudio.getResamplerQuality();
-	const model::LoadState   state       = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality);
-
-	progress(0.6f);
+	const model::LoadState   state       = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality, wavesProgress);
 
 	/* Prepare the engine. Recorder has to recompute the actions positions if
 	the current samplerate != patch samplerate. Clock needs to update frames
@@ -144,9 +155,17 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, std::fu
 
 	m_mixer.enable();
 	m_midiSynchronizer.startSendClock(m_model.get().sequencer.bpm);
+	m_waveLoader.start(m_sequencer.getCurrentScene(), rsmpQuality, m_model.get().kernelAudio.streamingThreshold);
 
 	progress(1.0f);
 
 	return state;
 }
+
+/* -------------------------------------------------------------------------- */
+
+bool StorageApi::bounce(const Bouncer::Params& params, std::function<void(float)> progress) const
+{
+	return m_bouncer.bounce(params, progress);
+}
 } // namespace giada::m
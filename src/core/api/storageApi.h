@@ -27,6 +27,7 @@
 #ifndef G_STORAGE_API_H
 #define G_STORAGE_API_H
 
+#include "src/core/bouncer.h"
 #include "src/core/model/model.h"
 #include "src/core/types.h"
 #include "src/gui/model.h"
@@ -44,24 +45,33 @@ class ChannelManager;
 class KernelAudio;
 class Sequencer;
 class ActionRecorder;
+class WaveLoader;
 class StorageApi
 {
 public:
 	StorageApi(Engine&, model::Model&, PluginManager&, MidiSynchronizer&,
-	    Mixer&, ChannelManager&, KernelAudio&, Sequencer&, ActionRecorder&);
+	    Mixer&, ChannelManager&, KernelAudio&, Sequencer&, ActionRecorder&, WaveLoader&, Bouncer&);
 
 	/* storeProject
-	Saves the current project. Returns true on success. */
+	Saves the current project. Returns true on success. Waits for samples still
+	loading in background, if any. */
 
 	bool storeProject(const std::string& projectPath, const v::Model&,
 	    std::function<void(float)>       progress) const;
 
 	/* loadProject
 	Loads a new project. Returns a model::LoadState object containing the
-	operation state. */
+	operation state. If lazy sample loading is enabled, it returns before the
+	audio data of samples has been decoded. */
 
 	model::LoadState loadProject(const std::string& projectPath, std::function<void(float)> progress);
 
+	/* bounce
+	Renders the current scene to file, faster than realtime. Returns true on
+	success. See Bouncer. */
+
+	bool bounce(const Bouncer::Params&, std::function<void(float)> progress) const;
+
 private:
 	Engine&           m_engine;
 	model::Model&     m_model;
@@ -72,6 +82,8 @@ private:
 	KernelAudio&      m_kernelAudio;
 	Sequencer&        m_sequencer;
 	ActionRecorder&   m_actionRecorder;
+	WaveLoader&       m_waveLoader;
+	Bouncer&          m_bouncer;
 };
 } // namespace giada::m
 
@@ -0,0 +1,318 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "src/core/bouncer.h"
+#include "src/core/const.h"
+#include "src/core/kernelAudio.h"
+#include "src/core/kernelMidi.h"
+#include "src/core/midiSynchronizer.h"
+#include "src/core/mixer.h"
+#include "src/core/model/model.h"
+#include "src/core/rendering/reactor.h"
+#include "src/core/rendering/renderer.h"
+#include "src/core/sequencer.h"
+#include "src/core/waveLoader.h"
+#include "src/core/waveStream.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/deps/mcl-utils/src/fs.hpp"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <fmt/core.h>
+#include <sndfile.h>
+#include <utility>
+#include <vector>
+
+namespace utils = mcl::utils;
+
+namespace giada::m
+{
+namespace
+{
+/* SoundFile_
+An audio file open for writing, closed on destruction. */
+
+class SoundFile_
+{
+public:
+	SoundFile_(const std::string& path, int channels, int sampleRate, Bouncer::Format format)
+	: m_file(nullptr)
+	{
+		SF_INFO header    = {};
+		header.samplerate = sampleRate;
+		header.channels   = channels;
+		header.format     = format == Bouncer::Format::FLAC ? SF_FORMAT_FLAC | SF_FORMAT_PCM_24 : SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+		m_file = sf_open(path.c_str(), SFM_WRITE, &header);
+		if (m_file == nullptr)
+		{
+			u::log::print("[Bouncer] Unable to open {} for writing: {}\n", path, sf_strerror(nullptr));
+			return;
+		}
+
+		/* Integer formats: clip instead of wrapping around. */
+
+		if (format == Bouncer::Format::FLAC)
+			sf_command(m_file, SFC_SET_CLIPPING, nullptr, SF_TRUE);
+	}
+
+	SoundFile_(SoundFile_&& o) noexcept
+	: m_file(o.m_file)
+	{
+		o.m_file = nullptr;
+	}
+
+	SoundFile_(const SoundFile_&)            = delete;
+	SoundFile_& operator=(const SoundFile_&) = delete;
+	SoundFile_& operator=(SoundFile_&&)      = delete;
+
+	~SoundFile_()
+	{
+		if (m_file != nullptr)
+			sf_close(m_file);
+	}
+
+	bool isOpen() const { return m_file != nullptr; }
+
+	bool write(const mcl::AudioBuffer& buffer, Frame offset, Frame frames)
+	{
+		return sf_writef_float(m_file, buffer[offset], frames) == frames;
+	}
+
+private:
+	SNDFILE* m_file;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* Cursor_
+Writing position of an output file. The output is late by some latency, which
+is known after the first block: 'toSkip' frames are skipped first, then
+'length' frames are written. */
+
+struct Cursor_
+{
+	/* advance
+	Returns the range of the next block of 'bufferSize' frames to be written, as
+	offset and length, given the latency of the output. */
+
+	std::pair<Frame, Frame> advance(Frame latency, Frame bufferSize, Frame length)
+	{
+		if (toSkip < 0)
+			toSkip = latency;
+
+		const Frame skip   = std::min(toSkip, bufferSize);
+		const Frame frames = std::min(bufferSize - skip, length - written);
+
+		toSkip -= skip;
+		written += frames;
+
+		return {skip, frames};
+	}
+
+	Frame toSkip  = -1;
+	Frame written = 0;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* makeStemPath_
+Returns the path of the stem file of a Track, next to the mixdown one: e.g.
+'song.wav' -> 'song-2-drums.wav'. */
+
+std::string makeStemPath_(const std::string& mixdownPath, std::size_t index, std::string name)
+{
+	std::replace_if(name.begin(), name.end(), [](char c)
+	{ return c == '/' || c == '\\' || c == ':'; }, '_');
+
+	const std::string base = utils::fs::stripExt(mixdownPath);
+	const std::string ext  = utils::fs::getExt(mixdownPath);
+
+	if (name.empty())
+		return fmt::format("{}-{}{}", base, index + 1, ext);
+	return fmt::format("{}-{}-{}{}", base, index + 1, name, ext);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Bouncer::Bouncer(model::Model& m, KernelAudio& ka, KernelMidi& km, Mixer& mx, Sequencer& s, MidiSynchronizer& ms,
+    rendering::Renderer& r, rendering::Reactor& re, WaveLoader& wl)
+: m_model(m)
+, m_kernelAudio(ka)
+, m_kernelMidi(km)
+, m_mixer(mx)
+, m_sequencer(s)
+, m_midiSynchronizer(ms)
+, m_renderer(r)
+, m_reactor(re)
+, m_waveLoader(wl)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Bouncer::bounce(const Params& params, std::function<void(float)> progress) const
+{
+	assert(params.loops > 0);
+
+	if (m_mixer.isRecordingInput())
+	{
+		u::log::print("[Bouncer::bounce] Can't bounce while recording input\n");
+		return false;
+	}
+
+	u::log::print("[Bouncer::bounce] Bouncing {} loop(s) to {}\n", params.loops, params.path);
+
+	progress(0.0f);
+
+	/* Samples still loading in background would be rendered as silence. */
+
+	m_waveLoader.wait();
+
+	/* Take the realtime thread out of the way: from now on the Renderer is
+	driven by this thread only. MIDI output is muted too, or sequenced events
+	would be fired at external devices faster than realtime. */
+
+	const bool wasStreaming = m_kernelAudio.isReady();
+	if (wasStreaming)
+		m_kernelAudio.stopStream();
+	m_midiSynchronizer.stopSendClock();
+	m_kernelMidi.muteOutput();
+
+	m_sequencer.offline_stop();
+	m_reactor.stopAll();
+	m_sequencer.offline_rewind();
+	m_reactor.rewindAll();
+	m_sequencer.offline_start();
+
+	const bool res = render(params, m_sequencer.getFramesInLoop() * params.loops, progress);
+
+	/* Bring everything back to the initial state. */
+
+	m_sequencer.offline_stop();
+	m_reactor.stopAll();
+	m_sequencer.offline_rewind();
+	m_reactor.rewindAll();
+
+	m_kernelMidi.unmuteOutput();
+	m_midiSynchronizer.startSendClock(m_sequencer.getBpm());
+	if (wasStreaming)
+		m_kernelAudio.startStream();
+
+	progress(1.0f);
+
+	return res;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Bouncer::render(const Params& params, Frame length, std::function<void(float)> progress) const
+{
+	const int sampleRate = m_kernelAudio.getSampleRate();
+	const int bufferSize = m_kernelAudio.getBufferSize();
+	const int channels   = std::max(m_kernelAudio.getChannelsOutCount(), G_MAX_IO_CHANS);
+
+	/* The mixdown is what would be sent to the audio device, all its channels
+	included. Stems are stereo. */
+
+	SoundFile_ mixdown(params.path, channels, sampleRate, params.format);
+	if (!mixdown.isOpen())
+		return false;
+
+	std::vector<SoundFile_>       stemFiles;
+	std::vector<mcl::AudioBuffer> stems;
+
+	if (params.stems)
+	{
+		const Scene scene = m_sequencer.getCurrentScene();
+		for (const model::Track& track : m_model.get().tracks.getAll())
+		{
+			if (track.isInternal())
+				continue;
+			const std::string path = makeStemPath_(params.path, stemFiles.size(), track.getGroupChannel().getName(scene));
+			if (!stemFiles.emplace_back(path, G_MAX_IO_CHANS, sampleRate, params.format).isOpen())
+				return false;
+			stems.emplace_back(bufferSize, G_MAX_IO_CHANS);
+		}
+	}
+
+	mcl::AudioBuffer       out(bufferSize, channels);
+	const mcl::AudioBuffer in; // No audio input while offline
+
+	/* The mixdown is late by the whole processing latency. Stems are taken
+	before the master output plug-ins and the limiter: they are late by the
+	plug-in delay compensation of the tracks only. Keep going until 'length'
+	frames have been written to each file. */
+
+	Cursor_ mixdownCursor;
+	Cursor_ stemsCursor;
+	float   lastProgress = 0.0f;
+
+	while (mixdownCursor.written < length || (!stems.empty() && stemsCursor.written < length))
+	{
+		/* There's no background streaming thread fast enough for offline
+		rendering: refill streamed samples before each block. */
+
+		WaveStream::refillAll();
+
+		for (mcl::AudioBuffer& stem : stems)
+			stem.clear();
+
+		m_renderer.render(out, in, m_model, params.stems ? &stems : nullptr);
+
+		const auto [mixdownSkip, mixdownFrames] = mixdownCursor.advance(m_renderer.getLatency(), bufferSize, length);
+		const auto [stemsSkip, stemsFrames]     = stemsCursor.advance(m_renderer.getTracksLatency(), bufferSize, length);
+
+		bool res = mixdownFrames == 0 || mixdown.write(out, mixdownSkip, mixdownFrames);
+		for (std::size_t i = 0; i < stemFiles.size() && stemsFrames > 0; i++)
+			res = res && stemFiles[i].write(stems[i], stemsSkip, stemsFrames);
+		if (!res)
+		{
+			u::log::print("[Bouncer::render] Incomplete write!\n");
+			return false;
+		}
+
+		/* Don't flood the caller (likely the UI) with progress updates. The
+		mixdown is the last file to be completed. */
+
+		const float p = static_cast<float>(mixdownCursor.written) / length;
+		if (p - lastProgress >= 0.01f)
+		{
+			progress(p);
+			lastProgress = p;
+		}
+	}
+
+	u::log::print("[Bouncer::render] {} frames written\n", mixdownCursor.written);
+
+	return true;
+}
+} // namespace giada::m
@@ -0,0 +1,107 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_BOUNCER_H
+#define G_BOUNCER_H
+
+#include "src/types.h"
+#include <functional>
+#include <string>
+
+namespace giada::m::model
+{
+class Model;
+}
+
+namespace giada::m::rendering
+{
+class Renderer;
+class Reactor;
+} // namespace giada::m::rendering
+
+namespace giada::m
+{
+class KernelAudio;
+class KernelMidi;
+class Mixer;
+class Sequencer;
+class MidiSynchronizer;
+class WaveLoader;
+
+/* Bouncer
+Renders the current scene to file, faster than realtime. The audio stream is
+stopped meanwhile and the Renderer is driven in a tight loop from the calling
+thread, with the sequencer and its actions advancing exactly as they would in
+realtime, one block of the current buffer size at a time. */
+
+class Bouncer final
+{
+public:
+	enum class Format
+	{
+		WAV, // 32-bit float, bit-identical to the realtime output
+		FLAC // 24-bit integer
+	};
+
+	struct Params
+	{
+		std::string path;             // File of the mixdown
+		Format      format = Format::WAV;
+		int         loops  = 1;     // Sequencer loops to render
+		bool        stems  = false; // Also write one file per Track, next to 'path'
+	};
+
+	Bouncer(model::Model&, KernelAudio&, KernelMidi&, Mixer&, Sequencer&, MidiSynchronizer&,
+	    rendering::Renderer&, rendering::Reactor&, WaveLoader&);
+
+	/* bounce
+	Renders the current scene from the beginning. Plug-in latency is
+	compensated, so that the files are aligned with the sequencer grid.
+	Returns false if a file can't be written or if the input is being
+	recorded. MIDI output is muted meanwhile. */
+
+	bool bounce(const Params&, std::function<void(float)> progress) const;
+
+private:
+	/* render
+	The actual offline rendering, with the sequencer already rewound and
+	running. */
+
+	bool render(const Params&, Frame length, std::function<void(float)> progress) const;
+
+	model::Model&        m_model;
+	KernelAudio&         m_kernelAudio;
+	KernelMidi&          m_kernelMidi;
+	Mixer&               m_mixer;
+	Sequencer&           m_sequencer;
+	MidiSynchronizer&    m_midiSynchronizer;
+	rendering::Renderer& m_renderer;
+	rendering::Reactor&  m_reactor;
+	WaveLoader&          m_waveLoader;
+};
+} // namespace giada::m
+
+#endif
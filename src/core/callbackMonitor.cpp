@@ -0,0 +1,235 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "src/core/callbackMonitor.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace giada::m
+{
+namespace
+{
+float toMicros_(std::chrono::steady_clock::duration d)
+{
+	return std::chrono::duration<float, std::micro>(d).count();
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+uint64_t CallbackMonitor::Stats::getXruns() const
+{
+	return inputOverflows + outputUnderflows + overruns;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void CallbackMonitor::Slot::write(const Callback& callback, uint64_t index)
+{
+	seq.store((2 * index) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	time.store(callback.time, std::memory_order_relaxed);
+	duration.store(callback.duration, std::memory_order_relaxed);
+	period.store(callback.period, std::memory_order_relaxed);
+	interval.store(callback.interval, std::memory_order_relaxed);
+	load.store(callback.load, std::memory_order_relaxed);
+	inputOverflow.store(callback.inputOverflow, std::memory_order_relaxed);
+	outputUnderflow.store(callback.outputUnderflow, std::memory_order_relaxed);
+	modelSwaps.store(callback.modelSwaps, std::memory_order_relaxed);
+
+	seq.store(2 * (index + 1), std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool CallbackMonitor::Slot::read(Callback& callback, uint64_t index) const
+{
+	const uint64_t expected = 2 * (index + 1);
+
+	if (seq.load(std::memory_order_acquire) != expected)
+		return false;
+
+	callback.time            = time.load(std::memory_order_relaxed);
+	callback.duration        = duration.load(std::memory_order_relaxed);
+	callback.period          = period.load(std::memory_order_relaxed);
+	callback.interval        = interval.load(std::memory_order_relaxed);
+	callback.load            = load.load(std::memory_order_relaxed);
+	callback.inputOverflow   = inputOverflow.load(std::memory_order_relaxed);
+	callback.outputUnderflow = outputUnderflow.load(std::memory_order_relaxed);
+	callback.modelSwaps      = modelSwaps.load(std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return seq.load(std::memory_order_relaxed) == expected;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+CallbackMonitor::CallbackMonitor()
+: m_head(0)
+, m_inputOverflows(0)
+, m_outputUnderflows(0)
+, m_overruns(0)
+, m_modelSwaps(0)
+, m_loggedXruns(0)
+, m_sampleRate(G_DEFAULT_SAMPLERATE)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CallbackMonitor::reset(int sampleRate)
+{
+	assert(sampleRate > 0);
+
+	for (Slot& slot : m_history)
+		slot.seq.store(0);
+	m_head.store(0);
+	m_inputOverflows.store(0);
+	m_outputUnderflows.store(0);
+	m_overruns.store(0);
+	m_loggedXruns.store(0);
+	m_origin     = std::chrono::steady_clock::now();
+	m_prevStart  = {};
+	m_sampleRate = sampleRate;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CallbackMonitor::record(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end,
+    int bufferSize, bool inputOverflow, bool outputUnderflow)
+{
+	const uint64_t head = m_head.load(std::memory_order_relaxed);
+
+	Callback callback;
+	callback.time            = std::chrono::duration_cast<std::chrono::microseconds>(start - m_origin).count();
+	callback.duration        = toMicros_(end - start);
+	callback.period          = bufferSize * 1000000.0f / m_sampleRate;
+	callback.interval        = m_prevStart == std::chrono::steady_clock::time_point{} ? 0.0f : toMicros_(start - m_prevStart);
+	callback.load            = callback.period > 0.0f ? callback.duration / callback.period : 0.0f;
+	callback.inputOverflow   = inputOverflow;
+	callback.outputUnderflow = outputUnderflow;
+	callback.modelSwaps      = m_modelSwaps.load(std::memory_order_relaxed);
+
+	if (inputOverflow)
+		m_inputOverflows.fetch_add(1, std::memory_order_relaxed);
+	if (outputUnderflow)
+		m_outputUnderflows.fetch_add(1, std::memory_order_relaxed);
+	if (callback.load > 1.0f)
+		m_overruns.fetch_add(1, std::memory_order_relaxed);
+
+	m_history[head % G_CALLBACK_HISTORY_SIZE].write(callback, head);
+
+	m_prevStart = start;
+	m_head.store(head + 1, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CallbackMonitor::notifyModelSwap()
+{
+	m_modelSwaps.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+CallbackMonitor::Stats CallbackMonitor::getStats() const
+{
+	Stats stats;
+	stats.callbacks        = m_head.load(std::memory_order_acquire);
+	stats.inputOverflows   = m_inputOverflows.load(std::memory_order_relaxed);
+	stats.outputUnderflows = m_outputUnderflows.load(std::memory_order_relaxed);
+	stats.overruns         = m_overruns.load(std::memory_order_relaxed);
+
+	const std::vector<Callback> history = getHistory();
+
+	if (history.empty())
+		return stats;
+
+	float totalLoad = 0.0f;
+	for (const Callback& callback : history)
+	{
+		totalLoad += callback.load;
+		stats.peakLoad = std::max(stats.peakLoad, callback.load);
+		if (callback.interval > 0.0f)
+			stats.jitter = std::max(stats.jitter, std::fabs(callback.interval - callback.period));
+	}
+	stats.load = totalLoad / history.size();
+
+	return stats;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<CallbackMonitor::Callback> CallbackMonitor::getHistory() const
+{
+	const uint64_t last  = m_head.load(std::memory_order_acquire);
+	const uint64_t first = last > G_CALLBACK_HISTORY_SIZE ? last - G_CALLBACK_HISTORY_SIZE : 0;
+
+	/* The realtime thread keeps writing while the history is being copied: the
+	oldest records might get overwritten in the meantime. Such records fail to
+	read and are skipped. */
+
+	std::vector<Callback> out;
+	out.reserve(last - first);
+	for (uint64_t i = first; i < last; i++)
+	{
+		Callback callback;
+		if (m_history[i % G_CALLBACK_HISTORY_SIZE].read(callback, i))
+			out.push_back(callback);
+	}
+
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CallbackMonitor::logNewXruns()
+{
+	const Stats stats = getStats();
+
+	if (m_loggedXruns.exchange(stats.getXruns()) == stats.getXruns())
+		return;
+
+	u::log::print("[CallbackMonitor] Xrun detected - input overflows={} output underflows={} overruns={}\n",
+	    stats.inputOverflows, stats.outputUnderflows, stats.overruns);
+
+	for (const Callback& callback : getHistory())
+		u::log::print("     time={}us duration={:.0f}us interval={:.0f}us load={:.0f}% swaps={}{}{}\n",
+		    callback.time, callback.duration, callback.interval, callback.load * 100.0f, callback.modelSwaps,
+		    callback.inputOverflow ? " INPUT_OVERFLOW" : "", callback.outputUnderflow ? " OUTPUT_UNDERFLOW" : "");
+}
+} // namespace giada::m
@@ -0,0 +1,156 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_CALLBACK_MONITOR_H
+#define G_CALLBACK_MONITOR_H
+
+#include "src/core/const.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace giada::m
+{
+/* CallbackMonitor
+Keeps track of how the audio callback meets its deadline: how long it takes
+compared to the buffer period (the DSP load), how regularly it is invoked (the
+jitter) and whether the device reported any xrun. The realtime thread writes a
+record for each callback into a ring, with no locks nor allocations. */
+
+class CallbackMonitor final
+{
+public:
+	/* Callback
+	A single audio callback. Times are in microseconds. */
+
+	struct Callback
+	{
+		int64_t  time            = 0;    // Start time, since the last reset
+		float    duration        = 0.0f; // Time spent in the callback
+		float    period          = 0.0f; // Duration of the buffer
+		float    interval        = 0.0f; // Time since the start of the previous callback, 0 if none
+		float    load            = 0.0f; // Duration over period
+		bool     inputOverflow   = false;
+		bool     outputUnderflow = false;
+		uint64_t modelSwaps      = 0; // Model swaps occurred so far
+	};
+
+	/* Stats
+	DSP load (1.0 = the whole buffer period) and jitter (in microseconds) over
+	the last G_CALLBACK_HISTORY_SIZE callbacks, plus counters since the last
+	reset. */
+
+	struct Stats
+	{
+		float    load             = 0.0f;
+		float    peakLoad         = 0.0f;
+		float    jitter           = 0.0f;
+		uint64_t callbacks        = 0;
+		uint64_t inputOverflows   = 0;
+		uint64_t outputUnderflows = 0;
+		uint64_t overruns         = 0; // Callbacks that took longer than the buffer period
+
+		uint64_t getXruns() const;
+	};
+
+	CallbackMonitor();
+
+	/* reset
+	Discards all records and sets the sample rate of the new stream. Call it
+	while the stream is not running. */
+
+	void reset(int sampleRate);
+
+	/* record
+	Stores a callback that processed 'bufferSize' frames between 'start' and
+	'end'. Realtime-safe. */
+
+	void record(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end,
+	    int bufferSize, bool inputOverflow, bool outputUnderflow);
+
+	/* notifyModelSwap
+	Counts a model swap, so that xruns can be correlated with it. */
+
+	void notifyModelSwap();
+
+	Stats getStats() const;
+
+	/* getHistory
+	Returns the last G_CALLBACK_HISTORY_SIZE callbacks at most, oldest first.
+	Non-realtime. */
+
+	std::vector<Callback> getHistory() const;
+
+	/* logNewXruns
+	Writes the callback history to the log if new xruns have occurred since the
+	last call. Non-realtime. */
+
+	void logNewXruns();
+
+private:
+	/* Slot
+	A Callback in the history ring, guarded by a sequence lock: 'seq' is odd
+	while the realtime thread writes the slot, and 2 * (index + 1) once record
+	number 'index' is complete. read() copies the fields and fails if 'seq' has
+	changed in the meantime. Fields are atomic, so that reading them while they
+	are written is well defined. */
+
+	struct Slot
+	{
+		void write(const Callback&, uint64_t index);
+		bool read(Callback&, uint64_t index) const;
+
+		std::atomic<uint64_t> seq             = 0;
+		std::atomic<int64_t>  time            = 0;
+		std::atomic<float>    duration        = 0.0f;
+		std::atomic<float>    period          = 0.0f;
+		std::atomic<float>    interval        = 0.0f;
+		std::atomic<float>    load            = 0.0f;
+		std::atomic<bool>     inputOverflow   = false;
+		std::atomic<bool>     outputUnderflow = false;
+		std::atomic<uint64_t> modelSwaps      = 0;
+	};
+
+	std::array<Slot, G_CALLBACK_HISTORY_SIZE> m_history;
+	std::atomic<uint64_t>                     m_head; // Callbacks recorded so far
+
+	std::atomic<uint64_t> m_inputOverflows;
+	std::atomic<uint64_t> m_outputUnderflows;
+	std::atomic<uint64_t> m_overruns;
+	std::atomic<uint64_t> m_modelSwaps;
+	std::atomic<uint64_t> m_loggedXruns;
+
+	/* Realtime thread only. */
+
+	std::chrono::steady_clock::time_point m_origin;
+	std::chrono::steady_clock::time_point m_prevStart;
+	int                                   m_sampleRate;
+};
+} // namespace giada::m
+
+#endif
@@ -35,6 +35,21 @@
 
 namespace giada::m
 {
+namespace
+{
+ChannelShared::LaneValues getLaneValues_(const Channel& ch)
+{
+	ChannelShared::LaneValues values{ch.volume, ch.pan.asFloat(), {}};
+	for (std::size_t i = 0; i < G_MAX_NUM_SCENES; i++)
+		values.pitch[i] = ch.sampleChannel ? ch.sampleChannel->getPitch(Scene{i}) : G_DEFAULT_PITCH;
+	return values;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Channel::Channel(ChannelType type, ID id, ChannelShared& s)
 : shared(&s)
 , id(id)
@@ -257,4 +272,44 @@ void Channel::kickIn(Frame f)
 	shared->tracker.store(f);
 	shared->playStatus.store(ChannelStatus::PLAY);
 }
+
+/* -------------------------------------------------------------------------- */
+
+void Channel::syncLanes() const
+{
+	const ChannelShared::LaneValues values = getLaneValues_(*this);
+
+	shared->volume.set(values.volume);
+	shared->pan.set(values.pan);
+	if (sampleChannel)
+		for (std::size_t i = 0; i < G_MAX_NUM_SCENES; i++)
+			shared->pitch[i].set(values.pitch[i]);
+
+	shared->syncedValues = values;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Channel::syncChangedLanes() const
+{
+	if (shared->syncedValues == getLaneValues_(*this) || shared->lanesEdited.load())
+		return;
+	syncLanes();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Channel::syncFromLanes()
+{
+	volume = shared->volume.get();
+	pan    = shared->pan.get();
+
+	if (sampleChannel)
+		for (std::size_t i = 0; i < G_MAX_NUM_SCENES; i++)
+			sampleChannel->setPitch(shared->pitch[i].get(), Scene{i});
+
+	/* The lanes already hold these values: nothing to sync back. */
+
+	shared->syncedValues = getLaneValues_(*this);
+}
 } // namespace giada::m
\ No newline at end of file
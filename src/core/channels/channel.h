@@ -106,6 +106,27 @@ public:
 
 	void kickIn(Frame f);
 
+	/* syncLanes
+	Copies volume, pan and pitch into the realtime parameter lanes of the shared
+	state. */
+
+	void syncLanes() const;
+
+	/* syncChangedLanes
+	Same as syncLanes(), but only if volume, pan or pitch have changed since the
+	last sync. Lanes edited by another thread in the meantime (see
+	ChannelShared::lanesEdited) are never overwritten: they are newer than the
+	Channel values. */
+
+	void syncChangedLanes() const;
+
+	/* syncFromLanes
+	The opposite of syncLanes(): copies the parameter lanes back into volume,
+	pan and pitch, after they have been written by a thread other than the main
+	one. Main thread only. */
+
+	void syncFromLanes();
+
 	ChannelShared*       shared;
 	ID                   id;
 	ChannelType          type;
@@ -37,6 +37,7 @@
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/deps/mcl-utils/src/container.hpp"
 #include "src/utils/log.h"
+#include <utility>
 
 namespace utils = mcl::utils;
 
@@ -66,6 +67,11 @@ Channel& ChannelManager::getChannel(ID channelId)
 	return m_model.get().tracks.getChannel(channelId);
 }
 
+const Channel& ChannelManager::getChannel(ID channelId) const
+{
+	return std::as_const(m_model.get().tracks).getChannel(channelId);
+}
+
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::reset(Frame framesInBuffer)
@@ -130,7 +136,7 @@ void ChannelManager::removeTrack(std::size_t trackIndex)
 {
 	assert(canRemoveTrack(trackIndex));
 
-	const Channel& ch = m_model.get().tracks.get(trackIndex).getGroupChannel();
+	const Channel& ch = std::as_const(m_model.get().tracks).get(trackIndex).getGroupChannel();
 
 	m_model.removeChannelShared(*ch.shared);
 	m_model.get().tracks.remove(trackIndex);
@@ -168,9 +174,9 @@ Channel& ChannelManager::addChannel(ChannelType type, std::size_t trackIndex, in
 /* -------------------------------------------------------------------------- */
 
 int ChannelManager::loadSampleChannel(ID channelId, const std::string& fname, int sampleRate,
-    Resampler::Quality quality, Scene scene)
+    Resampler::Quality quality, int streamingThreshold, Scene scene)
 {
-	waveFactory::Result res = waveFactory::createFromFile(fname, /*id=*/{}, sampleRate, quality);
+	waveFactory::Result res = waveFactory::createFromFile(fname, /*id=*/{}, sampleRate, quality, streamingThreshold);
 	if (res.status != G_RES_OK)
 		return res.status;
 
@@ -203,8 +209,8 @@ void ChannelManager::loadSampleChannel(ID channelId, Wave& wave, Scene scene)
 
 void ChannelManager::cloneChannel(ID channelId, Scene scene, int bufferSize, const std::vector<Plugin*>& plugins)
 {
-	const Channel&           oldChannel     = m_model.get().tracks.getChannel(channelId);
-	const std::size_t        trackIndex     = m_model.get().tracks.getByChannel(channelId).getIndex();
+	const Channel&           oldChannel     = std::as_const(m_model.get().tracks).getChannel(channelId);
+	const std::size_t        trackIndex     = std::as_const(m_model.get().tracks).getByChannel(channelId).getIndex();
 	const Resampler::Quality rsmpQuality    = m_model.get().kernelAudio.rsmpQuality;
 	channelFactory::Data     newChannelData = channelFactory::create(oldChannel, bufferSize, rsmpQuality);
 
@@ -215,10 +221,14 @@ void ChannelManager::cloneChannel(ID channelId, Scene scene, int bufferSize, con
 	if (oldChannel.sampleChannel && oldChannel.sampleChannel->hasWave(scene))
 	{
 		const Sample& sample   = oldChannel.sampleChannel->getSample(scene);
-		const Wave&   oldWave  = *sample.wave;
+		Wave&         oldWave  = *sample.wave;
 		const Frame   oldShift = sample.shift;
 		const auto    oldRange = sample.range;
-		Wave&         wave     = m_model.addWave(waveFactory::createFromWave(oldWave));
+
+		if (oldWave.isPending())
+			loadWaveInMemory(oldWave);
+
+		Wave& wave = m_model.addWave(waveFactory::createFromWave(oldWave));
 
 		newChannelData.channel.loadSample({&wave, oldRange, oldShift}, scene);
 	}
@@ -251,7 +261,11 @@ void ChannelManager::copyChannelToScene(ID channelId, Scene srcScene, Scene dstS
 	of Wave and set it to the new scene. */
 
 	Sample sample = ch.sampleChannel->getSample(srcScene);
-	Wave&  wave   = m_model.addWave(waveFactory::createFromWave(*sample.wave));
+
+	if (sample.wave->isPending())
+		loadWaveInMemory(*sample.wave);
+
+	Wave& wave = m_model.addWave(waveFactory::createFromWave(*sample.wave));
 
 	sample.wave = &wave;
 	ch.loadSample(sample, dstScene);
@@ -261,6 +275,36 @@ void ChannelManager::copyChannelToScene(ID channelId, Scene srcScene, Scene dstS
 
 /* -------------------------------------------------------------------------- */
 
+void ChannelManager::loadWaveInMemory(Wave& wave)
+{
+	if (!wave.isStreamed() && !wave.isPending())
+		return;
+
+	/* Read from disk first, then swap data while the audio thread is not
+	rendering. */
+
+	if (wave.isStreamed())
+	{
+		mcl::AudioBuffer data = waveFactory::readStream(wave);
+
+		model::SharedLock lock = m_model.lockShared();
+		wave.replaceData(std::move(data));
+		return;
+	}
+
+	/* A pending Wave might be being decoded by the WaveLoader at the same time:
+	its result will be discarded, as the Wave is no longer pending. */
+
+	std::unique_ptr<Wave> loaded = waveFactory::loadPending(wave, m_model.get().kernelAudio.rsmpQuality);
+	if (loaded == nullptr)
+		return;
+
+	model::SharedLock lock = m_model.lockShared();
+	wave = std::move(*loaded);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelManager::freeSampleChannel(ID channelId, Scene sceneToFree)
 {
 	Channel& ch = m_model.get().tracks.getChannel(channelId);
@@ -307,7 +351,7 @@ void ChannelManager::freeAllSampleChannels(Scene scene)
 
 void ChannelManager::moveChannel(ID channelId, std::size_t newTrackIndex, std::size_t newPosition)
 {
-	Channel ch = m_model.get().tracks.getChannel(channelId); // Make copy
+	Channel ch = std::as_const(m_model.get().tracks).getChannel(channelId); // Make copy
 	m_model.get().tracks.removeChannel(channelId);
 	m_model.get().tracks.addChannel(std::move(ch), newTrackIndex, newPosition);
 	m_model.swap(model::SwapType::HARD);
@@ -317,7 +361,7 @@ void ChannelManager::moveChannel(ID channelId, std::size_t newTrackIndex, std::s
 
 void ChannelManager::deleteChannel(ID channelId)
 {
-	const Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 
 	if (ch.type == ChannelType::SAMPLE)
 	{
@@ -346,22 +390,22 @@ void ChannelManager::renameChannel(ID channelId, const std::string& name, Scene
 
 float ChannelManager::getMasterInVol() const
 {
-	return m_model.get().tracks.getChannel(MASTER_IN_CHANNEL_ID).volume;
+	return std::as_const(m_model.get().tracks).getChannel(MASTER_IN_CHANNEL_ID).volume;
 }
 
 float ChannelManager::getMasterOutVol() const
 {
-	return m_model.get().tracks.getChannel(MASTER_OUT_CHANNEL_ID).volume;
+	return std::as_const(m_model.get().tracks).getChannel(MASTER_OUT_CHANNEL_ID).volume;
 }
 
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::finalizeInputRec(const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame, Scene scene)
 {
-	for (Channel* ch : getRecordableChannels(scene))
-		recordChannel(*ch, buffer, recordedFrames, currentFrame, scene);
-	for (Channel* ch : getOverdubbableChannels(scene))
-		overdubChannel(*ch, buffer, currentFrame, scene);
+	for (const ID channelId : getRecordableChannels(scene))
+		recordChannel(m_model.get().tracks.getChannel(channelId), buffer, recordedFrames, currentFrame, scene);
+	for (const ID channelId : getOverdubbableChannels(scene))
+		overdubChannel(m_model.get().tracks.getChannel(channelId), buffer, currentFrame, scene);
 
 	triggerOnChannelsAltered();
 }
@@ -376,31 +420,75 @@ void ChannelManager::setInputMonitor(ID channelId, bool value)
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::setVolume(ID channelId, float value)
+void ChannelManager::setVolume(ID channelId, float value, Thread t)
 {
-	m_model.get().tracks.getChannel(channelId).volume = std::clamp(value, 0.0f, G_MAX_VOLUME);
-	m_model.swap(model::SwapType::SOFT);
+	/* Continuous control: no model swap here, the audio thread reads the
+	parameter lane. The Document is updated anyway and will reach the audio
+	thread with the next structural change. Only the main thread can edit the
+	Document though: other threads write the lane and flag it, so that the
+	main thread picks the value up on the next swap (see Model::swap). */
+
+	const float volume = std::clamp(value, 0.0f, G_MAX_VOLUME);
+
+	if (t != Thread::MAIN)
+	{
+		const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
+		ch.shared->volume.set(volume);
+		ch.shared->lanesEdited.store(true);
+		return;
+	}
+
+	Channel& ch = m_model.get().tracks.getChannel(channelId);
+
+	ch.volume = volume;
+	ch.shared->volume.set(ch.volume);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::setPitch(ID channelId, float value, Scene scene)
+void ChannelManager::setPitch(ID channelId, float value, Scene scene, Thread t)
 {
-	assert(m_model.get().tracks.getChannel(channelId).sampleChannel);
+	assert(std::as_const(m_model.get().tracks).getChannel(channelId).sampleChannel);
 
 	const float pitch = std::clamp(value, G_MIN_PITCH, G_MAX_PITCH);
 
-	m_model.get().tracks.getChannel(channelId).sampleChannel->setPitch(pitch, scene);
-	m_model.get().tracks.getChannel(PREVIEW_CHANNEL_ID).sampleChannel->setPitch(pitch, scene);
-	m_model.swap(model::SwapType::SOFT);
+	/* Continuous control, no model swap: see setVolume() above. */
+
+	for (const ID id : {channelId, PREVIEW_CHANNEL_ID})
+	{
+		if (t != Thread::MAIN)
+		{
+			const Channel& ch = std::as_const(m_model.get().tracks).getChannel(id);
+			ch.shared->pitch[scene.getIndex()].set(pitch);
+			ch.shared->lanesEdited.store(true);
+			continue;
+		}
+		Channel& ch = m_model.get().tracks.getChannel(id);
+		ch.sampleChannel->setPitch(pitch, scene);
+		ch.shared->pitch[scene.getIndex()].set(pitch);
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::setPan(ID channelId, float value)
+void ChannelManager::setPan(ID channelId, float value, Thread t)
 {
-	m_model.get().tracks.getChannel(channelId).pan = std::clamp(value, 0.0f, G_MAX_PAN);
-	m_model.swap(model::SwapType::SOFT);
+	/* Continuous control, no model swap: see setVolume() above. */
+
+	const float pan = std::clamp(value, 0.0f, G_MAX_PAN);
+
+	if (t != Thread::MAIN)
+	{
+		const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
+		ch.shared->pan.set(pan);
+		ch.shared->lanesEdited.store(true);
+		return;
+	}
+
+	Channel& ch = m_model.get().tracks.getChannel(channelId);
+
+	ch.pan = pan;
+	ch.shared->pan.set(ch.pan.asFloat());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -479,7 +567,7 @@ void ChannelManager::setHeight(ID channelId, int height)
 void ChannelManager::setSendToMaster(ID channelId, bool value)
 {
 	/* Can't toggle 'send to master' flag if there are no extra outputs. */
-	assert(m_model.get().tracks.getChannel(channelId).extraOutputs.size() > 0);
+	assert(std::as_const(m_model.get().tracks).getChannel(channelId).extraOutputs.size() > 0);
 
 	m_model.get().tracks.getChannel(channelId).sendToMaster = value;
 	m_model.swap(model::SwapType::NONE);
@@ -509,17 +597,43 @@ void ChannelManager::removeExtraOutput(ID channelId, std::size_t i)
 void ChannelManager::loadWaveInPreviewChannel(ID channelId, Scene scene)
 {
 	Channel&       previewCh = m_model.get().tracks.getChannel(PREVIEW_CHANNEL_ID);
-	const Channel& sourceCh  = m_model.get().tracks.getChannel(channelId);
+	const Channel& sourceCh  = std::as_const(m_model.get().tracks).getChannel(channelId);
 
 	assert(previewCh.sampleChannel);
 	assert(sourceCh.sampleChannel);
 
-	previewCh.loadSample(sourceCh.sampleChannel->getSample(scene), Scene{0});
+	Sample sample = sourceCh.sampleChannel->getSample(scene);
+
+	/* Streamed Waves can't be shared: give the preview channel its own stream,
+	reusing the current one if it's already reading the same file. */
+
+	std::unique_ptr<Wave> oldPreviewWave;
+	if (sample.wave != nullptr && sample.wave->isStreamed())
+	{
+		const bool reusable = m_previewWave != nullptr &&
+		                      m_previewWave->getPath() == sample.wave->getPath() &&
+		                      m_previewWave->countFrames() == sample.wave->countFrames();
+		if (!reusable)
+		{
+			oldPreviewWave = std::move(m_previewWave);
+			m_previewWave  = waveFactory::createFromWave(*sample.wave);
+		}
+		sample.wave = m_previewWave.get();
+	}
+	else
+		oldPreviewWave = std::move(m_previewWave);
+
+	previewCh.loadSample(sample, Scene{0});
 	previewCh.sampleChannel->mode = SamplePlayerMode::SINGLE_BASIC_PAUSE;
 	previewCh.sampleChannel->setRange(sourceCh.sampleChannel->getRange(scene), Scene{0});
 	previewCh.sampleChannel->setPitch(sourceCh.sampleChannel->getPitch(scene), Scene{0});
 
 	m_model.swap(model::SwapType::SOFT);
+
+	/* The old private Wave, if any, goes away here. It is safe to do it now: the
+	audio thread is already processing the new Document. */
+
+	oldPreviewWave.reset();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -530,20 +644,21 @@ void ChannelManager::freeWaveInPreviewChannel()
 
 	previewCh.loadSample({}, Scene{0});
 	m_model.swap(model::SwapType::SOFT);
+	m_previewWave.reset();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::setPreviewTracker(Frame f)
 {
-	m_model.get().tracks.getChannel(PREVIEW_CHANNEL_ID).shared->tracker.store(f);
+	std::as_const(m_model.get().tracks).getChannel(PREVIEW_CHANNEL_ID).shared->tracker.store(f);
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool ChannelManager::saveSample(ID channelId, const std::string& filePath, Scene scene)
 {
-	const Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 
 	assert(ch.sampleChannel);
 
@@ -551,6 +666,9 @@ bool ChannelManager::saveSample(ID channelId, const std::string& filePath, Scene
 
 	assert(wave != nullptr);
 
+	if (wave->isPending())
+		loadWaveInMemory(*wave);
+
 	if (!waveFactory::save(*wave, filePath))
 		return false;
 
@@ -608,7 +726,7 @@ bool ChannelManager::hasSolos() const
 
 bool ChannelManager::canRemoveTrack(std::size_t trackIndex) const
 {
-	return m_model.get().tracks.get(trackIndex).getNumChannels() == 1;
+	return std::as_const(m_model.get().tracks).get(trackIndex).getNumChannels() == 1;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -649,16 +767,22 @@ void ChannelManager::setupChannelCallbacks(const Channel& ch, ChannelShared& sha
 
 /* -------------------------------------------------------------------------- */
 
-std::vector<Channel*> ChannelManager::getRecordableChannels(Scene scene)
+std::vector<ID> ChannelManager::getRecordableChannels(Scene scene) const
 {
-	return m_model.get().tracks.getChannelsIf([scene](const Channel& c)
-	{ return c.canInputRec(scene) && !c.hasWave(scene); });
+	std::vector<ID> out;
+	for (const Channel* c : m_model.get().tracks.getChannels())
+		if (c->canInputRec(scene) && !c->hasWave(scene))
+			out.push_back(c->id);
+	return out;
 }
 
-std::vector<Channel*> ChannelManager::getOverdubbableChannels(Scene scene)
+std::vector<ID> ChannelManager::getOverdubbableChannels(Scene scene) const
 {
-	return m_model.get().tracks.getChannelsIf([scene](const Channel& c)
-	{ return c.canInputRec(scene) && c.hasWave(scene); });
+	std::vector<ID> out;
+	for (const Channel* c : m_model.get().tracks.getChannels())
+		if (c->canInputRec(scene) && c->hasWave(scene))
+			out.push_back(c->id);
+	return out;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -701,6 +825,12 @@ void ChannelManager::overdubChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 {
 	Wave* wave = ch.sampleChannel->getWave(scene);
 
+	/* A streamed or pending Wave must be brought in memory first. */
+
+	loadWaveInMemory(*wave);
+	if (wave->isPending())
+		return; // File no longer readable, nothing to overdub on
+
 	/* Need model::DataLock here, as data might be being read by the audio
 	thread at the same time. */
 
@@ -66,9 +66,12 @@ public:
 	ChannelManager(model::Model&, MidiMapper<KernelMidi>&, KernelMidi&);
 
 	/* getChannel
-	Returns channel object by ID. */
+	Returns channel object by ID. The non-const version is for editing: it
+	makes the Channel unique in the current Document first, so use the const
+	one for read-only access. */
 
-	Channel& getChannel(ID);
+	Channel&       getChannel(ID);
+	const Channel& getChannel(ID) const;
 
 	/* hasInputRecordableChannels
 	Tells whether Mixer has one or more input-recordable channels. */
@@ -125,9 +128,11 @@ public:
 	Channel& addChannel(ChannelType, std::size_t trackIndex, int bufferSize);
 
 	/* loadSampleChannel (1)
-	Creates a new Wave from a file path and loads it inside a Sample Channel. */
+	Creates a new Wave from a file path and loads it inside a Sample Channel.
+	See waveFactory::createFromFile() for the meaning of 'streamingThreshold'. */
 
-	int loadSampleChannel(ID channelId, const std::string&, int sampleRate, Resampler::Quality, Scene);
+	int loadSampleChannel(ID channelId, const std::string&, int sampleRate, Resampler::Quality,
+	    int streamingThreshold, Scene);
 
 	/* loadSampleChannel (2)
 	Loads an existing Wave inside a Sample Channel. */
@@ -156,6 +161,12 @@ public:
 
 	void copyChannelToScene(ID channelId, Scene srcScene, Scene dstScene);
 
+	/* loadWaveInMemory
+	Makes sure the audio data of a Wave lives in memory, reading it from disk
+	right away if streamed or still pending. */
+
+	void loadWaveInMemory(Wave&);
+
 	/* finalizeInputRec
 	Fills armed Sample channel with audio data coming from an input recording
 	session. */
@@ -171,9 +182,16 @@ public:
 	void finalizeActionRec(const std::unordered_set<ID>&);
 
 	void setInputMonitor(ID channelId, bool value);
-	void setVolume(ID channelId, float value);
-	void setPitch(ID channelId, float value, Scene);
-	void setPan(ID channelId, float value);
+
+	/* setVolume, setPitch, setPan
+	Continuous controls. They write the realtime parameter lanes in
+	ChannelShared without swapping the model. The Document is written too when
+	called from the main thread; other threads (e.g. MIDI learn) flag the lanes
+	as edited instead and the main thread syncs the Document later on. */
+
+	void setVolume(ID channelId, float value, Thread);
+	void setPitch(ID channelId, float value, Scene, Thread);
+	void setPan(ID channelId, float value, Thread);
 	void setRange(ID channelId, SampleRange, Scene);
 	void resetRange(ID channelId, Scene);
 	void toggleArm(ID channelId);
@@ -214,8 +232,12 @@ private:
 
 	void setupChannelCallbacks(const Channel&, ChannelShared&) const;
 
-	std::vector<Channel*> getRecordableChannels(Scene);
-	std::vector<Channel*> getOverdubbableChannels(Scene);
+	/* getRecordableChannels, getOverdubbableChannels
+	Return channel IDs rather than pointers: recording a channel swaps the model,
+	which may release the channels seen before the swap. */
+
+	std::vector<ID> getRecordableChannels(Scene) const;
+	std::vector<ID> getOverdubbableChannels(Scene) const;
 
 	/* setupChannelPostRecording
 	Fnialize the Sample channel after an audio recording session. */
@@ -238,6 +260,13 @@ private:
 	model::Model&           m_model;
 	KernelMidi&             m_kernelMidi;
 	MidiMapper<KernelMidi>& m_midiMapper;
+
+	/* m_previewWave
+	Private copy of a streamed Wave loaded in the preview channel. A stream
+	follows a single playhead, so the preview channel can't share it with the
+	source channel. Not part of the model: it never ends up in a patch. */
+
+	std::unique_ptr<Wave> m_previewWave;
 };
 } // namespace giada::m
 
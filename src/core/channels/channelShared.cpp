@@ -28,10 +28,34 @@
 
 namespace giada::m
 {
+bool ChannelShared::PitchedWave::isValidFor(const Wave& source, float p) const
+{
+	return wave != nullptr && sourceId == source.id && sourceRevision == source.getRevision() && pitch == p;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelShared::Automation::reset()
+{
+	if (volume.size() > 0)
+		volume.clear();
+	if (pan.size() > 0)
+		pan.clear();
+	pitch.reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
 ChannelShared::ChannelShared(ID id, Frame bufferSize)
 : id(id)
 , audioBuffer(bufferSize, G_MAX_IO_CHANS)
+, pluginBuffer(bufferSize)
+, delayLine(G_MAX_LATENCY_COMP)
 {
+	midiBuffer.ensureSize(G_DEFAULT_VST_MIDIBUFFER_SIZE);
+
+	for (ParamLane& lane : pitch)
+		lane.set(G_DEFAULT_PITCH);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -45,8 +69,17 @@ bool ChannelShared::isReadingActions() const
 
 /* -------------------------------------------------------------------------- */
 
+void ChannelShared::advanceLanes()
+{
+	volume.advance();
+	pan.advance();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelShared::setBufferSize(int bufferSize)
 {
 	audioBuffer.alloc(bufferSize, audioBuffer.countChannels());
+	pluginBuffer.setSize(bufferSize);
 }
 } // namespace giada::m
\ No newline at end of file
@@ -27,14 +27,20 @@
 #ifndef G_CHANNELSHARED_H
 #define G_CHANNELSHARED_H
 
+#include "src/core/actions/automationCurve.h"
 #include "src/core/const.h"
+#include "src/core/delayLine.h"
 #include "src/core/midiEvent.h"
+#include "src/core/paramLane.h"
+#include "src/core/plugins/pluginHost.h"
 #include "src/core/quantizer.h"
 #include "src/core/rendering/sampleRendering.h"
 #include "src/core/resampler.h"
+#include "src/core/wave.h"
 #include "src/deps/concurrentqueue/concurrentqueue.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <memory>
 #include <optional>
 
 namespace giada::m
@@ -44,12 +50,53 @@ struct ChannelShared final
 	using MidiQueue   = moodycamel::ConcurrentQueue<MidiEvent>;
 	using RenderQueue = moodycamel::ConcurrentQueue<rendering::RenderInfo>;
 
+	/* PitchedWave
+	Copy of a Wave pre-rendered at a fixed pitch, see PitchCache. It can be
+	played as long as ID and revision of the source Wave and pitch match the
+	ones of the current sample. */
+
+	struct PitchedWave
+	{
+		bool isValidFor(const Wave&, float pitch) const;
+
+		std::unique_ptr<Wave> wave;
+		ID                    sourceId;
+		int                   sourceRevision = 0;
+		float                 pitch          = G_DEFAULT_PITCH;
+		Resampler::Quality    quality        = Resampler::Quality::LINEAR;
+	};
+
+	/* Automation
+	Automated parameters for the current block, computed by the realtime thread
+	before rendering (see rendering::advanceAutomation). Volume and pan are
+	split into linear segments and applied sample by sample; pitch is applied
+	once per block. An empty set of segments means the parameter is not
+	automated: its ParamLane is in charge. */
+
+	struct Automation
+	{
+		/* reset
+		Marks all parameters as not automated. */
+
+		void reset();
+
+		AutomationCurve::Segments volume;
+		AutomationCurve::Segments pan;
+		std::optional<float>      pitch;
+	};
+
 	ChannelShared(ID, Frame bufferSize);
 
 	bool isReadingActions() const;
 
+	/* advanceLanes
+	Computes the volume and pan ramps for the next block. Realtime thread only,
+	once per block. */
+
+	void advanceLanes();
+
 	/* setBufferSize
-	Sets a new size for the internal audio buffer. */
+	Sets a new size for the internal audio buffers. */
 
 	void setBufferSize(int);
 
@@ -57,6 +104,19 @@ struct ChannelShared final
 
 	mcl::AudioBuffer audioBuffer;
 	juce::MidiBuffer midiBuffer;
+
+	/* pluginBuffer
+	Working buffer used by PluginHost while processing this channel's plug-in
+	stack. Each channel owns its own, so that the stacks of different tracks can
+	be rendered concurrently. */
+
+	PluginHost::WorkBuffer pluginBuffer;
+
+	/* delayLine
+	Delays the output of this channel to compensate for the latency of plug-ins
+	on other channels, see Renderer::compensateLatency. */
+
+	DelayLine delayLine;
 	MidiQueue        midiQueue{/*size=*/32, 0, /*num_threads=*/8}; // TODO - maximum 8 MIDI threads for now
 
 	WeakAtomic<Frame>         tracker        = 0;
@@ -65,6 +125,44 @@ struct ChannelShared final
 	WeakAtomic<bool>          readActions    = false;
 	WeakAtomic<float>         volumeInternal = G_DEFAULT_VOL; // Used for velocity-drives-volume mode on Sample Channels
 
+	/* volume, pan, pitch
+	Realtime copies of the Channel parameters with the same name, read by the
+	audio thread in place of the Channel ones. Continuous controls write here
+	directly without swapping the model; model swaps sync them with the Channel
+	anyway. Pitch has a lane per scene and is applied per block, without ramp. */
+
+	ParamLane             volume{G_DEFAULT_VOL};
+	ParamLane             pan{G_DEFAULT_PAN};
+	SceneArray<ParamLane> pitch;
+
+	/* lanesEdited
+	Set when the lanes above have been written by a thread other than the main
+	one (e.g. MIDI learn), which can't touch the Document. The main thread then
+	copies them back into the Channel, see Channel::syncFromLanes. */
+
+	WeakAtomic<bool> lanesEdited = false;
+
+	/* LaneValues
+	Channel values of volume, pan and pitch, as last synced with the lanes
+	above. */
+
+	struct LaneValues
+	{
+		bool operator==(const LaneValues&) const = default;
+
+		float             volume = G_DEFAULT_VOL;
+		float             pan    = G_DEFAULT_PAN;
+		SceneArray<float> pitch  = {};
+	};
+
+	/* syncedValues
+	Tells whether the Channel values have changed since the last sync, see
+	Channel::syncChangedLanes. Empty if never synced. Main thread only. */
+
+	std::optional<LaneValues> syncedValues;
+
+	Automation automation;
+
 	std::optional<Quantizer> quantizer;
 
 	/* Optional render queue for sample-based channels. Used by callers on thread
@@ -73,12 +171,29 @@ struct ChannelShared final
 
 	std::optional<RenderQueue> renderQueue = {};
 
-	/* Optional resampler for sample-based channels. Unfortunately a Resampler
-	object (based on libsamplerate) doesn't like to get copied while rendering
-	audio, so can't live inside a Channel object (which is copied on model
+	/* Optional resampler for sample-based channels. A Resampler object keeps
+	the filter history between audio blocks, so it can't get copied while
+	rendering audio, nor live inside a Channel object (which is copied on model
 	changes by the Swapper mechanism). Let's put it in the shared state here. */
 
 	std::optional<Resampler> resampler = {};
+
+	/* Optional pre-rendered copy of the Wave being played by sample-based
+	channels. Swapped by PitchCache while the model is locked. */
+
+	PitchedWave pitchedWave;
+
+	/* Playback position in 'pitchedWave' and the tracker value it refers to. If
+	the tracker has been moved by someone else the position is recomputed. Used
+	by the audio thread only. */
+
+	double pitchedPos     = 0.0;
+	Frame  pitchedTracker = -1;
+
+	/* Set by PitchCache when 'pitchedWave' has been replaced: the audio thread
+	then drops the playback position above and recomputes it. */
+
+	WeakAtomic<bool> pitchedReset = false;
 };
 } // namespace giada::m
 
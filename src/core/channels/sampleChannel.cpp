@@ -84,6 +84,7 @@ bool SampleChannel::isAnyNonLoopingSingleMode() const
 bool SampleChannel::hasWave(Scene scene) const { return m_samples[scene.getIndex()].wave != nullptr; }
 bool SampleChannel::hasLogicalWave(Scene scene) const { return hasWave(scene) && m_samples[scene.getIndex()].wave->isLogical(); }
 bool SampleChannel::hasEditedWave(Scene scene) const { return hasWave(scene) && m_samples[scene.getIndex()].wave->isEdited(); }
+bool SampleChannel::hasPendingWave(Scene scene) const { return hasWave(scene) && m_samples[scene.getIndex()].wave->isPending(); }
 
 /* -------------------------------------------------------------------------- */
 
@@ -126,7 +127,7 @@ const Sample& SampleChannel::getSample(Scene scene) const
 
 Frame SampleChannel::getWaveSize(Scene scene) const
 {
-	return hasWave(scene) ? m_samples[scene.getIndex()].wave->getBuffer().countFrames() : 0;
+	return hasWave(scene) ? m_samples[scene.getIndex()].wave->countFrames() : 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -138,7 +139,7 @@ void SampleChannel::loadSample(const Sample& s, Scene scene)
 	if (s.wave != nullptr)
 	{
 		m_samples[scene.getIndex()].shift = s.shift == -1 ? 0 : s.shift;
-		m_samples[scene.getIndex()].range = s.range.isValid() ? s.range : SampleRange(0, s.wave->getBuffer().countFrames());
+		m_samples[scene.getIndex()].range = s.range.isValid() ? s.range : SampleRange(0, s.wave->countFrames());
 	}
 }
 
@@ -46,6 +46,7 @@ public:
 	bool        hasWave(Scene) const;
 	bool        hasLogicalWave(Scene) const;
 	bool        hasEditedWave(Scene) const;
+	bool        hasPendingWave(Scene) const;
 	ID          getWaveId(Scene) const;
 	Frame       getWaveSize(Scene) const;
 	Wave*       getWave(Scene) const;
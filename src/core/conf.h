@@ -28,6 +28,7 @@
 #define G_CONF_H
 
 #include "src/core/const.h"
+#include "src/core/limiter.h"
 #include "src/core/resampler.h"
 #include "src/core/types.h"
 #include "src/deps/geompp/src/rect.hpp"
@@ -58,7 +59,18 @@ struct Conf final
 	int                samplerate       = G_DEFAULT_SAMPLERATE;
 	int                buffersize       = G_DEFAULT_BUFSIZE;
 	bool               limitOutput      = false;
+	Limiter::Mode      limiterMode      = Limiter::Mode::HARD;
 	Resampler::Quality rsmpQuality      = Resampler::Quality::SINC_BEST;
+	int                renderThreads    = 0;
+
+	int  streamingThreshold = 0;                         // In seconds, 0 = never stream samples from disk
+	int  waveCacheSize      = G_DEFAULT_WAVE_CACHE_SIZE; // In MB, 0 = disable the decoded sample cache
+	bool lazySampleLoading  = true;                      // Decode project samples in background
+	bool pitchCache         = true;                      // Pre-render samples with a steady pitch
+	bool planarBuses        = false;                     // Keep group and master buses non-interleaved
+	bool logXruns           = false;                     // Log the last audio callbacks on each xrun
+
+	std::set<std::string> sandboxedPlugins; // JUCE ids of plug-ins to be hosted in a sandbox process
 
 	RtMidi::Api           midiSystem = G_DEFAULT_MIDI_API;
 	std::set<std::size_t> midiDevicesOut;
@@ -48,7 +48,16 @@ constexpr auto CONF_KEY_CHANNELS_IN_START             = "channels_in_start";
 constexpr auto CONF_KEY_SAMPLERATE                    = "samplerate";
 constexpr auto CONF_KEY_BUFFER_SIZE                   = "buffer_size";
 constexpr auto CONF_KEY_LIMIT_OUTPUT                  = "limit_output";
+constexpr auto CONF_KEY_LIMITER_MODE                  = "limiter_mode";
 constexpr auto CONF_KEY_RESAMPLE_QUALITY              = "resample_quality";
+constexpr auto CONF_KEY_RENDER_THREADS                = "render_threads";
+constexpr auto CONF_KEY_STREAMING_THRESHOLD           = "streaming_threshold";
+constexpr auto CONF_KEY_WAVE_CACHE_SIZE               = "wave_cache_size";
+constexpr auto CONF_KEY_LAZY_SAMPLE_LOADING           = "lazy_sample_loading";
+constexpr auto CONF_KEY_PITCH_CACHE                   = "pitch_cache";
+constexpr auto CONF_KEY_PLANAR_BUSES                  = "planar_buses";
+constexpr auto CONF_KEY_LOG_XRUNS                     = "log_xruns";
+constexpr auto CONF_KEY_SANDBOXED_PLUGINS             = "sandboxed_plugins";
 constexpr auto CONF_KEY_MIDI_SYSTEM                   = "midi_system";
 constexpr auto CONF_KEY_MIDI_PORT_OUT                 = "midi_port_out";
 constexpr auto CONF_KEY_MIDI_PORT_IN                  = "midi_port_in";
@@ -154,7 +163,16 @@ Conf parse_(std::ifstream& ifs)
 	conf.samplerate                 = j.value(CONF_KEY_SAMPLERATE, conf.samplerate);
 	conf.buffersize                 = j.value(CONF_KEY_BUFFER_SIZE, conf.buffersize);
 	conf.limitOutput                = j.value(CONF_KEY_LIMIT_OUTPUT, conf.limitOutput);
+	conf.limiterMode                = j.value(CONF_KEY_LIMITER_MODE, conf.limiterMode);
 	conf.rsmpQuality                = j.value(CONF_KEY_RESAMPLE_QUALITY, conf.rsmpQuality);
+	conf.renderThreads              = j.value(CONF_KEY_RENDER_THREADS, conf.renderThreads);
+	conf.streamingThreshold         = j.value(CONF_KEY_STREAMING_THRESHOLD, conf.streamingThreshold);
+	conf.waveCacheSize              = j.value(CONF_KEY_WAVE_CACHE_SIZE, conf.waveCacheSize);
+	conf.lazySampleLoading          = j.value(CONF_KEY_LAZY_SAMPLE_LOADING, conf.lazySampleLoading);
+	conf.pitchCache                 = j.value(CONF_KEY_PITCH_CACHE, conf.pitchCache);
+	conf.planarBuses                = j.value(CONF_KEY_PLANAR_BUSES, conf.planarBuses);
+	conf.logXruns                   = j.value(CONF_KEY_LOG_XRUNS, conf.logXruns);
+	conf.sandboxedPlugins           = j.value(CONF_KEY_SANDBOXED_PLUGINS, conf.sandboxedPlugins);
 	conf.midiSystem                 = j.value(CONF_KEY_MIDI_SYSTEM, conf.midiSystem);
 	conf.midiDevicesOut             = j.value(CONF_KEY_MIDI_PORT_OUT, conf.midiDevicesOut);
 	conf.midiDevicesIn              = j.value(CONF_KEY_MIDI_PORT_IN, conf.midiDevicesIn);
@@ -249,12 +267,15 @@ Conf parse_(std::ifstream& ifs)
 
 void sanitize_(Conf& conf)
 {
-	conf.soundDeviceOut   = std::max(0, conf.soundDeviceOut);
-	conf.soundDeviceIn    = std::max(0, conf.soundDeviceIn);
-	conf.channelsOutCount = std::max(0, conf.channelsOutCount);
-	conf.channelsOutStart = std::max(0, conf.channelsOutStart);
-	conf.channelsInCount  = std::max(1, conf.channelsInCount);
-	conf.channelsInStart  = std::max(0, conf.channelsInStart);
+	conf.soundDeviceOut     = std::max(0, conf.soundDeviceOut);
+	conf.soundDeviceIn      = std::max(0, conf.soundDeviceIn);
+	conf.channelsOutCount   = std::max(0, conf.channelsOutCount);
+	conf.channelsOutStart   = std::max(0, conf.channelsOutStart);
+	conf.channelsInCount    = std::max(1, conf.channelsInCount);
+	conf.channelsInStart    = std::max(0, conf.channelsInStart);
+	conf.renderThreads      = std::clamp(conf.renderThreads, 0, G_MAX_RENDER_THREADS);
+	conf.streamingThreshold = std::max(0, conf.streamingThreshold);
+	conf.waveCacheSize      = std::max(0, conf.waveCacheSize);
 
 	conf.uiScaling = std::clamp(conf.uiScaling, G_MIN_UI_SCALING, G_MAX_UI_SCALING);
 }
@@ -285,7 +306,16 @@ bool serialize(const Conf& conf)
 	j[CONF_KEY_SAMPLERATE]                    = conf.samplerate;
 	j[CONF_KEY_BUFFER_SIZE]                   = conf.buffersize;
 	j[CONF_KEY_LIMIT_OUTPUT]                  = conf.limitOutput;
+	j[CONF_KEY_LIMITER_MODE]                  = conf.limiterMode;
 	j[CONF_KEY_RESAMPLE_QUALITY]              = conf.rsmpQuality;
+	j[CONF_KEY_RENDER_THREADS]                = conf.renderThreads;
+	j[CONF_KEY_STREAMING_THRESHOLD]           = conf.streamingThreshold;
+	j[CONF_KEY_WAVE_CACHE_SIZE]               = conf.waveCacheSize;
+	j[CONF_KEY_LAZY_SAMPLE_LOADING]           = conf.lazySampleLoading;
+	j[CONF_KEY_PITCH_CACHE]                   = conf.pitchCache;
+	j[CONF_KEY_PLANAR_BUSES]                  = conf.planarBuses;
+	j[CONF_KEY_LOG_XRUNS]                     = conf.logXruns;
+	j[CONF_KEY_SANDBOXED_PLUGINS]             = conf.sandboxedPlugins;
 	j[CONF_KEY_MIDI_SYSTEM]                   = conf.midiSystem;
 	j[CONF_KEY_MIDI_PORT_OUT]                 = conf.midiDevicesOut;
 	j[CONF_KEY_MIDI_PORT_IN]                  = conf.midiDevicesIn;
@@ -32,6 +32,7 @@
 #include "src/types.h"
 #include "src/version.h"
 #include <RtMidi.h>
+#include <cstddef>
 #include <cstdint>
 
 namespace giada
@@ -53,6 +54,59 @@ The rate at which KernelMidi checks for MIDI events received from the devices.
 Note: this value will obviously increase the MIDI latency, keep it small! */
 constexpr int G_KERNEL_MIDI_INPUT_RATE_MS = 3;
 
+/* G_WAVE_STREAM_RATE_MS
+The rate at which samples streamed from disk get their data refilled. It must
+be way shorter than the streaming window (a few seconds). */
+constexpr int G_WAVE_STREAM_RATE_MS = 10;
+
+/* G_PROFILER_RATE_MS, G_PROFILER_RING_SIZE, G_PROFILER_WINDOW, G_PROFILER_EXPIRY
+How often the realtime timings are collected, how many of them each rendering
+thread can buffer in the meantime, how many recent timings the statistics
+are computed on and after how many collections with no new timings the
+statistics of a section are discarded (e.g. a deleted channel or plug-in). */
+constexpr int G_PROFILER_RATE_MS   = 250;
+constexpr int G_PROFILER_RING_SIZE = 8192;
+constexpr int G_PROFILER_WINDOW    = 1024;
+constexpr int G_PROFILER_EXPIRY    = 40;
+
+/* G_CALLBACK_MONITOR_RATE_MS, G_CALLBACK_HISTORY_SIZE
+How often the audio callback statistics are checked for new xruns, and how many
+recent callbacks are kept for the statistics and the xrun reports. */
+constexpr int G_CALLBACK_MONITOR_RATE_MS = 250;
+constexpr int G_CALLBACK_HISTORY_SIZE    = 256;
+
+/* G_HEADLESS_DISPATCH_RATE_MS
+How long each pass of the JUCE message loop lasts in headless mode, i.e. the
+maximum delay before a quit signal is noticed. */
+constexpr int G_HEADLESS_DISPATCH_RATE_MS = 100;
+
+/* G_PITCH_CACHE_RATE_MS, G_PITCH_CACHE_DELAY_MS, G_PITCH_CACHE_MAX_BYTES
+The rate at which PitchCache looks for samples to pre-render, how long the
+pitch of a sample must stay unchanged before it gets pre-rendered and how much
+memory all the pre-rendered samples can take. */
+constexpr int         G_PITCH_CACHE_RATE_MS   = 250;
+constexpr int         G_PITCH_CACHE_DELAY_MS  = 1000;
+constexpr std::size_t G_PITCH_CACHE_MAX_BYTES = 256 * 1024 * 1024;
+
+/* G_PLUGIN_SANDBOX_TIMEOUT_MS, G_PLUGIN_SANDBOX_WATCHDOG_MS
+How long the host waits for a plug-in sandbox to load its plug-in or to answer
+a command, and how often each sandbox is checked for crashes and stalls. */
+constexpr int G_PLUGIN_SANDBOX_TIMEOUT_MS  = 10000;
+constexpr int G_PLUGIN_SANDBOX_WATCHDOG_MS = 500;
+
+/* G_PLUGIN_SCAN_TIMEOUT_MS
+How long a plug-in file may keep a scanner process busy before being killed
+and blacklisted. */
+constexpr int G_PLUGIN_SCAN_TIMEOUT_MS = 30000;
+
+/* G_PLUGIN_SLEEP_THRESHOLD, G_PLUGIN_SLEEP_DELAY_MS
+Peak level below which the input of a plug-in counts as silence (-120 dBFS),
+and how long the silence must last, on top of the plug-in tail, before the
+plug-in stops being processed. The extra delay covers plug-ins that under-report
+their tail. */
+constexpr float G_PLUGIN_SLEEP_THRESHOLD = 0.000001f;
+constexpr int   G_PLUGIN_SLEEP_DELAY_MS  = 1000;
+
 /* -- MIN/MAX values -------------------------------------------------------- */
 constexpr float G_MIN_BPM               = 20.0f;
 constexpr float G_MAX_BPM               = 999.0f;
@@ -70,6 +124,9 @@ constexpr float G_MAX_VELOCITY_FLOAT    = 1.0f;
 constexpr int   G_MAX_MIDI_CHANS        = 16;
 constexpr int   G_MAX_DISPATCHER_EVENTS = 32;
 constexpr int   G_MAX_SEQUENCER_EVENTS  = 128; // Per block
+constexpr int   G_MAX_AUTOMATION_SEGS   = 32;  // Per block, per automated parameter
+constexpr int   G_MAX_RENDER_THREADS    = 32;
+constexpr int   G_MAX_LATENCY_COMP      = 16384; // Max plug-in delay compensation per Channel, in frames
 
 /* -- default values -------------------------------------------------------- */
 constexpr RtAudio::Api G_DEFAULT_SOUNDSYS            = RtAudio::Api::UNSPECIFIED;
@@ -93,6 +150,7 @@ constexpr auto         G_DEFAULT_PATCH_NAME          = "(default patch)";
 constexpr int          G_DEFAULT_ACTION_SIZE         = 8192; // frames
 constexpr float        G_DEFAULT_REC_TRIGGER_LEVEL   = -10.0f;
 constexpr int          G_DEFAULT_VST_MIDIBUFFER_SIZE = 1024; // TODO - not 100% sure about this size
+constexpr int          G_DEFAULT_WAVE_CACHE_SIZE     = 1024; // MB
 
 /* -- responses and return codes -------------------------------------------- */
 constexpr int G_RES_ERR_PROCESSING    = -6;
@@ -0,0 +1,117 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/delayLine.h"
+#include "src/core/const.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace giada::m
+{
+DelayLine::DelayLine(int maxDelay)
+: m_buffer((maxDelay + 1) * G_MAX_IO_CHANS, 0.0f)
+, m_capacity(maxDelay + 1)
+, m_delay(0)
+, m_writePos(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DelayLine::setDelay(int delay)
+{
+	m_delay = std::clamp(delay, 0, m_capacity - 1);
+}
+
+int DelayLine::getDelay() const
+{
+	return m_delay;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DelayLine::process(mcl::AudioBuffer& buf)
+{
+	if (m_delay == 0)
+		return;
+
+	const int numChannels = std::min(buf.countChannels(), G_MAX_IO_CHANS);
+	int       readPos     = (m_writePos - m_delay + m_capacity) % m_capacity;
+
+	for (int i = 0; i < buf.countFrames(); i++)
+	{
+		float* frame   = buf[i];
+		float* slot    = &m_buffer[m_writePos * G_MAX_IO_CHANS];
+		float* delayed = &m_buffer[readPos * G_MAX_IO_CHANS];
+
+		for (int j = 0; j < numChannels; j++)
+		{
+			slot[j]  = frame[j];
+			frame[j] = delayed[j];
+		}
+
+		m_writePos = m_writePos + 1 == m_capacity ? 0 : m_writePos + 1;
+		readPos    = readPos + 1 == m_capacity ? 0 : readPos + 1;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DelayLine::process(juce::AudioBuffer<float>& buf)
+{
+	if (m_delay == 0)
+		return;
+
+	const int numChannels = std::min(buf.getNumChannels(), G_MAX_IO_CHANS);
+	int       readPos     = (m_writePos - m_delay + m_capacity) % m_capacity;
+
+	float* const* channels = buf.getArrayOfWritePointers();
+
+	for (int i = 0; i < buf.getNumSamples(); i++)
+	{
+		float* slot    = &m_buffer[m_writePos * G_MAX_IO_CHANS];
+		float* delayed = &m_buffer[readPos * G_MAX_IO_CHANS];
+
+		for (int j = 0; j < numChannels; j++)
+		{
+			slot[j]        = channels[j][i];
+			channels[j][i] = delayed[j];
+		}
+
+		m_writePos = m_writePos + 1 == m_capacity ? 0 : m_writePos + 1;
+		readPos    = readPos + 1 == m_capacity ? 0 : readPos + 1;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DelayLine::clear()
+{
+	std::fill(m_buffer.begin(), m_buffer.end(), 0.0f);
+}
+} // namespace giada::m
@@ -0,0 +1,84 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_DELAY_LINE_H
+#define G_DELAY_LINE_H
+
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace juce
+{
+template <typename Type>
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* DelayLine
+Fixed-capacity delay for up to G_MAX_IO_CHANS channels, used to keep the
+output of tracks with different plug-in latencies aligned. The memory is
+allocated upfront, so that the delay can be changed on the realtime thread. */
+
+class DelayLine final
+{
+public:
+	DelayLine(int maxDelay);
+
+	/* setDelay
+	Sets the delay in frames, clamped to the capacity. Realtime-safe. */
+
+	void setDelay(int);
+
+	int getDelay() const;
+
+	/* process
+	Delays the buffer in place. Does nothing if the delay is zero. */
+
+	void process(mcl::AudioBuffer&);
+	void process(juce::AudioBuffer<float>&);
+
+	/* clear
+	Flushes the audio waiting to be output. */
+
+	void clear();
+
+private:
+	/* m_buffer
+	Ring buffer of m_capacity interleaved frames. */
+
+	std::vector<float> m_buffer;
+	int                m_capacity;
+	int                m_delay;
+	int                m_writePos;
+};
+} // namespace giada::m
+
+#endif
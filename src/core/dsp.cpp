@@ -0,0 +1,1064 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/dsp.h"
+#include "src/core/const.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define G_DSP_SSE2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define G_DSP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define G_DSP_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define G_DSP_NEON
+#include <arm_neon.h>
+#endif
+
+namespace giada::m::dsp
+{
+namespace
+{
+/* Kernels
+Table of functions working on raw interleaved data. 'sumPanned' and 'peak'
+expect stereo buffers, the others work on any number of samples. 'sumToPlanar'
+and 'sumFromPlanar' move stereo data between the interleaved and the planar
+layout, 'sumPeak' works on a single planar channel. */
+
+struct Kernels
+{
+	const char* name;
+	Peak (*sumPanned)(float* dest, const float* src, int frames, float gainL, float gainR);
+	void (*sum)(float* dest, const float* src, int samples, float gain);
+	void (*scale)(float* buf, int samples, float gain);
+	void (*clamp)(float* buf, int samples, float min, float max);
+	void (*sumClamp)(float* dest, const float* src, int samples, float gain, float min, float max);
+	void (*scaleClamp)(float* buf, int samples, float gain, float min, float max);
+	Peak (*peak)(const float* buf, int frames);
+	Peak (*sumToPlanar)(float* destL, float* destR, const float* src, int frames, float gainL, float gainR);
+	Peak (*sumFromPlanar)(float* dest, const float* srcL, const float* srcR, int frames, float gainL, float gainR);
+	float (*sumPeak)(float* dest, const float* src, int samples, float gain);
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* Scalar kernels. They also take care of the leftovers of the vectorized ones,
+hence the 'from' argument. */
+
+Peak sumPannedScalar_(float* dest, const float* src, int from, int frames,
+    float gainL, float gainR, Peak peak)
+{
+	for (int i = from * 2; i < frames * 2; i += 2)
+	{
+		peak.left  = std::max(peak.left, std::abs(src[i]));
+		peak.right = std::max(peak.right, std::abs(src[i + 1]));
+		dest[i] += src[i] * gainL;
+		dest[i + 1] += src[i + 1] * gainR;
+	}
+	return peak;
+}
+
+void sumScalar_(float* dest, const float* src, int from, int samples, float gain)
+{
+	for (int i = from; i < samples; i++)
+		dest[i] += src[i] * gain;
+}
+
+void scaleScalar_(float* buf, int from, int samples, float gain)
+{
+	for (int i = from; i < samples; i++)
+		buf[i] *= gain;
+}
+
+void clampScalar_(float* buf, int from, int samples, float min, float max)
+{
+	for (int i = from; i < samples; i++)
+		buf[i] = std::max(min, std::min(buf[i], max));
+}
+
+void sumClampScalar_(float* dest, const float* src, int from, int samples, float gain, float min, float max)
+{
+	for (int i = from; i < samples; i++)
+		dest[i] = std::max(min, std::min(dest[i] + src[i] * gain, max));
+}
+
+void scaleClampScalar_(float* buf, int from, int samples, float gain, float min, float max)
+{
+	for (int i = from; i < samples; i++)
+		buf[i] = std::max(min, std::min(buf[i] * gain, max));
+}
+
+Peak peakScalar_(const float* buf, int from, int frames, Peak peak)
+{
+	for (int i = from * 2; i < frames * 2; i += 2)
+	{
+		peak.left  = std::max(peak.left, std::abs(buf[i]));
+		peak.right = std::max(peak.right, std::abs(buf[i + 1]));
+	}
+	return peak;
+}
+
+Peak sumToPlanarScalar_(float* destL, float* destR, const float* src, int from, int frames,
+    float gainL, float gainR, Peak peak)
+{
+	for (int i = from; i < frames; i++)
+	{
+		peak.left  = std::max(peak.left, std::abs(src[i * 2]));
+		peak.right = std::max(peak.right, std::abs(src[i * 2 + 1]));
+		destL[i] += src[i * 2] * gainL;
+		destR[i] += src[i * 2 + 1] * gainR;
+	}
+	return peak;
+}
+
+Peak sumFromPlanarScalar_(float* dest, const float* srcL, const float* srcR, int from, int frames,
+    float gainL, float gainR, Peak peak)
+{
+	for (int i = from; i < frames; i++)
+	{
+		peak.left  = std::max(peak.left, std::abs(srcL[i]));
+		peak.right = std::max(peak.right, std::abs(srcR[i]));
+		dest[i * 2] += srcL[i] * gainL;
+		dest[i * 2 + 1] += srcR[i] * gainR;
+	}
+	return peak;
+}
+
+float sumPeakScalar_(float* dest, const float* src, int from, int samples, float gain, float peak)
+{
+	for (int i = from; i < samples; i++)
+	{
+		peak = std::max(peak, std::abs(src[i]));
+		dest[i] += src[i] * gain;
+	}
+	return peak;
+}
+
+/* -------------------------------------------------------------------------- */
+
+#if !defined(G_DSP_SSE2) && !defined(G_DSP_NEON)
+
+Peak sumPannedScalar_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	return sumPannedScalar_(dest, src, 0, frames, gainL, gainR, {0.0f, 0.0f});
+}
+
+void sumScalar_(float* dest, const float* src, int samples, float gain) { sumScalar_(dest, src, 0, samples, gain); }
+void scaleScalar_(float* buf, int samples, float gain) { scaleScalar_(buf, 0, samples, gain); }
+void clampScalar_(float* buf, int samples, float min, float max) { clampScalar_(buf, 0, samples, min, max); }
+void sumClampScalar_(float* dest, const float* src, int samples, float gain, float min, float max) { sumClampScalar_(dest, src, 0, samples, gain, min, max); }
+void scaleClampScalar_(float* buf, int samples, float gain, float min, float max) { scaleClampScalar_(buf, 0, samples, gain, min, max); }
+Peak peakScalar_(const float* buf, int frames) { return peakScalar_(buf, 0, frames, {0.0f, 0.0f}); }
+
+Peak sumToPlanarScalar_(float* destL, float* destR, const float* src, int frames, float gainL, float gainR)
+{
+	return sumToPlanarScalar_(destL, destR, src, 0, frames, gainL, gainR, {0.0f, 0.0f});
+}
+
+Peak sumFromPlanarScalar_(float* dest, const float* srcL, const float* srcR, int frames, float gainL, float gainR)
+{
+	return sumFromPlanarScalar_(dest, srcL, srcR, 0, frames, gainL, gainR, {0.0f, 0.0f});
+}
+
+float sumPeakScalar_(float* dest, const float* src, int samples, float gain) { return sumPeakScalar_(dest, src, 0, samples, gain, 0.0f); }
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+#if defined(G_DSP_SSE2)
+
+/* SSE2 kernels. A register holds two stereo frames: even lanes are left, odd
+lanes are right. */
+
+Peak reducePeakSSE2_(__m128 v)
+{
+	alignas(16) float p[4];
+	_mm_store_ps(p, v);
+	return {std::max(p[0], p[2]), std::max(p[1], p[3])};
+}
+
+Peak sumPannedSSE2_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+	__m128       peak = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 2 <= frames; i += 2)
+	{
+		const __m128 s = _mm_loadu_ps(src + i * 2);
+		const __m128 d = _mm_loadu_ps(dest + i * 2);
+		peak           = _mm_max_ps(peak, _mm_and_ps(s, mask));
+		_mm_storeu_ps(dest + i * 2, _mm_add_ps(d, _mm_mul_ps(s, gain)));
+	}
+	return sumPannedScalar_(dest, src, i, frames, gainL, gainR, reducePeakSSE2_(peak));
+}
+
+void sumSSE2_(float* dest, const float* src, int samples, float gain)
+{
+	const __m128 g = _mm_set1_ps(gain);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+	sumScalar_(dest, src, i, samples, gain);
+}
+
+void scaleSSE2_(float* buf, int samples, float gain)
+{
+	const __m128 g = _mm_set1_ps(gain);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		_mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), g));
+	scaleScalar_(buf, i, samples, gain);
+}
+
+void clampSSE2_(float* buf, int samples, float min, float max)
+{
+	const __m128 lo = _mm_set1_ps(min);
+	const __m128 hi = _mm_set1_ps(max);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		_mm_storeu_ps(buf + i, _mm_max_ps(lo, _mm_min_ps(_mm_loadu_ps(buf + i), hi)));
+	clampScalar_(buf, i, samples, min, max);
+}
+
+void sumClampSSE2_(float* dest, const float* src, int samples, float gain, float min, float max)
+{
+	const __m128 g  = _mm_set1_ps(gain);
+	const __m128 lo = _mm_set1_ps(min);
+	const __m128 hi = _mm_set1_ps(max);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+	{
+		const __m128 v = _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), g));
+		_mm_storeu_ps(dest + i, _mm_max_ps(lo, _mm_min_ps(v, hi)));
+	}
+	sumClampScalar_(dest, src, i, samples, gain, min, max);
+}
+
+void scaleClampSSE2_(float* buf, int samples, float gain, float min, float max)
+{
+	const __m128 g  = _mm_set1_ps(gain);
+	const __m128 lo = _mm_set1_ps(min);
+	const __m128 hi = _mm_set1_ps(max);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		_mm_storeu_ps(buf + i, _mm_max_ps(lo, _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(buf + i), g), hi)));
+	scaleClampScalar_(buf, i, samples, gain, min, max);
+}
+
+Peak peakSSE2_(const float* buf, int frames)
+{
+	const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	__m128       peak = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 2 <= frames; i += 2)
+		peak = _mm_max_ps(peak, _mm_and_ps(_mm_loadu_ps(buf + i * 2), mask));
+	return peakScalar_(buf, i, frames, reducePeakSSE2_(peak));
+}
+
+/* Planar SSE2 kernels. Four frames per step: the interleaved data is split
+into (or merged from) one register per channel with shuffles. */
+
+float reduceMaxSSE2_(__m128 v)
+{
+	alignas(16) float p[4];
+	_mm_store_ps(p, v);
+	return std::max(std::max(p[0], p[1]), std::max(p[2], p[3]));
+}
+
+Peak sumToPlanarSSE2_(float* destL, float* destR, const float* src, int frames, float gainL, float gainR)
+{
+	const __m128 mask  = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 gl    = _mm_set1_ps(gainL);
+	const __m128 gr    = _mm_set1_ps(gainR);
+	__m128       peakL = _mm_setzero_ps();
+	__m128       peakR = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 4 <= frames; i += 4)
+	{
+		const __m128 a = _mm_loadu_ps(src + i * 2);     // L0 R0 L1 R1
+		const __m128 b = _mm_loadu_ps(src + i * 2 + 4); // L2 R2 L3 R3
+		const __m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+		const __m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+		peakL          = _mm_max_ps(peakL, _mm_and_ps(l, mask));
+		peakR          = _mm_max_ps(peakR, _mm_and_ps(r, mask));
+		_mm_storeu_ps(destL + i, _mm_add_ps(_mm_loadu_ps(destL + i), _mm_mul_ps(l, gl)));
+		_mm_storeu_ps(destR + i, _mm_add_ps(_mm_loadu_ps(destR + i), _mm_mul_ps(r, gr)));
+	}
+	return sumToPlanarScalar_(destL, destR, src, i, frames, gainL, gainR, {reduceMaxSSE2_(peakL), reduceMaxSSE2_(peakR)});
+}
+
+Peak sumFromPlanarSSE2_(float* dest, const float* srcL, const float* srcR, int frames, float gainL, float gainR)
+{
+	const __m128 mask  = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 gl    = _mm_set1_ps(gainL);
+	const __m128 gr    = _mm_set1_ps(gainR);
+	__m128       peakL = _mm_setzero_ps();
+	__m128       peakR = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 4 <= frames; i += 4)
+	{
+		const __m128 l = _mm_loadu_ps(srcL + i);
+		const __m128 r = _mm_loadu_ps(srcR + i);
+		peakL          = _mm_max_ps(peakL, _mm_and_ps(l, mask));
+		peakR          = _mm_max_ps(peakR, _mm_and_ps(r, mask));
+
+		const __m128 gainedL = _mm_mul_ps(l, gl);
+		const __m128 gainedR = _mm_mul_ps(r, gr);
+		_mm_storeu_ps(dest + i * 2, _mm_add_ps(_mm_loadu_ps(dest + i * 2), _mm_unpacklo_ps(gainedL, gainedR)));
+		_mm_storeu_ps(dest + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(dest + i * 2 + 4), _mm_unpackhi_ps(gainedL, gainedR)));
+	}
+	return sumFromPlanarScalar_(dest, srcL, srcR, i, frames, gainL, gainR, {reduceMaxSSE2_(peakL), reduceMaxSSE2_(peakR)});
+}
+
+float sumPeakSSE2_(float* dest, const float* src, int samples, float gain)
+{
+	const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 g    = _mm_set1_ps(gain);
+	__m128       peak = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+	{
+		const __m128 s = _mm_loadu_ps(src + i);
+		peak           = _mm_max_ps(peak, _mm_and_ps(s, mask));
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(s, g)));
+	}
+	return sumPeakScalar_(dest, src, i, samples, gain, reduceMaxSSE2_(peak));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* AVX2 kernels. Same layout as the SSE2 ones, four stereo frames per
+register. */
+
+G_DSP_TARGET_AVX2 Peak reducePeakAVX2_(__m256 v)
+{
+	return reducePeakSSE2_(_mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+G_DSP_TARGET_AVX2 Peak sumPannedAVX2_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	const __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+	__m256       peak = _mm256_setzero_ps();
+
+	int i = 0;
+	for (; i + 4 <= frames; i += 4)
+	{
+		const __m256 s = _mm256_loadu_ps(src + i * 2);
+		const __m256 d = _mm256_loadu_ps(dest + i * 2);
+		peak           = _mm256_max_ps(peak, _mm256_and_ps(s, mask));
+		_mm256_storeu_ps(dest + i * 2, _mm256_add_ps(d, _mm256_mul_ps(s, gain)));
+	}
+	return sumPannedScalar_(dest, src, i, frames, gainL, gainR, reducePeakAVX2_(peak));
+}
+
+G_DSP_TARGET_AVX2 void sumAVX2_(float* dest, const float* src, int samples, float gain)
+{
+	const __m256 g = _mm256_set1_ps(gain);
+
+	int i = 0;
+	for (; i + 8 <= samples; i += 8)
+		_mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+	sumScalar_(dest, src, i, samples, gain);
+}
+
+G_DSP_TARGET_AVX2 void scaleAVX2_(float* buf, int samples, float gain)
+{
+	const __m256 g = _mm256_set1_ps(gain);
+
+	int i = 0;
+	for (; i + 8 <= samples; i += 8)
+		_mm256_storeu_ps(buf + i, _mm256_mul_ps(_mm256_loadu_ps(buf + i), g));
+	scaleScalar_(buf, i, samples, gain);
+}
+
+G_DSP_TARGET_AVX2 void clampAVX2_(float* buf, int samples, float min, float max)
+{
+	const __m256 lo = _mm256_set1_ps(min);
+	const __m256 hi = _mm256_set1_ps(max);
+
+	int i = 0;
+	for (; i + 8 <= samples; i += 8)
+		_mm256_storeu_ps(buf + i, _mm256_max_ps(lo, _mm256_min_ps(_mm256_loadu_ps(buf + i), hi)));
+	clampScalar_(buf, i, samples, min, max);
+}
+
+G_DSP_TARGET_AVX2 void sumClampAVX2_(float* dest, const float* src, int samples, float gain, float min, float max)
+{
+	const __m256 g  = _mm256_set1_ps(gain);
+	const __m256 lo = _mm256_set1_ps(min);
+	const __m256 hi = _mm256_set1_ps(max);
+
+	int i = 0;
+	for (; i + 8 <= samples; i += 8)
+	{
+		const __m256 v = _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+		_mm256_storeu_ps(dest + i, _mm256_max_ps(lo, _mm256_min_ps(v, hi)));
+	}
+	sumClampScalar_(dest, src, i, samples, gain, min, max);
+}
+
+G_DSP_TARGET_AVX2 void scaleClampAVX2_(float* buf, int samples, float gain, float min, float max)
+{
+	const __m256 g  = _mm256_set1_ps(gain);
+	const __m256 lo = _mm256_set1_ps(min);
+	const __m256 hi = _mm256_set1_ps(max);
+
+	int i = 0;
+	for (; i + 8 <= samples; i += 8)
+		_mm256_storeu_ps(buf + i, _mm256_max_ps(lo, _mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(buf + i), g), hi)));
+	scaleClampScalar_(buf, i, samples, gain, min, max);
+}
+
+G_DSP_TARGET_AVX2 Peak peakAVX2_(const float* buf, int frames)
+{
+	const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	__m256       peak = _mm256_setzero_ps();
+
+	int i = 0;
+	for (; i + 4 <= frames; i += 4)
+		peak = _mm256_max_ps(peak, _mm256_and_ps(_mm256_loadu_ps(buf + i * 2), mask));
+	return peakScalar_(buf, i, frames, reducePeakAVX2_(peak));
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool hasAVX2_()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx     = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) // OS must save YMM registers
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+#elif defined(G_DSP_NEON)
+
+/* NEON kernels. A register holds two stereo frames: even lanes are left, odd
+lanes are right. */
+
+Peak reducePeakNEON_(float32x4_t v)
+{
+	float p[4];
+	vst1q_f32(p, v);
+	return {std::max(p[0], p[2]), std::max(p[1], p[3])};
+}
+
+Peak sumPannedNEON_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	const float       g[4] = {gainL, gainR, gainL, gainR};
+	const float32x4_t gain = vld1q_f32(g);
+	float32x4_t       peak = vdupq_n_f32(0.0f);
+
+	int i = 0;
+	for (; i + 2 <= frames; i += 2)
+	{
+		const float32x4_t s = vld1q_f32(src + i * 2);
+		const float32x4_t d = vld1q_f32(dest + i * 2);
+		peak                = vmaxq_f32(peak, vabsq_f32(s));
+		vst1q_f32(dest + i * 2, vaddq_f32(d, vmulq_f32(s, gain)));
+	}
+	return sumPannedScalar_(dest, src, i, frames, gainL, gainR, reducePeakNEON_(peak));
+}
+
+void sumNEON_(float* dest, const float* src, int samples, float gain)
+{
+	const float32x4_t g = vdupq_n_f32(gain);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		vst1q_f32(dest + i, vaddq_f32(vld1q_f32(dest + i), vmulq_f32(vld1q_f32(src + i), g)));
+	sumScalar_(dest, src, i, samples, gain);
+}
+
+void scaleNEON_(float* buf, int samples, float gain)
+{
+	const float32x4_t g = vdupq_n_f32(gain);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		vst1q_f32(buf + i, vmulq_f32(vld1q_f32(buf + i), g));
+	scaleScalar_(buf, i, samples, gain);
+}
+
+void clampNEON_(float* buf, int samples, float min, float max)
+{
+	const float32x4_t lo = vdupq_n_f32(min);
+	const float32x4_t hi = vdupq_n_f32(max);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		vst1q_f32(buf + i, vmaxq_f32(lo, vminq_f32(vld1q_f32(buf + i), hi)));
+	clampScalar_(buf, i, samples, min, max);
+}
+
+void sumClampNEON_(float* dest, const float* src, int samples, float gain, float min, float max)
+{
+	const float32x4_t g  = vdupq_n_f32(gain);
+	const float32x4_t lo = vdupq_n_f32(min);
+	const float32x4_t hi = vdupq_n_f32(max);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+	{
+		const float32x4_t v = vaddq_f32(vld1q_f32(dest + i), vmulq_f32(vld1q_f32(src + i), g));
+		vst1q_f32(dest + i, vmaxq_f32(lo, vminq_f32(v, hi)));
+	}
+	sumClampScalar_(dest, src, i, samples, gain, min, max);
+}
+
+void scaleClampNEON_(float* buf, int samples, float gain, float min, float max)
+{
+	const float32x4_t g  = vdupq_n_f32(gain);
+	const float32x4_t lo = vdupq_n_f32(min);
+	const float32x4_t hi = vdupq_n_f32(max);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+		vst1q_f32(buf + i, vmaxq_f32(lo, vminq_f32(vmulq_f32(vld1q_f32(buf + i), g), hi)));
+	scaleClampScalar_(buf, i, samples, gain, min, max);
+}
+
+Peak peakNEON_(const float* buf, int frames)
+{
+	float32x4_t peak = vdupq_n_f32(0.0f);
+
+	int i = 0;
+	for (; i + 2 <= frames; i += 2)
+		peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(buf + i * 2)));
+	return peakScalar_(buf, i, frames, reducePeakNEON_(peak));
+}
+
+/* Planar NEON kernels. vld2q/vst2q split and merge four interleaved stereo
+frames natively. */
+
+float reduceMaxNEON_(float32x4_t v)
+{
+	float p[4];
+	vst1q_f32(p, v);
+	return std::max(std::max(p[0], p[1]), std::max(p[2], p[3]));
+}
+
+Peak sumToPlanarNEON_(float* destL, float* destR, const float* src, int frames, float gainL, float gainR)
+{
+	const float32x4_t gl    = vdupq_n_f32(gainL);
+	const float32x4_t gr    = vdupq_n_f32(gainR);
+	float32x4_t       peakL = vdupq_n_f32(0.0f);
+	float32x4_t       peakR = vdupq_n_f32(0.0f);
+
+	int i = 0;
+	for (; i + 4 <= frames; i += 4)
+	{
+		const float32x4x2_t s = vld2q_f32(src + i * 2);
+		peakL                 = vmaxq_f32(peakL, vabsq_f32(s.val[0]));
+		peakR                 = vmaxq_f32(peakR, vabsq_f32(s.val[1]));
+		vst1q_f32(destL + i, vaddq_f32(vld1q_f32(destL + i), vmulq_f32(s.val[0], gl)));
+		vst1q_f32(destR + i, vaddq_f32(vld1q_f32(destR + i), vmulq_f32(s.val[1], gr)));
+	}
+	return sumToPlanarScalar_(destL, destR, src, i, frames, gainL, gainR, {reduceMaxNEON_(peakL), reduceMaxNEON_(peakR)});
+}
+
+Peak sumFromPlanarNEON_(float* dest, const float* srcL, const float* srcR, int frames, float gainL, float gainR)
+{
+	const float32x4_t gl    = vdupq_n_f32(gainL);
+	const float32x4_t gr    = vdupq_n_f32(gainR);
+	float32x4_t       peakL = vdupq_n_f32(0.0f);
+	float32x4_t       peakR = vdupq_n_f32(0.0f);
+
+	int i = 0;
+	for (; i + 4 <= frames; i += 4)
+	{
+		const float32x4_t l = vld1q_f32(srcL + i);
+		const float32x4_t r = vld1q_f32(srcR + i);
+		peakL               = vmaxq_f32(peakL, vabsq_f32(l));
+		peakR               = vmaxq_f32(peakR, vabsq_f32(r));
+
+		float32x4x2_t d = vld2q_f32(dest + i * 2);
+		d.val[0]        = vaddq_f32(d.val[0], vmulq_f32(l, gl));
+		d.val[1]        = vaddq_f32(d.val[1], vmulq_f32(r, gr));
+		vst2q_f32(dest + i * 2, d);
+	}
+	return sumFromPlanarScalar_(dest, srcL, srcR, i, frames, gainL, gainR, {reduceMaxNEON_(peakL), reduceMaxNEON_(peakR)});
+}
+
+float sumPeakNEON_(float* dest, const float* src, int samples, float gain)
+{
+	const float32x4_t g    = vdupq_n_f32(gain);
+	float32x4_t       peak = vdupq_n_f32(0.0f);
+
+	int i = 0;
+	for (; i + 4 <= samples; i += 4)
+	{
+		const float32x4_t s = vld1q_f32(src + i);
+		peak                = vmaxq_f32(peak, vabsq_f32(s));
+		vst1q_f32(dest + i, vaddq_f32(vld1q_f32(dest + i), vmulq_f32(s, g)));
+	}
+	return sumPeakScalar_(dest, src, i, samples, gain, reduceMaxNEON_(peak));
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+Kernels selectKernels_()
+{
+#if defined(G_DSP_SSE2)
+	/* The planar kernels are shared between SSE2 and AVX2: shuffles across
+	the two 128-bit lanes of an AVX2 register would eat up the gain. */
+
+	if (hasAVX2_())
+		return {"AVX2", sumPannedAVX2_, sumAVX2_, scaleAVX2_, clampAVX2_, sumClampAVX2_, scaleClampAVX2_, peakAVX2_,
+		    sumToPlanarSSE2_, sumFromPlanarSSE2_, sumPeakSSE2_};
+	return {"SSE2", sumPannedSSE2_, sumSSE2_, scaleSSE2_, clampSSE2_, sumClampSSE2_, scaleClampSSE2_, peakSSE2_,
+	    sumToPlanarSSE2_, sumFromPlanarSSE2_, sumPeakSSE2_};
+#elif defined(G_DSP_NEON)
+	return {"NEON", sumPannedNEON_, sumNEON_, scaleNEON_, clampNEON_, sumClampNEON_, scaleClampNEON_, peakNEON_,
+	    sumToPlanarNEON_, sumFromPlanarNEON_, sumPeakNEON_};
+#else
+	return {"scalar", sumPannedScalar_, sumScalar_, scaleScalar_, clampScalar_, sumClampScalar_, scaleClampScalar_, peakScalar_,
+	    sumToPlanarScalar_, sumFromPlanarScalar_, sumPeakScalar_};
+#endif
+}
+
+const Kernels kernels_ = selectKernels_();
+
+/* -------------------------------------------------------------------------- */
+
+/* sumRamped_
+Plain loop for non-flat gain ramps. 'read(i, j)' returns sample 'i' of source
+channel 'j', 'write(i, j, v)' sums 'v' into the corresponding destination
+sample. Destination channels beyond 'destChannels' are skipped. */
+
+template <typename Read, typename Write>
+Peak sumRamped_(int frames, int srcChannels, int destChannels, const GainRamp& ramp, Read read, Write write)
+{
+	assert(srcChannels <= static_cast<int>(ramp.from.size()));
+
+	std::array<float, G_MAX_IO_CHANS> peak = {0.0f, 0.0f};
+
+	for (int j = 0; j < srcChannels; j++)
+	{
+		const float step = (ramp.to[j] - ramp.from[j]) / frames;
+		for (int i = 0; i < frames; i++)
+		{
+			const float in = read(i, j);
+			peak[j]        = std::max(peak[j], std::abs(in));
+			if (j < destChannels)
+				write(i, j, in * (ramp.from[j] + step * i));
+		}
+	}
+
+	return {peak[0], srcChannels == 1 ? peak[0] : peak[1]};
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* applyRamped_
+Plain loop for gain ramps applied in place on the frames [a, b). 'sample(i, j)'
+returns a reference to sample 'i' of channel 'j'. */
+
+template <typename Sample>
+void applyRamped_(int a, int b, int channels, const GainRamp& ramp, Sample sample)
+{
+	assert(channels <= static_cast<int>(ramp.from.size()));
+
+	if (b <= a)
+		return;
+
+	for (int j = 0; j < channels; j++)
+	{
+		const float step = (ramp.to[j] - ramp.from[j]) / (b - a);
+		for (int i = a; i < b; i++)
+			sample(i, j) *= ramp.from[j] + step * (i - a);
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, Pan::Type pan,
+    float gain, int destChannelOffset)
+{
+	assert(src.countChannels() <= static_cast<int>(pan.size()));
+	assert(destChannelOffset >= 0);
+
+	const int frames = std::min(dest.countFrames(), src.countFrames());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	if (src.countChannels() == 2 && dest.countChannels() == 2 && destChannelOffset == 0)
+		return kernels_.sumPanned(dest[0], src[0], frames, gain * pan[0], gain * pan[1]);
+
+	std::array<float, G_MAX_IO_CHANS> peak = {0.0f, 0.0f};
+
+	for (int i = 0; i < frames; i++)
+	{
+		for (int j = 0; j < src.countChannels(); j++)
+		{
+			peak[j] = std::max(peak[j], std::abs(src[i][j]));
+			if (j + destChannelOffset < dest.countChannels())
+				dest[i][j + destChannelOffset] += src[i][j] * (gain * pan[j]);
+		}
+	}
+
+	return {peak[0], src.countChannels() == 1 ? peak[0] : peak[1]};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sumAll(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, float gain)
+{
+	const int frames = std::min(dest.countFrames(), src.countFrames());
+
+	if (frames == 0)
+		return;
+
+	if (dest.countChannels() == src.countChannels())
+	{
+		kernels_.sum(dest[0], src[0], frames * dest.countChannels(), gain);
+		return;
+	}
+
+	const int channels = std::min(dest.countChannels(), src.countChannels());
+
+	for (int i = 0; i < frames; i++)
+		for (int j = 0; j < channels; j++)
+			dest[i][j] += src[i][j] * gain;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(juce::AudioBuffer<float>& dest, const mcl::AudioBuffer& src, Pan::Type pan,
+    float gain)
+{
+	assert(src.countChannels() <= static_cast<int>(pan.size()));
+
+	const int frames = std::min(dest.getNumSamples(), src.countFrames());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	if (src.countChannels() == 2 && dest.getNumChannels() == 2)
+		return kernels_.sumToPlanar(dest.getWritePointer(0), dest.getWritePointer(1), src[0], frames,
+		    gain * pan[0], gain * pan[1]);
+
+	std::array<float, G_MAX_IO_CHANS> peak = {0.0f, 0.0f};
+
+	for (int j = 0; j < src.countChannels(); j++)
+	{
+		float* out = j < dest.getNumChannels() ? dest.getWritePointer(j) : nullptr;
+		for (int i = 0; i < frames; i++)
+		{
+			peak[j] = std::max(peak[j], std::abs(src[i][j]));
+			if (out != nullptr)
+				out[i] += src[i][j] * (gain * pan[j]);
+		}
+	}
+
+	return {peak[0], src.countChannels() == 1 ? peak[0] : peak[1]};
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(mcl::AudioBuffer& dest, const juce::AudioBuffer<float>& src, Pan::Type pan,
+    float gain, int destChannelOffset)
+{
+	assert(src.getNumChannels() <= static_cast<int>(pan.size()));
+	assert(destChannelOffset >= 0);
+
+	const int frames = std::min(dest.countFrames(), src.getNumSamples());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	if (src.getNumChannels() == 2 && dest.countChannels() == 2 && destChannelOffset == 0)
+		return kernels_.sumFromPlanar(dest[0], src.getReadPointer(0), src.getReadPointer(1), frames,
+		    gain * pan[0], gain * pan[1]);
+
+	std::array<float, G_MAX_IO_CHANS> peak = {0.0f, 0.0f};
+
+	for (int j = 0; j < src.getNumChannels(); j++)
+	{
+		const float* in = src.getReadPointer(j);
+		for (int i = 0; i < frames; i++)
+		{
+			peak[j] = std::max(peak[j], std::abs(in[i]));
+			if (j + destChannelOffset < dest.countChannels())
+				dest[i][j + destChannelOffset] += in[i] * (gain * pan[j]);
+		}
+	}
+
+	return {peak[0], src.getNumChannels() == 1 ? peak[0] : peak[1]};
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(juce::AudioBuffer<float>& dest, const juce::AudioBuffer<float>& src,
+    Pan::Type pan, float gain)
+{
+	assert(src.getNumChannels() <= static_cast<int>(pan.size()));
+
+	const int frames = std::min(dest.getNumSamples(), src.getNumSamples());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	std::array<float, G_MAX_IO_CHANS> peak = {0.0f, 0.0f};
+
+	for (int j = 0; j < src.getNumChannels(); j++)
+	{
+		if (j < dest.getNumChannels())
+			peak[j] = kernels_.sumPeak(dest.getWritePointer(j), src.getReadPointer(j), frames, gain * pan[j]);
+		else
+			peak[j] = src.getMagnitude(j, 0, frames);
+	}
+
+	return {peak[0], src.getNumChannels() == 1 ? peak[0] : peak[1]};
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool GainRamp::isFlat() const
+{
+	return from == to;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, const GainRamp& ramp,
+    int destChannelOffset)
+{
+	assert(destChannelOffset >= 0);
+
+	if (ramp.isFlat())
+		return sumAll(dest, src, ramp.from, 1.0f, destChannelOffset);
+
+	const int frames = std::min(dest.countFrames(), src.countFrames());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	return sumRamped_(frames, src.countChannels(), dest.countChannels() - destChannelOffset, ramp,
+	    [&](int i, int j)
+	{ return src[i][j]; },
+	    [&](int i, int j, float v)
+	{ dest[i][j + destChannelOffset] += v; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(juce::AudioBuffer<float>& dest, const mcl::AudioBuffer& src, const GainRamp& ramp)
+{
+	if (ramp.isFlat())
+		return sumAll(dest, src, ramp.from, 1.0f);
+
+	const int frames = std::min(dest.getNumSamples(), src.countFrames());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	return sumRamped_(frames, src.countChannels(), dest.getNumChannels(), ramp,
+	    [&](int i, int j)
+	{ return src[i][j]; },
+	    [&](int i, int j, float v)
+	{ dest.getWritePointer(j)[i] += v; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(mcl::AudioBuffer& dest, const juce::AudioBuffer<float>& src, const GainRamp& ramp,
+    int destChannelOffset)
+{
+	assert(destChannelOffset >= 0);
+
+	if (ramp.isFlat())
+		return sumAll(dest, src, ramp.from, 1.0f, destChannelOffset);
+
+	const int frames = std::min(dest.countFrames(), src.getNumSamples());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	return sumRamped_(frames, src.getNumChannels(), dest.countChannels() - destChannelOffset, ramp,
+	    [&](int i, int j)
+	{ return src.getReadPointer(j)[i]; },
+	    [&](int i, int j, float v)
+	{ dest[i][j + destChannelOffset] += v; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak sumAll(juce::AudioBuffer<float>& dest, const juce::AudioBuffer<float>& src, const GainRamp& ramp)
+{
+	if (ramp.isFlat())
+		return sumAll(dest, src, ramp.from, 1.0f);
+
+	const int frames = std::min(dest.getNumSamples(), src.getNumSamples());
+
+	if (frames == 0)
+		return {0.0f, 0.0f};
+
+	return sumRamped_(frames, src.getNumChannels(), dest.getNumChannels(), ramp,
+	    [&](int i, int j)
+	{ return src.getReadPointer(j)[i]; },
+	    [&](int i, int j, float v)
+	{ dest.getWritePointer(j)[i] += v; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void applyGain(mcl::AudioBuffer& b, float gain)
+{
+	if (b.countFrames() > 0)
+		kernels_.scale(b[0], b.countFrames() * b.countChannels(), gain);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void applyGain(mcl::AudioBuffer& buffer, const GainRamp& ramp, int a, int b)
+{
+	assert(a >= 0);
+
+	applyRamped_(a, std::min(b, buffer.countFrames()), buffer.countChannels(), ramp, [&](int i, int j) -> float&
+	{ return buffer[i][j]; });
+}
+
+void applyGain(juce::AudioBuffer<float>& buffer, const GainRamp& ramp, int a, int b)
+{
+	assert(a >= 0);
+
+	applyRamped_(a, std::min(b, buffer.getNumSamples()), buffer.getNumChannels(), ramp, [&](int i, int j) -> float&
+	{ return buffer.getWritePointer(j)[i]; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clamp(mcl::AudioBuffer& b, float min, float max)
+{
+	if (b.countFrames() > 0)
+		kernels_.clamp(b[0], b.countFrames() * b.countChannels(), min, max);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void finalize(mcl::AudioBuffer& out, const mcl::AudioBuffer* in, float gain, bool clamp)
+{
+	const int samples = out.countFrames() * out.countChannels();
+
+	if (samples == 0)
+		return;
+
+	if (in == nullptr)
+	{
+		if (clamp)
+			kernels_.scaleClamp(out[0], samples, gain, -1.0f, 1.0f);
+		else
+			kernels_.scale(out[0], samples, gain);
+		return;
+	}
+
+	if (in->countChannels() == out.countChannels() && in->countFrames() == out.countFrames())
+	{
+		if (clamp)
+			kernels_.sumClamp(out[0], (*in)[0], samples, gain, -1.0f, 1.0f);
+		else
+			kernels_.sum(out[0], (*in)[0], samples, gain);
+		return;
+	}
+
+	sumAll(out, *in, gain);
+	if (clamp)
+		kernels_.clamp(out[0], samples, -1.0f, 1.0f);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak getPeak(const mcl::AudioBuffer& b)
+{
+	if (b.countFrames() == 0 || b.countChannels() == 0)
+		return {0.0f, 0.0f};
+
+	if (b.countChannels() == 2)
+		return kernels_.peak(b[0], b.countFrames());
+
+	const int channels = std::min(b.countChannels(), G_MAX_IO_CHANS);
+
+	std::array<float, G_MAX_IO_CHANS> peak = {0.0f, 0.0f};
+
+	for (int i = 0; i < b.countFrames(); i++)
+		for (int j = 0; j < channels; j++)
+			peak[j] = std::max(peak[j], std::abs(b[i][j]));
+
+	return {peak[0], channels == 1 ? peak[0] : peak[1]};
+}
+
+/* -------------------------------------------------------------------------- */
+
+const char* getInstructionSet()
+{
+	return kernels_.name;
+}
+} // namespace giada::m::dsp
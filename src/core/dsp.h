@@ -0,0 +1,141 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_DSP_H
+#define G_DSP_H
+
+#include "src/core/pan.h"
+#include "src/types.h"
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace juce
+{
+template <typename Type>
+class AudioBuffer;
+}
+
+namespace giada::m::dsp
+{
+/* Vectorized kernels for the operations the mixer performs on every block.
+Stereo buffers take an SSE2/AVX2 (x86) or NEON (ARM) path, selected at runtime
+according to what the CPU supports; any other layout falls back to plain
+loops. */
+
+/* GainRamp
+Per-channel gains moving linearly from 'from' to 'to' across the frames of a
+block, in place of a constant pan and gain. Flat ramps take the same vectorized
+path as a constant gain; the others fall back to plain loops. */
+
+struct GainRamp
+{
+	bool isFlat() const;
+
+	Pan::Type from;
+	Pan::Type to;
+};
+
+/* sumAll (1)
+Sums 'src' into 'dest' with a per-channel pan and a global gain, starting at
+channel 'destChannelOffset' of 'dest'. Source channels that don't fit into
+'dest' are skipped. Returns the peak of 'src', measured in the same pass. */
+
+Peak sumAll(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, Pan::Type pan,
+    float gain, int destChannelOffset = 0);
+
+/* sumAll (2)
+Sums 'src' into 'dest' with a global gain. Buffers must share the same number
+of channels. */
+
+void sumAll(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, float gain);
+
+/* sumAll (3)
+Same as (1), for a planar (non-interleaved) 'dest': 'src' is deinterleaved
+while being summed. */
+
+Peak sumAll(juce::AudioBuffer<float>& dest, const mcl::AudioBuffer& src, Pan::Type pan,
+    float gain);
+
+/* sumAll (4)
+Same as (1), for a planar 'src': it is interleaved while being summed. */
+
+Peak sumAll(mcl::AudioBuffer& dest, const juce::AudioBuffer<float>& src, Pan::Type pan,
+    float gain, int destChannelOffset = 0);
+
+/* sumAll (5)
+Same as (1), with both buffers planar. */
+
+Peak sumAll(juce::AudioBuffer<float>& dest, const juce::AudioBuffer<float>& src,
+    Pan::Type pan, float gain);
+
+/* sumAll (6, 7, 8, 9)
+Same as (1), (3), (4) and (5) respectively, with a GainRamp. */
+
+Peak sumAll(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, const GainRamp&,
+    int destChannelOffset = 0);
+Peak sumAll(juce::AudioBuffer<float>& dest, const mcl::AudioBuffer& src, const GainRamp&);
+Peak sumAll(mcl::AudioBuffer& dest, const juce::AudioBuffer<float>& src, const GainRamp&,
+    int destChannelOffset = 0);
+Peak sumAll(juce::AudioBuffer<float>& dest, const juce::AudioBuffer<float>& src, const GainRamp&);
+
+void applyGain(mcl::AudioBuffer&, float gain);
+
+/* applyGain (2, 3)
+Applies a GainRamp to the frames [a, b) of the buffer, in place. The ramp
+moves across those frames only. */
+
+void applyGain(mcl::AudioBuffer&, const GainRamp&, int a, int b);
+void applyGain(juce::AudioBuffer<float>&, const GainRamp&, int a, int b);
+
+/* clamp
+Hard-limits all samples in the buffer to the [min, max] range. */
+
+void clamp(mcl::AudioBuffer&, float min, float max);
+
+/* finalize
+Fused pass over the master output: sums 'in' into 'out' with 'gain' if 'in' is
+given, otherwise applies 'gain' to 'out'; then clamps the result to
+[-1.0, 1.0] if 'clamp' is set. */
+
+void finalize(mcl::AudioBuffer& out, const mcl::AudioBuffer* in, float gain, bool clamp);
+
+/* getPeak
+Returns the absolute peak of left and right channels in a single pass. Mono
+buffers report the same value on both sides. */
+
+Peak getPeak(const mcl::AudioBuffer&);
+
+/* getInstructionSet
+Returns the name of the instruction set selected at startup. */
+
+const char* getInstructionSet();
+} // namespace giada::m::dsp
+
+#endif
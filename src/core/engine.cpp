@@ -27,13 +27,17 @@
 #include "src/core/engine.h"
 #include "src/core/conf.h"
 #include "src/core/confFactory.h"
+#include "src/core/dsp.h"
 #include "src/core/model/model.h"
 #include "src/core/rendering/midiOutput.h"
+#include "src/core/waveCache.h"
+#include "src/core/waveStream.h"
 #include "src/utils/fs.h"
 #include "src/utils/log.h"
 #include "src/utils/string.h"
 #include <fmt/core.h>
 #include <memory>
+#include <utility>
 
 namespace giada::m
 {
@@ -41,10 +45,10 @@ Engine::Engine()
 : onMidiReceived(nullptr)
 , onMidiSent(nullptr)
 , onModelSwap(nullptr)
-, m_kernelAudio(m_model)
+, m_kernelAudio(m_model, m_callbackMonitor)
 , m_kernelMidi(m_model)
 , m_midiMapper(m_kernelMidi)
-, m_pluginHost(m_model)
+, m_pluginHost(m_model, m_profiler)
 , m_midiSynchronizer(m_kernelMidi)
 , m_sequencer(m_model, m_midiSynchronizer, m_jackTransport)
 , m_mixer(m_model)
@@ -53,24 +57,32 @@ Engine::Engine()
 , m_recorder(m_sequencer, m_channelManager, m_mixer, m_actionRecorder)
 , m_midiDispatcher(m_model)
 #ifdef WITH_AUDIO_JACK
-, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_jackSynchronizer, m_jackTransport, m_kernelMidi)
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_jackSynchronizer, m_jackTransport, m_kernelMidi, m_profiler)
 #else
-, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_kernelMidi)
+, m_renderer(m_sequencer, m_mixer, m_pluginHost, m_kernelMidi, m_profiler)
 #endif
 , m_reactor(m_model, m_midiMapper, m_actionRecorder, m_kernelMidi)
-, m_mainApi(m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder, m_reactor)
+, m_waveStreamer(G_WAVE_STREAM_RATE_MS)
+, m_waveLoader(m_model)
+, m_pitchCache(m_model)
+, m_pitchCacheWorker(G_PITCH_CACHE_RATE_MS)
+, m_profilerWorker(G_PROFILER_RATE_MS)
+, m_callbackMonitorWorker(G_CALLBACK_MONITOR_RATE_MS)
+, m_bouncer(m_model, m_kernelAudio, m_kernelMidi, m_mixer, m_sequencer, m_midiSynchronizer, m_renderer, m_reactor, m_waveLoader)
+, m_mainApi(m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder, m_reactor, m_waveLoader, m_profiler, m_callbackMonitor)
 , m_channelsApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_channelManager, m_recorder, m_actionRecorder, m_pluginHost, m_pluginManager, m_reactor)
 , m_pluginsApi(m_kernelAudio, m_pluginManager, m_pluginHost, m_model)
 , m_sampleEditorApi(m_kernelAudio, m_model, m_channelManager, m_reactor, m_sequencer)
 , m_actionEditorApi(*this, m_sequencer, m_actionRecorder)
 , m_ioApi(m_model, m_midiDispatcher)
-, m_storageApi(*this, m_model, m_pluginManager, m_midiSynchronizer, m_mixer, m_channelManager, m_kernelAudio, m_sequencer, m_actionRecorder)
+, m_storageApi(*this, m_model, m_pluginManager, m_midiSynchronizer, m_mixer, m_channelManager, m_kernelAudio, m_sequencer, m_actionRecorder, m_waveLoader, m_bouncer)
 , m_configApi(m_model, m_kernelAudio, m_kernelMidi, m_midiMapper, m_midiSynchronizer)
 {
 	m_kernelAudio.onAudioCallback = [this](mcl::AudioBuffer& out, const mcl::AudioBuffer& in)
 	{
 		registerThread(Thread::AUDIO, /*realtime=*/true);
 		m_renderer.render(out, in, m_model);
+		m_kernelAudio.setProcessingLatency(m_renderer.getLatency());
 		return 0;
 	};
 	m_kernelAudio.onStreamAboutToOpen = [this]()
@@ -85,7 +97,7 @@ Engine::Engine()
 #endif
 		const int sampleRate = m_kernelAudio.getSampleRate();
 		const int bufferSize = m_kernelAudio.getBufferSize();
-		m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
+		m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize, sampleRate, m_kernelAudio.getChannelsOutCount());
 		m_channelManager.setBufferSize(bufferSize);
 		m_sequencer.setSampleRate(sampleRate);
 		m_pluginHost.setBufferSize(bufferSize);
@@ -193,12 +205,24 @@ Engine::Engine()
 		m_eventDispatcher.pumpEvent([this, channelId, status]()
 		{
 			registerThread(Thread::EVENTS, /*realtime=*/false);
-			const Channel& ch = m_model.get().tracks.getChannel(channelId);
+			const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 			if (ch.midiLightning.enabled)
 				rendering::sendMidiLightningStatus(ch.id, ch.midiLightning, status, /*isAudible=*/true /* TODO!!! */, m_midiMapper);
 		});
 	};
 
+	/* Fired by a loader thread. Applying new audio data alters the model, so
+	it is done by the Event Dispatcher as well. */
+
+	m_waveLoader.onWaveReady = [this]()
+	{
+		m_eventDispatcher.pumpEvent([this]()
+		{
+			registerThread(Thread::EVENTS, /*realtime=*/false);
+			m_waveLoader.apply();
+		});
+	};
+
 	m_channelManager.onChannelsAltered = [this]()
 	{
 		if (!m_recorder.canEnableFreeInputRec(m_sequencer.getCurrentScene()))
@@ -243,6 +267,7 @@ Engine::Engine()
 	m_model.onSwap = [this](model::SwapType t)
 	{
 		assert(onModelSwap != nullptr);
+		m_callbackMonitor.notifyModelSwap();
 		onModelSwap(t);
 	};
 
@@ -275,11 +300,19 @@ void Engine::init(const Conf& conf)
 	const int sampleRate = m_kernelAudio.getSampleRate();
 	const int bufferSize = m_kernelAudio.getBufferSize();
 
-	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
+	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize, sampleRate, m_kernelAudio.getChannelsOutCount());
 	m_channelManager.reset(bufferSize);
 	m_sequencer.reset(sampleRate);
 	m_pluginHost.reset(bufferSize);
 	m_pluginManager.reset();
+	m_pluginManager.setSandboxedPlugins(document.kernelAudio.sandboxedPlugins);
+	m_renderer.startWorkers(document.kernelAudio.renderThreads);
+	m_waveStreamer.start(WaveStream::refillAll);
+
+	const int waveCacheSize = document.kernelAudio.waveCacheSize;
+	waveCache::init(waveCacheSize > 0 ? u::fs::getWaveCachePath() : "", static_cast<std::size_t>(waveCacheSize) * 1024 * 1024);
+
+	u::log::print("[Engine::init] Using {} audio kernels\n", dsp::getInstructionSet());
 
 	m_mixer.enable();
 	m_kernelAudio.startStream();
@@ -293,12 +326,33 @@ void Engine::init(const Conf& conf)
 
 	m_eventDispatcher.start();
 	m_midiSynchronizer.startSendClock(G_DEFAULT_BPM);
+
+	m_pitchCacheWorker.start([this]()
+	{
+		m_eventDispatcher.pumpEvent([this]()
+		{
+			registerThread(Thread::EVENTS, /*realtime=*/false);
+			m_pitchCache.update(m_sequencer.getCurrentScene());
+		});
+	});
+
+	m_profilerWorker.start([this]()
+	{ m_profiler.collect(); });
+
+	if (document.kernelAudio.logXruns)
+		m_callbackMonitorWorker.start([this]()
+		{ m_callbackMonitor.logNewXruns(); });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Engine::reset()
 {
+	/* Stop loading samples of the previous project, if any. */
+
+	m_waveLoader.cancel();
+	m_pitchCache.clear();
+
 	/* Managers first, due to the internal ID numbering. */
 
 	channelFactory::reset();
@@ -311,11 +365,12 @@ void Engine::reset()
 	const int bufferSize = m_kernelAudio.getBufferSize();
 
 	m_model.reset();
-	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize);
+	m_mixer.reset(m_sequencer.getMaxFramesInLoop(sampleRate), bufferSize, sampleRate, m_kernelAudio.getChannelsOutCount());
 	m_channelManager.reset(bufferSize);
 	m_sequencer.reset(sampleRate);
 	m_actionRecorder.reset();
 	m_pluginHost.reset(bufferSize);
+	m_profiler.clear();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -330,6 +385,14 @@ void Engine::shutdown(Conf& conf)
 		u::log::print("[Engine::shutdown] Mixer closed\n");
 	}
 
+	m_renderer.stopWorkers();
+	m_waveStreamer.stop();
+	m_waveLoader.cancel();
+	m_pitchCacheWorker.stop();
+	m_pitchCache.clear();
+	m_profilerWorker.stop();
+	m_callbackMonitorWorker.stop();
+
 	m_model.store(conf);
 
 	/* It's safer and cleaner to free all plug-ins before closing the app. Some
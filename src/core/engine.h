@@ -36,6 +36,8 @@
 #include "src/core/api/pluginsApi.h"
 #include "src/core/api/sampleEditorApi.h"
 #include "src/core/api/storageApi.h"
+#include "src/core/bouncer.h"
+#include "src/core/callbackMonitor.h"
 #include "src/core/channels/channelFactory.h"
 #include "src/core/channels/channelManager.h"
 #include "src/core/eventDispatcher.h"
@@ -48,13 +50,17 @@
 #include "src/core/midiSynchronizer.h"
 #include "src/core/mixer.h"
 #include "src/core/model/model.h"
+#include "src/core/pitchCache.h"
 #include "src/core/plugins/pluginHost.h"
 #include "src/core/plugins/pluginManager.h"
+#include "src/core/profiler.h"
 #include "src/core/recorder.h"
 #include "src/core/rendering/reactor.h"
 #include "src/core/rendering/renderer.h"
 #include "src/core/sequencer.h"
 #include "src/core/waveFactory.h"
+#include "src/core/waveLoader.h"
+#include "src/core/worker.h"
 #ifdef WITH_AUDIO_JACK
 #include "src/core/jackSynchronizer.h"
 #endif
@@ -125,9 +131,11 @@ private:
 	void registerThread(Thread, bool isRealtime) const;
 
 	model::Model           m_model;
+	CallbackMonitor        m_callbackMonitor;
 	KernelAudio            m_kernelAudio;
 	KernelMidi             m_kernelMidi;
 	MidiMapper<KernelMidi> m_midiMapper;
+	Profiler               m_profiler;
 	PluginHost             m_pluginHost;
 	JackTransport          m_jackTransport;
 	MidiSynchronizer       m_midiSynchronizer;
@@ -145,6 +153,39 @@ private:
 	rendering::Renderer m_renderer;
 	rendering::Reactor  m_reactor;
 
+	/* m_waveStreamer
+	Background thread that reads from disk the samples being streamed. */
+
+	Worker m_waveStreamer;
+
+	/* m_waveLoader
+	Loads in background the samples of a project after it has been opened. */
+
+	WaveLoader m_waveLoader;
+
+	/* m_pitchCache, m_pitchCacheWorker
+	Pre-renders samples played at a steady pitch. The worker periodically asks
+	the Event Dispatcher to update it, as doing so alters the model. */
+
+	PitchCache m_pitchCache;
+	Worker     m_pitchCacheWorker;
+
+	/* m_profilerWorker
+	Periodically collects the timings recorded by the audio rendering. */
+
+	Worker m_profilerWorker;
+
+	/* m_callbackMonitorWorker
+	Periodically writes the last audio callbacks to the log when an xrun has
+	occurred. Running only if enabled in the configuration. */
+
+	Worker m_callbackMonitorWorker;
+
+	/* m_bouncer
+	Renders the project to file, faster than realtime. */
+
+	Bouncer m_bouncer;
+
 	MainApi         m_mainApi;
 	ChannelsApi     m_channelsApi;
 	PluginsApi      m_pluginsApi;
@@ -29,6 +29,8 @@
 #endif
 #include "src/core/confFactory.h"
 #include "src/core/engine.h"
+#include "src/core/plugins/pluginSandbox.h"
+#include "src/core/plugins/pluginScanner.h"
 #include "src/gui/elems/mainWindow/keyboard/keyboard.h"
 #include "src/gui/elems/mainWindow/mainInput.h"
 #include "src/gui/elems/mainWindow/mainOutput.h"
@@ -38,13 +40,26 @@
 #ifdef WITH_TESTS
 #define CATCH_CONFIG_RUNNER
 #include "tests/actionRecorder.cpp"
+#include "tests/actions.cpp"
+#include "tests/automation.cpp"
+#include "tests/callbackMonitor.cpp"
 #include "tests/channelFactory.cpp"
+#include "tests/channelManager.cpp"
+#include "tests/delayLine.cpp"
+#include "tests/dsp.cpp"
+#include "tests/limiter.cpp"
 #include "tests/midiEvent.cpp"
 #include "tests/midiLightning.cpp"
+#include "tests/paramLane.cpp"
 #include "tests/patch.cpp"
+#include "tests/profiler.cpp"
+#include "tests/quantizer.cpp"
+#include "tests/renderPool.cpp"
+#include "tests/resampler.cpp"
 #include "tests/sampleRendering.cpp"
 #include "tests/version.cpp"
 #include "tests/wave.cpp"
+#include "tests/waveCache.cpp"
 #include "tests/waveFactory.cpp"
 #include "tests/waveFx.cpp"
 #include "tests/waveReading.cpp"
@@ -53,6 +68,8 @@
 #include <vector>
 #endif
 #include <FL/Fl.H>
+#include <csignal>
+#include <cstring>
 
 extern giada::m::Engine* g_engine;
 extern giada::v::Ui*     g_ui;
@@ -61,6 +78,48 @@ namespace giada::m::init
 {
 namespace
 {
+/* headlessQuit_
+Set by the signal handler to break the headless run loop. */
+
+volatile std::sig_atomic_t headlessQuit_ = 0;
+
+/* -------------------------------------------------------------------------- */
+
+void onHeadlessSignal_(int)
+{
+	headlessQuit_ = 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Conf readConf_()
+{
+	Conf conf = confFactory::deserialize();
+
+	if (!conf.valid)
+		u::log::print("[init::startup] Can't read configuration file! Using default values\n");
+
+	if (!u::log::init(conf.logMode))
+		u::log::print("[init::startup] log init failed! Using default stdout\n");
+
+	return conf;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void writeConf_(const Conf& conf)
+{
+	if (!confFactory::serialize(conf))
+		u::log::print("[init::shutdown] error while saving configuration file!\n");
+	else
+		u::log::print("[init::shutdown] configuration saved\n");
+
+	u::log::print("[init] Giada {} closed\n\n", G_VERSION.toString());
+	u::log::close();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void printBuildInfo_()
 {
 	u::log::print("[init] Giada {}\n", G_VERSION.toString());
@@ -106,6 +165,85 @@ int tests(int argc, char** argv)
 
 /* -------------------------------------------------------------------------- */
 
+int sandbox(int argc, char** argv)
+{
+	if (argc > 2 && strcmp(argv[1], pluginSandbox::PROCESS_ARG) == 0)
+		return pluginSandbox::run(argv[2]);
+	if (argc > 4 && strcmp(argv[1], pluginScanner::PROCESS_ARG) == 0)
+		return pluginScanner::run(argv[2], argv[3], argv[4]);
+	return -1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int headless(int argc, char** argv)
+{
+	if (argc < 2 || strcmp(argv[1], HEADLESS_ARG) != 0)
+		return -1;
+
+	/* There is no UI to notify: engine callbacks are no-ops. MIDI input still
+	reaches channels through the MidiDispatcher. */
+
+	g_engine->onMidiReceived        = []() {};
+	g_engine->onMidiSent            = []() {};
+	g_engine->onMidiSentFromChannel = [](ID) {};
+	g_engine->onModelSwap           = [](model::SwapType) {};
+
+	Conf conf = readConf_();
+
+	juce::initialiseJuce_GUI();
+	g_engine->init(conf);
+
+	printBuildInfo_();
+
+	int ret = 0;
+
+	if (!g_engine->isAudioReady())
+	{
+		u::log::print("[init::headless] Audio device not available, quitting\n");
+		ret = 1;
+	}
+	else if (argc > 2)
+	{
+		const model::LoadState state = g_engine->getStorageApi().loadProject(argv[2], [](float) {});
+		if (state.patch.status != G_FILE_OK)
+		{
+			u::log::print("[init::headless] Can't load project {} (status={})\n", argv[2], state.patch.status);
+			ret = 1;
+		}
+	}
+
+	if (ret == 0)
+	{
+		std::signal(SIGINT, onHeadlessSignal_);
+		std::signal(SIGTERM, onHeadlessSignal_);
+
+		u::log::print("[init::headless] Running, send SIGINT or SIGTERM to quit\n");
+
+		/* Plug-ins still need the JUCE message loop, normally pumped by the UI
+		on an FLTK timer. */
+
+		juce::MessageManager* mm = juce::MessageManager::getInstanceWithoutCreating();
+		assert(mm != nullptr);
+		while (headlessQuit_ == 0)
+			mm->runDispatchLoopUntil(G_HEADLESS_DISPATCH_RATE_MS);
+	}
+
+	/* Start from the stored configuration, so that UI-only values written by a
+	previous session are preserved. */
+
+	conf = confFactory::deserialize();
+
+	g_engine->shutdown(conf);
+	juce::shutdownJuce_GUI();
+
+	writeConf_(conf);
+
+	return ret;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void startup()
 {
 	g_ui->dispatcher.onEventOccured = []()
@@ -142,13 +280,7 @@ void startup()
 		{ type == model::SwapType::HARD ? g_ui->rebuild() : g_ui->refresh(); });
 	};
 
-	Conf conf = confFactory::deserialize();
-
-	if (!conf.valid)
-		u::log::print("[init::startup] Can't read configuration file! Using default values\n");
-
-	if (!u::log::init(conf.logMode))
-		u::log::print("[init::startup] log init failed! Using default stdout\n");
+	Conf conf = readConf_();
 
 	juce::initialiseJuce_GUI();
 	g_engine->init(conf);
@@ -174,12 +306,6 @@ void shutdown()
 	g_engine->shutdown(conf);
 	juce::shutdownJuce_GUI();
 
-	if (!confFactory::serialize(conf))
-		u::log::print("[init::shutdown] error while saving configuration file!\n");
-	else
-		u::log::print("[init::shutdown] configuration saved\n");
-
-	u::log::print("[init] Giada {} closed\n\n", G_VERSION.toString());
-	u::log::close();
+	writeConf_(conf);
 }
 } // namespace giada::m::init
@@ -29,12 +29,29 @@
 
 namespace giada::m::init
 {
+constexpr auto HEADLESS_ARG = "--headless";
+
 /* tests
 Performs tests, if requested. Returns -1 if no tests are available or the
 `--run-tests` has not been passed in. */
 
 int tests(int argc, char** argv);
 
+/* sandbox
+Runs as a plug-in sandbox or scanner process, if started with the
+pluginSandbox::PROCESS_ARG or pluginScanner::PROCESS_ARG switch. Returns -1
+otherwise. */
+
+int sandbox(int argc, char** argv);
+
+/* headless
+Runs the engine without any UI if started with the HEADLESS_ARG switch,
+optionally followed by the path of a project to load. Blocks until SIGINT or
+SIGTERM is received, then shuts the engine down. Returns -1 if the switch is
+missing. */
+
+int headless(int argc, char** argv);
+
 void startup();
 void run();
 void shutdown();
@@ -35,6 +35,7 @@
 #include "src/utils/string.h"
 #include "src/utils/vector.h"
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 
 namespace giada::m
@@ -54,12 +55,14 @@ constexpr int RTAUDIO_MAX_PRIORITY = 99;
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-KernelAudio::KernelAudio(model::Model& model)
+KernelAudio::KernelAudio(model::Model& model, CallbackMonitor& callbackMonitor)
 : onAudioCallback(nullptr)
 , onStreamAboutToOpen(nullptr)
 , onStreamOpened(nullptr)
 , m_model(model)
+, m_callbackMonitor(callbackMonitor)
 , m_jackMaxOutputChannels(0)
+, m_processingLatency(0)
 {
 }
 
@@ -186,6 +189,18 @@ Resampler::Quality KernelAudio::getResamplerQuality() const { return m_model.get
 
 /* -------------------------------------------------------------------------- */
 
+Frame KernelAudio::getProcessingLatency() const
+{
+	return m_processingLatency.load();
+}
+
+void KernelAudio::setProcessingLatency(Frame latency)
+{
+	m_processingLatency.store(latency);
+}
+
+/* -------------------------------------------------------------------------- */
+
 std::vector<m::KernelAudio::Device> KernelAudio::getAvailableDevices() const
 {
 	std::vector<Device> out;
@@ -422,6 +437,8 @@ KernelAudio::OpenStreamResult KernelAudio::openStream_(
 
 	u::log::print("[KA] Device opened successfully\n");
 
+	m_callbackMonitor.reset(actualSampleRate);
+
 	return {
 	    true,
 	    {
@@ -440,8 +457,10 @@ KernelAudio::OpenStreamResult KernelAudio::openStream_(
 /* -------------------------------------------------------------------------- */
 
 int KernelAudio::audioCallback(void* outBuf, void* inBuf, unsigned bufferSize,
-    double /*streamTime*/, RtAudioStreamStatus /*status*/, void*   data)
+    double /*streamTime*/, RtAudioStreamStatus status, void*       data)
 {
+	const auto start = std::chrono::steady_clock::now();
+
 	const CallbackInfo& info = *static_cast<CallbackInfo*>(data);
 
 	mcl::AudioBuffer out(static_cast<float*>(outBuf), bufferSize, info.channelsOutCount);
@@ -449,6 +468,11 @@ int KernelAudio::audioCallback(void* outBuf, void* inBuf, unsigned bufferSize,
 	if (info.channelsInCount > 0)
 		in = mcl::AudioBuffer(static_cast<float*>(inBuf), bufferSize, info.channelsInCount);
 
-	return info.kernelAudio->onAudioCallback(out, in);
+	const int result = info.kernelAudio->onAudioCallback(out, in);
+
+	info.kernelAudio->m_callbackMonitor.record(start, std::chrono::steady_clock::now(), bufferSize,
+	    status & RTAUDIO_INPUT_OVERFLOW, status & RTAUDIO_OUTPUT_UNDERFLOW);
+
+	return result;
 }
 } // namespace giada::m
@@ -27,6 +27,7 @@
 #ifndef G_KERNELAUDIO_H
 #define G_KERNELAUDIO_H
 
+#include "src/core/callbackMonitor.h"
 #include "src/core/model/model.h"
 #include "src/core/weakAtomic.h"
 #include "src/deps/rtaudio/RtAudio.h"
@@ -67,7 +68,7 @@ public:
 		std::vector<unsigned int> sampleRates       = {};
 	};
 
-	KernelAudio(model::Model&);
+	KernelAudio(model::Model&, CallbackMonitor&);
 
 	static void logCompiledAPIs();
 
@@ -113,6 +114,13 @@ public:
 	jack_client_t* getJackHandle() const;
 #endif
 
+	/* get/setProcessingLatency
+	Latency added by the processing chain (plug-ins, limiter) on top of the
+	audio device one, in frames. Written by the audio thread on each block. */
+
+	Frame getProcessingLatency() const;
+	void  setProcessingLatency(Frame);
+
 	/* onAudioCallback
 	Main callback invoked on each audio block. */
 
@@ -171,7 +179,9 @@ private:
 	std::unique_ptr<RtAudio> m_rtAudio;
 	CallbackInfo             m_callbackInfo;
 	model::Model&            m_model;
+	CallbackMonitor&         m_callbackMonitor;
 	int                      m_jackMaxOutputChannels;
+	WeakAtomic<Frame>        m_processingLatency;
 };
 } // namespace giada::m
 
@@ -210,6 +210,7 @@ KernelMidi::KernelMidi(model::Model& m)
 , m_inputWorker(G_KERNEL_MIDI_INPUT_RATE_MS)
 , m_outputQueue(OUTPUT_QUEUE_MIN_CAPACITY, 0, MAX_NUM_PRODUCERS) // See https://github.com/cameron314/concurrentqueue#preallocation-correctly-using-try_enqueue
 , m_inputQueue(INPUT_QUEUE_MIN_CAPACITY, 0, MAX_NUM_PRODUCERS)
+, m_outputMuted(false)
 {
 }
 
@@ -391,7 +392,7 @@ std::vector<KernelMidi::DeviceInfo> KernelMidi::getAvailableInDevices() const
 
 bool KernelMidi::send(const MidiEvent& event) const
 {
-	if (!canSend())
+	if (!canSend() || m_outputMuted.load())
 		return false;
 
 	assert(event.getNumBytes() > 0 && event.getNumBytes() <= 3);
@@ -414,6 +415,18 @@ bool KernelMidi::send(const MidiEvent& event) const
 
 /* -------------------------------------------------------------------------- */
 
+void KernelMidi::muteOutput()
+{
+	m_outputMuted.store(true);
+}
+
+void KernelMidi::unmuteOutput()
+{
+	m_outputMuted.store(false);
+}
+
+/* -------------------------------------------------------------------------- */
+
 template <typename RtMidiType>
 KernelMidi::Devices<RtMidiType> KernelMidi::makeDevices()
 {
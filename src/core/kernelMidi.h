@@ -32,6 +32,7 @@
 #include "src/core/worker.h"
 #include "src/deps/concurrentqueue/concurrentqueue.h"
 #include <RtMidi.h>
+#include <atomic>
 #include <concepts>
 #include <cstdint>
 #include <functional>
@@ -114,10 +115,18 @@ public:
 
 	/* send
 	Sends a MIDI message to the outside world. Returns false if MIDI out is not
-	enabled or the internal queue is full. */
+	enabled, muted or the internal queue is full. */
 
 	bool send(const MidiEvent&) const;
 
+	/* muteOutput, unmuteOutput
+	Drops or lets through all outgoing MIDI messages. Used when rendering
+	offline, faster than realtime (see Bouncer), which would otherwise flood
+	the devices. */
+
+	void muteOutput();
+	void unmuteOutput();
+
 	/* start
 	Starts the internal workers on separate threads. Call this on startup. */
 
@@ -209,6 +218,11 @@ private:
 	(devices). */
 
 	mutable moodycamel::ConcurrentQueue<MidiEvent> m_inputQueue;
+
+	/* m_outputMuted
+	See muteOutput() and unmuteOutput(). */
+
+	std::atomic<bool> m_outputMuted;
 };
 } // namespace giada::m
 
@@ -0,0 +1,195 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/limiter.h"
+#include "src/core/dsp.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace giada::m
+{
+namespace
+{
+constexpr float LOOKAHEAD_MS = 1.5f;
+constexpr float RELEASE_MS   = 60.0f;
+constexpr float CEILING      = 1.0f;
+
+/* catmullRom_
+Returns the weights of the four points x[-1], x[0], x[1], x[2] to interpolate
+at position 't' between x[0] and x[1]. */
+
+constexpr std::array<float, 4> catmullRom_(float t)
+{
+	const float t2 = t * t;
+	const float t3 = t2 * t;
+	return {
+	    (-t3 + 2.0f * t2 - t) / 2.0f,
+	    (3.0f * t3 - 5.0f * t2 + 2.0f) / 2.0f,
+	    (-3.0f * t3 + 4.0f * t2 + t) / 2.0f,
+	    (t3 - t2) / 2.0f};
+}
+
+/* INTERPOLATION_WEIGHTS
+Points where inter-sample peaks are looked for: 4x oversampling. */
+
+constexpr std::array<std::array<float, 4>, 3> INTERPOLATION_WEIGHTS = {
+    catmullRom_(0.25f), catmullRom_(0.5f), catmullRom_(0.75f)};
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void Limiter::reset(int sampleRate, int channels)
+{
+	assert(sampleRate > 0);
+	assert(channels >= 0);
+
+	m_channels     = channels;
+	m_lookahead    = std::max(1, static_cast<int>(sampleRate * LOOKAHEAD_MS / 1000.0f));
+	m_releaseCoeff = std::exp(-1000.0f / (sampleRate * RELEASE_MS));
+
+	m_delay.assign((m_lookahead + 1) * channels, 0.0f);
+	m_history.assign(3 * channels, 0.0f);
+	m_minGains.assign(m_lookahead, 1.0f);
+	m_minFrames.assign(m_lookahead, 0);
+	m_box.assign(m_lookahead, 1.0f);
+
+	m_minHead  = 0;
+	m_minSize  = 0;
+	m_boxSum   = m_lookahead;
+	m_frame    = 0;
+	m_envelope = 1.0f;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int Limiter::getLatency() const
+{
+	return m_lookahead + 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Limiter::process(mcl::AudioBuffer& buf) const
+{
+	if (buf.countChannels() != m_channels || m_channels == 0)
+	{
+		dsp::clamp(buf, -CEILING, CEILING);
+		return;
+	}
+
+	/* The level detector looks at the segment between the two previous samples,
+	so it runs one frame late: the delay line is one frame longer than the
+	lookahead window to compensate. */
+
+	const int delayFrames = m_lookahead + 1;
+
+	for (int i = 0; i < buf.countFrames(); i++)
+	{
+		float* frame   = buf[i];
+		float* delayed = &m_delay[(m_frame % delayFrames) * m_channels];
+
+		float level = 0.0f;
+		for (int j = 0; j < m_channels; j++)
+			level = std::max(level, getLevel(j, frame[j]));
+
+		/* Moving average of the windowed minimum: the gain ramps down across the
+		lookahead window and reaches the required value right when the peak
+		leaves the delay line. Release is exponential. */
+
+		const float minGain = getMinGain(level > CEILING ? CEILING / level : 1.0f);
+		const float oldest  = std::exchange(m_box[m_frame % m_lookahead], minGain);
+
+		m_boxSum += minGain - oldest;
+
+		const float target = static_cast<float>(m_boxSum / m_lookahead);
+
+		m_envelope = target < m_envelope ? target : target + (m_envelope - target) * m_releaseCoeff;
+
+		for (int j = 0; j < m_channels; j++)
+		{
+			const float out = delayed[j] * m_envelope;
+			delayed[j]      = frame[j];
+			frame[j]        = std::clamp(out, -CEILING, CEILING); // Guard against rounding errors
+		}
+
+		m_frame++;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+float Limiter::getLevel(int ch, float sample) const
+{
+	float* h = &m_history[ch * 3];
+
+	float level = std::max(std::abs(h[1]), std::abs(h[2]));
+	for (const std::array<float, 4>& w : INTERPOLATION_WEIGHTS)
+		level = std::max(level, std::abs(w[0] * h[0] + w[1] * h[1] + w[2] * h[2] + w[3] * sample));
+
+	h[0] = h[1];
+	h[1] = h[2];
+	h[2] = sample;
+
+	return level;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float Limiter::getMinGain(float gain) const
+{
+	/* Older gains not smaller than the new one can't be the minimum anymore. */
+
+	while (m_minSize > 0)
+	{
+		const int back = (m_minHead + m_minSize - 1) % m_lookahead;
+		if (m_minGains[back] < gain)
+			break;
+		m_minSize--;
+	}
+
+	/* Frames enter the window one at a time, so at most one gain can leave it. */
+
+	if (m_minSize > 0 && m_minFrames[m_minHead] <= m_frame - m_lookahead)
+	{
+		m_minHead = (m_minHead + 1) % m_lookahead;
+		m_minSize--;
+	}
+
+	const int tail    = (m_minHead + m_minSize) % m_lookahead;
+	m_minGains[tail]  = gain;
+	m_minFrames[tail] = m_frame;
+	m_minSize++;
+
+	return m_minGains[m_minHead];
+}
+} // namespace giada::m
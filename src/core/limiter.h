@@ -0,0 +1,121 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_LIMITER_H
+#define G_LIMITER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* Limiter
+Lookahead true-peak limiter for the master output. The signal is delayed by a
+few milliseconds so that the gain can be brought down smoothly before a peak
+shows up, instead of clipping it. Inter-sample peaks are estimated with a
+cubic interpolation between samples. All channels share the same gain. The
+amount of work per block only depends on the block size. */
+
+class Limiter final
+{
+public:
+	enum class Mode : int
+	{
+		HARD      = 0, // Clamps samples to [-1.0, 1.0], no latency
+		LOOKAHEAD = 1
+	};
+
+	/* reset
+	Allocates the internal buffers and brings the gain back to unity. Not
+	realtime-safe. */
+
+	void reset(int sampleRate, int channels);
+
+	/* process
+	Limits 'buf' in place to 0 dBFS. Falls back to a hard clamp if the buffer
+	layout doesn't match the one given to reset(). */
+
+	void process(mcl::AudioBuffer& buf) const;
+
+	/* getLatency
+	Returns the delay introduced by the limiter, in frames. */
+
+	int getLatency() const;
+
+private:
+	/* getLevel
+	Returns the peak level of the segment between the two previous samples of
+	channel 'ch', including the inter-sample peaks, once 'sample' is known. */
+
+	float getLevel(int ch, float sample) const;
+
+	/* getMinGain
+	Pushes the gain required by the current frame into the sliding-window
+	minimum and returns the minimum over the lookahead window. */
+
+	float getMinGain(float gain) const;
+
+	int   m_channels     = 0;
+	int   m_lookahead    = 0;
+	float m_releaseCoeff = 0.0f;
+
+	/* m_delay
+	Ring buffer of m_lookahead + 1 interleaved frames, the audio waiting to be
+	output. */
+
+	mutable std::vector<float> m_delay;
+
+	/* m_history
+	Last three input samples for each channel, for the true-peak estimation. */
+
+	mutable std::vector<float> m_history;
+
+	/* m_minGains, m_minFrames
+	Monotonic queue (ring buffer) for the sliding-window minimum of the gain. */
+
+	mutable std::vector<float>   m_minGains;
+	mutable std::vector<int64_t> m_minFrames;
+	mutable int                  m_minHead = 0;
+	mutable int                  m_minSize = 0;
+
+	/* m_box, m_boxSum
+	Moving average that turns the stepped minimum into a smooth gain ramp. */
+
+	mutable std::vector<float> m_box;
+	mutable double             m_boxSum = 0.0;
+
+	mutable int64_t m_frame    = 0;
+	mutable float   m_envelope = 1.0f;
+};
+} // namespace giada::m
+
+#endif
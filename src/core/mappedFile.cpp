@@ -0,0 +1,128 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/mappedFile.h"
+#include "src/utils/log.h"
+#if G_OS_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <filesystem>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace giada::m
+{
+#if G_OS_WINDOWS
+
+MappedFile::MappedFile(const std::string& path)
+: m_data(nullptr)
+, m_size(0)
+, m_mapping(nullptr)
+{
+	HANDLE file = CreateFileW(std::filesystem::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+	    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		u::log::print("[MappedFile] unable to open {}\n", path);
+		return;
+	}
+
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		m_mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file); // The mapping keeps its own reference to the file
+
+	if (m_mapping == nullptr)
+	{
+		u::log::print("[MappedFile] unable to map {}\n", path);
+		return;
+	}
+
+	m_data = static_cast<std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_COPY, 0, 0, 0));
+	m_size = m_data != nullptr ? static_cast<std::size_t>(size.QuadPart) : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+MappedFile::~MappedFile()
+{
+	if (m_data != nullptr)
+		UnmapViewOfFile(m_data);
+	if (m_mapping != nullptr)
+		CloseHandle(m_mapping);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+: m_data(nullptr)
+, m_size(0)
+{
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		u::log::print("[MappedFile] unable to open {}\n", path);
+		return;
+	}
+
+	struct stat info;
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		void* data = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED)
+		{
+			m_data = static_cast<std::byte*>(data);
+			m_size = static_cast<std::size_t>(info.st_size);
+		}
+	}
+	close(fd); // The mapping keeps its own reference to the file
+
+	if (m_data == nullptr)
+		u::log::print("[MappedFile] unable to map {}\n", path);
+}
+
+/* -------------------------------------------------------------------------- */
+
+MappedFile::~MappedFile()
+{
+	if (m_data != nullptr)
+		munmap(m_data, m_size);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+bool        MappedFile::isValid() const { return m_data != nullptr; }
+std::byte*  MappedFile::getData() const { return m_data; }
+std::size_t MappedFile::getSize() const { return m_size; }
+} // namespace giada::m
@@ -0,0 +1,69 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_MAPPED_FILE_H
+#define G_MAPPED_FILE_H
+
+#include "src/const.h"
+#include <cstddef>
+#include <string>
+
+namespace giada::m
+{
+/* MappedFile
+Copy-on-write memory mapping of a whole file. Pages are shared with any other
+process mapping the same file, until written: changes stay private to the
+process and never reach the file on disk. */
+
+class MappedFile final
+{
+public:
+	MappedFile(const std::string& path);
+	MappedFile(const MappedFile&)            = delete;
+	MappedFile(MappedFile&&)                 = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&)      = delete;
+	~MappedFile();
+
+	/* isValid
+	False if the file could not be mapped. */
+
+	bool isValid() const;
+
+	std::byte*  getData() const;
+	std::size_t getSize() const;
+
+private:
+	std::byte*  m_data;
+	std::size_t m_size;
+#if G_OS_WINDOWS
+	void* m_mapping; // HANDLE
+#endif
+};
+} // namespace giada::m
+
+#endif
@@ -38,6 +38,7 @@
 #include "src/utils/log.h"
 #include <cassert>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 namespace giada::m
@@ -149,7 +150,7 @@ bool MidiDispatcher::isMasterMidiInAllowed(int c)
 
 bool MidiDispatcher::isChannelMidiInAllowed(ID channelId, int c)
 {
-	return m_model.get().tracks.getChannel(channelId).midiInput.isAllowed(c);
+	return std::as_const(m_model.get().tracks).getChannel(channelId).midiInput.isAllowed(c);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -183,14 +184,14 @@ void MidiDispatcher::processPlugins(ID channelId, const std::vector<Plugin*>& pl
 void MidiDispatcher::processTracks(const MidiEvent& midiEvent)
 {
 	for (const model::Track& track : m_model.get().tracks.getAll())
-		processChannels(track.getChannels().getAll(), midiEvent);
+		processChannels(track.getChannels(), midiEvent);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void MidiDispatcher::processChannels(const std::vector<Channel>& channels, const MidiEvent& midiEvent)
+void MidiDispatcher::processChannels(const model::Channels& channels, const MidiEvent& midiEvent)
 {
-	for (const Channel& ch : channels)
+	for (const Channel& ch : channels.getAll())
 		processChannel(ch, midiEvent);
 }
 
@@ -76,7 +76,7 @@ private:
 	bool isChannelMidiInAllowed(ID channelId, int c);
 
 	void processTracks(const MidiEvent&);
-	void processChannels(const std::vector<Channel>&, const MidiEvent&);
+	void processChannels(const model::Channels&, const MidiEvent&);
 	void processChannel(const Channel&, const MidiEvent&);
 	void processMaster(const MidiEvent&);
 
@@ -26,6 +26,7 @@
 
 #include "src/core/mixer.h"
 #include "src/core/const.h"
+#include "src/core/dsp.h"
 #include "src/core/model/model.h"
 #include "src/deps/mcl-utils/src/math.hpp"
 #include "src/utils/log.h"
@@ -34,19 +35,6 @@ namespace math = mcl::utils::math;
 
 namespace giada::m
 {
-namespace
-{
-/* CH_LEFT, CH_RIGHT
-Channels identifiers. */
-
-constexpr int CH_LEFT  = 0;
-constexpr int CH_RIGHT = 1;
-} // namespace
-
-/* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
-
 Mixer::Mixer(model::Model& m)
 : onSignalTresholdReached(nullptr)
 , onEndOfRecording(nullptr)
@@ -58,7 +46,7 @@ Mixer::Mixer(model::Model& m)
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::reset(int maxFramesInLoop, int framesInBuffer)
+void Mixer::reset(int maxFramesInLoop, int framesInBuffer, int sampleRate, int channelsOut)
 {
 	/* Allocate working buffers. rec buffer has variable size: it depends on how
 	many frames there are in the current loop. */
@@ -66,6 +54,8 @@ void Mixer::reset(int maxFramesInLoop, int framesInBuffer)
 	m_model.get().mixer.getRecBuffer().alloc(maxFramesInLoop, G_MAX_IO_CHANS);
 	m_model.get().mixer.getInBuffer().alloc(framesInBuffer, G_MAX_IO_CHANS);
 
+	m_limiter.reset(sampleRate, channelsOut);
+
 	u::log::print("[mixer::reset] buffers ready - maxFramesInLoop={}, framesInBuffer={}\n",
 	    maxFramesInLoop, framesInBuffer);
 }
@@ -135,7 +125,7 @@ void Mixer::setInputRecMode(InputRecMode m)
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_RT, int maxFramesToRec) const
+void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_RT, int maxFramesToRec, Frame latency) const
 {
 	const model::Mixer&       mixer       = document_RT.mixer;
 	const model::Sequencer&   sequencer   = document_RT.sequencer;
@@ -149,6 +139,7 @@ void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_R
 	const bool  shouldLineInRec = seqIsActive && mixer.isRecordingInput && hasInput;
 	const float recTriggerLevel = kernelAudio.recTriggerLevel;
 	const bool  allowsOverdub   = mixer.inputRecMode == InputRecMode::RIGID;
+	const float inVol           = masterInCh.shared->volume.getRamp().to;
 
 	mixer.getInBuffer().clear();
 
@@ -158,13 +149,13 @@ void Mixer::render(const mcl::AudioBuffer& in, const model::Document& document_R
 	mixer.a_setPeakIn({0.0f, 0.0f});
 
 	if (hasInput)
-		processLineIn(mixer, in, masterInCh.volume, recTriggerLevel, seqIsActive);
+		processLineIn(mixer, in, inVol, recTriggerLevel, seqIsActive);
 
 	if (shouldLineInRec)
 	{
 		const Frame newTrackerPos = lineInRec(in, mixer.getRecBuffer(),
-		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.volume,
-		    allowsOverdub);
+		    mixer.a_getInputTracker(), maxFramesToRec, inVol,
+		    allowsOverdub, latency);
 		mixer.a_setInputTracker(newTrackerPos);
 	}
 }
@@ -259,13 +250,13 @@ Peak Mixer::makePeak(const mcl::AudioBuffer& b) const
 {
 	if (!b.isAllocd())
 		return {0.0f, 0.0f};
-	return {b.getPeak(CH_LEFT), b.getPeak(b.countChannels() == 1 ? CH_LEFT : CH_RIGHT)};
+	return dsp::getPeak(b);
 }
 
 /* -------------------------------------------------------------------------- */
 
 int Mixer::lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf, Frame inputTracker,
-    int maxFrames, float inVol, bool allowsOverdub) const
+    int maxFrames, float inVol, bool allowsOverdub, Frame latency) const
 {
 	assert(maxFrames > 0 && maxFrames <= recBuf.countFrames());
 	assert(onEndOfRecording != nullptr);
@@ -279,7 +270,7 @@ int Mixer::lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf, Fr
 
 	const int   framesToCopy = -1; // copy everything
 	const Frame srcOffset    = 0;
-	const Frame destOffset   = inputTracker % maxFrames; // loop over at maxFrames
+	const Frame destOffset   = ((inputTracker - latency) % maxFrames + maxFrames) % maxFrames; // loop over at maxFrames
 
 	recBuf.sumAll(inBuf, framesToCopy, srcOffset, destOffset, inVol);
 
@@ -312,31 +303,33 @@ void Mixer::processLineIn(const model::Mixer& mixer, const mcl::AudioBuffer& inB
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::limit(mcl::AudioBuffer& outBuf) const
+int Mixer::getOutputLatency(bool shouldLimit, Limiter::Mode limiterMode) const
 {
-	for (int i = 0; i < outBuf.countFrames(); i++)
-		for (int j = 0; j < outBuf.countChannels(); j++)
-			outBuf[i][j] = std::max(-1.0f, std::min(outBuf[i][j], 1.0f));
+	return shouldLimit && limiterMode == Limiter::Mode::LOOKAHEAD ? m_limiter.getLatency() : 0;
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Mixer::finalizeOutput(const model::Mixer& mixer, mcl::AudioBuffer& buf,
-    bool inToOut, bool shouldLimit, float vol) const
+    bool inToOut, bool shouldLimit, Limiter::Mode limiterMode, float vol) const
 {
-	if (inToOut)
-		buf.sumAll(mixer.getInBuffer(), vol);
-	else
-		buf.applyGain(vol);
+	const mcl::AudioBuffer* in = inToOut ? &mixer.getInBuffer() : nullptr;
+
+	/* The hard limiter is folded into the gain pass. The lookahead one needs
+	its own pass, as it works on the final signal. */
+
+	const bool lookahead = shouldLimit && limiterMode == Limiter::Mode::LOOKAHEAD;
+
+	dsp::finalize(buf, in, vol, /*clamp=*/shouldLimit && !lookahead);
 
-	if (shouldLimit)
-		limit(buf);
+	if (lookahead)
+		m_limiter.process(buf);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::updateOutputPeak(const model::Mixer& mixer, const mcl::AudioBuffer& buf) const
+void Mixer::updateOutputPeak(const model::Mixer& mixer, Peak peak) const
 {
-	mixer.a_setPeakOut({buf.getPeak(CH_LEFT), buf.getPeak(CH_RIGHT)});
+	mixer.a_setPeakOut(peak);
 }
 } // namespace giada::m
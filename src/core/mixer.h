@@ -27,6 +27,7 @@
 #ifndef G_MIXER_H
 #define G_MIXER_H
 
+#include "src/core/limiter.h"
 #include "src/core/midiEvent.h"
 #include "src/core/ringBuffer.h"
 #include "src/core/sequencer.h"
@@ -81,15 +82,17 @@ public:
 	InputRecMode   getInputRecMode() const;
 
 	/* render
-	Core rendering function. */
+	Core rendering function. 'latency' is the processing latency of the output,
+	see Renderer::getLatency: recorded input is shifted back by that amount, to
+	line it up with what was being heard while playing. */
 
-	void render(const mcl::AudioBuffer& in, const model::Document&, int maxFramesToRec) const;
+	void render(const mcl::AudioBuffer& in, const model::Document&, int maxFramesToRec, Frame latency) const;
 
 	/* reset
 	Brings everything back to the initial state. Must be called only when mixer
 	is disabled.*/
 
-	void reset(int framesInLoop, int framesInBuffer);
+	void reset(int framesInLoop, int framesInBuffer, int sampleRate, int channelsOut);
 
 	/* enable, disable
 	Toggles master callback processing. Useful to suspend the rendering. */
@@ -135,15 +138,21 @@ public:
 
 	/* finalizeOutput
 	Last touches after the output has been rendered: apply inToOut if any, apply
-	output volume. */
+	output volume and limit the result, in a single pass when possible. */
+
+	/* getOutputLatency
+	Returns the delay introduced by finalizeOutput() with the given limiter
+	settings, in frames. */
+
+	int getOutputLatency(bool shouldLimit, Limiter::Mode) const;
 
 	void finalizeOutput(const model::Mixer&, mcl::AudioBuffer&, bool inToOut,
-	    bool limit, float vol) const;
+	    bool limit, Limiter::Mode, float vol) const;
 
 	/* updateOutputPeak
-	Reads the maximum peak in the given buffer and updates the value in model::Mixer. */
+	Stores the output peak, already measured while rendering, in model::Mixer. */
 
-	void updateOutputPeak(const model::Mixer&, const mcl::AudioBuffer&) const;
+	void updateOutputPeak(const model::Mixer&, Peak) const;
 
 	void setRecTriggerMode(RecTriggerMode);
 	void setInputRecMode(InputRecMode);
@@ -175,10 +184,11 @@ private:
 	/* lineInRec
 	Records from line in. 'maxFrames' determines how many frames to record
 	before the internal tracker loops over. The value changes whether you are
-	recording in RIGID or FREE mode. Returns the number of recorded frames. */
+	recording in RIGID or FREE mode. Audio is written 'latency' frames before
+	the tracker position. Returns the number of recorded frames. */
 
 	int lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf,
-	    Frame inputTracker, int maxFrames, float inVol, bool allowsOverdub) const;
+	    Frame inputTracker, int maxFrames, float inVol, bool allowsOverdub, Frame latency) const;
 
 	/* processLineIn
 	Computes line in peaks and prepares the internal working buffer for input
@@ -187,11 +197,6 @@ private:
 	void processLineIn(const model::Mixer& mixer, const mcl::AudioBuffer& inBuf,
 	    float inVol, float recTriggerLevel, bool isSeqActive) const;
 
-	/* limit
-	Applies a very dumb hard limiter. */
-
-	void limit(mcl::AudioBuffer& outBuf) const;
-
 	model::Model& m_model;
 
 	/* m_signalCbFired, m_endOfRecCbFired
@@ -200,6 +205,8 @@ private:
 
 	mutable bool m_signalCbFired;
 	mutable bool m_endOfRecCbFired;
+
+	Limiter m_limiter;
 };
 } // namespace giada::m
 
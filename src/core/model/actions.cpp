@@ -29,21 +29,38 @@
 #include "src/utils/log.h"
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <memory>
+#include <unordered_set>
+#include <utility>
 #if G_DEBUG_MODE
 #include <fmt/core.h>
 #endif
 
 namespace giada::m::model
 {
-void Actions::set(model::Actions::Map&& actions)
+namespace
 {
-	m_actions = std::move(actions);
+bool isSameEvent_(const Action& a, ID channelId, Scene scene, Frame frame, const MidiEvent& event)
+{
+	return a.channelId == channelId && a.frame == frame && a.event.getRaw() == event.getRaw() && a.scene == scene;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void Actions::set(std::vector<Action>&& actions)
+{
+	edit().actions = std::move(actions);
+	sort();
 }
 
 void Actions::clearAll()
 {
-	m_actions.clear();
+	edit().actions.clear();
+	rebuildIndexes();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -82,42 +99,34 @@ void Actions::deleteAction(ID currId, ID nextId)
 
 void Actions::updateKeyFrames(std::function<Frame(Frame old)> f)
 {
-	Map temp;
-
-	/* Copy all existing actions in local map by cloning them, with just a
-	difference: they have a new frame value. */
-
-	for (const auto& [oldFrame, actions] : m_actions)
+	for (Action& a : edit().actions)
 	{
-		Frame newFrame = f(oldFrame);
-		for (const Action& a : actions)
-		{
-			Action copy = a;
-			copy.frame  = newFrame;
-			temp[newFrame].push_back(copy);
-		}
-		G_DEBUG("{} -> {}", oldFrame, newFrame);
+		const Frame newFrame = f(a.frame);
+		G_DEBUG("{} -> {}", a.frame, newFrame);
+		a.frame = newFrame;
 	}
-
-	m_actions = std::move(temp);
+	sort();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::updateEvent(ID id, MidiEvent e)
 {
-	Action* a = findAction(m_actions, id);
+	Action* a = findMutableAction(id);
 	assert(a != nullptr);
-	a->event = e;
+	const bool wasAutomation = a->isAutomation();
+	a->event                 = e;
+	if (wasAutomation || a->isAutomation())
+		rebuildCurves();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::updateSiblings(ID id, ID prevId, ID nextId)
 {
-	Action* pcurr = findAction(m_actions, id);
-	Action* pprev = findAction(m_actions, prevId);
-	Action* pnext = findAction(m_actions, nextId);
+	Action* pcurr = findMutableAction(id);
+	Action* pprev = findMutableAction(prevId);
+	Action* pnext = findMutableAction(nextId);
 
 	pcurr->prevId = pprev->id;
 	pcurr->nextId = pnext->id;
@@ -136,20 +145,55 @@ void Actions::updateSiblings(ID id, ID prevId, ID nextId)
 
 bool Actions::hasActions(ID channelId, int type) const
 {
-	for (const auto& [frame, actions] : m_actions)
-		for (const Action& a : actions)
-			if (a.channelId == channelId && (type == 0 || type == a.event.getStatus()))
-				return true;
+	for (const std::size_t pos : getChannelRange(channelId))
+		if (type == 0 || type == m_timeline->actions[pos].event.getStatus())
+			return true;
 	return false;
 }
 
 /* -------------------------------------------------------------------------- */
 
-const Actions::Map& Actions::getAll() const { return m_actions; }
+std::span<const AutomationCurve> Actions::getCurvesOnChannel(ID channelId) const
+{
+	const std::vector<AutomationCurve>& curves = m_timeline->curves;
+
+	const auto key  = channelId.getValue();
+	const auto less = [](const AutomationCurve& curve, auto key)
+	{ return curve.channelId.getValue() < key; };
+
+	const auto first = std::lower_bound(curves.begin(), curves.end(), key, less);
+	const auto last  = std::lower_bound(first, curves.end(), key + 1, less);
+
+	return {first, last};
+}
 
 /* -------------------------------------------------------------------------- */
 
-const Action* Actions::findAction(ID id) const { return findAction(m_actions, id); }
+const std::vector<Action>& Actions::getAll() const { return m_timeline->actions; }
+
+/* -------------------------------------------------------------------------- */
+
+const Action* Actions::findAction(ID id) const
+{
+	if (!id.isValid())
+		return nullptr;
+
+	const auto it = std::lower_bound(m_timeline->byId.begin(), m_timeline->byId.end(), id, [this](std::size_t pos, ID id)
+	{ return m_timeline->actions[pos].id.getValue() < id.getValue(); });
+
+	if (it == m_timeline->byId.end() || m_timeline->actions[*it].id != id)
+		return nullptr;
+	return &m_timeline->actions[*it];
+}
+
+Action* Actions::findMutableAction(ID id)
+{
+	const Action* action = std::as_const(*this).findAction(id);
+	if (action == nullptr)
+		return nullptr;
+	const std::size_t pos = action - m_timeline->actions.data();
+	return &edit().actions[pos];
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -159,32 +203,31 @@ void Actions::debug() const
 {
 	puts("model::actions");
 
-	for (const auto& [frame, actions] : m_actions)
-	{
-		fmt::print("\tframe: {}\n", frame);
-		for (const Action& a : actions)
-			fmt::print("\t\t({}) - ID={}, scene={}, frame={}, channel={}, value=0x{}, prevId={}, nextId={}\n",
-			    (void*)&a, a.id.getValue(), a.scene.getIndex(), a.frame, a.channelId.getValue(), a.event.getRaw(), a.prevId.getValue(), a.nextId.getValue());
-	}
+	for (const Action& a : m_timeline->actions)
+		fmt::print("\t({}) - ID={}, scene={}, frame={}, channel={}, value=0x{}, prevId={}, nextId={}\n",
+		    (void*)&a, a.id.getValue(), a.scene.getIndex(), a.frame, a.channelId.getValue(), a.event.getRaw(), a.prevId.getValue(), a.nextId.getValue());
 }
 
 #endif
 
 /* -------------------------------------------------------------------------- */
 
-Action Actions::rec(ID channelId, Scene scene, Frame frame, MidiEvent event)
+Action Actions::rec(ID channelId, Scene scene, Frame frame, MidiEvent event, ID pluginId, int pluginParam)
 {
 	/* Skip duplicates. */
 
 	if (exists(channelId, scene, frame, event))
 		return {};
 
-	Action a = actionFactory::makeAction({}, channelId, scene, frame, event);
+	Action a = actionFactory::makeAction({}, channelId, scene, frame, event, pluginId, pluginParam);
 
-	/* If key frame doesn't exist yet, the [] operator in std::map is smart
-	enough to insert a new item first. No plug-in data for now. */
+	/* Insert after the last action on the same frame, if any, to keep the
+	insertion order. */
 
-	m_actions[frame].push_back(a);
+	Timeline&  timeline = edit();
+	const auto pos      = std::upper_bound(timeline.frames.begin(), timeline.frames.end(), frame) - timeline.frames.begin();
+	timeline.actions.insert(timeline.actions.begin() + pos, a);
+	rebuildIndexes();
 
 	return a;
 }
@@ -196,31 +239,84 @@ void Actions::rec(std::vector<Action>& actions, Scene scene)
 	if (actions.size() == 0)
 		return;
 
+	/* Sort the new actions by frame, then merge them into the timeline in a
+	single pass. Duplicates are skipped: actions already in the timeline or
+	already accepted from this batch, either by ID or by event. Accepted actions
+	on the same frame are contiguous once sorted, so only those are compared. */
+
+	std::stable_sort(actions.begin(), actions.end(), [](const Action& a, const Action& b)
+	{ return a.frame < b.frame; });
+
+	std::vector<Action>    accepted;
+	std::unordered_set<ID> ids;
+	std::size_t            firstOnFrame = 0;
+
+	accepted.reserve(actions.size());
+
 	for (const Action& a : actions)
-		if (!exists(a.channelId, scene, a.frame, a.event, m_actions))
-			m_actions[a.frame].push_back(a);
+	{
+		if (a.id.isValid() && (findAction(a.id) != nullptr || !ids.insert(a.id).second))
+			continue;
+		if (exists(a.channelId, scene, a.frame, a.event))
+			continue;
+
+		if (firstOnFrame < accepted.size() && accepted[firstOnFrame].frame != a.frame)
+			firstOnFrame = accepted.size();
+		const auto isDuplicate = [&](const Action& other)
+		{ return isSameEvent_(other, a.channelId, scene, a.frame, a.event); };
+		if (std::any_of(accepted.begin() + firstOnFrame, accepted.end(), isDuplicate))
+			continue;
+
+		accepted.push_back(a);
+	}
+
+	if (accepted.empty())
+		return;
+
+	/* std::merge is stable: on the same frame, actions already in the timeline
+	come first. */
+
+	const std::vector<Action>& timeline = m_timeline->actions;
+	std::vector<Action>        merged;
+
+	merged.reserve(timeline.size() + accepted.size());
+	std::merge(timeline.begin(), timeline.end(), accepted.begin(), accepted.end(), std::back_inserter(merged),
+	    [](const Action& a, const Action& b)
+	{ return a.frame < b.frame; });
+
+	edit().actions = std::move(merged);
+	rebuildIndexes();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::rec(ID channelId, Scene scene, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2)
 {
-	m_actions[f1].push_back(actionFactory::makeAction({}, channelId, scene, f1, e1));
-	m_actions[f2].push_back(actionFactory::makeAction({}, channelId, scene, f2, e2));
+	Action a1 = actionFactory::makeAction({}, channelId, scene, f1, e1);
+	Action a2 = actionFactory::makeAction({}, channelId, scene, f2, e2);
+	a1.nextId = a2.id;
+	a2.prevId = a1.id;
+
+	edit().actions.push_back(a1);
+	edit().actions.push_back(a2);
+	sort();
+}
 
-	Action* a1 = findAction(m_actions, m_actions[f1].back().id);
-	Action* a2 = findAction(m_actions, m_actions[f2].back().id);
-	a1->nextId = a2->id;
-	a2->prevId = a1->id;
+/* -------------------------------------------------------------------------- */
+
+std::span<const Action> Actions::getActionsOnFrame(Frame frame) const
+{
+	return getActionsInRange(frame, frame + 1);
 }
 
 /* -------------------------------------------------------------------------- */
 
-const std::vector<Action>* Actions::getActionsOnFrame(Frame frame) const
+std::span<const Action> Actions::getActionsInRange(Frame a, Frame b) const
 {
-	if (m_actions.count(frame) == 0)
-		return nullptr;
-	return &m_actions.at(frame);
+	const auto first = std::lower_bound(m_timeline->frames.begin(), m_timeline->frames.end(), a);
+	const auto last  = std::lower_bound(first, m_timeline->frames.end(), b);
+
+	return {m_timeline->actions.data() + (first - m_timeline->frames.begin()), static_cast<std::size_t>(last - first)};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -228,13 +324,14 @@ const std::vector<Action>* Actions::getActionsOnFrame(Frame frame) const
 Action Actions::getClosestAction(ID channelId, Frame f, int type) const
 {
 	Action out = {};
-	forEachAction([&](const Action& a)
+	for (const std::size_t pos : getChannelRange(channelId))
 	{
-		if (a.event.getStatus() != type || a.channelId != channelId)
-			return;
+		const Action& a = m_timeline->actions[pos];
+		if (a.event.getStatus() != type)
+			continue;
 		if (!out.isValid() || (a.frame <= f && a.frame > out.frame))
 			out = a;
-	});
+	}
 	return out;
 }
 
@@ -243,11 +340,9 @@ Action Actions::getClosestAction(ID channelId, Frame f, int type) const
 std::vector<Action> Actions::getActionsOnChannel(ID channelId, Scene scene) const
 {
 	std::vector<Action> out;
-	forEachAction([&](const Action& a)
-	{
-		if (a.channelId == channelId && a.scene == scene)
-			out.push_back(a);
-	});
+	for (const std::size_t pos : getChannelRange(channelId))
+		if (m_timeline->actions[pos].scene == scene)
+			out.push_back(m_timeline->actions[pos]);
 	return out;
 }
 
@@ -255,61 +350,119 @@ std::vector<Action> Actions::getActionsOnChannel(ID channelId, Scene scene) cons
 
 void Actions::forEachAction(std::function<void(const Action&)> f) const
 {
-	for (auto& [_, actions] : m_actions)
-		for (const Action& action : actions)
-			f(action);
+	for (const Action& action : m_timeline->actions)
+		f(action);
 }
 
 /* -------------------------------------------------------------------------- */
 
-const Action* Actions::findAction(const Map& src, ID id) const
+std::span<const std::size_t> Actions::getChannelRange(ID channelId) const
 {
-	if (!id.isValid())
-		return nullptr;
-	for (const auto& [frame, actions] : src)
-		for (const Action& a : actions)
-			if (a.id == id)
-				return &a;
-	return nullptr;
+	const auto key  = channelId.getValue();
+	const auto less = [this](std::size_t pos, auto key)
+	{ return m_timeline->actions[pos].channelId.getValue() < key; };
+
+	const auto first = std::lower_bound(m_timeline->byChannel.begin(), m_timeline->byChannel.end(), key, less);
+	const auto last  = std::lower_bound(first, m_timeline->byChannel.end(), key + 1, less);
+
+	return {first, last};
 }
 
-Action* Actions::findAction(Map& src, ID id)
+/* -------------------------------------------------------------------------- */
+
+void Actions::sort()
 {
-	return const_cast<Action*>(std::as_const(*this).findAction(src, id));
+	std::vector<Action>& actions = edit().actions;
+	std::stable_sort(actions.begin(), actions.end(), [](const Action& a, const Action& b)
+	{ return a.frame < b.frame; });
+	rebuildIndexes();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Actions::optimize(Map& map)
+void Actions::rebuildIndexes()
 {
-	for (auto it = map.cbegin(); it != map.cend();)
-		it->second.size() == 0 ? it = map.erase(it) : ++it;
+	Timeline&         timeline = edit();
+	const std::size_t size     = timeline.actions.size();
+
+	timeline.frames.resize(size);
+	timeline.byId.resize(size);
+	timeline.byChannel.resize(size);
+
+	for (std::size_t i = 0; i < size; i++)
+	{
+		timeline.frames[i]    = timeline.actions[i].frame;
+		timeline.byId[i]      = i;
+		timeline.byChannel[i] = i;
+	}
+
+	std::sort(timeline.byId.begin(), timeline.byId.end(), [&timeline](std::size_t a, std::size_t b)
+	{ return timeline.actions[a].id.getValue() < timeline.actions[b].id.getValue(); });
+
+	/* Stable sort: actions of the same channel stay sorted by frame. */
+
+	std::stable_sort(timeline.byChannel.begin(), timeline.byChannel.end(), [&timeline](std::size_t a, std::size_t b)
+	{ return timeline.actions[a].channelId.getValue() < timeline.actions[b].channelId.getValue(); });
+
+	rebuildCurves();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Actions::rebuildCurves()
+{
+	Timeline&                     timeline = edit();
+	std::vector<AutomationCurve>& curves   = timeline.curves;
+
+	curves.clear();
+
+	/* The channel index yields actions grouped by channel and sorted by frame:
+	curves come out sorted by channel, each with its breakpoints in order. Only
+	curves of the current channel need to be searched. */
+
+	std::size_t firstOnChannel = 0;
+	for (const std::size_t pos : timeline.byChannel)
+	{
+		const Action& a = timeline.actions[pos];
+		if (!a.isAutomation())
+			continue;
+
+		if (firstOnChannel < curves.size() && curves[firstOnChannel].channelId != a.channelId)
+			firstOnChannel = curves.size();
+
+		const auto it = std::find_if(curves.begin() + firstOnChannel, curves.end(), [&a](const AutomationCurve& curve)
+		{ return curve.matches(a); });
+
+		AutomationCurve& curve = it != curves.end() ? *it : curves.emplace_back(a);
+		curve.add(a.frame, a.event.getVelocityFloat());
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::removeIf(std::function<bool(const Action&)> f)
 {
-	for (auto& [frame, actions] : m_actions)
-		actions.erase(std::remove_if(actions.begin(), actions.end(), f), actions.end());
-	optimize(m_actions);
+	std::vector<Action>& actions = edit().actions;
+	actions.erase(std::remove_if(actions.begin(), actions.end(), f), actions.end());
+	rebuildIndexes();
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Actions::exists(ID channelId, Scene scene, Frame frame, const MidiEvent& event, const Map& target) const
+Actions::Timeline& Actions::edit()
 {
-	for (const auto& [_, actions] : target)
-		for (const Action& a : actions)
-			if (a.channelId == channelId && a.frame == frame && a.event.getRaw() == event.getRaw() && a.scene == scene)
-				return true;
-	return false;
+	if (m_timeline.use_count() > 1)
+		m_timeline = std::make_shared<Timeline>(*m_timeline);
+	return *m_timeline;
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool Actions::exists(ID channelId, Scene scene, Frame frame, const MidiEvent& event) const
 {
-	return exists(channelId, scene, frame, event, m_actions);
+	for (const Action& a : getActionsOnFrame(frame))
+		if (isSameEvent_(a, channelId, scene, frame, event))
+			return true;
+	return false;
 }
 } // namespace giada::m::model
@@ -29,23 +29,32 @@
 
 #include "src/const.h"
 #include "src/core/actions/action.h"
+#include "src/core/actions/automationCurve.h"
 #include "src/core/midiEvent.h"
 #include "src/core/types.h"
 #include <functional>
-#include <map>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace giada::m::model
 {
+/* Actions
+Timeline of recorded actions. Actions live in a single contiguous vector sorted
+by frame (and by insertion order within the same frame), next to a dense column
+of their frames used for binary searching. Two sorted indexes of positions
+speed up lookups by action ID and by channel. Indexes are rebuilt on each
+mutation: that happens on the main thread only, while the realtime thread just
+reads contiguous ranges of actions. Automation actions are also collected into
+breakpoint curves, grouped by channel. Copies of Actions share the same
+timeline until one of them is altered. */
+
 class Actions
 {
 public:
-	using Map = std::map<Frame, std::vector<Action>>;
-
 	/* forEachAction
 	Applies a read-only callback on each action recorded. NEVER do anything
-	inside the callback that might alter the ActionMap. */
+	inside the callback that might alter the timeline. */
 
 	void forEachAction(std::function<void(const Action&)> f) const;
 
@@ -60,20 +69,32 @@ public:
 	Action getClosestAction(ID channelId, Frame f, int type) const;
 
 	/* getActionsOnFrame
-	Returns a pointer to a vector of actions recorded on frame 'f', or nullptr
-	if the frame has no actions. */
+	Returns the actions recorded on frame 'f'. The span is empty if the frame
+	has no actions. */
+
+	std::span<const Action> getActionsOnFrame(Frame f) const;
 
-	const std::vector<Action>* getActionsOnFrame(Frame f) const;
+	/* getActionsInRange
+	Returns the actions recorded in the range [a, b), sorted by frame. Costs two
+	binary searches, regardless of the range length. */
+
+	std::span<const Action> getActionsInRange(Frame a, Frame b) const;
 
 	/* hasActions
 	Checks if the channel has at least one action recorded. */
 
 	bool hasActions(ID channelId, int type = 0) const;
 
+	/* getCurvesOnChannel
+	Returns the automation curves of channel 'channelId', for all scenes. The
+	span is empty if the channel is not automated. */
+
+	std::span<const AutomationCurve> getCurvesOnChannel(ID channelId) const;
+
 	/* getAll
-	Returns a reference to the internal map. */
+	Returns a reference to the internal timeline, sorted by frame. */
 
-	const Map& getAll() const;
+	const std::vector<Action>& getAll() const;
 
 	/* findAction
 	Finds action given ID. Returns nullptr if not found. */
@@ -85,9 +106,10 @@ public:
 #endif
 
 	/* set
-	Sets a new whole map of actions. Use this when deserializing stuff. */
+	Sets a new whole timeline of actions, in any order. Use this when
+	deserializing stuff. */
 
-	void set(model::Actions::Map&&);
+	void set(std::vector<Action>&&);
 
 	/* clearAll
 	Deletes all recorded actions. */
@@ -115,8 +137,8 @@ public:
 	void deleteAction(ID currId, ID nextId);
 
 	/* updateKeyFrames
-	Update all the key frames in the internal map of actions, according to a
-	lambda function 'f'. */
+	Update all the key frames in the timeline, according to a lambda function
+	'f'. */
 
 	void updateKeyFrames(std::function<Frame(Frame old)> f);
 
@@ -132,13 +154,15 @@ public:
 	void updateSiblings(ID id, ID prevId, ID nextId);
 
 	/* rec (1)
-	Records an action and returns it. Used by the Action Editor. */
+	Records an action and returns it. Used by the Action Editor. Plug-in data
+	is optional, for automation actions targeting plug-in parameters. */
 
-	Action rec(ID channelId, Scene, Frame frame, MidiEvent e);
+	Action rec(ID channelId, Scene, Frame frame, MidiEvent e, ID pluginId = {}, int pluginParam = -1);
 
 	/* rec (2)
-	Transfer a vector of actions into the current ActionMap. This is called by
-	recordHandler when a live session is over and consolidation is required. */
+	Transfer a vector of actions into the current timeline. This is called by
+	recordHandler when a live session is over and consolidation is required.
+	'actions' gets sorted by frame in the process. */
 
 	void rec(std::vector<Action>& actions, Scene);
 
@@ -149,20 +173,69 @@ public:
 	void rec(ID channelId, Scene, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2);
 
 private:
-	bool exists(ID channelId, Scene, Frame frame, const MidiEvent& event, const Map& target) const;
 	bool exists(ID channelId, Scene, Frame frame, const MidiEvent& event) const;
 
-	Action*       findAction(Map& src, ID id);
-	const Action* findAction(const Map& src, ID id) const;
+	Action* findMutableAction(ID id);
+
+	/* getChannelRange
+	Returns the range of the channel index pointing to actions of channel
+	'channelId'. */
+
+	std::span<const std::size_t> getChannelRange(ID channelId) const;
+
+	/* sort
+	Sorts the timeline by frame, preserving the insertion order of actions on the
+	same frame, then rebuilds the indexes. */
+
+	void sort();
+
+	/* rebuildIndexes
+	Rebuilds the frame column and the ID and channel indexes. Call this after
+	each change in the timeline. */
 
-	/* optimize
-	Removes frames without actions. */
+	void rebuildIndexes();
 
-	void optimize(Map& map);
+	/* rebuildCurves
+	Collects the automation actions into curves. Called by rebuildIndexes(),
+	as it walks the channel index. */
+
+	void rebuildCurves();
 
 	void removeIf(std::function<bool(const Action&)> f);
 
-	Actions::Map m_actions;
+	struct Timeline
+	{
+		std::vector<Action> actions;
+
+		/* frames
+		Frame column, parallel to 'actions'. */
+
+		std::vector<Frame> frames;
+
+		/* byId, byChannel
+		Positions in 'actions', sorted by action ID and by channel ID
+		respectively. */
+
+		std::vector<std::size_t> byId;
+		std::vector<std::size_t> byChannel;
+
+		/* curves
+		Automation curves, sorted by channel ID. */
+
+		std::vector<AutomationCurve> curves;
+	};
+
+	/* edit
+	Returns the timeline for writing, copying it first if shared with other
+	Actions objects. */
+
+	Timeline& edit();
+
+	/* m_timeline
+	Shared between copies of this object (e.g. when the Document is swapped) and
+	copied only on the first write. */
+
+	std::shared_ptr<Timeline> m_timeline = std::make_shared<Timeline>();
 };
 } // namespace giada::m::model
 
@@ -27,6 +27,7 @@
 #include "src/core/model/channels.h"
 #include "src/core/plugins/plugin.h"
 #include "src/deps/mcl-utils/src/container.hpp"
+#include <algorithm>
 #include <cassert>
 #if G_DEBUG_MODE
 #include "src/utils/string.h"
@@ -39,55 +40,48 @@ namespace giada::m::model
 {
 Channel* Channels::find(ID id)
 {
-	return const_cast<Channel*>(std::as_const(*this).find(id));
+	const auto it = findIt(id);
+	if (it == m_channels.end())
+		return nullptr;
+	return &makeUnique(m_channels[it - m_channels.begin()]);
 }
 
 const Channel* Channels::find(ID id) const
 {
-	auto it = std::find_if(m_channels.begin(), m_channels.end(), [id](const Channel& c)
-	{ return c.id == id; });
-	return it != m_channels.end() ? &*it : nullptr;
+	const auto it = findIt(id);
+	return it != m_channels.end() ? it->get() : nullptr;
 }
 
 /* -------------------------------------------------------------------------- */
 
 Channel& Channels::get(ID id)
 {
-	return const_cast<Channel&>(std::as_const(*this).get(id));
+	Channel* ch = find(id);
+	assert(ch != nullptr);
+	return *ch;
 }
 
 const Channel& Channels::get(ID id) const
 {
-	auto it = std::find_if(m_channels.begin(), m_channels.end(), [id](const Channel& c)
-	{ return c.id == id; });
-	assert(it != m_channels.end());
-	return *it;
+	const Channel* ch = find(id);
+	assert(ch != nullptr);
+	return *ch;
 }
 
 /* -------------------------------------------------------------------------- */
 
 Channel& Channels::getLast()
 {
-	return m_channels.back();
-}
-
-/* -------------------------------------------------------------------------- */
-
-std::vector<Channel>& Channels::getAll()
-{
-	return m_channels;
-}
-
-const std::vector<Channel>& Channels::getAll() const
-{
-	return m_channels;
+	return makeUnique(m_channels.back());
 }
 
 /* -------------------------------------------------------------------------- */
 
 const std::size_t Channels::getIndex(ID id) const
 {
-	return utils::container::indexOf(m_channels, get(id));
+	const auto it = findIt(id);
+	assert(it != m_channels.end());
+	return it - m_channels.begin();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -95,7 +89,7 @@ const std::size_t Channels::getIndex(ID id) const
 const std::vector<ID> Channels::getAllIDs() const
 {
 	std::vector<ID> out;
-	for (const Channel& ch : m_channels)
+	for (const Channel& ch : getAll())
 		out.push_back(ch.id);
 	return out;
 }
@@ -104,7 +98,7 @@ const std::vector<ID> Channels::getAllIDs() const
 
 bool Channels::anyOf(std::function<bool(const Channel&)> f) const
 {
-	return std::any_of(m_channels.begin(), m_channels.end(), f);
+	return std::ranges::any_of(getAll(), f);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -115,7 +109,7 @@ void Channels::debug() const
 {
 	puts("model::channels");
 
-	for (int i = 0; const Channel& c : m_channels)
+	for (int i = 0; const Channel& c : getAll())
 	{
 		fmt::print("\t{} - {}\n", i++, c.debug());
 
@@ -135,9 +129,9 @@ void Channels::debug() const
 std::vector<Channel*> Channels::getIf(std::function<bool(const Channel&)> f)
 {
 	std::vector<Channel*> out;
-	for (Channel& ch : m_channels)
-		if (f(ch))
-			out.push_back(&ch);
+	for (std::shared_ptr<Channel>& ch : m_channels)
+		if (f(*ch))
+			out.push_back(&makeUnique(ch));
 	return out;
 }
 
@@ -145,21 +139,38 @@ std::vector<Channel*> Channels::getIf(std::function<bool(const Channel&)> f)
 
 void Channels::remove(ID id)
 {
-	utils::container::removeIf(m_channels, [id](const Channel& c)
-	{ return c.id == id; });
+	utils::container::removeIf(m_channels, [id](const std::shared_ptr<Channel>& c)
+	{ return c->id == id; });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Channels::add(Channel&& ch)
 {
-	m_channels.push_back(std::move(ch));
+	m_channels.push_back(std::make_shared<Channel>(std::move(ch)));
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Channels::add(Channel&& ch, std::size_t position)
 {
-	m_channels.insert(m_channels.begin() + std::min(position, m_channels.size()), std::move(ch));
+	m_channels.insert(m_channels.begin() + std::min(position, m_channels.size()), std::make_shared<Channel>(std::move(ch)));
+}
+
+/* -------------------------------------------------------------------------- */
+
+Channel& Channels::makeUnique(std::shared_ptr<Channel>& ch)
+{
+	if (ch.use_count() > 1)
+		ch = std::make_shared<Channel>(*ch);
+	return *ch;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<std::shared_ptr<Channel>>::const_iterator Channels::findIt(ID id) const
+{
+	return std::find_if(m_channels.begin(), m_channels.end(), [id](const std::shared_ptr<Channel>& c)
+	{ return c->id == id; });
 }
 } // namespace giada::m::model
@@ -29,17 +29,32 @@
 
 #include "src/core/channels/channel.h"
 #include "src/core/types.h"
+#include <memory>
+#include <ranges>
 
 namespace giada::m::model
 {
+/* Channels
+Channels are stored as reference-counted objects, shared by all the copies of
+this container (e.g. the ones made when the Document is swapped). A Channel is
+copied only when accessed through a non-const method while still shared. */
+
 class Channels
 {
 public:
-	const Channel&              get(ID) const;
-	const Channel*              find(ID) const;
-	const std::vector<Channel>& getAll() const;
-	const std::size_t           getIndex(ID) const;
-	const std::vector<ID>       getAllIDs() const;
+	const Channel&        get(ID) const;
+	const Channel*        find(ID) const;
+	const std::size_t     getIndex(ID) const;
+	const std::vector<ID> getAllIDs() const;
+
+	/* getAll (1)
+	Returns a read-only view of all channels. */
+
+	auto getAll() const
+	{
+		return m_channels | std::views::transform([](const std::shared_ptr<Channel>& ch) -> const Channel&
+		{ return *ch; });
+	}
 
 	/* anyOf
 	Returns true if any channel satisfies the callback 'f'. */
@@ -50,17 +65,34 @@ public:
 	void debug() const;
 #endif
 
+	/* getAll (2)
+	Returns a writable view of all channels. Each Channel is made unique as soon
+	as it's accessed: use the read-only version when possible. */
+
+	auto getAll()
+	{
+		return m_channels | std::views::transform([](std::shared_ptr<Channel>& ch) -> Channel&
+		{ return makeUnique(ch); });
+	}
+
 	Channel*              find(ID);
 	Channel&              get(ID);
 	Channel&              getLast();
-	std::vector<Channel>& getAll();
 	std::vector<Channel*> getIf(std::function<bool(const Channel&)> f);
 	void                  add(Channel&&);
 	void                  add(Channel&&, std::size_t position);
 	void                  remove(ID);
 
 private:
-	std::vector<Channel> m_channels;
+	/* makeUnique
+	Copies the Channel pointed by 'ch' if it's shared with other Channels
+	containers, then returns it. */
+
+	static Channel& makeUnique(std::shared_ptr<Channel>& ch);
+
+	std::vector<std::shared_ptr<Channel>>::const_iterator findIt(ID) const;
+
+	std::vector<std::shared_ptr<Channel>> m_channels;
 };
 } // namespace giada::m::model
 
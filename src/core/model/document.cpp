@@ -84,7 +84,16 @@ void Document::load(const Conf& conf)
 	kernelAudio.samplerate              = conf.samplerate;
 	kernelAudio.buffersize              = conf.buffersize;
 	kernelAudio.limitOutput             = conf.limitOutput;
+	kernelAudio.limiterMode             = conf.limiterMode;
 	kernelAudio.rsmpQuality             = conf.rsmpQuality;
+	kernelAudio.renderThreads           = conf.renderThreads;
+	kernelAudio.streamingThreshold      = conf.streamingThreshold;
+	kernelAudio.waveCacheSize           = conf.waveCacheSize;
+	kernelAudio.lazySampleLoading       = conf.lazySampleLoading;
+	kernelAudio.pitchCache              = conf.pitchCache;
+	kernelAudio.planarBuses             = conf.planarBuses;
+	kernelAudio.logXruns                = conf.logXruns;
+	kernelAudio.sandboxedPlugins        = conf.sandboxedPlugins;
 	kernelAudio.recTriggerLevel         = conf.recTriggerLevel;
 
 	kernelMidi.api         = conf.midiSystem;
@@ -138,18 +147,27 @@ void Document::store(Patch& patch) const
 
 void Document::store(Conf& conf) const
 {
-	conf.soundSystem      = kernelAudio.api;
-	conf.soundDeviceOut   = kernelAudio.deviceOut.id;
-	conf.channelsOutCount = kernelAudio.deviceOut.channelsCount;
-	conf.channelsOutStart = kernelAudio.deviceOut.channelsStart;
-	conf.soundDeviceIn    = kernelAudio.deviceIn.id;
-	conf.channelsInCount  = kernelAudio.deviceIn.channelsCount;
-	conf.channelsInStart  = kernelAudio.deviceIn.channelsStart;
-	conf.samplerate       = kernelAudio.samplerate;
-	conf.buffersize       = kernelAudio.buffersize;
-	conf.limitOutput      = kernelAudio.limitOutput;
-	conf.rsmpQuality      = kernelAudio.rsmpQuality;
-	conf.recTriggerLevel  = kernelAudio.recTriggerLevel;
+	conf.soundSystem        = kernelAudio.api;
+	conf.soundDeviceOut     = kernelAudio.deviceOut.id;
+	conf.channelsOutCount   = kernelAudio.deviceOut.channelsCount;
+	conf.channelsOutStart   = kernelAudio.deviceOut.channelsStart;
+	conf.soundDeviceIn      = kernelAudio.deviceIn.id;
+	conf.channelsInCount    = kernelAudio.deviceIn.channelsCount;
+	conf.channelsInStart    = kernelAudio.deviceIn.channelsStart;
+	conf.samplerate         = kernelAudio.samplerate;
+	conf.buffersize         = kernelAudio.buffersize;
+	conf.limitOutput        = kernelAudio.limitOutput;
+	conf.limiterMode        = kernelAudio.limiterMode;
+	conf.rsmpQuality        = kernelAudio.rsmpQuality;
+	conf.renderThreads      = kernelAudio.renderThreads;
+	conf.streamingThreshold = kernelAudio.streamingThreshold;
+	conf.waveCacheSize      = kernelAudio.waveCacheSize;
+	conf.lazySampleLoading  = kernelAudio.lazySampleLoading;
+	conf.pitchCache         = kernelAudio.pitchCache;
+	conf.planarBuses        = kernelAudio.planarBuses;
+	conf.logXruns           = kernelAudio.logXruns;
+	conf.sandboxedPlugins   = kernelAudio.sandboxedPlugins;
+	conf.recTriggerLevel    = kernelAudio.recTriggerLevel;
 
 	conf.midiSystem     = kernelMidi.api;
 	conf.midiDevicesOut = kernelMidi.devicesOut;
@@ -27,9 +27,12 @@
 #ifndef G_MODEL_KERNEL_AUDIO_H
 #define G_MODEL_KERNEL_AUDIO_H
 
+#include "src/core/limiter.h"
 #include "src/core/resampler.h"
 #include "src/core/types.h"
 #include "src/deps/rtaudio/RtAudio.h"
+#include <set>
+#include <string>
 
 namespace giada::m::model
 {
@@ -48,8 +51,57 @@ struct KernelAudio
 	unsigned int       samplerate      = G_DEFAULT_SAMPLERATE;
 	unsigned int       buffersize      = G_DEFAULT_BUFSIZE;
 	bool               limitOutput     = false;
+	Limiter::Mode      limiterMode     = Limiter::Mode::HARD;
 	Resampler::Quality rsmpQuality     = Resampler::Quality::LINEAR;
 	float              recTriggerLevel = 0.0f;
+
+	/* renderThreads
+	Number of helper threads for parallel track rendering. 0 = serial rendering
+	on the audio thread only. */
+
+	int renderThreads = 0;
+
+	/* streamingThreshold
+	Samples longer than this amount of seconds are streamed from disk instead
+	of being loaded in memory. 0 = always load samples in memory. */
+
+	int streamingThreshold = 0;
+
+	/* waveCacheSize
+	Max size of the on-disk cache of decoded samples, in MB. 0 = disabled. */
+
+	int waveCacheSize = G_DEFAULT_WAVE_CACHE_SIZE;
+
+	/* lazySampleLoading
+	If true, projects are opened before their samples are decoded: samples are
+	loaded in background afterwards, see WaveLoader. */
+
+	bool lazySampleLoading = true;
+
+	/* pitchCache
+	If true, samples whose pitch doesn't change for a while are pre-rendered at
+	that pitch, so that they can be played without resampling. See PitchCache. */
+
+	bool pitchCache = true;
+
+	/* planarBuses
+	If true, group and master buses are kept planar (non-interleaved) during
+	rendering, so that plug-in stacks work on them directly. Audio is
+	interleaved only once, when the master bus is summed to the device output. */
+
+	bool planarBuses = false;
+
+	/* logXruns
+	If true, the last audio callbacks are written to the log file whenever an
+	xrun occurs. See CallbackMonitor. */
+
+	bool logXruns = false;
+
+	/* sandboxedPlugins
+	JUCE ids of the plug-ins to be hosted in a separate sandbox process, so that
+	they can't take down the whole application. See SandboxedPlugin. */
+
+	std::set<std::string> sandboxedPlugins;
 };
 } // namespace giada::m::model
 
@@ -35,6 +35,7 @@
 #include "src/utils/string.h"
 #include <cassert>
 #include <memory>
+#include <utility>
 #if G_DEBUG_MODE
 #include <fmt/core.h>
 #endif
@@ -89,15 +90,18 @@ void Model::load(const Conf& conf)
 
 /* -------------------------------------------------------------------------- */
 
-LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality)
+LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality,
+    std::function<void(float)> progress)
 {
 	const float sampleRateRatio = sampleRate / static_cast<float>(patch.samplerate);
 
 	/* Lock the shared data. Real-time thread can't read from it until this method
 	goes out of scope. */
 
-	const SharedLock lock  = lockShared(SwapType::NONE);
-	const LoadState  state = m_shared.load(patch, pluginManager, get().sequencer, sampleRate, bufferSize, rsmpQuality);
+	const SharedLock lock      = lockShared(SwapType::NONE);
+	const int        threshold = get().kernelAudio.streamingThreshold;
+	const bool       lazy      = get().kernelAudio.lazySampleLoading;
+	const LoadState  state     = m_shared.load(patch, pluginManager, get().sequencer, sampleRate, bufferSize, rsmpQuality, threshold, lazy, progress);
 	get().load(patch, m_shared, sampleRateRatio);
 
 	return state;
@@ -116,6 +120,7 @@ void Model::store(Conf& conf) const
 
 void Model::store(Patch& patch, const std::string& projectPath)
 {
+	syncChannelsFromLanes();
 	get().store(patch);
 
 	/* Lock the shared data before storing it. Real-time thread can't read from
@@ -144,6 +149,22 @@ DocumentLock    Model::get_RT() const { return DocumentLock(m_swapper); }
 
 void Model::swap(SwapType t)
 {
+	syncChannelsFromLanes();
+
+	/* The render graph must be ready before the realtime thread gets the
+	Document: it can't be compiled in the middle of a swap. */
+
+	get().tracks.compileGraph();
+
+	/* Continuous controls write the realtime parameter lanes directly, but
+	anything else might have changed volume, pan or pitch too (e.g. loading a
+	project): keep lanes in line with the Document. Only the values changed in
+	the Document are synced: the other lanes might have been written by the MIDI
+	thread after syncChannelsFromLanes() above. */
+
+	for (const Channel* ch : std::as_const(get().tracks).getChannels())
+		ch->syncChangedLanes();
+
 	m_swapper.swap();
 	if (onSwap != nullptr)
 		onSwap(t);
@@ -151,6 +172,22 @@ void Model::swap(SwapType t)
 
 /* -------------------------------------------------------------------------- */
 
+void Model::syncChannelsFromLanes()
+{
+	/* Only channels with edited lanes are made unique in the Document: the
+	others stay shared with the previous one. */
+
+	for (const Channel* ch : std::as_const(get().tracks).getChannels())
+	{
+		if (!ch->shared->lanesEdited.load())
+			continue;
+		ch->shared->lanesEdited.store(false);
+		get().tracks.getChannel(ch->id).syncFromLanes();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
 SharedLock Model::lockShared(SwapType t)
 {
 	return SharedLock(*this, t);
@@ -46,6 +46,7 @@
 #include "src/deps/mcl-atomic-swapper/src/atomic-swapper.hpp"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/utils/vector.h"
+#include <functional>
 #include <memory>
 
 namespace giada::m::model
@@ -85,9 +86,11 @@ public:
 	void load(const Conf&);
 
 	/* load (2)
-	Loads data from a Patch object. */
+	Loads data from a Patch object. 'progress' reports the sample loading
+	progress, in [0.0, 1.0]. */
 
-	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality);
+	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality,
+	    std::function<void(float)> progress);
 
 	/* store
 	Stores data into a Conf object. */
@@ -157,6 +160,12 @@ public:
 	std::function<void(SwapType)> onSwap;
 
 private:
+	/* syncChannelsFromLanes
+	Copies back into the Document the continuous parameters changed by other
+	threads directly on the realtime parameter lanes. */
+
+	void syncChannelsFromLanes();
+
 	AtomicSwapper m_swapper;
 	Shared        m_shared;
 };
@@ -101,7 +101,8 @@ void Shared::init()
 
 /* -------------------------------------------------------------------------- */
 
-LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const Sequencer& sequencer, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality)
+LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const Sequencer& sequencer, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality,
+    int streamingThreshold, bool lazySampleLoading, std::function<void(float)> progress)
 {
 	init();
 
@@ -116,13 +117,31 @@ LoadState Shared::load(const Patch& patch, PluginManager& pluginManager, const S
 		getAllPlugins().push_back(std::move(p));
 	}
 
-	for (const Patch::Wave& pwave : patch.waves)
+	/* With lazy loading only the file headers are read here, while the audio
+	data is decoded later on in background (see WaveLoader). */
+
+	std::vector<std::unique_ptr<Wave>> waves;
+
+	if (lazySampleLoading)
+	{
+		for (std::size_t i = 0; i < patch.waves.size(); i++)
+		{
+			waves.push_back(waveFactory::deserializePendingWave(patch.waves[i], sampleRate));
+			if (progress != nullptr)
+				progress((i + 1) / static_cast<float>(patch.waves.size()));
+		}
+	}
+	else
+	{
+		waves = waveFactory::deserializeWaves(patch.waves, sampleRate, rsmpQuality, streamingThreshold, progress);
+	}
+
+	for (std::size_t i = 0; i < waves.size(); i++)
 	{
-		std::unique_ptr<Wave> w = waveFactory::deserializeWave(pwave, sampleRate, rsmpQuality);
-		if (w != nullptr)
-			getAllWaves().push_back(std::move(w));
+		if (waves[i] != nullptr)
+			getAllWaves().push_back(std::move(waves[i]));
 		else
-			state.missingWaves.push_back(pwave.path);
+			state.missingWaves.push_back(patch.waves[i].path);
 	}
 
 	for (const Patch::Channel& pchannel : patch.channels)
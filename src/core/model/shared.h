@@ -33,6 +33,7 @@
 #include "src/core/model/sequencer.h"
 #include "src/core/plugins/plugin.h"
 #include "src/core/wave.h"
+#include <functional>
 
 namespace giada::m
 {
@@ -52,9 +53,12 @@ public:
 	void init();
 
 	/* load
-	Loads shared data from a Patch object. */
+	Loads shared data from a Patch object. Samples are decoded in parallel, or
+	just created as pending Waves if 'lazySampleLoading' is true. 'progress' is
+	called with a value in [0.0, 1.0] as each sample is ready. */
 
-	LoadState load(const Patch&, PluginManager&, const Sequencer&, int sampleRate, int bufferSize, Resampler::Quality);
+	LoadState load(const Patch&, PluginManager&, const Sequencer&, int sampleRate, int bufferSize, Resampler::Quality,
+	    int streamingThreshold, bool lazySampleLoading, std::function<void(float)> progress);
 
 	/* store
 	Stores shared data into a Patch object. */
@@ -27,6 +27,7 @@
 #include "src/core/model/track.h"
 #include "src/core/types.h"
 #include <cassert>
+#include <utility>
 #if G_DEBUG_MODE
 #include <fmt/core.h>
 #endif
@@ -109,7 +110,9 @@ const Channel& Track::getGroupChannel() const
 
 Channel& Track::getGroupChannel()
 {
-	return const_cast<Channel&>(std::as_const(*this).getGroupChannel());
+	assert(std::as_const(*this).getGroupChannel().type == ChannelType::GROUP);
+
+	return m_channels.getAll()[0];
 }
 
 /* -------------------------------------------------------------------------- */
@@ -121,6 +124,17 @@ std::size_t Track::getNumChannels() const
 
 /* -------------------------------------------------------------------------- */
 
+std::vector<ID> Track::getChildrenIds() const
+{
+	std::vector<ID> out;
+	for (const Channel& ch : m_channels.getAll())
+		if (ch.type != ChannelType::GROUP)
+			out.push_back(ch.id);
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Track::addChannel(Channel&& ch)
 {
 	m_channels.add(std::move(ch));
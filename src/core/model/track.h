@@ -47,6 +47,12 @@ public:
 	const Channel&  getGroupChannel() const;
 	std::size_t     getNumChannels() const;
 
+	/* getChildrenIds
+	Returns the IDs of all non-group Channels in this Track. Iterate over these
+	instead of the Channels themselves when the model is swapped in the loop. */
+
+	std::vector<ID> getChildrenIds() const;
+
 	/* getIndex
 	Returns this Track index. */
 
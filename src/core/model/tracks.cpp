@@ -26,14 +26,93 @@
 
 #include "src/core/model/tracks.h"
 #include "src/deps/mcl-utils/src/container.hpp"
+#include <cassert>
+#include <utility>
 
 namespace utils = mcl::utils;
 
 namespace giada::m::model
 {
+Tracks::Tracks()
+: m_data(std::make_shared<Data>())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tracks::Tracks(const Tracks& o)
+: m_data(o.share())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tracks::Tracks(Tracks&& o)
+: m_data(o.share())
+{
+	o.m_data = std::make_shared<Data>();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tracks& Tracks::operator=(const Tracks& o)
+{
+	if (this == &o)
+		return *this;
+	m_data = o.share();
+	return *this;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tracks& Tracks::operator=(Tracks&& o)
+{
+	if (this == &o)
+		return *this;
+	m_data   = o.share();
+	o.m_data = std::make_shared<Data>();
+	return *this;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tracks::Data& Tracks::edit()
+{
+	if (m_data.use_count() > 1)
+		m_data = std::make_shared<Data>(*m_data);
+	m_data->dirty = true;
+	return *m_data;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::shared_ptr<Tracks::Data> Tracks::share() const
+{
+	compileGraph();
+	return m_data;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Tracks::compileGraph() const
+{
+	/* Data is dirty only if edit() has been called since the last compilation,
+	and edit() always leaves Data unshared: safe to recompile it in place. */
+
+	if (!m_data->dirty)
+		return;
+
+	assert(m_data.use_count() == 1);
+
+	m_data->graph.compile(m_data->tracks);
+	m_data->dirty = false;
+}
+
+/* -------------------------------------------------------------------------- */
+
 const std::vector<Track>& Tracks::getAll() const
 {
-	return m_tracks;
+	return m_data->tracks;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -47,56 +126,58 @@ Track& Tracks::add(Channel&& groupChannel, int width, bool internal)
 
 Track& Tracks::add(int width, bool internal)
 {
-	m_tracks.push_back({m_tracks.size(), width, internal});
-	return m_tracks.back();
+	std::vector<Track>& tracks = edit().tracks;
+	tracks.push_back({tracks.size(), width, internal});
+	return tracks.back();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Tracks::remove(std::size_t index)
 {
-	assert(index < m_tracks.size());
+	std::vector<Track>& tracks = edit().tracks;
 
-	m_tracks.erase(m_tracks.begin() + index);
+	assert(index < tracks.size());
 
-	for (const auto [newIndex, track] : utils::container::enumerate(m_tracks))
+	tracks.erase(tracks.begin() + index);
+
+	for (const auto [newIndex, track] : utils::container::enumerate(tracks))
 		track.m_index = newIndex;
 }
 
 /* -------------------------------------------------------------------------- */
 
+const Track& Tracks::get(std::size_t index) const
+{
+	assert(index < m_data->tracks.size());
+
+	return m_data->tracks[index];
+}
+
 Track& Tracks::get(std::size_t index)
 {
-	assert(index < m_tracks.size());
+	assert(index < m_data->tracks.size());
 
-	return m_tracks[index];
+	return edit().tracks[index];
 }
 
 /* -------------------------------------------------------------------------- */
 
 const Channel& Tracks::getChannel(ID channelId) const
 {
-	const Channel* out = nullptr;
-	for (const Track& track : m_tracks)
-	{
-		out = track.findChannel(channelId);
-		if (out != nullptr)
-			break;
-	}
-	assert(out != nullptr);
-	return *out;
+	return getByChannel(channelId).getChannels().get(channelId);
 }
 
 Channel& Tracks::getChannel(ID channelId)
 {
-	return const_cast<Channel&>(std::as_const(*this).getChannel(channelId));
+	return getByChannel(channelId).getChannels().get(channelId);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Tracks::forEachChannel(std::function<bool(Channel&)> f)
 {
-	for (Track& track : m_tracks)
+	for (Track& track : edit().tracks)
 		for (Channel& channel : track.getChannels().getAll())
 			if (!f(channel))
 				return;
@@ -107,7 +188,7 @@ void Tracks::forEachChannel(std::function<bool(Channel&)> f)
 std::vector<Channel*> Tracks::getChannelsIf(std::function<bool(const Channel&)> f)
 {
 	std::vector<Channel*> out;
-	for (Track& track : m_tracks)
+	for (Track& track : edit().tracks)
 	{
 		const std::vector<Channel*> tmp = track.getChannels().getIf(f);
 		out.insert(out.end(), tmp.begin(), tmp.end());
@@ -119,7 +200,7 @@ std::vector<Channel*> Tracks::getChannelsIf(std::function<bool(const Channel&)>
 
 bool Tracks::anyChannelOf(std::function<bool(const Channel&)> f) const
 {
-	for (const Track& track : m_tracks)
+	for (const Track& track : m_data->tracks)
 		if (track.getChannels().anyOf(f))
 			return true;
 	return false;
@@ -130,7 +211,7 @@ bool Tracks::anyChannelOf(std::function<bool(const Channel&)> f) const
 std::vector<const Channel*> Tracks::getChannels() const
 {
 	std::vector<const Channel*> out;
-	for (const Track& track : m_tracks)
+	for (const Track& track : m_data->tracks)
 		for (const Channel& channel : track.getChannels().getAll())
 			out.push_back(&channel);
 	return out;
@@ -138,11 +219,20 @@ std::vector<const Channel*> Tracks::getChannels() const
 
 /* -------------------------------------------------------------------------- */
 
+const rendering::Graph& Tracks::getGraph() const
+{
+	assert(!m_data->dirty);
+
+	return m_data->graph;
+}
+
+/* -------------------------------------------------------------------------- */
+
 #if G_DEBUG_MODE
 
 void Tracks::debug() const
 {
-	for (const Track& track : m_tracks)
+	for (const Track& track : m_data->tracks)
 		track.debug();
 }
 
@@ -150,34 +240,39 @@ void Tracks::debug() const
 
 /* -------------------------------------------------------------------------- */
 
-Track& Tracks::getByChannel(ID channelId)
+const Track& Tracks::getByChannel(ID channelId) const
 {
-	const auto p = [channelId](Track& track)
+	const auto p = [channelId](const Track& track)
 	{
-		return utils::container::hasIf(track.getChannels().getAll(), [channelId](const Channel& ch)
+		return track.getChannels().anyOf([channelId](const Channel& ch)
 		{ return channelId == ch.id; });
 	};
-	auto it = utils::container::findIf(m_tracks, p);
-	assert(it != m_tracks.end());
+	auto it = utils::container::findIf(m_data->tracks, p);
+	assert(it != m_data->tracks.end());
 	return *it;
 }
 
+Track& Tracks::getByChannel(ID channelId)
+{
+	return get(std::as_const(*this).getByChannel(channelId).getIndex());
+}
+
 /* -------------------------------------------------------------------------- */
 
 void Tracks::addChannel(Channel&& channel, std::size_t trackIndex)
 {
 	assert(channel.type != ChannelType::GROUP);
-	assert(trackIndex <= m_tracks.size());
+	assert(trackIndex <= m_data->tracks.size());
 
-	m_tracks[trackIndex].addChannel(std::move(channel));
+	edit().tracks[trackIndex].addChannel(std::move(channel));
 }
 
 void Tracks::addChannel(Channel&& channel, std::size_t trackIndex, std::size_t position)
 {
 	assert(channel.type != ChannelType::GROUP);
-	assert(trackIndex <= m_tracks.size());
+	assert(trackIndex <= m_data->tracks.size());
 
-	m_tracks[trackIndex].addChannel(std::move(channel), position);
+	edit().tracks[trackIndex].addChannel(std::move(channel), position);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -191,8 +286,8 @@ void Tracks::removeChannel(ID channelId)
 
 Channel& Tracks::getLastChannel(std::size_t trackIndex)
 {
-	assert(trackIndex <= m_tracks.size());
+	assert(trackIndex <= m_data->tracks.size());
 
-	return m_tracks[trackIndex].getLastChannel();
+	return edit().tracks[trackIndex].getLastChannel();
 }
 } // namespace giada::m::model
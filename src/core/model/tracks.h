@@ -28,6 +28,8 @@
 #define G_MODEL_TRACKS_H
 
 #include "src/core/model/track.h"
+#include "src/core/rendering/graph.h"
+#include <memory>
 
 namespace giada::m
 {
@@ -36,14 +38,48 @@ class Channel;
 
 namespace giada::m::model
 {
+/* Tracks
+Tracks are stored in a reference-counted Data object, shared by all the copies
+of this container. Copying Tracks (e.g. when the Document is swapped) is then
+cheap: Data is copied only when accessed through a non-const method while still
+shared, and so are the Channels inside it, one by one (see model::Channels). */
+
 class Tracks
 {
 public:
+	Tracks();
+
+	/* Tracks (copy, move)
+	The render graph is recompiled before sharing Data with another Tracks
+	object if it has been altered, so that it always refers to the Channels
+	owned by Data. This is what happens when the Document is swapped and handed
+	over to the realtime thread. */
+
+	Tracks(const Tracks&);
+	Tracks(Tracks&&);
+	Tracks& operator=(const Tracks&);
+	Tracks& operator=(Tracks&&);
+
 	const std::vector<Track>&   getAll() const;
+	const Track&                get(std::size_t index) const;
 	const Channel&              getChannel(ID) const;
+	const Track&                getByChannel(ID) const;
 	bool                        anyChannelOf(std::function<bool(const Channel&)> f) const;
 	std::vector<const Channel*> getChannels() const;
 
+	/* getGraph
+	Returns the render graph compiled from these Tracks. Only valid on Tracks
+	that have not been altered since the last copy (e.g. the realtime Document). */
+
+	const rendering::Graph& getGraph() const;
+
+	/* compileGraph
+	Recompiles the render graph, if Tracks have been altered since the last
+	compilation. The graph is a cache derived from the Tracks, hence the const.
+	Must be called before these Tracks become visible to the realtime thread. */
+
+	void compileGraph() const;
+
 #if G_DEBUG_MODE
 	void debug() const;
 #endif
@@ -70,7 +106,30 @@ public:
 	std::vector<Channel*> getChannelsIf(std::function<bool(const Channel&)>);
 
 private:
-	std::vector<Track> m_tracks;
+	struct Data
+	{
+		std::vector<Track> tracks;
+		rendering::Graph   graph;
+
+		/* dirty
+		True if 'tracks' might have been altered since the last graph
+		compilation. */
+
+		bool dirty = true;
+	};
+
+	/* edit
+	Returns Data for writing, copying it first if shared with other Tracks. */
+
+	Data& edit();
+
+	/* share
+	Returns Data ready to be shared with another Tracks object, i.e. with an
+	up-to-date render graph. */
+
+	std::shared_ptr<Data> share() const;
+
+	std::shared_ptr<Data> m_data;
 };
 } // namespace giada::m::model
 
@@ -0,0 +1,74 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/paramLane.h"
+
+namespace giada::m
+{
+bool ParamLane::Ramp::isFlat() const
+{
+	return from == to;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+ParamLane::ParamLane(float value)
+: m_target(value)
+, m_ramp({value, value})
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+float ParamLane::get() const
+{
+	return m_target.load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+ParamLane::Ramp ParamLane::getRamp() const
+{
+	return m_ramp;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ParamLane::set(float value)
+{
+	m_target.store(value, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ParamLane::advance()
+{
+	m_ramp = {m_ramp.to, m_target.load(std::memory_order_relaxed)};
+}
+} // namespace giada::m
@@ -0,0 +1,84 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_PARAM_LANE_H
+#define G_PARAM_LANE_H
+
+#include <atomic>
+
+namespace giada::m
+{
+/* ParamLane
+Lock-free slot for a continuous parameter (volume, pan, pitch, ...). Any thread
+can set the target value at any time without swapping the model; the realtime
+thread moves towards it once per block, producing a linear ramp to apply across
+the block instead of a sudden step. */
+
+class ParamLane final
+{
+public:
+	struct Ramp
+	{
+		bool isFlat() const;
+
+		float from;
+		float to;
+	};
+
+	ParamLane(float value = 0.0f);
+
+	/* get
+	Returns the target value. */
+
+	float get() const;
+
+	/* getRamp
+	Returns the ramp computed by the last call to advance(). Realtime thread
+	only. */
+
+	Ramp getRamp() const;
+
+	/* set
+	Sets a new target value, reached by the realtime thread over the next
+	block. Safe to call from any thread. */
+
+	void set(float);
+
+	/* advance
+	Computes the ramp for the next block, from the value reached at the end of
+	the previous one to the current target. Realtime thread only, once per
+	block. */
+
+	void advance();
+
+private:
+	std::atomic<float> m_target;
+	Ramp               m_ramp;
+};
+} // namespace giada::m
+
+#endif
@@ -121,6 +121,9 @@ struct Patch
 		uint32_t    event = 0;
 		ID          prevId;
 		ID          nextId;
+		ID          pluginId;
+		int         pluginParam = -1;
+		float       value       = -1.0f; // High-resolution velocity, -1 if missing (older patches)
 	};
 
 	struct Wave
@@ -109,6 +109,9 @@ constexpr auto G_PATCH_KEY_ACTION_FRAME               = "frame";
 constexpr auto G_PATCH_KEY_ACTION_EVENT               = "event";
 constexpr auto G_PATCH_KEY_ACTION_PREV                = "prev";
 constexpr auto G_PATCH_KEY_ACTION_NEXT                = "next";
+constexpr auto G_PATCH_KEY_ACTION_PLUGIN              = "plugin";
+constexpr auto G_PATCH_KEY_ACTION_PLUGIN_PARAM        = "plugin_param";
+constexpr auto G_PATCH_KEY_ACTION_VALUE               = "value";
 
 /* -------------------------------------------------------------------------- */
 
@@ -197,13 +200,16 @@ void readActions_(Patch& patch, const nlohmann::json& j)
 	for (const auto& jaction : j[PATCH_KEY_ACTIONS])
 	{
 		Patch::Action a;
-		a.id        = jaction.value(G_PATCH_KEY_ACTION_ID, ++id);
-		a.channelId = jaction.value(G_PATCH_KEY_ACTION_CHANNEL, ID{});
-		a.scene     = jaction.value(G_PATCH_KEY_ACTION_SCENE, 0);
-		a.frame     = jaction.value(G_PATCH_KEY_ACTION_FRAME, 0);
-		a.event     = jaction.value(G_PATCH_KEY_ACTION_EVENT, 0);
-		a.prevId    = jaction.value(G_PATCH_KEY_ACTION_PREV, ID{});
-		a.nextId    = jaction.value(G_PATCH_KEY_ACTION_NEXT, ID{});
+		a.id          = jaction.value(G_PATCH_KEY_ACTION_ID, ++id);
+		a.channelId   = jaction.value(G_PATCH_KEY_ACTION_CHANNEL, ID{});
+		a.scene       = jaction.value(G_PATCH_KEY_ACTION_SCENE, 0);
+		a.frame       = jaction.value(G_PATCH_KEY_ACTION_FRAME, 0);
+		a.event       = jaction.value(G_PATCH_KEY_ACTION_EVENT, 0);
+		a.prevId      = jaction.value(G_PATCH_KEY_ACTION_PREV, ID{});
+		a.nextId      = jaction.value(G_PATCH_KEY_ACTION_NEXT, ID{});
+		a.pluginId    = jaction.value(G_PATCH_KEY_ACTION_PLUGIN, ID{});
+		a.pluginParam = jaction.value(G_PATCH_KEY_ACTION_PLUGIN_PARAM, -1);
+		a.value       = jaction.value(G_PATCH_KEY_ACTION_VALUE, -1.0f);
 		patch.actions.push_back(a);
 	}
 }
@@ -322,13 +328,16 @@ void writeActions_(const Patch& patch, nlohmann::json& j)
 	for (const Patch::Action& a : patch.actions)
 	{
 		nlohmann::json jaction;
-		jaction[G_PATCH_KEY_ACTION_ID]      = a.id;
-		jaction[G_PATCH_KEY_ACTION_CHANNEL] = a.channelId;
-		jaction[G_PATCH_KEY_ACTION_SCENE]   = a.scene;
-		jaction[G_PATCH_KEY_ACTION_FRAME]   = a.frame;
-		jaction[G_PATCH_KEY_ACTION_EVENT]   = a.event;
-		jaction[G_PATCH_KEY_ACTION_PREV]    = a.prevId;
-		jaction[G_PATCH_KEY_ACTION_NEXT]    = a.nextId;
+		jaction[G_PATCH_KEY_ACTION_ID]           = a.id;
+		jaction[G_PATCH_KEY_ACTION_CHANNEL]      = a.channelId;
+		jaction[G_PATCH_KEY_ACTION_SCENE]        = a.scene;
+		jaction[G_PATCH_KEY_ACTION_FRAME]        = a.frame;
+		jaction[G_PATCH_KEY_ACTION_EVENT]        = a.event;
+		jaction[G_PATCH_KEY_ACTION_PREV]         = a.prevId;
+		jaction[G_PATCH_KEY_ACTION_NEXT]         = a.nextId;
+		jaction[G_PATCH_KEY_ACTION_PLUGIN]       = a.pluginId;
+		jaction[G_PATCH_KEY_ACTION_PLUGIN_PARAM] = a.pluginParam;
+		jaction[G_PATCH_KEY_ACTION_VALUE]        = a.value;
 		j[PATCH_KEY_ACTIONS].push_back(jaction);
 	}
 }
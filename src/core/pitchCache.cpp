@@ -0,0 +1,400 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/pitchCache.h"
+#include "src/core/const.h"
+#include "src/core/model/model.h"
+#include "src/core/wave.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace giada::m
+{
+namespace
+{
+/* getCopySize_
+Returns the memory taken by the pre-rendered copy held by channel 'ch', if
+any. */
+
+std::size_t getCopySize_(const Channel& ch)
+{
+	const Wave* wave = ch.shared->pitchedWave.wave.get();
+	if (wave == nullptr)
+		return 0;
+	return static_cast<std::size_t>(wave->getBuffer().countFrames()) * wave->getBuffer().countChannels() * sizeof(float);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+PitchCache::PitchCache(model::Model& m)
+: m_model(m)
+, m_busy(false)
+, m_stop(false)
+, m_thread([this]()
+	{ workerLoop(); })
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+PitchCache::~PitchCache()
+{
+	{
+		std::scoped_lock lock(m_queueMutex);
+		m_stop = true;
+	}
+	m_queueCond.notify_all();
+	m_thread.join();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PitchCache::update(Scene scene)
+{
+	std::scoped_lock lock(m_mutex);
+
+	const model::Document& document = m_model.get();
+
+	if (!document.kernelAudio.pitchCache)
+	{
+		cancel();
+		m_states.clear();
+		drop([](const Channel&)
+		{ return true; });
+		return;
+	}
+
+	apply(scene);
+
+	/* Track how long each channel has been playing the same Wave at the same
+	pitch. Channels no longer around are forgotten. */
+
+	const auto now   = std::chrono::steady_clock::now();
+	const auto delay = std::chrono::milliseconds(G_PITCH_CACHE_DELAY_MS);
+
+	std::unordered_map<ID, State> states;
+	std::vector<const Channel*>   candidates;
+
+	for (const Channel* ch : std::as_const(document.tracks).getChannels())
+	{
+		const std::optional<Key> key = getKey(*ch, scene);
+		if (!key)
+			continue;
+
+		const auto  it    = m_states.find(ch->id);
+		const State state = it != m_states.end() && it->second.key == *key ? it->second : State{*key, now};
+
+		states[ch->id] = state;
+
+		if (!state.evicted && !m_pending.contains(ch->id) && ch->shared->pitchedWave.wave == nullptr && now - state.since >= delay)
+			candidates.push_back(ch);
+	}
+
+	m_states = std::move(states);
+
+	/* Drop the copies that no longer match what channels are playing, and the
+	queued jobs that would render such copies. */
+
+	drop([this](const Channel& ch)
+	{
+		const auto it = m_states.find(ch.id);
+		return it == m_states.end() || !hasCopy(ch, it->second.key);
+	});
+
+	{
+		std::scoped_lock queueLock(m_queueMutex);
+		std::erase_if(m_queue, [this](const std::unique_ptr<Job>& job)
+		{
+			const auto it = m_states.find(job->channelId);
+			if (it != m_states.end() && it->second.key == job->key)
+				return false;
+			m_pending.erase(job->channelId);
+			return true;
+		});
+	}
+
+	std::erase_if(m_applied, [this](ID id)
+	{ return !m_states.contains(id); });
+
+	/* Queue the new jobs, as long as their results fit into the memory budget. */
+
+	for (const Channel* ch : candidates)
+	{
+		const Key         key  = m_states.at(ch->id).key;
+		const Wave&       wave = *ch->sampleChannel->getWave(scene);
+		const std::size_t size = getSize(wave, key.pitch);
+
+		if (!evict(size))
+			continue;
+
+		m_pending[ch->id] = size;
+		{
+			std::scoped_lock queueLock(m_queueMutex);
+			m_queue.push_back(std::make_unique<Job>(Job{ch->id, key, getSource(wave, key.waveRevision), nullptr}));
+		}
+		m_queueCond.notify_one();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PitchCache::clear()
+{
+	std::scoped_lock lock(m_mutex);
+
+	cancel();
+	m_states.clear();
+	drop([](const Channel&)
+	{ return true; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::optional<PitchCache::Key> PitchCache::getKey(const Channel& ch, Scene scene) const
+{
+	if (ch.type != ChannelType::SAMPLE)
+		return {};
+
+	/* Pitch from the lane, not from the Channel: that's what the audio thread
+	plays and compares pre-rendered copies against. Continuous controls from
+	other threads reach the Channel only on the next model swap. */
+
+	const Wave* wave  = ch.sampleChannel->getWave(scene);
+	const float pitch = ch.shared->pitch[scene.getIndex()].get();
+
+	/* Streamed and pending Waves are not in memory, and would take too much of it
+	anyway. */
+
+	if (wave == nullptr || pitch == 1.0f || wave->isStreamed() || wave->isPending() ||
+	    wave->getBuffer().countChannels() != G_MAX_IO_CHANS)
+		return {};
+
+	return Key{wave->id, wave->getRevision(), pitch, m_model.get().kernelAudio.rsmpQuality};
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool PitchCache::hasCopy(const Channel& ch, const Key& key)
+{
+	const ChannelShared::PitchedWave& pitched = ch.shared->pitchedWave;
+
+	return pitched.wave != nullptr && pitched.sourceId == key.waveId && pitched.sourceRevision == key.waveRevision &&
+	       pitched.pitch == key.pitch && pitched.quality == key.quality;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t PitchCache::getSize(const Wave& wave, float pitch)
+{
+	const Frame frames = static_cast<Frame>(std::ceil(wave.getBuffer().countFrames() / static_cast<double>(pitch)));
+	return static_cast<std::size_t>(frames) * G_MAX_IO_CHANS * sizeof(float);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PitchCache::render(Job& job)
+{
+	const Wave& source = *job.source;
+	const Frame frames = static_cast<Frame>(std::ceil(source.getBuffer().countFrames() / static_cast<double>(job.key.pitch)));
+
+	job.result = std::make_unique<Wave>(source.id);
+	job.result->alloc(frames, G_MAX_IO_CHANS, source.getRate(), source.getBits(), source.getPath());
+
+	/* Same resampler used for live playback, so that switching between the two
+	goes unnoticed. */
+
+	Resampler resampler(job.key.quality, G_MAX_IO_CHANS);
+	resampler.process(source.getBuffer()[0], 0, source.getBuffer().countFrames(),
+	    job.result->getBuffer()[0], frames, job.key.pitch);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::shared_ptr<const Wave> PitchCache::getSource(const Wave& wave, int revision)
+{
+	std::erase_if(m_sources, [](const auto& pair)
+	{ return pair.second.wave.expired(); });
+
+	/* Render from a snapshot of the Wave, as the original one might be edited
+	in the meantime. The snapshot is shared by the jobs rendering the same
+	revision and goes away with the last of them. */
+
+	if (const auto it = m_sources.find(wave.id); it != m_sources.end() && it->second.waveRevision == revision)
+		if (std::shared_ptr<const Wave> source = it->second.wave.lock(); source != nullptr)
+			return source;
+
+	auto source         = std::make_shared<const Wave>(wave);
+	m_sources[wave.id] = {revision, source};
+	return source;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PitchCache::apply(Scene scene)
+{
+	std::vector<std::unique_ptr<Job>> done;
+	{
+		std::scoped_lock queueLock(m_queueMutex);
+		done = std::move(m_done);
+		m_done.clear();
+	}
+
+	for (const std::unique_ptr<Job>& job : done)
+	{
+		m_pending.erase(job->channelId);
+
+		/* Things might have changed while rendering: apply only if the channel is
+		still playing the same Wave at the same pitch. */
+
+		const Channel* ch = nullptr;
+		for (const Channel* c : std::as_const(m_model.get().tracks).getChannels())
+			if (c->id == job->channelId)
+				ch = c;
+
+		if (ch == nullptr)
+			continue;
+
+		const std::optional<Key> key = getKey(*ch, scene);
+		if (!key || *key != job->key)
+			continue;
+
+		u::log::print("[PitchCache::apply] Wave {} pre-rendered at pitch {}\n", job->result->getPath(), job->key.pitch);
+
+		model::SharedLock lock = m_model.lockShared(model::SwapType::NONE);
+
+		ch->shared->pitchedWave = {std::move(job->result), key->waveId, key->waveRevision, key->pitch, key->quality};
+		ch->shared->pitchedReset.store(true);
+
+		std::erase(m_applied, ch->id);
+		m_applied.push_back(ch->id);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PitchCache::drop(std::function<bool(const Channel&)> f)
+{
+	std::vector<ChannelShared*> shared;
+	for (const Channel* ch : std::as_const(m_model.get().tracks).getChannels())
+	{
+		if (ch->shared->pitchedWave.wave == nullptr || !f(*ch))
+			continue;
+		shared.push_back(ch->shared);
+		std::erase(m_applied, ch->id);
+	}
+
+	if (shared.empty())
+		return;
+
+	model::SharedLock lock = m_model.lockShared(model::SwapType::NONE);
+
+	for (ChannelShared* s : shared)
+		s->pitchedWave = {};
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool PitchCache::evict(std::size_t bytes)
+{
+	if (bytes > G_PITCH_CACHE_MAX_BYTES)
+		return false;
+
+	std::size_t used = 0;
+	for (const auto& [id, size] : m_pending)
+		used += size;
+	for (const Channel* ch : std::as_const(m_model.get().tracks).getChannels())
+		used += getCopySize_(*ch);
+
+	while (used + bytes > G_PITCH_CACHE_MAX_BYTES && !m_applied.empty())
+	{
+		const ID id = m_applied.front();
+
+		for (const Channel* ch : std::as_const(m_model.get().tracks).getChannels())
+			if (ch->id == id)
+				used -= getCopySize_(*ch);
+
+		if (const auto it = m_states.find(id); it != m_states.end())
+			it->second.evicted = true;
+
+		drop([id](const Channel& ch)
+		{ return ch.id == id; });
+		std::erase(m_applied, id); // In case the channel had no copy anymore
+	}
+
+	return used + bytes <= G_PITCH_CACHE_MAX_BYTES;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PitchCache::cancel()
+{
+	std::unique_lock queueLock(m_queueMutex);
+
+	m_queue.clear();
+	m_queueCond.wait(queueLock, [this]()
+	{ return !m_busy; });
+	m_done.clear();
+
+	m_pending.clear();
+	m_sources.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PitchCache::workerLoop()
+{
+	std::unique_lock lock(m_queueMutex);
+
+	while (true)
+	{
+		m_queueCond.wait(lock, [this]()
+		{ return m_stop || !m_queue.empty(); });
+
+		if (m_stop)
+			return;
+
+		std::unique_ptr<Job> job = std::move(m_queue.front());
+		m_queue.pop_front();
+		m_busy = true;
+
+		lock.unlock();
+		render(*job);
+		job->source.reset(); // Release the snapshot as soon as possible
+		lock.lock();
+
+		m_busy = false;
+		m_done.push_back(std::move(job));
+		m_queueCond.notify_all();
+	}
+}
+} // namespace giada::m
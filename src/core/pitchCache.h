@@ -0,0 +1,220 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_PITCH_CACHE_H
+#define G_PITCH_CACHE_H
+
+#include "src/core/resampler.h"
+#include "src/scene.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace giada::m::model
+{
+class Model;
+}
+
+namespace giada::m
+{
+class Channel;
+class Wave;
+
+/* PitchCache
+Pre-renders in background the Waves of sample channels whose pitch has not
+changed for a while (G_PITCH_CACHE_DELAY_MS). Such channels then play the
+pre-rendered copy, with no live resampling. Pre-rendered copies are dropped as
+soon as pitch, Wave or scene change, and the least recently rendered ones are
+evicted to stay within G_PITCH_CACHE_MAX_BYTES. Rendering happens on a single
+worker thread that processes a queue of jobs. */
+
+class PitchCache final
+{
+public:
+	PitchCache(model::Model&);
+	~PitchCache();
+
+	/* update
+	Looks for channels to pre-render in 'scene', applies the copies rendered so
+	far and drops the outdated ones. Call this periodically, from a thread that
+	is allowed to alter the model. */
+
+	void update(Scene);
+
+	/* clear
+	Drops all pre-rendered copies and pending jobs. Blocks until the one being
+	rendered, if any, is done. */
+
+	void clear();
+
+private:
+	/* Key
+	What a pre-rendered copy depends on. */
+
+	struct Key
+	{
+		bool operator==(const Key&) const = default;
+
+		ID                 waveId;
+		int                waveRevision = 0;
+		float              pitch        = 0.0f;
+		Resampler::Quality quality      = Resampler::Quality::LINEAR;
+	};
+
+	/* State
+	Last Key seen for a channel, and since when. 'evicted' tells that its copy
+	has been evicted to make room for others: it won't be rendered again until
+	the Key changes. */
+
+	struct State
+	{
+		Key                                   key;
+		std::chrono::steady_clock::time_point since;
+		bool                                  evicted = false;
+	};
+
+	/* Source
+	Read-only snapshot of a Wave, shared by all the jobs that render the same
+	Wave revision (e.g. several channels, or several pitches). */
+
+	struct Source
+	{
+		int                       waveRevision = 0;
+		std::weak_ptr<const Wave> wave;
+	};
+
+	/* Job
+	A pre-rendering job for a single channel. */
+
+	struct Job
+	{
+		ID                          channelId;
+		Key                         key;
+		std::shared_ptr<const Wave> source;
+		std::unique_ptr<Wave>       result;
+	};
+
+	/* getKey
+	Returns the Key for what channel 'ch' plays in 'scene', or nothing if it
+	can't be pre-rendered. */
+
+	std::optional<Key> getKey(const Channel& ch, Scene) const;
+
+	/* hasCopy
+	True if channel 'ch' holds a pre-rendered copy made for 'key'. */
+
+	static bool hasCopy(const Channel& ch, const Key& key);
+
+	/* getSize
+	Returns the memory taken by a copy of 'wave' pre-rendered at 'pitch'. */
+
+	static std::size_t getSize(const Wave& wave, float pitch);
+
+	/* render
+	Renders the source Wave of 'job' at the requested pitch. Runs on the worker
+	thread. */
+
+	static void render(Job& job);
+
+	/* getSource
+	Returns the shared snapshot of 'wave', making a new one if no job is using
+	the current revision. */
+
+	std::shared_ptr<const Wave> getSource(const Wave& wave, int revision);
+
+	/* apply
+	Moves the results of the jobs done so far, if still up to date, into their
+	channels. */
+
+	void apply(Scene);
+
+	/* drop
+	Drops the pre-rendered copies of the channels that match 'f'. */
+
+	void drop(std::function<bool(const Channel&)> f);
+
+	/* evict
+	Drops the least recently rendered copies until 'bytes' more fit into the
+	memory budget. Returns false if they can't fit anyway. */
+
+	bool evict(std::size_t bytes);
+
+	/* cancel
+	Removes all pending jobs and results. Waits for the job being rendered, if
+	any. */
+
+	void cancel();
+
+	/* workerLoop
+	Body of the worker thread: renders jobs from the queue until stopped. */
+
+	void workerLoop();
+
+	model::Model& m_model;
+
+	std::unordered_map<ID, State>  m_states;
+	std::unordered_map<ID, Source> m_sources;
+
+	/* m_applied
+	Channels holding a pre-rendered copy, oldest first. */
+
+	std::vector<ID> m_applied;
+
+	/* m_pending
+	Channels with a job either queued, running or done but not applied yet,
+	with the memory their result is going to take. */
+
+	std::unordered_map<ID, std::size_t> m_pending;
+
+	/* m_mutex
+	Serializes update() and clear(). */
+
+	std::mutex m_mutex;
+
+	/* m_queue, m_done, m_busy, m_stop
+	Shared with the worker thread, guarded by m_queueMutex. */
+
+	std::deque<std::unique_ptr<Job>>  m_queue;
+	std::vector<std::unique_ptr<Job>> m_done;
+	bool                              m_busy;
+	bool                              m_stop;
+	std::mutex                        m_queueMutex;
+	std::condition_variable           m_queueCond;
+
+	std::thread m_thread;
+};
+} // namespace giada::m
+
+#endif
@@ -25,10 +25,14 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/plugins/plugin.h"
+#include "src/core/const.h"
 #include "src/utils/log.h"
 #include "src/utils/time.h"
 #include <FL/Fl.H>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <memory>
 
 #if G_OS_WINDOWS
@@ -38,11 +42,41 @@
 
 namespace giada::m
 {
+namespace
+{
+/* countHeldNotes_
+Updates the number of notes held down with the events in 'midi'. */
+
+int countHeldNotes_(int heldNotes, const juce::MidiBuffer& midi)
+{
+	for (const juce::MidiMessageMetadata m : midi)
+	{
+		const juce::MidiMessage msg = m.getMessage();
+		if (msg.isNoteOn())
+			heldNotes++;
+		else if (msg.isNoteOff())
+			heldNotes = std::max(0, heldNotes - 1);
+		else if (msg.isAllNotesOff() || msg.isAllSoundOff())
+			heldNotes = 0;
+	}
+	return heldNotes;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Plugin::Plugin(ID id, const std::string& juceId)
 : id(id)
 , valid(false)
 , onEditorResize(nullptr)
 , m_plugin(nullptr)
+, m_silentFrames(0)
+, m_sleepAfter(0)
+, m_heldNotes(0)
+, m_processedBlocks(0)
+, m_skippedBlocks(0)
 , m_juceId(juceId)
 , m_hasEditor(false)
 {
@@ -58,6 +92,11 @@ Plugin::Plugin(ID id, const std::string& juceId, std::unique_ptr<juce::AudioPlug
 , m_plugin(std::move(plugin))
 , m_playHead(std::move(playHead))
 , m_bypass(false)
+, m_silentFrames(0)
+, m_sleepAfter(0)
+, m_heldNotes(0)
+, m_processedBlocks(0)
+, m_skippedBlocks(0)
 , m_juceId(juceId)
 , m_hasEditor(m_plugin->hasEditor())
 {
@@ -68,8 +107,6 @@ Plugin::Plugin(ID id, const std::string& juceId, std::unique_ptr<juce::AudioPlug
 	for (int i = 0; i < m_plugin->getParameters().size(); i++)
 		midiInParams.emplace_back(0x0, i);
 
-	m_buffer.setSize(G_MAX_IO_CHANS, buffersize);
-
 	/* Try to set the main bus to the current number of channels. In the future
 	this setup will be performed manually through a proper channel matrix. */
 
@@ -136,6 +173,15 @@ int Plugin::countMainOutChannels() const
 
 /* -------------------------------------------------------------------------- */
 
+int Plugin::getLatency() const
+{
+	if (!valid)
+		return 0;
+	return m_plugin->getLatencySamples();
+}
+
+/* -------------------------------------------------------------------------- */
+
 juce::AudioProcessorEditor* Plugin::createEditor() const
 {
 	juce::AudioProcessorEditor* e = m_plugin->createEditorIfNeeded();
@@ -217,15 +263,57 @@ void Plugin::setBypass(bool b) { m_bypass.store(b); }
 
 /* -------------------------------------------------------------------------- */
 
-const Plugin::Buffer& Plugin::process(const Plugin::Buffer& out, juce::MidiBuffer m)
+void Plugin::process(Plugin::Buffer& b, juce::MidiBuffer& m)
+{
+	m_plugin->processBlock(b, m);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Plugin::canSleep(const Buffer& b, const juce::MidiBuffer& m)
 {
-	/* Copy the incoming buffer data into the temporary one. This way FXes will
-	process	existing audio data on the private buffer. This is needed later on
-	when merging it back into the incoming buffer. */
+	const int numFrames = b.getNumSamples();
+
+	m_heldNotes = countHeldNotes_(m_heldNotes, m);
+
+	const bool silent = !isInstrument() && m.isEmpty() && m_heldNotes == 0 &&
+	                    b.getMagnitude(0, numFrames) < G_PLUGIN_SLEEP_THRESHOLD;
+
+	if (!silent)
+	{
+		m_silentFrames = 0;
+		m_processedBlocks.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	/* Read the tail as the silence begins: it may depend on the plug-in
+	parameters. An infinite tail means the plug-in never goes to sleep. */
 
-	m_buffer = out;
-	m_plugin->processBlock(m_buffer, m);
-	return m_buffer;
+	if (m_silentFrames == 0)
+	{
+		const double sampleRate = m_plugin->getSampleRate();
+		const double tail       = m_plugin->getTailLengthSeconds();
+
+		m_sleepAfter = std::isfinite(tail)
+		                   ? static_cast<Frame>((tail + G_PLUGIN_SLEEP_DELAY_MS / 1000.0) * sampleRate) + getLatency()
+		                   : std::numeric_limits<Frame>::max();
+	}
+
+	/* The counter includes the current block: sleep only if the whole block
+	lies past the tail. */
+
+	m_silentFrames = std::min(m_silentFrames, std::numeric_limits<Frame>::max() - numFrames) + numFrames;
+
+	const bool asleep = m_silentFrames > m_sleepAfter;
+	(asleep ? m_skippedBlocks : m_processedBlocks).fetch_add(1, std::memory_order_relaxed);
+	return asleep;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Plugin::SleepStats Plugin::getSleepStats() const
+{
+	return {m_processedBlocks.load(std::memory_order_relaxed), m_skippedBlocks.load(std::memory_order_relaxed)};
 }
 
 /* -------------------------------------------------------------------------- */
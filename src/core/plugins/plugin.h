@@ -40,6 +40,7 @@ Windows. */
 #include "src/core/plugins/pluginState.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -50,6 +51,16 @@ class Plugin : private juce::ComponentListener
 public:
 	using Buffer = juce::AudioBuffer<float>;
 
+	/* SleepStats
+	How many blocks have been processed and how many have been skipped because
+	the plug-in was asleep. */
+
+	struct SleepStats
+	{
+		uint64_t processed = 0;
+		uint64_t skipped   = 0;
+	};
+
 	/* Plugin (1)
 	Constructs an invalid plug-in. */
 
@@ -96,14 +107,29 @@ public:
 
 	int countMainOutChannels() const;
 
+	/* getLatency
+	Returns the delay introduced by the plug-in, in frames, as reported by the
+	plug-in itself. It may change over time. */
+
+	int getLatency() const;
+
 	/* process
-	Process the plug-in with audio and MIDI data. The audio buffer is a
-	reference, while the MIDI buffer must be passed by copy: each plug-in must
-	receive its own copy of the event set, so that any attempt to change/clear
-	the MIDI buffer will only modify the local copy. Returns a reference of the
-	local buffer filled with processed data. */
+	Process the plug-in with audio and MIDI data, in place. The MIDI buffer may
+	be changed by the plug-in: the caller must provide a private copy of the
+	event set to each plug-in (see PluginHost::processPlugin). */
 
-	const Buffer& process(const Buffer& b, juce::MidiBuffer m);
+	void process(Buffer& b, juce::MidiBuffer& m);
+
+	/* canSleep
+	Feeds the silence detector with the input of the current block. Returns true
+	if processing the block can be skipped: the input has been silent, with no
+	notes held, for longer than the plug-in tail. Any sample or MIDI event above
+	the threshold wakes the plug-in up for the whole block, so nothing is lost.
+	Instruments never sleep, as they may play on their own. Audio thread only. */
+
+	bool canSleep(const Buffer& b, const juce::MidiBuffer& m);
+
+	SleepStats getSleepStats() const;
 
 	void setState(PluginState p);
 	void setBypass(bool b);
@@ -147,10 +173,20 @@ private:
 
 	std::unique_ptr<juce::AudioPluginInstance> m_plugin;
 	std::unique_ptr<PluginHost::Info>          m_playHead;
-	Buffer                                     m_buffer;
 
 	std::atomic<bool> m_bypass;
 
+	/* m_silentFrames, m_sleepAfter, m_heldNotes
+	Silence detector state, audio thread only. m_sleepAfter is the tail (plus
+	latency and safety delay) in frames, read when the silence begins. */
+
+	Frame m_silentFrames;
+	Frame m_sleepAfter;
+	int   m_heldNotes;
+
+	std::atomic<uint64_t> m_processedBlocks;
+	std::atomic<uint64_t> m_skippedBlocks;
+
 	/* juceID
 	The original JUCE id, used for missing plugins. */
 
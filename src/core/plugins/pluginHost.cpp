@@ -30,9 +30,11 @@
 #include "src/core/model/model.h"
 #include "src/core/plugins/plugin.h"
 #include "src/core/plugins/pluginManager.h"
+#include "src/core/profiler.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/deps/mcl-utils/src/container.hpp"
 #include "src/utils/log.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <memory>
@@ -72,8 +74,27 @@ bool PluginHost::Info::canControlTransport()
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-PluginHost::PluginHost(model::Model& m)
+PluginHost::WorkBuffer::WorkBuffer(int bufferSize)
+{
+	setSize(bufferSize);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginHost::WorkBuffer::setSize(int bufferSize)
+{
+	audio.setSize(G_MAX_IO_CHANS, bufferSize);
+	instrument.setSize(G_MAX_IO_CHANS, bufferSize);
+	midi.ensureSize(G_DEFAULT_VST_MIDIBUFFER_SIZE);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+PluginHost::PluginHost(model::Model& m, Profiler& p)
 : m_model(m)
+, m_profiler(p)
 {
 }
 
@@ -89,7 +110,7 @@ void PluginHost::reset(int bufferSize)
 
 void PluginHost::setBufferSize(int bufferSize)
 {
-	m_audioBuffer.setSize(G_MAX_IO_CHANS, bufferSize);
+	m_workBuffer.setSize(bufferSize);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -97,22 +118,46 @@ void PluginHost::setBufferSize(int bufferSize)
 void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
     const juce::MidiBuffer* events)
 {
-	assert(outBuf.countFrames() == m_audioBuffer.getNumSamples());
+	processStack(outBuf, plugins, events, m_workBuffer);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
+    const juce::MidiBuffer* events, WorkBuffer& workBuf)
+{
+	assert(outBuf.countFrames() == workBuf.audio.getNumSamples());
 
 	if (plugins.empty())
 		return;
 
-	giadaToJuceTempBuf(outBuf);
+	giadaToJuceTempBuf(outBuf, workBuf.audio);
+	processPlugins(plugins, events, workBuf.audio, workBuf);
+	juceToGiadaOutBuf(outBuf, workBuf.audio);
+}
+
+/* -------------------------------------------------------------------------- */
 
-	if (events == nullptr)
-	{
-		juce::MidiBuffer dummyEvents; // empty
-		processPlugins(plugins, dummyEvents);
-	}
-	else
-		processPlugins(plugins, *events);
+void PluginHost::processPlanarStack(const mcl::AudioBuffer& inBuf, const std::vector<Plugin*>& plugins,
+    const juce::MidiBuffer* events, WorkBuffer& workBuf)
+{
+	assert(inBuf.countFrames() == workBuf.audio.getNumSamples());
 
-	juceToGiadaOutBuf(outBuf);
+	if (plugins.empty())
+		return;
+
+	giadaToJuceTempBuf(inBuf, workBuf.audio);
+	processPlugins(plugins, events, workBuf.audio, workBuf);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginHost::processPlanarStack(juce::AudioBuffer<float>& buf, const std::vector<Plugin*>& plugins,
+    const juce::MidiBuffer* events, WorkBuffer& workBuf)
+{
+	assert(buf.getNumSamples() == workBuf.instrument.getNumSamples());
+
+	processPlugins(plugins, events, buf, workBuf);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -175,68 +220,96 @@ void PluginHost::toggleBypass(ID pluginId)
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf)
+void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& workBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
+	assert(outBuf.countChannels() == workBuf.getNumChannels());
 
 	using namespace juce;
 	using Format = AudioData::Format<AudioData::Float32, AudioData::BigEndian>;
 
 	AudioData::deinterleaveSamples(
 	    AudioData::InterleavedSource<Format>{outBuf[0], outBuf.countChannels()},
-	    AudioData::NonInterleavedDest<Format>{m_audioBuffer.getArrayOfWritePointers(), m_audioBuffer.getNumChannels()},
+	    AudioData::NonInterleavedDest<Format>{workBuf.getArrayOfWritePointers(), workBuf.getNumChannels()},
 	    outBuf.countFrames());
 }
 
-void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const
+void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf, const juce::AudioBuffer<float>& workBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
+	assert(outBuf.countChannels() == workBuf.getNumChannels());
 
 	using namespace juce;
 	using Format = AudioData::Format<AudioData::Float32, AudioData::BigEndian>;
 
 	AudioData::interleaveSamples(
-	    AudioData::NonInterleavedSource<Format>{m_audioBuffer.getArrayOfReadPointers(), m_audioBuffer.getNumChannels()},
+	    AudioData::NonInterleavedSource<Format>{workBuf.getArrayOfReadPointers(), workBuf.getNumChannels()},
 	    AudioData::InterleavedDest<Format>{outBuf[0], outBuf.countChannels()},
 	    outBuf.countFrames());
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, const juce::MidiBuffer& events)
+void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, const juce::MidiBuffer* events,
+    juce::AudioBuffer<float>& buf, WorkBuffer& workBuf) const
 {
 	for (Plugin* p : plugins)
 	{
 		if (!p->valid || p->isSuspended() || p->isBypassed())
 			continue;
-		processPlugin(p, events);
+		processPlugin(*p, events, buf, workBuf);
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events)
+void PluginHost::processPlugin(Plugin& p, const juce::MidiBuffer* events, juce::AudioBuffer<float>& buf,
+    WorkBuffer& workBuf) const
 {
-	const Plugin::Buffer& pluginBuffer = p->process(m_audioBuffer, events);
-	const bool            isInstrument = p->isInstrument();
+	/* Each plug-in receives its own copy of the event set, so that any attempt
+	to change/clear it won't affect the following plug-ins. The MIDI buffer is
+	pre-allocated: copying events into it doesn't allocate. */
+
+	workBuf.midi.clear();
+	if (events != nullptr)
+		workBuf.midi.addEvents(*events, 0, -1, 0);
+
+	/* A sleeping effect has silence in and would produce silence out: the
+	buffer can be left untouched. */
+
+	if (p.canSleep(buf, workBuf.midi))
+		return;
 
-	/* Merge the plugin buffer back into the local one. Special care is needed
-	if audio channels mismatch. */
+	const Profiler::Scope profile(m_profiler, Profiler::Section::PLUGIN, p.id);
 
-	for (int i = 0, j = 0; i < m_audioBuffer.getNumChannels(); i++)
+	if (!p.isInstrument())
 	{
-		/* If instrument (i.e. a plug-in that accepts MIDI and produces audio
-		out of it), SUM the local working buffer to the main one. This allows
-		multiple plug-in instruments to play simultaneously on a given set of
-		MIDI events. If it's a normal FX instead (!isInstrument), the local
-		working buffer is simply copied over the main one. */
-
-		if (isInstrument)
-			m_audioBuffer.addFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
-		else
-			m_audioBuffer.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
-		if (i < p->countMainOutChannels() - 1)
-			j++;
+		p.process(buf, workBuf.midi);
+		spreadMainOut(p, buf);
+		return;
 	}
+
+	/* If instrument (i.e. a plug-in that accepts MIDI and produces audio out of
+	it), SUM its output to the working buffer. This allows multiple plug-in
+	instruments to play simultaneously on a given set of MIDI events. */
+
+	const int numFrames = buf.getNumSamples();
+
+	for (int i = 0; i < buf.getNumChannels(); i++)
+		workBuf.instrument.copyFrom(i, 0, buf, i, 0, numFrames);
+
+	p.process(workBuf.instrument, workBuf.midi);
+	spreadMainOut(p, workBuf.instrument);
+
+	for (int i = 0; i < buf.getNumChannels(); i++)
+		buf.addFrom(i, 0, workBuf.instrument, i, 0, numFrames);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginHost::spreadMainOut(const Plugin& p, juce::AudioBuffer<float>& buf) const
+{
+	const int numOuts = std::max(1, p.countMainOutChannels());
+
+	for (int i = numOuts; i < buf.getNumChannels(); i++)
+		buf.copyFrom(i, 0, buf, numOuts - 1, 0, buf.getNumSamples());
 }
-} // namespace giada::m
\ No newline at end of file
+} // namespace giada::m
@@ -47,7 +47,8 @@ class AudioBuffer;
 namespace giada::m
 {
 class Plugin;
-}
+class Profiler;
+} // namespace giada::m
 
 namespace giada::m::model
 {
@@ -73,7 +74,25 @@ public:
 		int                     m_sampleRate;
 	};
 
-	PluginHost(model::Model&);
+	/* WorkBuffer
+	Scratch memory for processing a plug-in stack. Plug-ins process 'audio' in
+	place; instruments render into 'instrument' first, which is then summed to
+	'audio'. 'midi' holds the private copy of the events each plug-in receives.
+	Everything is allocated up front by setSize(), so that processing a stack
+	never allocates on the audio thread. */
+
+	struct WorkBuffer
+	{
+		WorkBuffer(int bufferSize = 0);
+
+		void setSize(int bufferSize);
+
+		juce::AudioBuffer<float> audio;
+		juce::AudioBuffer<float> instrument;
+		juce::MidiBuffer         midi;
+	};
+
+	PluginHost(model::Model&, Profiler&);
 
 	/* reset
 	Brings everything back to the initial state. */
@@ -92,12 +111,35 @@ public:
 
 	const Plugin& addPlugin(std::unique_ptr<Plugin> p);
 
-	/* processStack
-	Applies the fx list to the buffer. */
+	/* processStack (1)
+	Applies the fx list to the buffer, using the internal working buffer. */
 
 	void processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
 	    const juce::MidiBuffer* events = nullptr);
 
+	/* processStack (2)
+	Same as above, with a caller-provided working buffer. Stacks processed with
+	distinct working buffers can run concurrently on different threads. The
+	buffer is deinterleaved and interleaved back only once per stack. */
+
+	void processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
+	    const juce::MidiBuffer* events, WorkBuffer& workBuf);
+
+	/* processPlanarStack (1)
+	Same as processStack (2), but the result is left planar in 'workBuf.audio'
+	instead of being interleaved back into 'inBuf'. Does nothing if 'plugins' is
+	empty. */
+
+	void processPlanarStack(const mcl::AudioBuffer& inBuf, const std::vector<Plugin*>& plugins,
+	    const juce::MidiBuffer* events, WorkBuffer& workBuf);
+
+	/* processPlanarStack (2)
+	Applies the fx list to the planar buffer 'buf' in place, with no format
+	conversion at all. 'buf' can be 'workBuf.audio' itself. */
+
+	void processPlanarStack(juce::AudioBuffer<float>& buf, const std::vector<Plugin*>& plugins,
+	    const juce::MidiBuffer* events, WorkBuffer& workBuf);
+
 	/* swapPlugin
 	Swaps plug-in 1 with plug-in 2 in the plug-in vector. */
 
@@ -124,23 +166,38 @@ public:
 
 private:
 	/* giadaToJuceTempBuf
-	Copies the Giada buffer 'outBuf' to the private JUCE buffer for local
+	Copies the Giada buffer 'outBuf' to the JUCE working buffer for local
 	processing. */
 
-	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf);
+	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& workBuf) const;
 
 	/* juceToGiadaOutBuf
-	Copies the private JUCE buffer to Giada buffer 'outBuf'. */
+	Copies the JUCE working buffer to Giada buffer 'outBuf'. */
+
+	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf, const juce::AudioBuffer<float>& workBuf) const;
+
+	void processPlugins(const std::vector<Plugin*>&, const juce::MidiBuffer* events,
+	    juce::AudioBuffer<float>& buf, WorkBuffer& workBuf) const;
+
+	/* processPlugin
+	Runs a single plug-in on the planar buffer 'buf'. Effects process it in
+	place, instruments render into the separate instrument buffer of 'workBuf'
+	which is then summed to 'buf'. Skipped while the plug-in sleeps on silent
+	input (see Plugin::canSleep). */
 
-	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const;
+	void processPlugin(Plugin&, const juce::MidiBuffer* events, juce::AudioBuffer<float>& buf,
+	    WorkBuffer& workBuf) const;
 
-	void processPlugins(const std::vector<Plugin*>&, const juce::MidiBuffer& events);
+	/* spreadMainOut
+	Copies the last channel produced by a plug-in with fewer main outputs than
+	the working buffer to the remaining channels of 'buf'. */
 
-	void processPlugin(Plugin*, const juce::MidiBuffer& events);
+	void spreadMainOut(const Plugin&, juce::AudioBuffer<float>& buf) const;
 
 	model::Model& m_model;
+	Profiler&     m_profiler;
 
-	juce::AudioBuffer<float> m_audioBuffer;
+	WorkBuffer m_workBuffer;
 };
 } // namespace giada::m
 
@@ -29,13 +29,17 @@
 #include "src/core/patch.h"
 #include "src/core/plugins/plugin.h"
 #include "src/core/plugins/pluginFactory.h"
+#include "src/core/plugins/pluginScanner.h"
+#include "src/core/plugins/sandboxedPlugin.h"
 #include "src/deps/mcl-utils/src/fs.hpp"
 #include "src/deps/mcl-utils/src/string.hpp"
 #include "src/utils/fs.h"
 #include "src/utils/log.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <memory>
+#include <thread>
 
 namespace utils = mcl::utils;
 
@@ -43,6 +47,20 @@ namespace giada::m
 {
 namespace
 {
+/* SCAN_CHECKPOINT_INTERVAL
+How many files to scan between two saves of the plug-in list. */
+
+constexpr int SCAN_CHECKPOINT_INTERVAL = 20;
+
+/* -------------------------------------------------------------------------- */
+
+std::string getListPath_()
+{
+	return utils::fs::join(u::fs::getConfigDirPath(), "plugins.xml");
+}
+
+/* -------------------------------------------------------------------------- */
+
 juce::FileSearchPath toJuceFileSearchPath_(const std::string& dirs)
 {
 	juce::FileSearchPath searchPath;
@@ -63,7 +81,14 @@ void PluginManager::reset()
 	if (m_formatManager.getNumFormats() == 0) // Must be called only once
 		m_formatManager.addDefaultFormats();
 
-	loadList(utils::fs::join(u::fs::getConfigDirPath(), "plugins.xml"));
+	loadList(getListPath_());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void PluginManager::setSandboxedPlugins(std::set<std::string> juceIds)
+{
+	m_sandboxedPlugins = std::move(juceIds);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -73,30 +98,55 @@ int PluginManager::scanDirs(const std::string& dirs, std::function<bool(float)>
 	u::log::print("[pluginManager::scanDir] requested directories: '{}'\n", dirs);
 	u::log::print("[pluginManager::scanDir] currently known plug-ins: {}\n", m_knownPluginList.getNumTypes());
 
-	m_knownPluginList.clear(); // clear up previous plugins
+	const juce::FileSearchPath searchPath = toJuceFileSearchPath_(dirs);
 
-	const juce::FileSearchPath searchPath    = toJuceFileSearchPath_(dirs);
-	const float                numFormats    = m_formatManager.getNumFormats();
-	bool                       shouldRun     = true;
-	float                      totalProgress = 1.0f;
+	/* Collect all plug-in files first, so that they can be scanned in parallel.
+	Files that haven't changed since the last scan are skipped, blacklisted ones
+	included. */
 
+	std::vector<pluginScanner::File> files;
+	std::set<std::string>            upToDate;
 	for (juce::AudioPluginFormat* format : m_formatManager.getFormats())
 	{
-		if (!shouldRun)
-			break;
-
-		juce::PluginDirectoryScanner scanner(m_knownPluginList, *format, searchPath, /*recursive=*/true, juce::File());
-
-		juce::String name;
-		while (scanner.scanNextFile(false, name) && shouldRun)
+		for (const juce::String& path : format->searchPathsForPlugins(searchPath, /*recursive=*/true))
 		{
-			u::log::print("[pluginManager::scanDir]   scanning '{}'\n", name.toRawUTF8());
-			shouldRun = progressCb((totalProgress + scanner.getProgress()) / numFormats);
+			const pluginScanner::File file = {format, path.toStdString()};
+			if (pluginScanner::isUpToDate(m_scanCache, file))
+				upToDate.insert(file.path);
+			else
+				files.push_back(file);
 		}
-
-		totalProgress += 1.0f;
 	}
 
+	/* Forget everything about files that have changed or are gone. */
+
+	for (const juce::PluginDescription& pd : m_knownPluginList.getTypes())
+		if (!upToDate.contains(pd.fileOrIdentifier.toStdString()))
+			m_knownPluginList.removeType(pd);
+
+	const juce::StringArray blacklisted = m_knownPluginList.getBlacklistedFiles();
+	for (const juce::String& path : blacklisted)
+		if (!upToDate.contains(path.toStdString()))
+			m_knownPluginList.removeFromBlacklist(path);
+
+	std::erase_if(m_scanCache, [&upToDate](const auto& entry)
+	{ return !upToDate.contains(entry.first); });
+
+	u::log::print("[pluginManager::scanDir] {} file(s) up to date, {} to scan\n", upToDate.size(), files.size());
+
+	const std::string listPath   = getListPath_();
+	const int         numWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+	pluginScanner::scan(files, m_knownPluginList, m_scanCache, numWorkers, [&](int done)
+	{
+		/* Save progress every now and then: an interrupted scan resumes from
+		where it stopped. */
+
+		if (done % SCAN_CHECKPOINT_INTERVAL == 0)
+			saveList(listPath);
+		return progressCb(done / static_cast<float>(files.size()));
+	});
+
 	u::log::print("[pluginManager::scanDir] {} plugin(s) found\n", m_knownPluginList.getNumTypes());
 	return m_knownPluginList.getNumTypes();
 }
@@ -105,7 +155,10 @@ int PluginManager::scanDirs(const std::string& dirs, std::function<bool(float)>
 
 bool PluginManager::saveList(const std::string& filepath) const
 {
-	bool out = m_knownPluginList.createXml()->writeTo(juce::File(filepath));
+	std::unique_ptr<juce::XmlElement> xml = m_knownPluginList.createXml();
+	pluginScanner::addToXml(m_scanCache, *xml);
+
+	bool out = xml->writeTo(juce::File(filepath));
 	if (!out)
 		u::log::print("[pluginManager::saveList] unable to save plugin list to {}\n", filepath);
 	return out;
@@ -119,6 +172,7 @@ bool PluginManager::loadList(const std::string& filepath)
 	if (elem == nullptr)
 		return false;
 	m_knownPluginList.recreateFromXml(*elem);
+	m_scanCache = pluginScanner::fromXml(*elem);
 	return true;
 }
 
@@ -218,6 +272,17 @@ std::unique_ptr<juce::AudioPluginInstance> PluginManager::makeJucePlugin(const s
 		return nullptr;
 	}
 
+	/* Never fall back to in-process loading if the sandbox fails: the plug-in
+	might be the reason why. */
+
+	if (m_sandboxedPlugins.contains(juceId))
+	{
+		std::unique_ptr<SandboxedPlugin> sp = SandboxedPlugin::create(*pd, sampleRate, bufferSize);
+		if (sp == nullptr)
+			u::log::print("[pluginManager::makeJucePlugin] unable to create sandboxed instance with juceId={}!\n", juceId);
+		return sp;
+	}
+
 	juce::String                               error;
 	std::unique_ptr<juce::AudioPluginInstance> pi = m_formatManager.createPluginInstance(*pd, sampleRate, bufferSize, error);
 	if (pi == nullptr)
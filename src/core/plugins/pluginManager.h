@@ -29,7 +29,10 @@
 
 #include "src/core/patch.h"
 #include "src/core/plugins/plugin.h"
+#include "src/core/plugins/pluginScanner.h"
 #include <memory>
+#include <set>
+#include <string>
 
 namespace giada::m::patch
 {
@@ -64,16 +67,24 @@ public:
 
 	void reset();
 
+	/* setSandboxedPlugins
+	Sets the JUCE ids of the plug-ins to be hosted in a sandbox process from now
+	on. Plug-ins already created are not affected. */
+
+	void setSandboxedPlugins(std::set<std::string>);
+
 	/* scanDirs
 	Parses plugin directories (semicolon-separated) and store list in
-	knownPluginList. The callback is called on each plugin found. Used to update
-	the main window from the GUI thread. Return false from the progress callback
-	to stop	the scanning process. */
+	knownPluginList. Files are scanned in parallel by separate processes, and
+	only if changed since the last scan (see pluginScanner). The callback is
+	called on each file scanned. Used to update the main window from the GUI
+	thread. Return false from the progress callback to stop the scanning
+	process. */
 
 	int scanDirs(const std::string& paths, std::function<bool(float)> progressCb);
 
 	/* (save|load)List
-	(Save|Load) knownPluginList (in|from) an XML file. */
+	(Save|Load) knownPluginList and the scan cache (in|from) an XML file. */
 
 	bool saveList(const std::string& path) const;
 	bool loadList(const std::string& path);
@@ -102,6 +113,16 @@ private:
 	List of known (i.e. scanned) plugins. */
 
 	juce::KnownPluginList m_knownPluginList;
+
+	/* m_sandboxedPlugins
+	JUCE ids of plug-ins hosted out of process, see SandboxedPlugin. */
+
+	std::set<std::string> m_sandboxedPlugins;
+
+	/* m_scanCache
+	What the previous scans found out about each plug-in file. */
+
+	pluginScanner::Cache m_scanCache;
 };
 } // namespace giada::m
 
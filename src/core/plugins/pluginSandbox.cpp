@@ -0,0 +1,338 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#if G_OS_WINDOWS
+#undef small
+#define NOMINMAX
+#endif
+
+#include "src/core/plugins/pluginSandbox.h"
+#include "src/core/sharedMemory.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace giada::m::pluginSandbox
+{
+namespace
+{
+/* SPIN_COUNT
+How many idle rounds the sandbox spends yielding, before falling back to short
+sleeps. The next block is usually just around the corner. */
+
+constexpr int SPIN_COUNT = 2000;
+
+/* -------------------------------------------------------------------------- */
+
+/* PlayHead_
+Feeds the plug-in with the transport information of the slot being processed. */
+
+class PlayHead_ : public juce::AudioPlayHead
+{
+public:
+	juce::Optional<PositionInfo> getPosition() const override
+	{
+		if (slot == nullptr)
+			return {};
+
+		PositionInfo info;
+		info.setBpm(slot->bpm);
+		info.setTimeInSamples(slot->timeInSamples);
+		info.setTimeInSeconds(slot->timeInSeconds);
+		info.setIsPlaying(slot->isPlaying != 0);
+
+		return {info};
+	}
+
+	const Slot* slot = nullptr;
+};
+
+/* -------------------------------------------------------------------------- */
+
+std::unique_ptr<juce::AudioPluginInstance> load_(const Block& block, juce::AudioPluginFormatManager& formats)
+{
+	std::unique_ptr<juce::XmlElement> xml = juce::parseXML(juce::String::fromUTF8(block.description));
+	juce::PluginDescription           pd;
+	if (xml == nullptr || !pd.loadFromXml(*xml))
+	{
+		u::log::print("[pluginSandbox::load_] invalid plug-in description!\n");
+		return nullptr;
+	}
+
+	juce::String                               error;
+	std::unique_ptr<juce::AudioPluginInstance> pi = formats.createPluginInstance(pd, block.sampleRate, block.bufferSize, error);
+	if (pi == nullptr)
+	{
+		u::log::print("[pluginSandbox::load_] unable to create instance of {}! Error: {}\n",
+		    pd.name.toStdString(), error.toStdString());
+		return nullptr;
+	}
+
+	/* Same bus setup performed by Plugin for in-process plug-ins. */
+
+	for (const bool isInput : {true, false})
+		for (int i = 0; i < pi->getBusCount(isInput); i++)
+			if (pi->getBus(isInput, i)->isMain())
+				pi->getBus(isInput, i)->setNumberOfChannels(G_MAX_IO_CHANS);
+
+	return pi;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void fillInfo_(Block& block, juce::AudioPluginInstance& plugin)
+{
+	Info&                                              info   = block.info;
+	const juce::Array<juce::AudioProcessorParameter*>& params = plugin.getParameters();
+
+	plugin.getName().copyToUTF8(info.name, MAX_NAME_SIZE);
+	info.numParameters = std::min(params.size(), MAX_PARAMETERS);
+	info.numPrograms   = plugin.getNumPrograms();
+	info.latency       = plugin.getLatencySamples();
+	info.acceptsMidi   = plugin.acceptsMidi();
+	info.producesMidi  = plugin.producesMidi();
+	info.tailSeconds   = plugin.getTailLengthSeconds();
+	info.currentProgram.store(plugin.getCurrentProgram());
+
+	for (int i = 0; i < info.numParameters; i++)
+	{
+		params[i]->getName(MAX_NAME_SIZE - 1).copyToUTF8(info.parameterNames[i], MAX_NAME_SIZE);
+		info.parameterDefaults[i] = params[i]->getDefaultValue();
+		block.parameters[i].store(params[i]->getValue(), std::memory_order_relaxed);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void applyParameters_(const Block& block, juce::AudioPluginInstance& plugin, std::vector<float>& applied)
+{
+	const juce::Array<juce::AudioProcessorParameter*>& params = plugin.getParameters();
+	for (std::size_t i = 0; i < applied.size(); i++)
+	{
+		const float value = block.parameters[i].load(std::memory_order_relaxed);
+		if (value == applied[i])
+			continue;
+		applied[i] = value;
+		params[static_cast<int>(i)]->setValue(value);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void writePayload_(Control& control, const void* data, std::size_t size)
+{
+	if (size > MAX_PAYLOAD)
+	{
+		control.result = 0;
+		return;
+	}
+	std::memcpy(control.payload, data, size);
+	control.size = size;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void runCommand_(Block& block, juce::AudioPluginInstance& plugin)
+{
+	Control& control = block.control;
+
+	control.result = 1;
+
+	switch (control.command)
+	{
+	case Command::PREPARE:
+		plugin.prepareToPlay(block.sampleRate, control.argument);
+		break;
+
+	case Command::RELEASE:
+		plugin.releaseResources();
+		break;
+
+	case Command::GET_STATE:
+	{
+		juce::MemoryBlock state;
+		plugin.getStateInformation(state);
+		writePayload_(control, state.getData(), state.getSize());
+		break;
+	}
+
+	case Command::SET_STATE:
+		plugin.setStateInformation(control.payload, static_cast<int>(control.size));
+		break;
+
+	case Command::SET_PROGRAM:
+		plugin.setCurrentProgram(control.argument);
+		block.info.currentProgram.store(plugin.getCurrentProgram());
+		break;
+
+	case Command::PROGRAM_NAME:
+	{
+		const std::string name = plugin.getProgramName(control.argument).toStdString();
+		writePayload_(control, name.data(), name.size());
+		break;
+	}
+
+	default:
+		control.result = 0;
+		break;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void process_(Slot& slot, juce::AudioPluginInstance& plugin, juce::MidiBuffer& midi, PlayHead_& playHead)
+{
+	/* Process the slot in place: the audio buffer refers to the shared memory,
+	no copies involved. */
+
+	float* channels[MAX_CHANNELS];
+	for (int i = 0; i < MAX_CHANNELS; i++)
+		channels[i] = slot.audio[i];
+
+	juce::AudioBuffer<float> audio(channels, MAX_CHANNELS, slot.numFrames);
+
+	midi.clear();
+	for (int i = 0; i < slot.numMidiEvents; i++)
+		midi.addEvent(slot.midi[i].data, slot.midi[i].size, slot.midi[i].offset);
+
+	playHead.slot = &slot;
+	plugin.processBlock(audio, midi);
+	playHead.slot = nullptr;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+int run(const std::string& name)
+{
+	SharedMemory memory(name, sizeof(Block), SharedMemory::Mode::OPEN);
+	if (!memory.isValid())
+		return 1;
+
+	Block& block = *reinterpret_cast<Block*>(memory.getData());
+	if (block.magic != MAGIC)
+	{
+		u::log::print("[pluginSandbox::run] invalid shared memory block {}\n", name);
+		return 1;
+	}
+
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::AudioPluginFormatManager  formats;
+	formats.addDefaultFormats();
+
+	std::unique_ptr<juce::AudioPluginInstance> plugin = load_(block, formats);
+	if (plugin == nullptr)
+	{
+		block.state.store(State::FAILED, std::memory_order_release);
+		return 1;
+	}
+
+	PlayHead_ playHead;
+	plugin->setPlayHead(&playHead);
+	plugin->prepareToPlay(block.sampleRate, block.bufferSize);
+
+	fillInfo_(block, *plugin);
+
+	std::vector<float> applied(block.info.numParameters);
+	for (std::size_t i = 0; i < applied.size(); i++)
+		applied[i] = block.parameters[i].load(std::memory_order_relaxed);
+
+	juce::MidiBuffer midi;
+	midi.ensureSize(G_DEFAULT_VST_MIDIBUFFER_SIZE);
+
+	block.state.store(State::READY, std::memory_order_release);
+
+	u::log::print("[pluginSandbox::run] plug-in {} ready\n", plugin->getName().toStdString());
+
+	using Clock = std::chrono::steady_clock;
+
+	uint32_t          parametersVersion = block.parametersVersion.load(std::memory_order_acquire);
+	uint64_t          hostHeartbeat     = block.hostHeartbeat.load(std::memory_order_relaxed);
+	Clock::time_point hostSeen          = Clock::now();
+	int               idleRounds        = 0;
+
+	while (block.state.load(std::memory_order_acquire) != State::QUIT)
+	{
+		block.heartbeat.fetch_add(1, std::memory_order_relaxed);
+
+		/* Quit if the host stopped beating: it has crashed or has been killed
+		without a chance to say goodbye. */
+
+		if (const uint64_t beat = block.hostHeartbeat.load(std::memory_order_relaxed); beat != hostHeartbeat)
+		{
+			hostHeartbeat = beat;
+			hostSeen      = Clock::now();
+		}
+		else if (Clock::now() - hostSeen > std::chrono::milliseconds(G_PLUGIN_SANDBOX_TIMEOUT_MS))
+		{
+			u::log::print("[pluginSandbox::run] host not responding, quitting\n");
+			break;
+		}
+
+		if (const uint32_t request = block.control.request.load(std::memory_order_acquire);
+		    request != block.control.done.load(std::memory_order_relaxed))
+		{
+			runCommand_(block, *plugin);
+			block.control.done.store(request, std::memory_order_release);
+		}
+
+		if (const uint32_t version = block.parametersVersion.load(std::memory_order_acquire); version != parametersVersion)
+		{
+			parametersVersion = version;
+			applyParameters_(block, *plugin, applied);
+		}
+
+		/* Always process the most recent block: if the host went ahead and
+		posted two of them in the meantime, the older one is dropped. */
+
+		if (const uint64_t requested = block.requested.load(std::memory_order_acquire);
+		    requested != block.completed.load(std::memory_order_relaxed))
+		{
+			process_(block.slots[requested % NUM_SLOTS], *plugin, midi, playHead);
+			block.completed.store(requested, std::memory_order_release);
+			idleRounds = 0;
+			continue;
+		}
+
+		if (++idleRounds < SPIN_COUNT)
+			std::this_thread::yield();
+		else
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+
+	plugin->releaseResources();
+	return 0;
+}
+} // namespace giada::m::pluginSandbox
@@ -0,0 +1,183 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_PLUGIN_SANDBOX_H
+#define G_PLUGIN_SANDBOX_H
+
+#include "src/core/const.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* pluginSandbox
+Out-of-process plug-in hosting. A sandbox is a child Giada process started with
+the PROCESS_ARG command line switch: it loads a single plug-in and processes
+audio on behalf of a SandboxedPlugin living in the host. The two processes
+talk through the Block below, placed in a SharedMemory object. Audio is
+pipelined over two slots: the host posts block N while collecting the output
+of block N-1, which adds one buffer of latency but never blocks the audio
+thread. */
+
+namespace giada::m::pluginSandbox
+{
+constexpr auto        PROCESS_ARG     = "--plugin-sandbox";
+constexpr uint32_t    MAGIC           = 0x47504C53; // 'GPLS'
+constexpr int         NUM_SLOTS       = 2;
+constexpr int         MAX_CHANNELS    = G_MAX_IO_CHANS;
+constexpr int         MAX_FRAMES      = 8192;
+constexpr int         MAX_MIDI_EVENTS = 512;
+constexpr int         MAX_PARAMETERS  = 2048;
+constexpr int         MAX_NAME_SIZE   = 128;
+constexpr std::size_t MAX_PAYLOAD     = 4 * 1024 * 1024;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<float>::is_always_lock_free);
+
+enum class State : uint32_t
+{
+	STARTING,
+	READY,
+	FAILED,
+	QUIT
+};
+
+enum class Command : uint32_t
+{
+	NONE,
+	PREPARE,      // argument: buffer size
+	RELEASE,      // -
+	GET_STATE,    // -> payload: state
+	SET_STATE,    // payload: state
+	SET_PROGRAM,  // argument: program index
+	PROGRAM_NAME, // argument: program index -> payload: name
+};
+
+/* MidiEvent
+Short MIDI message at a given offset in the block. Longer messages (SysEx)
+are not transported. */
+
+struct MidiEvent
+{
+	int32_t offset;
+	uint8_t size;
+	uint8_t data[3];
+};
+
+/* Slot
+One block of audio and MIDI. The host writes the input, the sandbox processes
+it in place. */
+
+struct Slot
+{
+	int32_t   numFrames;
+	int32_t   numMidiEvents;
+	int32_t   isPlaying;
+	double    bpm;
+	int64_t   timeInSamples;
+	double    timeInSeconds;
+	MidiEvent midi[MAX_MIDI_EVENTS];
+	float     audio[MAX_CHANNELS][MAX_FRAMES];
+};
+
+/* Info
+Plug-in properties, filled in by the sandbox once the plug-in is loaded. */
+
+struct Info
+{
+	char    name[MAX_NAME_SIZE];
+	int32_t numParameters;
+	int32_t numPrograms;
+	int32_t latency;
+	int32_t acceptsMidi;
+	int32_t producesMidi;
+	double  tailSeconds;
+	char    parameterNames[MAX_PARAMETERS][MAX_NAME_SIZE];
+	float   parameterDefaults[MAX_PARAMETERS];
+
+	std::atomic<int32_t> currentProgram;
+};
+
+/* Control
+Non-realtime request/response channel. The host bumps 'request' after having
+filled in a command, the sandbox copies 'request' into 'done' when finished. */
+
+struct Control
+{
+	std::atomic<uint32_t> request;
+	std::atomic<uint32_t> done;
+	Command               command;
+	int32_t               argument;
+	int32_t               result;
+	uint64_t              size;
+	std::byte             payload[MAX_PAYLOAD];
+};
+
+struct Block
+{
+	uint32_t magic;
+	int32_t  sampleRate;
+	int32_t  bufferSize;
+	char     description[64 * 1024]; // juce::PluginDescription as XML
+
+	std::atomic<State> state;
+
+	/* heartbeat, hostHeartbeat
+	Counters bumped periodically by the sandbox and by the host. Each side
+	treats a stuck counter as the other one being dead or hung. */
+
+	std::atomic<uint64_t> heartbeat;
+	std::atomic<uint64_t> hostHeartbeat;
+
+	/* requested, completed
+	Sequence numbers of the last block posted by the host and of the last block
+	processed by the sandbox. Block N lives in slots[N % NUM_SLOTS]. */
+
+	std::atomic<uint64_t> requested;
+	std::atomic<uint64_t> completed;
+	Slot                  slots[NUM_SLOTS];
+
+	/* parameters, parametersVersion
+	Parameter values set by the host. The version is bumped on each change, so
+	that the sandbox knows when to look for new values. */
+
+	std::atomic<float>    parameters[MAX_PARAMETERS];
+	std::atomic<uint32_t> parametersVersion;
+
+	Info    info;
+	Control control;
+};
+
+/* run
+Entry point of the sandbox process: opens the shared Block with the given name,
+loads the plug-in and processes audio until the host quits or disappears.
+Returns the process exit code. */
+
+int run(const std::string& name);
+} // namespace giada::m::pluginSandbox
+
+#endif
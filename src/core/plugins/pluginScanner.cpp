@@ -0,0 +1,291 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/plugins/pluginScanner.h"
+#include "src/core/const.h"
+#include "src/utils/log.h"
+#include <chrono>
+#include <thread>
+
+namespace giada::m::pluginScanner
+{
+namespace
+{
+constexpr auto CACHE_TAG   = "GIADA_SCAN_CACHE";
+constexpr auto RESULTS_TAG = "GIADA_SCAN_RESULTS";
+
+/* POLL_RATE_MS
+How often running scanner processes are checked for completion. */
+
+constexpr int POLL_RATE_MS = 5;
+
+using Clock = std::chrono::steady_clock;
+
+struct Job_
+{
+	const File*                         file;
+	std::unique_ptr<juce::ChildProcess> process;
+	juce::File                          output;
+	Clock::time_point                   start;
+};
+
+/* -------------------------------------------------------------------------- */
+
+std::unique_ptr<juce::ChildProcess> startProcess_(const File& file, const juce::File& output)
+{
+	/* The scanner is Giada itself, started in scanner mode. Its standard
+	streams are not needed: results go to the output file. */
+
+	const juce::StringArray args = {
+	    juce::File::getSpecialLocation(juce::File::currentExecutableFile).getFullPathName(),
+	    PROCESS_ARG,
+	    file.format->getName(),
+	    juce::String(file.path),
+	    output.getFullPathName()};
+
+	auto process = std::make_unique<juce::ChildProcess>();
+	if (!process->start(args, 0))
+		return nullptr;
+	return process;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool addResults_(const juce::File& output, juce::KnownPluginList& list)
+{
+	std::unique_ptr<juce::XmlElement> xml = juce::XmlDocument::parse(output);
+	if (xml == nullptr || !xml->hasTagName(RESULTS_TAG))
+		return false;
+
+	for (const juce::XmlElement* e : xml->getChildIterator())
+	{
+		juce::PluginDescription pd;
+		if (pd.loadFromXml(*e))
+			list.addType(pd);
+	}
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void scanInProcess_(const File& file, juce::KnownPluginList& list)
+{
+	juce::OwnedArray<juce::PluginDescription> found;
+	file.format->findAllTypesForFile(found, file.path);
+	for (const juce::PluginDescription* pd : found)
+		list.addType(*pd);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void store_(const File& file, bool ok, juce::KnownPluginList& list, Cache& cache)
+{
+	CacheEntry entry = makeCacheEntry(file);
+	entry.failed     = !ok;
+	cache[file.path] = entry;
+
+	if (ok)
+		list.removeFromBlacklist(file.path);
+	else
+	{
+		list.addToBlacklist(file.path);
+		u::log::print("[pluginScanner::scan] '{}' blacklisted\n", file.path);
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+CacheEntry makeCacheEntry(const File& file)
+{
+	/* Formats that don't use files (e.g. LV2 URIs) get a zero size and time:
+	they are considered unchanged as long as they are in the cache. */
+
+	const juce::File f = juce::File::isAbsolutePath(file.path) ? juce::File(file.path) : juce::File();
+
+	CacheEntry entry;
+	entry.format = file.format->getName().toStdString();
+	if (f.exists())
+	{
+		entry.size    = f.getSize();
+		entry.modTime = f.getLastModificationTime().toMilliseconds();
+	}
+	return entry;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool isUpToDate(const Cache& cache, const File& file)
+{
+	const auto it = cache.find(file.path);
+	if (it == cache.end())
+		return false;
+
+	const CacheEntry& cached  = it->second;
+	const CacheEntry  current = makeCacheEntry(file);
+
+	return cached.format == current.format && cached.size == current.size && cached.modTime == current.modTime;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void scan(const std::vector<File>& files, juce::KnownPluginList& list, Cache& cache, int numWorkers,
+    std::function<bool(int)> onFileDone)
+{
+	std::vector<Job_> jobs;
+	std::size_t       next    = 0;
+	int               done    = 0;
+	bool              running = true;
+
+	const auto complete = [&](const File& file, bool ok)
+	{
+		store_(file, ok, list, cache);
+		running = onFileDone(++done) && running;
+	};
+
+	while (running && (next < files.size() || !jobs.empty()))
+	{
+		/* Keep all workers busy. Should a scanner process fail to start, scan
+		the file in-process as a last resort. */
+
+		while (running && static_cast<int>(jobs.size()) < numWorkers && next < files.size())
+		{
+			const File& file   = files[next++];
+			juce::File  output = juce::File::createTempFile(".xml");
+
+			u::log::print("[pluginScanner::scan] scanning '{}'\n", file.path);
+
+			if (std::unique_ptr<juce::ChildProcess> process = startProcess_(file, output); process != nullptr)
+				jobs.push_back({&file, std::move(process), output, Clock::now()});
+			else
+			{
+				scanInProcess_(file, list);
+				complete(file, /*ok=*/true);
+			}
+		}
+
+		for (Job_& job : jobs)
+		{
+			bool ok = false;
+			if (!job.process->isRunning())
+				ok = job.process->getExitCode() == 0 && addResults_(job.output, list);
+			else if (Clock::now() - job.start > std::chrono::milliseconds(G_PLUGIN_SCAN_TIMEOUT_MS))
+			{
+				u::log::print("[pluginScanner::scan] '{}' timed out\n", job.file->path);
+				job.process->kill();
+			}
+			else
+				continue;
+
+			job.output.deleteFile();
+			job.process.reset();
+			complete(*job.file, ok);
+		}
+
+		std::erase_if(jobs, [](const Job_& job)
+		{ return job.process == nullptr; });
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(POLL_RATE_MS));
+	}
+
+	/* Scan interrupted. Files still being scanned are left out of the cache, so
+	that they will be scanned again next time. */
+
+	for (Job_& job : jobs)
+	{
+		job.process->kill();
+		job.output.deleteFile();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void addToXml(const Cache& cache, juce::XmlElement& parent)
+{
+	juce::XmlElement* xml = parent.createNewChildElement(CACHE_TAG);
+	for (const auto& [path, entry] : cache)
+	{
+		juce::XmlElement* e = xml->createNewChildElement("FILE");
+		e->setAttribute("path", juce::String(path));
+		e->setAttribute("format", juce::String(entry.format));
+		e->setAttribute("size", juce::String(entry.size));
+		e->setAttribute("modTime", juce::String(entry.modTime));
+		e->setAttribute("failed", entry.failed ? 1 : 0);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Cache fromXml(const juce::XmlElement& parent)
+{
+	Cache                   cache;
+	const juce::XmlElement* xml = parent.getChildByName(CACHE_TAG);
+	if (xml == nullptr)
+		return cache;
+
+	for (const juce::XmlElement* e : xml->getChildWithTagNameIterator("FILE"))
+	{
+		CacheEntry entry;
+		entry.format  = e->getStringAttribute("format").toStdString();
+		entry.size    = e->getStringAttribute("size").getLargeIntValue();
+		entry.modTime = e->getStringAttribute("modTime").getLargeIntValue();
+		entry.failed  = e->getIntAttribute("failed") != 0;
+
+		cache[e->getStringAttribute("path").toStdString()] = entry;
+	}
+	return cache;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int run(const std::string& formatName, const std::string& path, const std::string& outPath)
+{
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	juce::AudioPluginFormatManager  formats;
+	formats.addDefaultFormats();
+
+	for (juce::AudioPluginFormat* format : formats.getFormats())
+	{
+		if (format->getName().toStdString() != formatName)
+			continue;
+
+		juce::OwnedArray<juce::PluginDescription> found;
+		format->findAllTypesForFile(found, path);
+
+		juce::XmlElement xml(RESULTS_TAG);
+		for (const juce::PluginDescription* pd : found)
+			xml.addChildElement(pd->createXml().release());
+
+		return xml.writeTo(juce::File(outPath)) ? 0 : 1;
+	}
+
+	u::log::print("[pluginScanner::run] unknown plug-in format {}\n", formatName);
+	return 1;
+}
+} // namespace giada::m::pluginScanner
@@ -0,0 +1,110 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_PLUGIN_SCANNER_H
+#define G_PLUGIN_SCANNER_H
+
+#if G_OS_WINDOWS
+#undef small
+#define NOMINMAX
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/* pluginScanner
+Out-of-process plug-in scanning. Each plug-in file is scanned by a child Giada
+process started with the PROCESS_ARG command line switch, several of them
+running in parallel: a plug-in that crashes or hangs while being scanned only
+takes down its own scanner process, and gets blacklisted. */
+
+namespace giada::m::pluginScanner
+{
+constexpr auto PROCESS_ARG = "--plugin-scan";
+
+/* CacheEntry
+What a previous scan found out about a plug-in file: its size and last
+modification time at that moment, and whether scanning it failed. Files that
+haven't changed since are not scanned again. */
+
+struct CacheEntry
+{
+	std::string format;
+	int64_t     size    = 0;
+	int64_t     modTime = 0;
+	bool        failed  = false;
+};
+
+/* Cache
+Cache entries by file path (or identifier, for formats that don't use files). */
+
+using Cache = std::map<std::string, CacheEntry>;
+
+struct File
+{
+	juce::AudioPluginFormat* format;
+	std::string              path;
+};
+
+/* makeCacheEntry
+Returns a successful cache entry describing the current state of a file. */
+
+CacheEntry makeCacheEntry(const File&);
+
+/* isUpToDate
+True if the file has been scanned already and hasn't changed since. */
+
+bool isUpToDate(const Cache&, const File&);
+
+/* scan
+Scans files in parallel, at most 'numWorkers' at a time. Plug-ins found are
+added to the list; files that make a scanner crash or time out are
+blacklisted. The cache is updated accordingly. 'onFileDone' is called with the
+number of files completed so far: return false from it to stop scanning. */
+
+void scan(const std::vector<File>&, juce::KnownPluginList&, Cache&, int numWorkers,
+    std::function<bool(int)> onFileDone);
+
+/* addToXml, fromXml
+Store the cache into a child of the given XML element, or restore it from
+there. */
+
+void  addToXml(const Cache&, juce::XmlElement& parent);
+Cache fromXml(const juce::XmlElement& parent);
+
+/* run
+Entry point of the scanner process: scans a single file with the given plug-in
+format and writes the descriptions found to 'outPath' as XML. Returns the
+process exit code. */
+
+int run(const std::string& format, const std::string& path, const std::string& outPath);
+} // namespace giada::m::pluginScanner
+
+#endif
@@ -0,0 +1,452 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/plugins/sandboxedPlugin.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace giada::m
+{
+namespace
+{
+/* MAX_STALLED_CHECKS
+How many watchdog rounds in a row the sandbox heartbeat may stay still before
+the sandbox is considered hung. */
+
+constexpr int MAX_STALLED_CHECKS = 2;
+
+/* -------------------------------------------------------------------------- */
+
+std::string makeName_()
+{
+	/* Keep it short: macOS limits shared memory names to 31 characters. */
+
+	return "giada-" + juce::String::toHexString(juce::Random::getSystemRandom().nextInt64()).toStdString();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool waitForSandbox_(const pluginSandbox::Block& block, juce::ChildProcess& process)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(G_PLUGIN_SANDBOX_TIMEOUT_MS);
+	while (std::chrono::steady_clock::now() < deadline && process.isRunning())
+	{
+		const pluginSandbox::State state = block.state.load(std::memory_order_acquire);
+		if (state != pluginSandbox::State::STARTING)
+			return state == pluginSandbox::State::READY;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	return false;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+class SandboxedPlugin::Parameter final : public juce::AudioProcessorParameter
+{
+public:
+	Parameter(pluginSandbox::Block& block, int index)
+	: m_block(block)
+	, m_index(index)
+	{
+	}
+
+	float getValue() const override
+	{
+		return m_block.parameters[m_index].load(std::memory_order_relaxed);
+	}
+
+	void setValue(float value) override
+	{
+		m_block.parameters[m_index].store(value, std::memory_order_relaxed);
+		m_block.parametersVersion.fetch_add(1, std::memory_order_release);
+	}
+
+	float getDefaultValue() const override
+	{
+		return m_block.info.parameterDefaults[m_index];
+	}
+
+	juce::String getName(int maximumLength) const override
+	{
+		return juce::String::fromUTF8(m_block.info.parameterNames[m_index]).substring(0, maximumLength);
+	}
+
+	juce::String getLabel() const override
+	{
+		return {};
+	}
+
+	float getValueForText(const juce::String& text) const override
+	{
+		return text.getFloatValue();
+	}
+
+private:
+	pluginSandbox::Block& m_block;
+	int                   m_index;
+};
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::unique_ptr<SandboxedPlugin> SandboxedPlugin::create(const juce::PluginDescription& pd, int sampleRate, int bufferSize)
+{
+	auto memory = std::make_unique<SharedMemory>(makeName_(), sizeof(pluginSandbox::Block), SharedMemory::Mode::CREATE);
+	if (!memory->isValid())
+		return nullptr;
+
+	pluginSandbox::Block& block = *new (memory->getData()) pluginSandbox::Block();
+
+	block.magic      = pluginSandbox::MAGIC;
+	block.sampleRate = sampleRate;
+	block.bufferSize = bufferSize;
+	pd.createXml()->toString().copyToUTF8(block.description, sizeof(block.description));
+
+	/* The sandbox is Giada itself, started in sandbox mode. Its standard
+	streams are not needed. */
+
+	const juce::StringArray args = {
+	    juce::File::getSpecialLocation(juce::File::currentExecutableFile).getFullPathName(),
+	    pluginSandbox::PROCESS_ARG,
+	    memory->getName()};
+
+	auto process = std::make_unique<juce::ChildProcess>();
+	if (!process->start(args, 0))
+	{
+		u::log::print("[SandboxedPlugin::create] unable to start sandbox for {}\n", pd.name.toStdString());
+		return nullptr;
+	}
+
+	if (!waitForSandbox_(block, *process))
+	{
+		u::log::print("[SandboxedPlugin::create] sandbox failed to load {}\n", pd.name.toStdString());
+		process->kill();
+		return nullptr;
+	}
+
+	u::log::print("[SandboxedPlugin::create] {} loaded in sandbox {}\n", pd.name.toStdString(), memory->getName());
+
+	return std::unique_ptr<SandboxedPlugin>(new SandboxedPlugin(pd, std::move(memory), std::move(process)));
+}
+
+/* -------------------------------------------------------------------------- */
+
+SandboxedPlugin::SandboxedPlugin(const juce::PluginDescription& pd, std::unique_ptr<SharedMemory> memory,
+    std::unique_ptr<juce::ChildProcess> process)
+: juce::AudioPluginInstance(BusesProperties()
+                                .withInput("Input", juce::AudioChannelSet::canonicalChannelSet(G_MAX_IO_CHANS), true)
+                                .withOutput("Output", juce::AudioChannelSet::canonicalChannelSet(G_MAX_IO_CHANS), true))
+, m_description(pd)
+, m_memory(std::move(memory))
+, m_process(std::move(process))
+, m_failed(false)
+, m_posted(0)
+, m_lastHeartbeat(0)
+, m_stalledChecks(0)
+, m_watchdog(G_PLUGIN_SANDBOX_WATCHDOG_MS)
+{
+	const pluginSandbox::Block& block = getBlock();
+
+	for (int i = 0; i < block.info.numParameters; i++)
+		addParameter(new Parameter(getBlock(), i));
+
+	setLatencySamples(block.info.latency + block.bufferSize);
+
+	m_watchdog.start([this]()
+	{ watch(); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+SandboxedPlugin::~SandboxedPlugin()
+{
+	m_watchdog.stop();
+
+	getBlock().state.store(pluginSandbox::State::QUIT, std::memory_order_release);
+	if (!m_process->waitForProcessToFinish(G_PLUGIN_SANDBOX_WATCHDOG_MS))
+		m_process->kill();
+}
+
+/* -------------------------------------------------------------------------- */
+
+pluginSandbox::Block& SandboxedPlugin::getBlock() const
+{
+	return *reinterpret_cast<pluginSandbox::Block*>(m_memory->getData());
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool SandboxedPlugin::hasFailed() const
+{
+	return m_failed.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::fail(const std::string& reason)
+{
+	if (m_failed.exchange(true))
+		return;
+	u::log::print("[SandboxedPlugin] {} failed: {}. Audio will pass through from now on\n",
+	    m_description.name.toStdString(), reason);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::watch()
+{
+	pluginSandbox::Block& block = getBlock();
+
+	if (m_failed.load())
+	{
+		if (m_process->isRunning())
+			m_process->kill();
+		return;
+	}
+
+	block.hostHeartbeat.fetch_add(1, std::memory_order_relaxed);
+
+	if (!m_process->isRunning())
+	{
+		fail("sandbox process exited");
+		return;
+	}
+
+	/* The heartbeat stops while a command is being served, e.g. a long state
+	restore: runCommand() has its own timeout for that. */
+
+	const uint64_t heartbeat = block.heartbeat.load(std::memory_order_relaxed);
+	const bool     busy      = block.control.request.load() != block.control.done.load();
+
+	m_stalledChecks = heartbeat == m_lastHeartbeat && !busy ? m_stalledChecks + 1 : 0;
+	m_lastHeartbeat = heartbeat;
+
+	if (m_stalledChecks >= MAX_STALLED_CHECKS)
+		fail("sandbox not responding");
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool SandboxedPlugin::runCommand(pluginSandbox::Command command, int argument, const void* data,
+    std::size_t size, juce::MemoryBlock* out)
+{
+	if (m_failed.load() || size > pluginSandbox::MAX_PAYLOAD)
+		return false;
+
+	std::scoped_lock lock(m_commandMutex);
+
+	pluginSandbox::Control& control = getBlock().control;
+
+	control.command  = command;
+	control.argument = argument;
+	control.size     = size;
+	if (size > 0)
+		std::memcpy(control.payload, data, size);
+
+	const uint32_t request  = control.request.load(std::memory_order_relaxed) + 1;
+	const auto     deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(G_PLUGIN_SANDBOX_TIMEOUT_MS);
+
+	control.request.store(request, std::memory_order_release);
+
+	while (control.done.load(std::memory_order_acquire) != request)
+	{
+		if (m_failed.load())
+			return false;
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			fail("command timed out");
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	if (control.result == 0)
+		return false;
+	if (out != nullptr)
+		out->replaceAll(control.payload, control.size);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::writeSlot(pluginSandbox::Slot& slot, const juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi)
+{
+	const int numFrames   = std::min(buffer.getNumSamples(), pluginSandbox::MAX_FRAMES);
+	const int numChannels = std::min(buffer.getNumChannels(), pluginSandbox::MAX_CHANNELS);
+
+	slot.numFrames = numFrames;
+	for (int i = 0; i < pluginSandbox::MAX_CHANNELS; i++)
+	{
+		if (i < numChannels)
+			std::memcpy(slot.audio[i], buffer.getReadPointer(i), numFrames * sizeof(float));
+		else
+			std::fill_n(slot.audio[i], numFrames, 0.0f);
+	}
+
+	slot.numMidiEvents = 0;
+	for (const juce::MidiMessageMetadata m : midi)
+	{
+		if (m.numBytes > 3 || slot.numMidiEvents == pluginSandbox::MAX_MIDI_EVENTS)
+			continue;
+		pluginSandbox::MidiEvent& e = slot.midi[slot.numMidiEvents++];
+		e.offset                    = m.samplePosition;
+		e.size                      = static_cast<uint8_t>(m.numBytes);
+		std::memcpy(e.data, m.data, m.numBytes);
+	}
+
+	slot.bpm           = 0.0;
+	slot.timeInSamples = 0;
+	slot.timeInSeconds = 0.0;
+	slot.isPlaying     = 0;
+	if (juce::AudioPlayHead* playHead = getPlayHead(); playHead != nullptr)
+	{
+		if (const juce::Optional<juce::AudioPlayHead::PositionInfo> pos = playHead->getPosition(); pos.hasValue())
+		{
+			slot.bpm           = pos->getBpm().orFallback(0.0);
+			slot.timeInSamples = pos->getTimeInSamples().orFallback(0);
+			slot.timeInSeconds = pos->getTimeInSeconds().orFallback(0.0);
+			slot.isPlaying     = pos->getIsPlaying();
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::readSlot(const pluginSandbox::Slot& slot, juce::AudioBuffer<float>& buffer) const
+{
+	const int numFrames   = std::min(buffer.getNumSamples(), static_cast<int>(slot.numFrames));
+	const int numChannels = std::min(buffer.getNumChannels(), pluginSandbox::MAX_CHANNELS);
+
+	buffer.clear();
+	for (int i = 0; i < numChannels; i++)
+		buffer.copyFrom(i, 0, slot.audio[i], numFrames);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+	/* A failed sandbox leaves the audio untouched, as if bypassed. */
+
+	if (m_failed.load(std::memory_order_relaxed))
+	{
+		midi.clear();
+		return;
+	}
+
+	pluginSandbox::Block& block     = getBlock();
+	const uint64_t        completed = block.completed.load(std::memory_order_acquire);
+
+	/* The previous block is ready if the sandbox has caught up with it. A new
+	block can be posted only if the slot it goes into is no longer in use, that
+	is if the sandbox is at most one block behind. Otherwise this block is
+	dropped. Either way the audio thread never waits. */
+
+	const bool ready   = m_posted != 0 && completed == m_posted;
+	const bool canPost = m_posted - completed <= 1;
+
+	if (canPost)
+	{
+		writeSlot(block.slots[(m_posted + 1) % pluginSandbox::NUM_SLOTS], buffer, midi);
+		block.requested.store(m_posted + 1, std::memory_order_release);
+	}
+
+	if (ready)
+		readSlot(block.slots[m_posted % pluginSandbox::NUM_SLOTS], buffer);
+	else
+		buffer.clear();
+
+	if (canPost)
+		m_posted++;
+
+	midi.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::prepareToPlay(double sampleRate, int bufferSize)
+{
+	getBlock().sampleRate = static_cast<int>(sampleRate);
+	getBlock().bufferSize = bufferSize;
+	setLatencySamples(getBlock().info.latency + bufferSize);
+	runCommand(pluginSandbox::Command::PREPARE, bufferSize);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::releaseResources()
+{
+	runCommand(pluginSandbox::Command::RELEASE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::getStateInformation(juce::MemoryBlock& dest)
+{
+	runCommand(pluginSandbox::Command::GET_STATE, 0, nullptr, 0, &dest);
+}
+
+void SandboxedPlugin::setStateInformation(const void* data, int size)
+{
+	runCommand(pluginSandbox::Command::SET_STATE, 0, data, static_cast<std::size_t>(size));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void SandboxedPlugin::setCurrentProgram(int index)
+{
+	runCommand(pluginSandbox::Command::SET_PROGRAM, index);
+}
+
+const juce::String SandboxedPlugin::getProgramName(int index)
+{
+	juce::MemoryBlock name;
+	if (!runCommand(pluginSandbox::Command::PROGRAM_NAME, index, nullptr, 0, &name))
+		return {};
+	return name.toString();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void                        SandboxedPlugin::fillInPluginDescription(juce::PluginDescription& pd) const { pd = m_description; }
+const juce::String          SandboxedPlugin::getName() const { return m_description.name; }
+double                      SandboxedPlugin::getTailLengthSeconds() const { return getBlock().info.tailSeconds; }
+bool                        SandboxedPlugin::acceptsMidi() const { return getBlock().info.acceptsMidi != 0; }
+bool                        SandboxedPlugin::producesMidi() const { return getBlock().info.producesMidi != 0; }
+juce::AudioProcessorEditor* SandboxedPlugin::createEditor() { return nullptr; }
+bool                        SandboxedPlugin::hasEditor() const { return false; }
+int                         SandboxedPlugin::getNumPrograms() { return getBlock().info.numPrograms; }
+int                         SandboxedPlugin::getCurrentProgram() { return getBlock().info.currentProgram.load(); }
+void                        SandboxedPlugin::changeProgramName(int, const juce::String&) {}
+} // namespace giada::m
@@ -0,0 +1,142 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_SANDBOXED_PLUGIN_H
+#define G_SANDBOXED_PLUGIN_H
+
+#if G_OS_WINDOWS
+#undef small
+#define NOMINMAX
+#endif
+
+#include "src/core/plugins/pluginSandbox.h"
+#include "src/core/sharedMemory.h"
+#include "src/core/worker.h"
+#include <atomic>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace giada::m
+{
+/* SandboxedPlugin
+Plug-in instance that forwards everything to a plug-in loaded in a separate
+sandbox process (see pluginSandbox.h). A crash or a hang in the plug-in takes
+down the sandbox only: the watchdog notices it and from then on the audio
+passes through untouched. Audio comes back one buffer late, which is reported
+as extra latency. Plug-in editors are not available. */
+
+class SandboxedPlugin final : public juce::AudioPluginInstance
+{
+public:
+	/* create
+	Starts a sandbox process and waits for it to load the plug-in. Returns
+	nullptr if the sandbox can't be started or the plug-in fails to load. */
+
+	static std::unique_ptr<SandboxedPlugin> create(const juce::PluginDescription&, int sampleRate, int bufferSize);
+
+	~SandboxedPlugin() override;
+
+	/* hasFailed
+	True once the sandbox has crashed, hung or quit unexpectedly. */
+
+	bool hasFailed() const;
+
+	void                        fillInPluginDescription(juce::PluginDescription&) const override;
+	const juce::String          getName() const override;
+	void                        prepareToPlay(double sampleRate, int bufferSize) override;
+	void                        releaseResources() override;
+	void                        processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+	double                      getTailLengthSeconds() const override;
+	bool                        acceptsMidi() const override;
+	bool                        producesMidi() const override;
+	juce::AudioProcessorEditor* createEditor() override;
+	bool                        hasEditor() const override;
+	int                         getNumPrograms() override;
+	int                         getCurrentProgram() override;
+	void                        setCurrentProgram(int) override;
+	const juce::String          getProgramName(int) override;
+	void                        changeProgramName(int, const juce::String&) override;
+	void                        getStateInformation(juce::MemoryBlock&) override;
+	void                        setStateInformation(const void*, int) override;
+
+private:
+	class Parameter;
+
+	SandboxedPlugin(const juce::PluginDescription&, std::unique_ptr<SharedMemory>, std::unique_ptr<juce::ChildProcess>);
+
+	pluginSandbox::Block& getBlock() const;
+
+	/* runCommand
+	Sends a command to the sandbox and waits for it to complete. Returns false
+	on failure or timeout. Not realtime-safe. */
+
+	bool runCommand(pluginSandbox::Command, int argument = 0, const void* data = nullptr,
+	    std::size_t size = 0, juce::MemoryBlock* out = nullptr);
+
+	/* writeSlot, readSlot
+	Move audio, MIDI and transport information in and out of a shared slot.
+	Realtime-safe. */
+
+	void writeSlot(pluginSandbox::Slot&, const juce::AudioBuffer<float>&, const juce::MidiBuffer&);
+	void readSlot(const pluginSandbox::Slot&, juce::AudioBuffer<float>&) const;
+
+	/* watch
+	Watchdog callback. Kills the sandbox process if it has exited, stopped
+	responding or failed in any other way. */
+
+	void watch();
+
+	/* fail
+	Marks the sandbox as failed. The process is killed by the watchdog. */
+
+	void fail(const std::string& reason);
+
+	juce::PluginDescription             m_description;
+	std::unique_ptr<SharedMemory>       m_memory;
+	std::unique_ptr<juce::ChildProcess> m_process;
+	std::mutex                          m_commandMutex;
+	std::atomic<bool>                   m_failed;
+
+	/* m_posted
+	Sequence number of the last block posted to the sandbox. Audio thread
+	only. */
+
+	uint64_t m_posted;
+
+	/* m_lastHeartbeat, m_stalledChecks
+	Sandbox heartbeat seen by the previous watchdog round, and how many rounds
+	in a row it has not moved. Watchdog thread only. */
+
+	uint64_t m_lastHeartbeat;
+	int      m_stalledChecks;
+
+	Worker m_watchdog;
+};
+} // namespace giada::m
+
+#endif
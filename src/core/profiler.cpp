@@ -0,0 +1,291 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "src/core/profiler.h"
+#include <algorithm>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <numeric>
+
+namespace giada::m
+{
+namespace
+{
+std::atomic<uint64_t> nextSerial_ = 1;
+
+/* -------------------------------------------------------------------------- */
+
+constexpr auto PROFILE_KEY_CHANNELS  = "channels";
+constexpr auto PROFILE_KEY_PLUGINS   = "plugins";
+constexpr auto PROFILE_KEY_SEQUENCER = "sequencer";
+constexpr auto PROFILE_KEY_MIXER     = "mixer";
+constexpr auto PROFILE_KEY_DROPPED   = "dropped";
+constexpr auto PROFILE_KEY_ID        = "id";
+constexpr auto PROFILE_KEY_MIN       = "min_us";
+constexpr auto PROFILE_KEY_AVG       = "avg_us";
+constexpr auto PROFILE_KEY_MAX       = "max_us";
+constexpr auto PROFILE_KEY_P99       = "p99_us";
+constexpr auto PROFILE_KEY_COUNT     = "count";
+
+/* -------------------------------------------------------------------------- */
+
+nlohmann::json toJson_(const Profiler::Stats& stats)
+{
+	nlohmann::json j;
+	j[PROFILE_KEY_MIN]   = stats.min;
+	j[PROFILE_KEY_AVG]   = stats.avg;
+	j[PROFILE_KEY_MAX]   = stats.max;
+	j[PROFILE_KEY_P99]   = stats.p99;
+	j[PROFILE_KEY_COUNT] = stats.count;
+	return j;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Profiler::Scope::Scope(Profiler& p, Section section, ID id)
+: m_profiler(p)
+, m_section(section)
+, m_id(id)
+, m_start(std::chrono::steady_clock::now())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Scope::~Scope()
+{
+	m_profiler.record(m_section, m_id, std::chrono::steady_clock::now() - m_start);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Profiler::ThreadSlot::~ThreadSlot()
+{
+	release();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::ThreadSlot::release()
+{
+	if (ring != nullptr)
+		ring->taken.store(false, std::memory_order_release);
+	ring  = nullptr;
+	owner = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool Profiler::Key::operator<(const Key& o) const
+{
+	if (section != o.section)
+		return section < o.section;
+	return id.getValue() < o.id.getValue();
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Profiler::Profiler()
+: m_dropped(0)
+, m_serial(nextSerial_.fetch_add(1))
+{
+	for (std::shared_ptr<Ring>& ring : m_rings)
+		ring = std::make_shared<Ring>();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::record(Section section, ID id, std::chrono::nanoseconds time)
+{
+	Ring* ring = getThreadRing();
+	if (ring == nullptr)
+	{
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	const std::size_t head = ring->head.load(std::memory_order_relaxed);
+	if (head - ring->tail.load(std::memory_order_acquire) == G_PROFILER_RING_SIZE)
+	{
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	const auto nanos = std::min<std::chrono::nanoseconds::rep>(time.count(), std::numeric_limits<uint32_t>::max());
+
+	ring->samples[head % G_PROFILER_RING_SIZE] = {section, id, static_cast<uint32_t>(nanos)};
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::collect()
+{
+	std::scoped_lock lock(m_mutex);
+
+	for (auto& [key, window] : m_windows)
+		window.idle++;
+
+	for (const std::shared_ptr<Ring>& ring : m_rings)
+	{
+		const std::size_t head = ring->head.load(std::memory_order_acquire);
+		std::size_t       tail = ring->tail.load(std::memory_order_relaxed);
+
+		for (; tail != head; tail++)
+		{
+			const Sample& sample = ring->samples[tail % G_PROFILER_RING_SIZE];
+			Window&       window = m_windows[{sample.section, sample.id}];
+			const float   micros = sample.nanos / 1000.0f;
+
+			if (window.values.size() < G_PROFILER_WINDOW)
+				window.values.push_back(micros);
+			else
+				window.values[window.next] = micros;
+			window.next = (window.next + 1) % G_PROFILER_WINDOW;
+			window.idle = 0;
+		}
+
+		ring->tail.store(tail, std::memory_order_release);
+	}
+
+	std::erase_if(m_windows, [](const auto& pair)
+	{ return pair.second.idle >= G_PROFILER_EXPIRY; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::clear()
+{
+	std::scoped_lock lock(m_mutex);
+	m_windows.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Stats Profiler::getStats(Section section, ID id) const
+{
+	std::scoped_lock lock(m_mutex);
+
+	const auto it = m_windows.find({section, id});
+	return it == m_windows.end() ? Stats{} : computeStats(it->second);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::string Profiler::toJson() const
+{
+	std::scoped_lock lock(m_mutex);
+
+	nlohmann::json j;
+	j[PROFILE_KEY_CHANNELS] = nlohmann::json::array();
+	j[PROFILE_KEY_PLUGINS]  = nlohmann::json::array();
+
+	for (const auto& [key, window] : m_windows)
+	{
+		nlohmann::json jstats = toJson_(computeStats(window));
+
+		switch (key.section)
+		{
+		case Section::CHANNEL:
+			jstats[PROFILE_KEY_ID] = key.id.getValue();
+			j[PROFILE_KEY_CHANNELS].push_back(jstats);
+			break;
+		case Section::PLUGIN:
+			jstats[PROFILE_KEY_ID] = key.id.getValue();
+			j[PROFILE_KEY_PLUGINS].push_back(jstats);
+			break;
+		case Section::SEQUENCER:
+			j[PROFILE_KEY_SEQUENCER] = jstats;
+			break;
+		case Section::MIXER:
+			j[PROFILE_KEY_MIXER] = jstats;
+			break;
+		}
+	}
+
+	j[PROFILE_KEY_DROPPED] = m_dropped.load(std::memory_order_relaxed);
+
+	return j.dump(4);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Ring* Profiler::getThreadRing()
+{
+	thread_local ThreadSlot slot;
+
+	if (slot.owner == m_serial)
+		return slot.ring.get();
+
+	slot.release();
+	slot.owner = m_serial;
+
+	for (const std::shared_ptr<Ring>& ring : m_rings)
+	{
+		bool expected = false;
+		if (ring->taken.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+		{
+			slot.ring = ring;
+			break;
+		}
+	}
+
+	return slot.ring.get();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Stats Profiler::computeStats(const Window& window) const
+{
+	if (window.values.empty())
+		return {};
+
+	std::vector<float> values = window.values;
+
+	const std::size_t p99Index = values.size() * 99 / 100;
+	std::nth_element(values.begin(), values.begin() + p99Index, values.end());
+
+	const auto [min, max] = std::minmax_element(values.begin(), values.end());
+
+	return {
+	    *min,
+	    std::accumulate(values.begin(), values.end(), 0.0f) / values.size(),
+	    *max,
+	    values[p99Index],
+	    values.size()};
+}
+} // namespace giada::m
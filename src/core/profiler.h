@@ -0,0 +1,193 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_PROFILER_H
+#define G_PROFILER_H
+
+#include "src/core/const.h"
+#include "src/types.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace giada::m
+{
+/* Profiler
+Lightweight timing of the realtime rendering. Each rendering thread writes its
+measurements into a private single-producer, single-consumer ring, with no locks
+nor allocations. A non-realtime thread periodically drains all rings with
+collect() into rolling statistics, one set for each measured section. */
+
+class Profiler final
+{
+public:
+	enum class Section : uint8_t
+	{
+		CHANNEL,   // A Channel, plug-ins included, or a bus and its plug-ins
+		PLUGIN,    // A single plug-in
+		SEQUENCER, // Sequencer::advance
+		MIXER      // Mixer::render
+	};
+
+	/* Stats
+	Rolling statistics over the last G_PROFILER_WINDOW timings, in
+	microseconds. */
+
+	struct Stats
+	{
+		float       min   = 0.0f;
+		float       avg   = 0.0f;
+		float       max   = 0.0f;
+		float       p99   = 0.0f;
+		std::size_t count = 0;
+	};
+
+	/* Scope
+	Measures its own lifetime and records it on destruction. Realtime-safe. */
+
+	class Scope
+	{
+	public:
+		Scope(Profiler&, Section, ID = {});
+		~Scope();
+
+	private:
+		Profiler&                             m_profiler;
+		Section                               m_section;
+		ID                                    m_id;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	Profiler();
+
+	/* record
+	Stores a timing from the calling thread. Realtime-safe. The timing is
+	dropped if the ring of the thread is full or if there are no rings left. */
+
+	void record(Section, ID, std::chrono::nanoseconds);
+
+	/* collect
+	Drains the rings of all threads into the statistics. Sections with no new
+	timings for G_PROFILER_EXPIRY collections in a row are discarded, so that
+	deleted channels and plug-ins don't pile up. Non-realtime. */
+
+	void collect();
+
+	/* clear
+	Discards all statistics collected so far. */
+
+	void clear();
+
+	Stats getStats(Section, ID = {}) const;
+
+	/* toJson
+	Returns all statistics as a JSON document. */
+
+	std::string toJson() const;
+
+private:
+	struct Sample
+	{
+		Section  section;
+		ID       id;
+		uint32_t nanos;
+	};
+
+	struct Ring
+	{
+		std::array<Sample, G_PROFILER_RING_SIZE> samples;
+		std::atomic<std::size_t>                 head  = 0; // Written by the producer
+		std::atomic<std::size_t>                 tail  = 0; // Written by the consumer
+		std::atomic<bool>                        taken = false;
+	};
+
+	/* ThreadSlot
+	The ring owned by a thread, given back when the thread exits. The ring is
+	shared, so that it outlives the Profiler if the thread does. */
+
+	struct ThreadSlot
+	{
+		~ThreadSlot();
+
+		void release();
+
+		uint64_t              owner = 0;
+		std::shared_ptr<Ring> ring;
+	};
+
+	struct Key
+	{
+		bool operator<(const Key&) const;
+
+		Section section;
+		ID      id;
+	};
+
+	/* Window
+	The last G_PROFILER_WINDOW timings of a section, in microseconds, and the
+	number of collections in a row with no new timings. */
+
+	struct Window
+	{
+		std::vector<float> values;
+		std::size_t        next = 0;
+		int                idle = 0;
+	};
+
+	/* getThreadRing
+	Returns the ring of the calling thread, taking a free one on the first call.
+	Returns nullptr if all rings are taken. */
+
+	Ring* getThreadRing();
+
+	Stats computeStats(const Window&) const;
+
+	/* m_rings
+	One for the audio thread plus one for each render worker. */
+
+	std::array<std::shared_ptr<Ring>, G_MAX_RENDER_THREADS + 1> m_rings;
+	std::atomic<uint64_t>                                       m_dropped;
+
+	/* m_serial
+	Unique among all Profiler instances, tells threads which Profiler their
+	ring belongs to. */
+
+	uint64_t m_serial;
+
+	std::map<Key, Window> m_windows;
+	mutable std::mutex    m_mutex;
+};
+} // namespace giada::m
+
+#endif
@@ -55,17 +55,17 @@ void Quantizer::advance(SampleRange block, Frame quantizerStep) const
 		return;
 
 	assert(m_callbacks.count(pid) > 0);
+	assert(quantizerStep > 0);
 
-	for (Frame global = block.a, local = 0; global < block.b; global++, local++)
-	{
+	/* Jump straight to the first quantization unit in the block, if any. */
 
-		if (global % quantizerStep != 0) // Skip if it's not on a quantization unit.
-			continue;
+	const Frame next = ((block.a + quantizerStep - 1) / quantizerStep) * quantizerStep;
 
-		m_callbacks.at(pid)(local);
-		m_performId.store(-1);
+	if (next >= block.b)
 		return;
-	}
+
+	m_callbacks.at(pid)(next - block.a);
+	m_performId.store(-1);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -0,0 +1,157 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "src/core/rendering/automationRendering.h"
+#include "src/core/channels/channel.h"
+#include "src/core/dsp.h"
+#include "src/core/pan.h"
+#include "src/core/plugins/plugin.h"
+
+namespace giada::m::rendering
+{
+namespace
+{
+constexpr float PAN_CENTER = 0.5f;
+
+/* -------------------------------------------------------------------------- */
+
+/* setPluginParam_
+Moves a plug-in parameter to the value of the curve at frame 'frame'. Values
+are set only if changed, to avoid flooding the plug-in with notifications. */
+
+void setPluginParam_(const Channel& ch, const AutomationCurve& curve, Frame frame)
+{
+	for (const Plugin* p : ch.plugins)
+	{
+		if (p->id != curve.pluginId)
+			continue;
+		if (!p->valid || curve.pluginParam < 0 || curve.pluginParam >= p->getNumParameters())
+			return;
+
+		const float value = curve.valueAt(frame);
+		if (p->getParameter(curve.pluginParam) != value)
+			p->setParameter(curve.pluginParam, value);
+		return;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+template <typename Buffer>
+void applyVolume_(Buffer& buffer, const AutomationCurve::Segments& segments)
+{
+	for (const AutomationCurve::Segment& s : segments)
+		dsp::applyGain(buffer, {{s.from, s.from}, {s.to, s.to}}, s.a, s.b);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* applyPan_
+Pan gains are linear on each side of the center only: segments crossing it
+are split in two. */
+
+template <typename Buffer>
+void applyPan_(Buffer& buffer, const AutomationCurve::Segments& segments)
+{
+	for (const AutomationCurve::Segment& s : segments)
+	{
+		if ((s.from - PAN_CENTER) * (s.to - PAN_CENTER) >= 0.0f)
+		{
+			dsp::applyGain(buffer, {Pan(s.from).get(), Pan(s.to).get()}, s.a, s.b);
+			continue;
+		}
+
+		const int center = s.a + static_cast<int>((PAN_CENTER - s.from) / (s.to - s.from) * (s.b - s.a));
+
+		dsp::applyGain(buffer, {Pan(s.from).get(), Pan(PAN_CENTER).get()}, s.a, center);
+		dsp::applyGain(buffer, {Pan(PAN_CENTER).get(), Pan(s.to).get()}, center, s.b);
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void advanceAutomation(const Channel& ch, std::span<const AutomationCurve> curves, Scene scene, SampleRange block,
+    Frame framesInLoop)
+{
+	ChannelShared::Automation& automation = ch.shared->automation;
+
+	automation.reset();
+
+	for (const AutomationCurve& curve : curves)
+	{
+		if (curve.scene != scene)
+			continue;
+
+		switch (curve.param)
+		{
+		case AutomationParam::VOLUME:
+			curve.getSegments(block.a, block.b - block.a, framesInLoop, automation.volume);
+			break;
+
+		case AutomationParam::PAN:
+			curve.getSegments(block.a, block.b - block.a, framesInLoop, automation.pan);
+			break;
+
+		case AutomationParam::PITCH:
+			automation.pitch = AutomationCurve::toParamValue(curve.param, curve.valueAt(block.a));
+			break;
+
+		case AutomationParam::PLUGIN:
+			setPluginParam_(ch, curve, block.a);
+			break;
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void resetAutomation(const Channel& ch)
+{
+	ch.shared->automation.reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void renderAutomation(const Channel& ch, bool planar)
+{
+	ChannelShared&                   shared     = *ch.shared;
+	const ChannelShared::Automation& automation = shared.automation;
+
+	if (planar)
+	{
+		applyVolume_(shared.pluginBuffer.audio, automation.volume);
+		applyPan_(shared.pluginBuffer.audio, automation.pan);
+	}
+	else
+	{
+		applyVolume_(shared.audioBuffer, automation.volume);
+		applyPan_(shared.audioBuffer, automation.pan);
+	}
+}
+} // namespace giada::m::rendering
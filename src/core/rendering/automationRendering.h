@@ -0,0 +1,63 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RENDERING_AUTOMATION_RENDERING_H
+#define G_RENDERING_AUTOMATION_RENDERING_H
+
+#include "src/core/actions/automationCurve.h"
+#include "src/core/types.h"
+#include <span>
+
+namespace giada::m
+{
+class Channel;
+}
+
+namespace giada::m::rendering
+{
+/* advanceAutomation
+Computes the automation of Channel 'ch' for the frames in 'block', out of the
+curves recorded on it in the given scene. Plug-in parameters are set right
+away, once per block, since plug-ins process whole blocks. */
+
+void advanceAutomation(const Channel& ch, std::span<const AutomationCurve>, Scene, SampleRange block,
+    Frame framesInLoop);
+
+/* resetAutomation
+Stops automating the parameters of Channel 'ch', e.g. when the sequencer is
+not running. */
+
+void resetAutomation(const Channel& ch);
+
+/* renderAutomation
+Applies the automated volume and pan to the rendered audio of Channel 'ch',
+in place. 'planar' tells whether the audio lives in the planar plug-in buffer
+of the Channel rather than in its audio buffer. */
+
+void renderAutomation(const Channel& ch, bool planar);
+} // namespace giada::m::rendering
+
+#endif
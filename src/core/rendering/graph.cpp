@@ -0,0 +1,105 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/rendering/graph.h"
+#include "src/const.h"
+#include "src/core/model/track.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <cassert>
+
+namespace giada::m::rendering
+{
+namespace
+{
+const Channel* findMasterOut_(const std::vector<model::Track>& tracks)
+{
+	for (const model::Track& track : tracks)
+		if (const Channel* ch = track.findChannel(MASTER_OUT_CHANNEL_ID); ch != nullptr)
+			return ch;
+	return nullptr;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void Graph::compile(const std::vector<model::Track>& tracks)
+{
+	m_nodes.clear();
+	m_stages.clear();
+
+	const Channel*            masterOutCh     = findMasterOut_(tracks);
+	mcl::AudioBuffer*         masterOut       = masterOutCh != nullptr ? &masterOutCh->shared->audioBuffer : nullptr;
+	juce::AudioBuffer<float>* planarMasterOut = masterOutCh != nullptr ? &masterOutCh->shared->pluginBuffer.audio : nullptr;
+
+	for (const model::Track& track : tracks)
+	{
+		if (track.isInternal())
+			continue;
+
+		const Channel&            group     = track.getGroupChannel();
+		mcl::AudioBuffer*         bus       = &group.shared->audioBuffer;
+		juce::AudioBuffer<float>* planarBus = &group.shared->pluginBuffer.audio;
+		const std::size_t         first     = m_nodes.size();
+
+		/* Channels first, each one summed into the group bus. The group
+		channel itself is the first one in the Track: skip it. */
+
+		for (const Channel& ch : track.getChannels().getAll())
+		{
+			if (ch.type == ChannelType::GROUP)
+				continue;
+			m_nodes.push_back({Node::Type::CHANNEL, &ch, &ch.shared->audioBuffer,
+			    ch.sendToMaster ? bus : nullptr, ch.sendToMaster ? planarBus : nullptr});
+		}
+
+		/* Then the group bus, which feeds the master output. */
+
+		m_nodes.push_back({Node::Type::BUS, &group, bus,
+		    group.sendToMaster ? masterOut : nullptr, group.sendToMaster ? planarMasterOut : nullptr});
+
+		m_stages.push_back({first, m_nodes.size(), bus, planarBus});
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+const std::vector<Graph::Stage>& Graph::getStages() const
+{
+	return m_stages;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::span<const Graph::Node> Graph::getNodes(const Stage& stage) const
+{
+	assert(stage.last <= m_nodes.size());
+
+	return {m_nodes.data() + stage.first, stage.last - stage.first};
+}
+} // namespace giada::m::rendering
@@ -0,0 +1,106 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_RENDERING_GRAPH_H
+#define G_RENDERING_GRAPH_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace juce
+{
+template <typename Type>
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+class Channel;
+}
+
+namespace giada::m::model
+{
+class Track;
+}
+
+namespace giada::m::rendering
+{
+/* Graph
+A compiled, flat representation of the audio routing described by the Tracks.
+Nodes are stored in topological order (sources first, then the bus they feed)
+with all buffer pointers already resolved, so that the realtime thread only
+walks a contiguous array. Nodes are grouped into Stages: each Stage is an
+independent sub-graph that can be rendered concurrently with the others. */
+
+class Graph
+{
+public:
+	struct Node
+	{
+		enum class Type
+		{
+			CHANNEL, // Renders audio (samples, MIDI plug-ins) into its buffer
+			BUS      // Processes the audio summed into its buffer by other nodes
+		};
+
+		Type                      type;
+		const Channel*            channel;
+		mcl::AudioBuffer*         buffer;     // Buffer this node renders into
+		mcl::AudioBuffer*         send;       // Buffer this node is summed into, nullptr if none
+		juce::AudioBuffer<float>* planarSend; // Same as 'send', when buses are planar
+	};
+
+	struct Stage
+	{
+		std::size_t               first;     // Index of the first node
+		std::size_t               last;      // Index of one past the last node
+		mcl::AudioBuffer*         bus;       // Buffer to clean up before rendering the Stage
+		juce::AudioBuffer<float>* planarBus; // Same as 'bus', when buses are planar
+	};
+
+	/* compile
+	Rebuilds the graph out of a list of Tracks. Nodes point to Channels inside
+	'tracks', so the graph must be recompiled whenever those move in memory. */
+
+	void compile(const std::vector<model::Track>& tracks);
+
+	const std::vector<Stage>& getStages() const;
+	std::span<const Node>     getNodes(const Stage&) const;
+
+private:
+	std::vector<Node>  m_nodes;
+	std::vector<Stage> m_stages;
+};
+} // namespace giada::m::rendering
+
+#endif
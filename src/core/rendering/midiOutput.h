@@ -30,6 +30,7 @@
 #include "src/core/channels/channelShared.h"
 #include "src/core/midiEvent.h"
 #include "src/core/midiMapper.h"
+#include <span>
 
 namespace giada::m
 {
@@ -48,7 +49,7 @@ void registerOnSendMidiCb(std::function<void(ID channelId)>);
 /* sendMidiFromActions
 Sends a corresponding MIDI event for each action in the action vector. */
 
-void sendMidiFromActions(const Channel&, Scene, const std::vector<Action>&, Frame delta, KernelMidi&);
+void sendMidiFromActions(const Channel&, Scene, std::span<const Action>, Frame delta, KernelMidi&);
 
 /* sendMidiAllNotesOff
 Sends a G_MIDI_ALL_NOTES_OFF event to the outside world and plug-ins. */
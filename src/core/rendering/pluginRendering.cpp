@@ -60,7 +60,7 @@ const juce::MidiBuffer& prepareMidiBuffer_(ChannelShared& shared)
 
 void renderAudioAndMidiPlugins(const Channel& ch, PluginHost& pluginHost)
 {
-	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, &prepareMidiBuffer_(*ch.shared));
+	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, &prepareMidiBuffer_(*ch.shared), ch.shared->pluginBuffer);
 	ch.shared->midiBuffer.clear();
 }
 
@@ -68,6 +68,28 @@ void renderAudioAndMidiPlugins(const Channel& ch, PluginHost& pluginHost)
 
 void renderAudioPlugins(const Channel& ch, PluginHost& pluginHost)
 {
-	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, nullptr);
+	pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, nullptr, ch.shared->pluginBuffer);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void renderPlanarAudioAndMidiPlugins(const Channel& ch, PluginHost& pluginHost)
+{
+	pluginHost.processPlanarStack(ch.shared->audioBuffer, ch.plugins, &prepareMidiBuffer_(*ch.shared), ch.shared->pluginBuffer);
+	ch.shared->midiBuffer.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void renderPlanarAudioPlugins(const Channel& ch, PluginHost& pluginHost)
+{
+	pluginHost.processPlanarStack(ch.shared->audioBuffer, ch.plugins, nullptr, ch.shared->pluginBuffer);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void renderBusPlugins(const Channel& ch, PluginHost& pluginHost)
+{
+	pluginHost.processPlanarStack(ch.shared->pluginBuffer.audio, ch.plugins, nullptr, ch.shared->pluginBuffer);
 }
 } // namespace giada::m::rendering
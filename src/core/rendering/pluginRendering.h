@@ -46,6 +46,20 @@ void renderAudioAndMidiPlugins(const Channel&, PluginHost&);
 Renders audio-only plug-ins. */
 
 void renderAudioPlugins(const Channel&, PluginHost&);
+
+/* renderPlanarAudioAndMidiPlugins, renderPlanarAudioPlugins
+Same as above, but the result is left planar in the Channel's plug-in buffer
+instead of being interleaved back into its audio buffer. Used when buses are
+planar. */
+
+void renderPlanarAudioAndMidiPlugins(const Channel&, PluginHost&);
+void renderPlanarAudioPlugins(const Channel&, PluginHost&);
+
+/* renderBusPlugins
+Renders audio-only plug-ins in place on the planar bus held by the Channel's
+plug-in buffer. */
+
+void renderBusPlugins(const Channel&, PluginHost&);
 } // namespace giada::m::rendering
 
 #endif
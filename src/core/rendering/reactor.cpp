@@ -30,6 +30,7 @@
 #include "src/core/rendering/midiOutput.h"
 #include "src/core/rendering/midiReactions.h"
 #include "src/core/rendering/sampleReactions.h"
+#include <utility>
 
 namespace giada::m::rendering
 {
@@ -45,7 +46,7 @@ Reactor::Reactor(model::Model& model, MidiMapper<KernelMidi>& m, ActionRecorder&
 
 void Reactor::keyPress(ID channelId, Scene scene, float velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized)
 {
-	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 
 	if (ch.type == ChannelType::MIDI)
 	{
@@ -70,9 +71,8 @@ void Reactor::keyPress(ID channelId, Scene scene, float velocity, bool canRecord
 	}
 	else if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
-			if (child.type != ChannelType::GROUP)
-				keyPress(child.id, scene, velocity, canRecordActions, canQuantize, currentFrameQuantized);
+		for (const ID childId : std::as_const(m_model.get().tracks).getByChannel(ch.id).getChildrenIds())
+			keyPress(childId, scene, velocity, canRecordActions, canQuantize, currentFrameQuantized);
 	}
 
 	m_model.swap(model::SwapType::SOFT);
@@ -82,7 +82,7 @@ void Reactor::keyPress(ID channelId, Scene scene, float velocity, bool canRecord
 
 void Reactor::keyRelease(ID channelId, Scene scene, bool canRecordActions, Frame currentFrameQuantized)
 {
-	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 
 	if (ch.type == ChannelType::MIDI)
 		return;
@@ -107,9 +107,8 @@ void Reactor::keyRelease(ID channelId, Scene scene, bool canRecordActions, Frame
 	}
 	else if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
-			if (child.type != ChannelType::GROUP)
-				keyRelease(child.id, scene, canRecordActions, currentFrameQuantized);
+		for (const ID childId : std::as_const(m_model.get().tracks).getByChannel(ch.id).getChildrenIds())
+			keyRelease(childId, scene, canRecordActions, currentFrameQuantized);
 	}
 
 	m_model.swap(model::SwapType::SOFT);
@@ -119,7 +118,7 @@ void Reactor::keyRelease(ID channelId, Scene scene, bool canRecordActions, Frame
 
 void Reactor::keyKill(ID channelId, Scene scene, bool canRecordActions, Frame currentFrameQuantized)
 {
-	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 
 	if (ch.type == ChannelType::MIDI)
 	{
@@ -145,9 +144,8 @@ void Reactor::keyKill(ID channelId, Scene scene, bool canRecordActions, Frame cu
 	}
 	else if (ch.type == ChannelType::GROUP)
 	{
-		for (const Channel& child : m_model.get().tracks.getByChannel(ch.id).getChannels().getAll())
-			if (child.type != ChannelType::GROUP)
-				keyKill(child.id, scene, canRecordActions, currentFrameQuantized);
+		for (const ID childId : std::as_const(m_model.get().tracks).getByChannel(ch.id).getChildrenIds())
+			keyKill(childId, scene, canRecordActions, currentFrameQuantized);
 	}
 
 	m_model.swap(model::SwapType::SOFT);
@@ -157,7 +155,7 @@ void Reactor::keyKill(ID channelId, Scene scene, bool canRecordActions, Frame cu
 
 void Reactor::processMidiEvent(ID channelId, Scene scene, const MidiEvent& e, bool canRecordActions, Frame currentFrameQuantized)
 {
-	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 
 	assert(ch.type == ChannelType::MIDI);
 
@@ -175,7 +173,7 @@ void Reactor::processMidiEvent(ID channelId, Scene scene, const MidiEvent& e, bo
 
 void Reactor::toggleReadActions(ID channelId, bool seqIsRunning)
 {
-	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 	toggleSampleReadActions(*ch.shared, m_model.get().behaviors.treatRecsAsLoops, seqIsRunning);
 }
 
@@ -188,7 +186,7 @@ void Reactor::killReadActions(ID channelId)
 
 	if (!m_model.get().behaviors.treatRecsAsLoops)
 		return;
-	Channel& ch = m_model.get().tracks.getChannel(channelId);
+	const Channel& ch = std::as_const(m_model.get().tracks).getChannel(channelId);
 	killSampleReadActions(*ch.shared);
 }
 
@@ -298,11 +296,8 @@ void Reactor::setScene(Scene scene)
 {
 	/* Stop all channels that don't have a Wave to play for the selected scene. */
 
-	m_model.get().tracks.forEachChannel([scene](Channel& ch)
-	{
-		if (!ch.isInternal() && ch.type == ChannelType::SAMPLE && !ch.hasWave(scene) && ch.isPlaying())
-			killSampleChannel(*ch.shared, ch.sampleChannel->mode);
-		return true;
-	});
+	for (const Channel* ch : std::as_const(m_model.get().tracks).getChannels())
+		if (!ch->isInternal() && ch->type == ChannelType::SAMPLE && !ch->hasWave(scene) && ch->isPlaying())
+			killSampleChannel(*ch->shared, ch->sampleChannel->mode);
 }
 } // namespace giada::m::rendering
@@ -0,0 +1,251 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/rendering/renderPool.h"
+#include "src/utils/log.h"
+#include <cassert>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define G_CPU_PAUSE() _mm_pause()
+#elif defined(_M_ARM64)
+#include <intrin.h>
+#define G_CPU_PAUSE() __yield()
+#elif defined(__aarch64__) || defined(__arm__)
+#define G_CPU_PAUSE() __asm__ __volatile__("yield")
+#else
+#define G_CPU_PAUSE()
+#endif
+
+namespace giada::m::rendering
+{
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "RenderPool needs lock-free 64-bit atomics");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "RenderPool needs lock-free 32-bit atomics");
+
+/* -------------------------------------------------------------------------- */
+
+class RenderPool::Worker final : public juce::Thread
+{
+public:
+	Worker(const RenderPool& pool, int index)
+	: juce::Thread("Giada render worker " + juce::String(index))
+	, m_pool(pool)
+	{
+	}
+
+	void run() override
+	{
+		const juce::ScopedNoDenormals noDenormals;
+		m_pool.workerLoop();
+	}
+
+private:
+	const RenderPool& m_pool;
+};
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+RenderPool::RenderPool()
+: m_state(0)
+, m_wake(0)
+, m_done(0)
+, m_ctx(nullptr)
+, m_fn(nullptr)
+, m_running(false)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+RenderPool::~RenderPool()
+{
+	stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::start(int numWorkers)
+{
+	stop();
+
+	if (numWorkers <= 0)
+		return;
+
+	m_running.store(true);
+
+	for (int i = 0; i < numWorkers; i++)
+	{
+		auto worker = std::make_unique<Worker>(*this, i);
+		if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(10)))
+		{
+			u::log::print("[RenderPool::start] can't start realtime worker {}, using high priority instead\n", i);
+			worker->startThread(juce::Thread::Priority::highest);
+		}
+		m_workers.push_back(std::move(worker));
+	}
+
+	u::log::print("[RenderPool::start] {} render workers started\n", numWorkers);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::stop()
+{
+	if (m_workers.empty())
+		return;
+
+	/* Publish a new, empty generation to wake up sleeping workers, which will
+	then notice that the pool is no longer running. */
+
+	m_running.store(false);
+	m_state.fetch_add(GEN_ONE);
+	m_wake.fetch_add(1);
+	m_wake.notify_all();
+
+	for (std::unique_ptr<Worker>& worker : m_workers)
+		worker->stopThread(/*timeOutMilliseconds=*/-1);
+	m_workers.clear();
+
+	u::log::print("[RenderPool::stop] render workers stopped\n");
+}
+
+/* -------------------------------------------------------------------------- */
+
+int RenderPool::countWorkers() const
+{
+	return static_cast<int>(m_workers.size());
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t RenderPool::getIndex(std::uint64_t state) { return (state >> 16) & MAX_JOBS; }
+std::size_t RenderPool::getCount(std::uint64_t state) { return state & MAX_JOBS; }
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::dispatch(std::size_t count, const void* ctx, JobFn fn) const
+{
+	assert(count <= MAX_JOBS);
+
+	if (count == 0)
+		return;
+
+	m_ctx = ctx;
+	m_fn  = fn;
+	m_done.store(0, std::memory_order_relaxed);
+
+	/* Publish the new generation with its jobs. Context and job function above
+	become visible to any worker that successfully claims a job from it. */
+
+	const std::uint64_t generation = (m_state.load(std::memory_order_relaxed) & ~(GEN_ONE - 1)) + GEN_ONE;
+	std::uint64_t       state      = generation | count;
+
+	m_state.store(state, std::memory_order_release);
+	if (!m_workers.empty())
+	{
+		m_wake.fetch_add(1, std::memory_order_release);
+		m_wake.notify_all();
+	}
+
+	/* Run any job not claimed yet right here, instead of waiting for a worker
+	to wake up. Only then wait for the jobs still in progress on workers. */
+
+	while (runNext(state))
+		;
+	waitForWorkers(count);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::waitForWorkers(std::size_t count) const
+{
+	for (int i = 0; m_done.load(std::memory_order_acquire) < count; i++)
+	{
+		if (i >= SPIN_COUNT && i % YIELD_COUNT == 0)
+			std::this_thread::yield();
+		else
+			G_CPU_PAUSE();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderPool::runNext(std::uint64_t& state) const
+{
+	while (getIndex(state) < getCount(state))
+	{
+		if (!m_state.compare_exchange_weak(state, state + INDEX_ONE,
+		        std::memory_order_acq_rel, std::memory_order_acquire))
+			continue; // 'state' has been refreshed, try again
+
+		m_fn(m_ctx, getIndex(state));
+		m_done.fetch_add(1, std::memory_order_release);
+		return true;
+	}
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::workerLoop() const
+{
+	std::uint64_t state = m_state.load(std::memory_order_acquire);
+
+	while (m_running.load(std::memory_order_acquire))
+	{
+		if (runNext(state))
+			continue;
+
+		/* Nothing to do. Spin for a little while in case other jobs are about
+		to be published, then sleep until woken up. The wake word is read before
+		the last look at the state, so that a generation published in between
+		is never missed. */
+
+		const std::uint64_t idle = state;
+		for (int i = 0; i < SPIN_COUNT && state == idle; i++)
+		{
+			G_CPU_PAUSE();
+			state = m_state.load(std::memory_order_acquire);
+		}
+
+		if (state == idle)
+		{
+			const std::uint32_t wake = m_wake.load(std::memory_order_acquire);
+			state                    = m_state.load(std::memory_order_acquire);
+			if (state == idle)
+			{
+				m_wake.wait(wake, std::memory_order_acquire);
+				state = m_state.load(std::memory_order_acquire);
+			}
+		}
+	}
+}
+} // namespace giada::m::rendering
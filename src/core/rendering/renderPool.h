@@ -0,0 +1,136 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_RENDERING_RENDER_POOL_H
+#define G_RENDERING_RENDER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace giada::m::rendering
+{
+/* RenderPool
+A set of pre-spawned, realtime-priority worker threads that help the audio
+thread to process independent jobs (e.g. Tracks) concurrently. Jobs are claimed
+through a single atomic counter: no locks and no allocations take place while
+running. The calling thread always takes part in the processing, so a pool with
+zero workers simply runs everything serially. */
+
+class RenderPool
+{
+public:
+	RenderPool();
+	~RenderPool();
+
+	/* start
+	Spawns 'numWorkers' threads. Any previously running worker is stopped first.
+	Must be called by a non-realtime thread while the mixer is disabled. */
+
+	void start(int numWorkers);
+
+	/* stop
+	Stops and joins all workers. */
+
+	void stop();
+
+	int countWorkers() const;
+
+	/* run
+	Invokes 'f(i)' for each 'i' in [0, count) across the calling thread and the
+	workers, and returns when all jobs have completed. Realtime safe. The order
+	in which jobs are executed is unspecified: each job must only write to data
+	that no other job touches. */
+
+	template <typename F>
+	void run(std::size_t count, F&& f) const
+	{
+		dispatch(count, &f, [](const void* ctx, std::size_t i)
+		{ (*static_cast<const std::remove_reference_t<F>*>(ctx))(i); });
+	}
+
+private:
+	class Worker;
+
+	using JobFn = void (*)(const void* ctx, std::size_t index);
+
+	/* State layout
+	The state word packs a generation counter (bits 32-63), the index of the
+	next job to claim (bits 16-31) and the total number of jobs (bits 0-15). A
+	new generation is published for each run() call, so that stale claims from
+	a previous one always fail. Claims only use compare-and-swap, which is
+	lock-free on 64-bit words. Sleeping and waking up use the separate 32-bit
+	m_wake word instead, which maps to a futex (or equivalent) everywhere. */
+
+	static constexpr std::uint64_t INDEX_ONE   = 1ull << 16;
+	static constexpr std::uint64_t GEN_ONE     = 1ull << 32;
+	static constexpr std::size_t   MAX_JOBS    = 0xFFFF;
+	static constexpr int           SPIN_COUNT  = 2048;
+	static constexpr int           YIELD_COUNT = 64;
+
+	static std::size_t getIndex(std::uint64_t state);
+	static std::size_t getCount(std::uint64_t state);
+
+	/* dispatch
+	Type-erased implementation of run(). */
+
+	void dispatch(std::size_t count, const void* ctx, JobFn fn) const;
+
+	/* runNext
+	Tries to claim and run a job. Returns false if there are no jobs left in
+	the current generation. 'state' is updated with the last known value. */
+
+	bool runNext(std::uint64_t& state) const;
+
+	/* waitForWorkers
+	Waits until 'count' jobs have been completed. Spins with a CPU pause, then
+	yields the CPU, so that a preempted worker running on the same core can
+	finish its job. */
+
+	void waitForWorkers(std::size_t count) const;
+
+	/* workerLoop
+	Main loop of each worker: spins for a while, then sleeps until a new
+	generation is published. */
+
+	void workerLoop() const;
+
+	std::vector<std::unique_ptr<Worker>> m_workers;
+
+	mutable std::atomic<std::uint64_t> m_state;
+	mutable std::atomic<std::uint32_t> m_wake;
+	mutable std::atomic<std::uint32_t> m_done;
+	mutable const void*                m_ctx;
+	mutable JobFn                      m_fn;
+	std::atomic<bool>                  m_running;
+};
+} // namespace giada::m::rendering
+
+#endif
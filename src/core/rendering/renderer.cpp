@@ -25,8 +25,11 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/rendering/renderer.h"
+#include "src/core/dsp.h"
 #include "src/core/mixer.h"
 #include "src/core/model/model.h"
+#include "src/core/profiler.h"
+#include "src/core/rendering/automationRendering.h"
 #include "src/core/rendering/midiAdvance.h"
 #include "src/core/rendering/midiOutput.h"
 #include "src/core/rendering/midiReactions.h"
@@ -37,18 +40,139 @@
 #include "src/core/jackSynchronizer.h"
 #include "src/core/jackTransport.h"
 #endif
+#include <algorithm>
 
 namespace giada::m::rendering
 {
+namespace
+{
+/* hasPlanarOutput_
+Tells whether the audio of a graph node, once rendered, lives in the planar
+plug-in buffer of its Channel rather than in the interleaved audio buffer. With
+planar buses on, this is always the case for buses; channels end up there only
+if they have plug-ins (see PluginHost::processPlanarStack). */
+
+bool hasPlanarOutput_(const Graph::Node& node, bool planar)
+{
+	return planar && (node.type == Graph::Node::Type::BUS || !node.channel->plugins.empty());
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* getLatency_
+Returns the total latency of the plug-ins that are actually processed on a
+Channel. */
+
+Frame getLatency_(const Channel& ch)
+{
+	Frame latency = 0;
+	for (const Plugin* p : ch.plugins)
+		if (p->valid && !p->isSuspended() && !p->isBypassed())
+			latency += p->getLatency();
+	return latency;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* getBusInputLatency_
+Returns the highest latency among the channels summed into the bus of a Stage. */
+
+Frame getBusInputLatency_(std::span<const Graph::Node> nodes)
+{
+	Frame latency = 0;
+	for (const Graph::Node& node : nodes)
+		if (node.type == Graph::Node::Type::CHANNEL && node.send != nullptr)
+			latency = std::max(latency, getLatency_(*node.channel));
+	return latency;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void delay_(const Graph::Node& node, bool planar)
+{
+	ChannelShared& shared = *node.channel->shared;
+
+	if (hasPlanarOutput_(node, planar))
+		shared.delayLine.process(shared.pluginBuffer.audio);
+	else
+		shared.delayLine.process(shared.audioBuffer);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* makeGainRamp_
+Combines the volume and pan lanes of a Channel and a constant 'gain' into the
+per-channel gains for the current block. Automated volume and pan have been
+applied already by renderAutomation(): their lanes are left out. */
+
+dsp::GainRamp makeGainRamp_(const Channel& ch, float gain)
+{
+	const ChannelShared::Automation& automation = ch.shared->automation;
+
+	const ParamLane::Ramp volume = automation.volume.size() > 0 ? ParamLane::Ramp{1.0f, 1.0f} : ch.shared->volume.getRamp();
+	const ParamLane::Ramp pan    = automation.pan.size() > 0 ? ParamLane::Ramp{0.5f, 0.5f} : ch.shared->pan.getRamp();
+
+	dsp::GainRamp out = {Pan(pan.from).get(), Pan(pan.to).get()};
+	for (std::size_t i = 0; i < out.from.size(); i++)
+	{
+		out.from[i] *= volume.from * gain;
+		out.to[i] *= volume.to * gain;
+	}
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* advanceLanes_
+Advances the parameter lanes of all Channels in the Tracks, once per block. */
+
+void advanceLanes_(const model::Tracks& tracks)
+{
+	for (const model::Track& track : tracks.getAll())
+		for (const Channel& ch : track.getChannels().getAll())
+			ch.shared->advanceLanes();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* resetAutomation_
+Stops automating all Channels in the Tracks. */
+
+void resetAutomation_(const model::Tracks& tracks)
+{
+	for (const model::Track& track : tracks.getAll())
+		for (const Channel& ch : track.getChannels().getAll())
+			resetAutomation(ch);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* isAutomated_
+Sample Channels in single mode read automation along with their other actions,
+i.e. only when reading actions. Any other Channel is always automated. */
+
+bool isAutomated_(const Channel& ch)
+{
+	if (ch.type != ChannelType::SAMPLE || ch.sampleChannel->isAnyLoopMode())
+		return true;
+	return ch.shared->isReadingActions();
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 #ifdef WITH_AUDIO_JACK
-Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, JackSynchronizer& js, JackTransport& jt, KernelMidi& km)
+Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, JackSynchronizer& js, JackTransport& jt, KernelMidi& km, Profiler& p)
 #else
-Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km)
+Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km, Profiler& p)
 #endif
 : m_sequencer(s)
 , m_mixer(m)
 , m_pluginHost(ph)
 , m_kernelMidi(km)
+, m_profiler(p)
 #ifdef WITH_AUDIO_JACK
 , m_jackSynchronizer(js)
 , m_jackTransport(jt)
@@ -58,7 +182,20 @@ Renderer::Renderer(Sequencer& s, Mixer& m, PluginHost& ph, KernelMidi& km)
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model& model) const
+void Renderer::startWorkers(int numWorkers)
+{
+	m_renderPool.start(numWorkers);
+}
+
+void Renderer::stopWorkers()
+{
+	m_renderPool.stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model& model,
+    std::vector<mcl::AudioBuffer>* stems) const
 {
 	/* Clean up output buffer before any rendering. Do this even if mixer is
 	disabled to avoid audio leftovers during a temporary suspension (e.g. when
@@ -100,11 +237,18 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 		const int         quantizerStep = m_sequencer.getQuantizerStep();            // TODO pass this to m_sequencer.advance - or better, Advancer class
 		const SampleRange renderRange   = {currentFrame, currentFrame + bufferSize}; // TODO pass this to m_sequencer.advance - or better, Advancer class
 
-		const Sequencer::EventBuffer& events = m_sequencer.advance(sequencer, bufferSize, kernelAudio.samplerate, actions);
+		const Sequencer::EventBuffer& events = [&]() -> const Sequencer::EventBuffer&
+		{
+			const Profiler::Scope profile(m_profiler, Profiler::Section::SEQUENCER);
+			return m_sequencer.advance(sequencer, bufferSize, kernelAudio.samplerate, actions);
+		}();
 		m_sequencer.render(out, document_RT);
 		if (!document_RT.locked)
-			advanceTracks(events, tracks, renderRange, quantizerStep);
+			advanceTracks(events, tracks, actions, renderRange, sequencer.a_getCurrentScene(),
+			    sequencer.framesInLoop, quantizerStep);
 	}
+	else if (!document_RT.locked)
+		resetAutomation_(tracks);
 
 	/* Then render Mixer, channels and finalize output. */
 
@@ -112,39 +256,135 @@ void Renderer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const m
 	const Scene    scene          = sequencer.a_getCurrentScene();
 	const bool     hasSolos       = mixer.hasSolos;
 	const bool     hasInput       = in.isAllocd();
+	const bool     planar         = kernelAudio.planarBuses;
 	const Channel& masterOutCh    = tracks.getChannel(MASTER_OUT_CHANNEL_ID);
 	const Channel& masterInCh     = tracks.getChannel(MASTER_IN_CHANNEL_ID);
 	const Channel& previewCh      = tracks.getChannel(PREVIEW_CHANNEL_ID);
 
-	m_mixer.render(in, document_RT, maxFramesToRec);
+	/* Move parameter lanes before anything reads them. Tracks can't be inspected
+	while the document is locked: only the internal channels are advanced
+	meanwhile, the others are not rendered anyway. */
+
+	if (!document_RT.locked)
+		advanceLanes_(tracks);
+	else
+		for (const Channel* ch : {&masterOutCh, &masterInCh, &previewCh})
+			ch->shared->advanceLanes();
+
+	/* Plug-in delay compensation. Tracks can't be inspected while the document
+	is locked: keep the latency of the previous block meanwhile. */
+
+	if (!document_RT.locked)
+	{
+		m_tracksLatency = compensateLatency(tracks.getGraph());
+		m_latency       = m_tracksLatency + getLatency_(masterOutCh) +
+		                  m_mixer.getOutputLatency(kernelAudio.limitOutput, kernelAudio.limiterMode);
+	}
+
+	{
+		const Profiler::Scope profile(m_profiler, Profiler::Section::MIXER);
+		m_mixer.render(in, document_RT, maxFramesToRec, m_latency);
+	}
 
 	if (hasInput)
 		renderMasterIn(masterInCh, mixer.getInBuffer());
 
 	if (!document_RT.locked)
-		renderTracks(tracks, masterOutCh.shared->audioBuffer, out, mixer.getInBuffer(),
-		    scene, hasSolos, sequencer.isRunning());
+		renderTracks(tracks, masterOutCh, out, mixer.getInBuffer(), scene, hasSolos,
+		    sequencer.isRunning(), planar, stems);
 
-	renderMasterOut(masterOutCh, out, kernelAudio.deviceOut.channelsStart);
+	const Peak peakOut = renderMasterOut(masterOutCh, out, kernelAudio.deviceOut.channelsStart, planar);
 	if (mixer.renderPreview)
 		renderPreview(previewCh, out);
 
-	m_mixer.updateOutputPeak(mixer, masterOutCh.shared->audioBuffer);
+	m_mixer.updateOutputPeak(mixer, peakOut);
 
 	/* Post processing. */
 
-	m_mixer.finalizeOutput(mixer, out, mixer.inToOut, kernelAudio.limitOutput, masterOutCh.volume);
+	m_mixer.finalizeOutput(mixer, out, mixer.inToOut, kernelAudio.limitOutput, kernelAudio.limiterMode,
+	    masterOutCh.shared->volume.getRamp().to);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame Renderer::getLatency() const
+{
+	return m_latency;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame Renderer::getTracksLatency() const
+{
+	return m_tracksLatency;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame Renderer::compensateLatency(const Graph& graph) const
+{
+	/* Channels first: each one is delayed to match the slowest channel summed
+	into the same group bus. Meanwhile find out the slowest bus. */
+
+	Frame masterInLatency = 0;
+	for (const Graph::Stage& stage : graph.getStages())
+	{
+		const std::span<const Graph::Node> nodes      = graph.getNodes(stage);
+		const Frame                        busLatency = getBusInputLatency_(nodes);
+
+		for (const Graph::Node& node : nodes)
+		{
+			const Channel& ch = *node.channel;
+			if (node.type == Graph::Node::Type::BUS)
+			{
+				if (node.send != nullptr)
+					masterInLatency = std::max(masterInLatency, busLatency + getLatency_(ch));
+				continue;
+			}
+			ch.shared->delayLine.setDelay(node.send != nullptr ? busLatency - getLatency_(ch) : 0);
+		}
+	}
+
+	/* Then buses, delayed to match the slowest one summed into the master
+	output. */
+
+	for (const Graph::Stage& stage : graph.getStages())
+	{
+		const std::span<const Graph::Node> nodes = graph.getNodes(stage);
+		const Graph::Node&                 bus   = nodes.back();
+		const Frame                        delay = masterInLatency - getBusInputLatency_(nodes) - getLatency_(*bus.channel);
+
+		bus.channel->shared->delayLine.setDelay(bus.send != nullptr ? delay : 0);
+	}
+
+	return masterInLatency;
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::advanceTracks(const Sequencer::EventBuffer& events, const model::Tracks& tracks,
-    SampleRange block, int quantizerStep) const
+    const model::Actions& actions, SampleRange block, Scene scene, Frame framesInLoop, int quantizerStep) const
 {
-	for (const model::Track& track : tracks.getAll())
-		for (const Channel& c : track.getChannels().getAll())
-			if (!c.isInternal())
-				advanceChannel(c, events, block, quantizerStep);
+	const Graph& graph = tracks.getGraph();
+
+	/* Only channel nodes can react to events: group buses have nothing to
+	advance but their automation. */
+
+	for (const Graph::Stage& stage : graph.getStages())
+	{
+		for (const Graph::Node& node : graph.getNodes(stage))
+		{
+			const Channel& ch = *node.channel;
+
+			if (node.type == Graph::Node::Type::CHANNEL)
+				advanceChannel(ch, events, block, quantizerStep);
+
+			if (isAutomated_(ch))
+				advanceAutomation(ch, actions.getCurvesOnChannel(ch.id), scene, block, framesInLoop);
+			else
+				resetAutomation(ch);
+		}
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -166,68 +406,137 @@ void Renderer::advanceChannel(const Channel& ch, const Sequencer::EventBuffer& e
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderTracks(const model::Tracks& tracks, mcl::AudioBuffer& masterOut,
+void Renderer::renderTracks(const model::Tracks& tracks, const Channel& masterOut,
     mcl::AudioBuffer& hardwareOut, const mcl::AudioBuffer& in, Scene scene, bool hasSolos,
-    bool seqIsRunning) const
+    bool seqIsRunning, bool planar, std::vector<mcl::AudioBuffer>* stems) const
 {
-	masterOut.clear();
+	if (planar)
+		masterOut.shared->pluginBuffer.audio.clear();
+	else
+		masterOut.shared->audioBuffer.clear();
 
-	for (const model::Track& track : tracks.getAll())
+	const Graph&                     graph  = tracks.getGraph();
+	const std::vector<Graph::Stage>& stages = graph.getStages();
+
+	const auto getStem = [stems](std::size_t i)
+	{ return stems != nullptr && i < stems->size() ? &(*stems)[i] : nullptr; };
+
+	if (m_renderPool.countWorkers() > 0)
 	{
-		if (track.isInternal())
-			continue;
+		/* Render Stages concurrently, then merge them serially in the original
+		order: the result is bit-identical to the serial rendering below. */
+
+		m_renderPool.run(stages.size(), [&](std::size_t i)
+		{ renderStage(graph, stages[i], in, scene, hasSolos, seqIsRunning, planar); });
+
+		for (std::size_t i = 0; i < stages.size(); i++)
+			mergeStage(graph, stages[i], hardwareOut, getStem(i), hasSolos, planar);
+		return;
+	}
 
-		const Channel& group = track.getGroupChannel();
-		group.shared->audioBuffer.clear();
+	for (std::size_t i = 0; i < stages.size(); i++)
+	{
+		renderStage(graph, stages[i], in, scene, hasSolos, seqIsRunning, planar);
+		mergeStage(graph, stages[i], hardwareOut, getStem(i), hasSolos, planar);
+	}
+}
 
-		for (const Channel& c : track.getChannels().getAll())
+/* -------------------------------------------------------------------------- */
+
+void Renderer::renderStage(const Graph& graph, const Graph::Stage& stage,
+    const mcl::AudioBuffer& in, Scene scene, bool hasSolos, bool seqIsRunning, bool planar) const
+{
+	if (planar)
+		stage.planarBus->clear();
+	else
+		stage.bus->clear();
+
+	for (const Graph::Node& node : graph.getNodes(stage))
+	{
+		const Channel&        ch = *node.channel;
+		const Profiler::Scope profile(m_profiler, Profiler::Section::CHANNEL, ch.id);
+
+		if (node.type == Graph::Node::Type::BUS)
 		{
-			renderNormalChannel(c, in, scene, seqIsRunning);
-			if (!c.isAudible(hasSolos))
-				continue;
-			if (c.sendToMaster)
-				mergeChannel(c, group.shared->audioBuffer);
-			for (const int offset : c.extraOutputs)
-				mergeChannel(c, hardwareOut, offset);
+			if (planar)
+				renderBusPlugins(ch, m_pluginHost);
+			else
+				renderAudioPlugins(ch, m_pluginHost);
+			renderAutomation(ch, hasPlanarOutput_(node, planar));
+			delay_(node, planar);
+			continue;
 		}
 
-		renderAudioPlugins(group, m_pluginHost);
+		renderNormalChannel(ch, in, scene, seqIsRunning, planar);
+		renderAutomation(ch, hasPlanarOutput_(node, planar));
+		delay_(node, planar);
+		if (node.send == nullptr || !ch.isAudible(hasSolos))
+			continue;
+		if (planar)
+			mergeChannel(ch, *node.planarSend, hasPlanarOutput_(node, planar));
+		else
+			mergeChannel(ch, *node.send);
+	}
+}
 
-		if (!group.isAudible(hasSolos))
+/* -------------------------------------------------------------------------- */
+
+void Renderer::mergeStage(const Graph& graph, const Graph::Stage& stage,
+    mcl::AudioBuffer& hardwareOut, mcl::AudioBuffer* stem, bool hasSolos, bool planar) const
+{
+	for (const Graph::Node& node : graph.getNodes(stage))
+	{
+		const Channel& ch        = *node.channel;
+		const bool     planarSrc = hasPlanarOutput_(node, planar);
+
+		if (!ch.isAudible(hasSolos))
 			continue;
-		if (group.sendToMaster)
-			mergeChannel(group, masterOut);
-		for (const int offset : group.extraOutputs)
-			mergeChannel(group, hardwareOut, offset);
+		if (node.type == Graph::Node::Type::BUS && node.send != nullptr)
+		{
+			if (planar)
+				mergeChannel(ch, *node.planarSend, planarSrc);
+			else
+				mergeChannel(ch, *node.send);
+			if (stem != nullptr)
+				mergeChannel(ch, *stem, /*destChannelOffset=*/0, planarSrc);
+		}
+		for (const int offset : ch.extraOutputs)
+			mergeChannel(ch, hardwareOut, offset, planarSrc);
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::renderNormalChannel(const Channel& ch, const mcl::AudioBuffer& in,
-    Scene scene, bool seqIsRunning) const
+    Scene scene, bool seqIsRunning, bool planar) const
 {
 	ch.shared->audioBuffer.clear();
 
 	if (ch.type == ChannelType::SAMPLE)
-		renderSampleChannel(ch, in, scene, seqIsRunning);
+		renderSampleChannel(ch, in, scene, seqIsRunning, planar);
 	else if (ch.type == ChannelType::MIDI)
-		renderMidiChannel(ch);
+		renderMidiChannel(ch, planar);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::renderMasterIn(const Channel& ch, mcl::AudioBuffer& in) const
 {
-	m_pluginHost.processStack(in, ch.plugins, nullptr);
+	const Profiler::Scope profile(m_profiler, Profiler::Section::CHANNEL, ch.id);
+	m_pluginHost.processStack(in, ch.plugins, nullptr, ch.shared->pluginBuffer);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderMasterOut(const Channel& ch, mcl::AudioBuffer& out, int channelOffset) const
+Peak Renderer::renderMasterOut(const Channel& ch, mcl::AudioBuffer& out, int channelOffset, bool planar) const
 {
-	m_pluginHost.processStack(ch.shared->audioBuffer, ch.plugins, nullptr);
-	mergeChannel(ch, out, channelOffset);
+	const Profiler::Scope profile(m_profiler, Profiler::Section::CHANNEL, ch.id);
+
+	if (planar)
+		renderBusPlugins(ch, m_pluginHost);
+	else
+		renderAudioPlugins(ch, m_pluginHost);
+	return mergeChannel(ch, out, channelOffset, planar);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -239,12 +548,15 @@ void Renderer::renderPreview(const Channel& ch, mcl::AudioBuffer& out) const
 	if (ch.isPlaying())
 		rendering::renderSampleChannel(ch, Scene{0}, /*seqIsRunning=*/false); // Sequencer status and scene are irrelevant here
 
-	out.sumAll(ch.shared->audioBuffer, ch.volume);
+	const ParamLane::Ramp volume = ch.shared->volume.getRamp();
+
+	dsp::sumAll(out, ch.shared->audioBuffer, dsp::GainRamp{{volume.from, volume.from}, {volume.to, volume.to}});
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene scene, bool seqIsRunning) const
+void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene scene, bool seqIsRunning,
+    bool planar) const
 {
 	assert(ch.type == ChannelType::SAMPLE);
 
@@ -254,33 +566,53 @@ void Renderer::renderSampleChannel(const Channel& ch, const mcl::AudioBuffer& in
 	if (ch.canReceiveAudio())
 		renderSampleChannelInput(ch, in); // record "clean" audio first	(i.e. not plugin-processed)
 
-	renderAudioPlugins(ch, m_pluginHost);
+	if (planar)
+		renderPlanarAudioPlugins(ch, m_pluginHost);
+	else
+		renderAudioPlugins(ch, m_pluginHost);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::renderMidiChannel(const Channel& ch) const
+void Renderer::renderMidiChannel(const Channel& ch, bool planar) const
 {
 	assert(ch.type == ChannelType::MIDI);
 
-	renderAudioAndMidiPlugins(ch, m_pluginHost);
+	if (planar)
+		renderPlanarAudioAndMidiPlugins(ch, m_pluginHost);
+	else
+		renderAudioAndMidiPlugins(ch, m_pluginHost);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Renderer::mergeChannel(const Channel& ch, mcl::AudioBuffer& out) const
 {
-	out.sumAll(ch.shared->audioBuffer, ch.pan.get(), ch.volume * ch.shared->volumeInternal.load());
+	dsp::sumAll(out, ch.shared->audioBuffer, makeGainRamp_(ch, ch.shared->volumeInternal.load()));
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Renderer::mergeChannel(const Channel& ch, mcl::AudioBuffer& out, int destChannelOffset) const
+void Renderer::mergeChannel(const Channel& ch, juce::AudioBuffer<float>& out, bool planarSrc) const
+{
+	const dsp::GainRamp ramp = makeGainRamp_(ch, ch.shared->volumeInternal.load());
+
+	if (planarSrc)
+		dsp::sumAll(out, ch.shared->pluginBuffer.audio, ramp);
+	else
+		dsp::sumAll(out, ch.shared->audioBuffer, ramp);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak Renderer::mergeChannel(const Channel& ch, mcl::AudioBuffer& out, int destChannelOffset, bool planarSrc) const
 {
 	assert(ch.shared->audioBuffer.countChannels() == static_cast<int>(ch.pan.get().size()));
 
-	for (int i = 0; i < ch.shared->audioBuffer.countChannels(); i++)
-		if (destChannelOffset < out.countChannels())
-			out.sum(ch.shared->audioBuffer, i, i + destChannelOffset, ch.volume * ch.pan.get()[i]);
+	const dsp::GainRamp ramp = makeGainRamp_(ch, 1.0f);
+
+	if (planarSrc)
+		return dsp::sumAll(out, ch.shared->pluginBuffer.audio, ramp, destChannelOffset);
+	return dsp::sumAll(out, ch.shared->audioBuffer, ramp, destChannelOffset);
 }
 } // namespace giada::m::rendering
@@ -27,7 +27,10 @@
 #ifndef G_RENDERER_H
 #define G_RENDERER_H
 
+#include "src/core/rendering/graph.h"
+#include "src/core/rendering/renderPool.h"
 #include "src/core/sequencer.h"
+#include "src/types.h"
 #include <vector>
 
 namespace mcl
@@ -43,6 +46,7 @@ class Mixer;
 class Channel;
 class PluginHost;
 class KernelMidi;
+class Profiler;
 #ifdef WITH_AUDIO_JACK
 class JackSynchronizer;
 class JackTransport;
@@ -52,6 +56,7 @@ class JackTransport;
 namespace giada::m::model
 {
 class Model;
+class Actions;
 class Channels;
 class Tracks;
 } // namespace giada::m::model
@@ -62,32 +67,100 @@ class Renderer
 {
 public:
 #ifdef WITH_AUDIO_JACK
-	Renderer(Sequencer&, Mixer&, PluginHost&, JackSynchronizer&, JackTransport&, KernelMidi&);
+	Renderer(Sequencer&, Mixer&, PluginHost&, JackSynchronizer&, JackTransport&, KernelMidi&, Profiler&);
 #else
-	Renderer(Sequencer&, Mixer&, PluginHost&, KernelMidi&);
+	Renderer(Sequencer&, Mixer&, PluginHost&, KernelMidi&, Profiler&);
 #endif
 
-	void render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model&) const;
+	/* render
+	Renders a block of audio into 'out'. If 'stems' is given, it also receives
+	the audio each Track sends to the master output, one buffer per Track in
+	graph order. Used by offline rendering (see Bouncer). */
+
+	void render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Model&,
+	    std::vector<mcl::AudioBuffer>* stems = nullptr) const;
+
+	/* getLatency
+	Returns the processing latency of the last rendered block, in frames: plug-in
+	delay compensation plus master output plug-ins and limiter. Audio thread
+	only. */
+
+	Frame getLatency() const;
+
+	/* getTracksLatency
+	Same as getLatency(), limited to plug-in delay compensation: the latency of
+	the tracks as they are summed into the master output bus, i.e. of the
+	stems. Audio thread only. */
+
+	Frame getTracksLatency() const;
+
+	/* startWorkers
+	Enables parallel track rendering with 'numWorkers' helper threads. Zero
+	workers means serial rendering on the audio thread only. Must be called
+	while the mixer is disabled or before the audio stream starts. */
+
+	void startWorkers(int numWorkers);
+
+	/* stopWorkers
+	Stops all helper threads and goes back to serial rendering. */
+
+	void stopWorkers();
 
 private:
 	/* advanceTracks
 	Processes Channels' static events (e.g. pre-recorded actions or sequencer
-	events) in the current audio block. Called when the sequencer is running. */
+	events) and automation in the current audio block. Called when the
+	sequencer is running. */
 
-	void advanceTracks(const Sequencer::EventBuffer&, const model::Tracks&,
-	    SampleRange, int quantizerStep) const;
+	void advanceTracks(const Sequencer::EventBuffer&, const model::Tracks&, const model::Actions&,
+	    SampleRange, Scene, Frame framesInLoop, int quantizerStep) const;
 
 	void advanceChannel(const Channel&, const Sequencer::EventBuffer&, SampleRange, Frame quantizerStep) const;
 
-	void renderTracks(const model::Tracks&, mcl::AudioBuffer& masterOut,
+	/* compensateLatency
+	Sets the delay of each graph node so that everything summed into a bus is
+	aligned with the input that has the highest plug-in latency. Returns the
+	latency of the master output bus input. */
+
+	Frame compensateLatency(const Graph&) const;
+
+	/* renderTracks
+	Renders all Tracks into the master output Channel and the hardware output.
+	If 'planar' is set, group and master buses are kept planar (see
+	model::KernelAudio::planarBuses). */
+
+	void renderTracks(const model::Tracks&, const Channel& masterOut,
 	    mcl::AudioBuffer& hardwareOut, const mcl::AudioBuffer& in, Scene,
-	    bool hasSolos, bool seqIsRunning) const;
-	void renderNormalChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene, bool seqIsRunning) const;
+	    bool hasSolos, bool seqIsRunning, bool planar, std::vector<mcl::AudioBuffer>* stems) const;
+
+	/* renderStage
+	Renders all nodes of a graph Stage (i.e. a Track): channels are rendered
+	and summed into the group bus, then the bus plug-ins are processed. It only
+	writes to the Stage's own buffers, so different Stages can be rendered
+	concurrently. */
+
+	void renderStage(const Graph&, const Graph::Stage&, const mcl::AudioBuffer& in,
+	    Scene, bool hasSolos, bool seqIsRunning, bool planar) const;
+
+	/* mergeStage
+	Sums an already rendered Stage into the master and hardware outputs, and
+	into 'stem' if not null. Stages must be merged in order, to keep the output
+	identical across serial and parallel rendering. */
+
+	void mergeStage(const Graph&, const Graph::Stage&, mcl::AudioBuffer& hardwareOut,
+	    mcl::AudioBuffer* stem, bool hasSolos, bool planar) const;
+	void renderNormalChannel(const Channel& ch, const mcl::AudioBuffer& in, Scene, bool seqIsRunning, bool planar) const;
 	void renderMasterIn(const Channel&, mcl::AudioBuffer& in) const;
-	void renderMasterOut(const Channel&, mcl::AudioBuffer& out, int channelOffset) const;
+
+	/* renderMasterOut
+	Processes the master output and sums it into 'out'. Returns the peak of the
+	master output, measured while summing. With 'planar' set this is the only
+	point where the master bus gets interleaved. */
+
+	Peak renderMasterOut(const Channel&, mcl::AudioBuffer& out, int channelOffset, bool planar) const;
 	void renderPreview(const Channel&, mcl::AudioBuffer& out) const;
-	void renderSampleChannel(const Channel&, const mcl::AudioBuffer& in, Scene, bool seqIsRunning) const;
-	void renderMidiChannel(const Channel&) const;
+	void renderSampleChannel(const Channel&, const mcl::AudioBuffer& in, Scene, bool seqIsRunning, bool planar) const;
+	void renderMidiChannel(const Channel&, bool planar) const;
 
 	/* mergeChannel
 	Merges the Channel's audio buffer with 'out'. */
@@ -95,18 +168,37 @@ private:
 	void mergeChannel(const Channel&, mcl::AudioBuffer& out) const;
 
 	/* mergeChannel (2)
-	Same as above, with a channel offset for the destination buffer 'out'. */
+	Same as above, for a planar bus 'out'. The Channel's audio is read from its
+	planar plug-in buffer if 'planarSrc' is set, from its audio buffer
+	otherwise. */
 
-	void mergeChannel(const Channel&, mcl::AudioBuffer& out, int destChannelOffset) const;
+	void mergeChannel(const Channel&, juce::AudioBuffer<float>& out, bool planarSrc) const;
+
+	/* mergeChannel (3)
+	Same as (1), with a channel offset for the destination buffer 'out'. Reads
+	from the planar plug-in buffer if 'planarSrc' is set, like (2). Returns the
+	peak of the Channel's audio. */
+
+	Peak mergeChannel(const Channel&, mcl::AudioBuffer& out, int destChannelOffset, bool planarSrc) const;
 
 	Sequencer&  m_sequencer;
 	Mixer&      m_mixer;
 	PluginHost& m_pluginHost;
 	KernelMidi& m_kernelMidi;
+	Profiler&   m_profiler;
 #ifdef WITH_AUDIO_JACK
 	JackSynchronizer& m_jackSynchronizer;
 	JackTransport&    m_jackTransport;
 #endif
+
+	mutable Frame m_latency       = 0;
+	mutable Frame m_tracksLatency = 0;
+
+	/* m_renderPool
+	Helper threads for parallel track rendering. Idle if no workers have been
+	started. */
+
+	RenderPool m_renderPool;
 };
 } // namespace giada::m::rendering
 
@@ -28,6 +28,7 @@
 #include "src/core/channels/channel.h"
 #include "src/core/channels/channelShared.h"
 #include "src/core/rendering/sampleReactions.h"
+#include <span>
 
 namespace giada::m::rendering
 {
@@ -114,7 +115,7 @@ void onNoteOn_(ChannelShared& shared, Frame localFrame, SamplePlayerMode mode, f
 
 /* -------------------------------------------------------------------------- */
 
-void parseActions_(ID channelId, Scene scene, ChannelShared& shared, const std::vector<Action>& as,
+void parseActions_(ID channelId, Scene scene, ChannelShared& shared, std::span<const Action> as,
     Frame localFrame, SamplePlayerMode mode)
 {
 	for (const Action& a : as)
@@ -167,7 +168,7 @@ void advanceSampleChannel(const Channel& ch, const Sequencer::Event& e)
 
 	case Sequencer::EventType::ACTIONS:
 		if (!isLoop && ch.shared->isReadingActions())
-			parseActions_(ch.id, e.scene, *ch.shared, *e.actions, e.delta, mode);
+			parseActions_(ch.id, e.scene, *ch.shared, e.actions, e.delta, mode);
 		break;
 
 	default:
@@ -26,12 +26,16 @@
 
 #include "src/core/rendering/sampleRendering.h"
 #include "src/core/channels/channel.h"
+#include "src/core/const.h"
 #include "src/core/plugins/pluginHost.h"
 #include "src/core/rendering/sampleAdvance.h"
 #include "src/core/resampler.h"
 #include "src/core/wave.h"
+#include "src/core/waveStream.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 namespace giada::m::rendering
 {
@@ -40,6 +44,8 @@ namespace
 ReadResult readResampled_(const Wave& wave, mcl::AudioBuffer& dest, Frame start,
     Frame max, Frame offset, float pitch, const Resampler& resampler)
 {
+	resampler.seek(start);
+
 	Resampler::Result res = resampler.process(
 	    /*input=*/wave.getBuffer()[0],
 	    /*inputPos=*/start,
@@ -69,6 +75,105 @@ ReadResult readCopy_(const Wave& wave, mcl::AudioBuffer& dest, Frame start,
 
 /* -------------------------------------------------------------------------- */
 
+/* readSilence_
+Leaves the output silent, while moving the position forward as if the Wave had
+been played. Used when audio data is not available (yet). */
+
+ReadResult readSilence_(const mcl::AudioBuffer& dest, Frame start, Frame max, Frame offset, float pitch)
+{
+	const Frame outputLen = dest.countFrames() - offset;
+	const Frame used      = std::min(max - start, static_cast<Frame>(std::ceil(outputLen * pitch)));
+
+	return {used, std::min(outputLen, static_cast<Frame>(std::ceil(used / pitch)))};
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* readPitched_
+Same as readCopy_, for a Wave pre-rendered at pitch 'pitch' (see PitchCache).
+'start' and 'max' refer to the original Wave: they are mapped to positions in
+the pre-rendered one, kept in ChannelShared so that no rounding error piles
+up. */
+
+ReadResult readPitched_(ChannelShared& shared, mcl::AudioBuffer& dest, Frame start,
+    Frame max, Frame offset, float pitch)
+{
+	const Wave& wave = *shared.pitchedWave.wave;
+
+	if (shared.pitchedReset.load())
+	{
+		shared.pitchedReset.store(false);
+		shared.pitchedTracker = -1;
+	}
+
+	if (shared.pitchedTracker != start)
+		shared.pitchedPos = start / static_cast<double>(pitch);
+
+	const Frame from      = static_cast<Frame>(shared.pitchedPos);
+	const Frame to        = std::min(wave.countFrames(), static_cast<Frame>(std::ceil(max / static_cast<double>(pitch))));
+	const Frame generated = std::min(dest.countFrames() - offset, to - from);
+
+	if (generated <= 0)
+		return {max - start, 0};
+
+	dest.setAll(wave.getBuffer(), generated, from, offset);
+
+	shared.pitchedPos += generated;
+	shared.pitchedTracker = std::min(max, static_cast<Frame>(shared.pitchedPos * pitch));
+
+	return {shared.pitchedTracker - start, generated};
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* readStreamed_
+Same as readCopy_ and readResampled_ above, for a Wave streamed from disk. If
+data is not available yet (underrun) the output is left silent, see
+readSilence_. */
+
+ReadResult readStreamed_(const Wave& wave, mcl::AudioBuffer& dest, Frame start,
+    Frame max, Frame offset, float pitch, const Resampler& resampler)
+{
+	/* The resampler might read a little more than the frames it turns into
+	output: ask for some extra input data, if available. */
+
+	constexpr Frame RESAMPLER_MARGIN = 1024;
+
+	assert(dest.countChannels() == G_MAX_IO_CHANS);
+
+	const Frame outputLen = dest.countFrames() - offset;
+	const Frame inputLen  = static_cast<Frame>(std::ceil(outputLen * pitch));
+	const Frame needed    = std::min(max - start, pitch == 1.0f ? inputLen : inputLen + RESAMPLER_MARGIN);
+
+	Frame        available = 0;
+	const float* data      = wave.getStream()->read(start, needed, available);
+
+	if (data == nullptr)
+		return readSilence_(dest, start, max, offset, pitch);
+
+	if (pitch == 1.0f)
+	{
+		std::copy(data, data + (needed * G_MAX_IO_CHANS), dest[offset]);
+		return {needed, needed};
+	}
+
+	resampler.seek(start);
+
+	Resampler::Result res = resampler.process(
+	    /*input=*/const_cast<float*>(data),
+	    /*inputPos=*/0,
+	    /*inputLen=*/std::min(available, max - start),
+	    /*output=*/dest[offset],
+	    /*outputLen=*/outputLen,
+	    /*pitch=*/pitch);
+
+	return {
+	    static_cast<int>(res.used),
+	    static_cast<int>(res.generated)};
+}
+
+/* -------------------------------------------------------------------------- */
+
 /* onSampleEnd
 Things to do when the last frame has been reached. 'natural' == true if the
 rendering has ended because the end of the sample has been reached.
@@ -122,16 +227,23 @@ void stop_(const Channel& ch, mcl::AudioBuffer& buf, Frame offset, bool seqIsRun
 Frame render_(const Channel& ch, mcl::AudioBuffer& buf, Scene scene, Frame tracker, Frame offset, bool seqIsRunning, bool testEnd)
 {
 	const auto       range     = ch.sampleChannel->getRange(scene);
-	const float      pitch     = ch.sampleChannel->getPitch(scene);
+	const float      pitch     = ch.shared->automation.pitch.value_or(ch.shared->pitch[scene.getIndex()].get());
 	const Wave*      wave      = ch.sampleChannel->getWave(scene);
 	const Resampler& resampler = ch.shared->resampler.value();
 
 	if (wave == nullptr)
 		return tracker;
 
+	/* Play the pre-rendered copy of the Wave, if it matches the current pitch,
+	instead of resampling it live. */
+
+	const bool usePitched = pitch != 1.0f && ch.shared->pitchedWave.isValidFor(*wave, pitch);
+
 	while (true)
 	{
-		ReadResult res = readWave(*wave, buf, tracker, range.b, offset, pitch, resampler);
+		ReadResult res = usePitched
+		                     ? readPitched_(*ch.shared, buf, tracker, range.b, offset, pitch)
+		                     : readWave(*wave, buf, tracker, range.b, offset, pitch, resampler);
 		tracker += res.used;
 		offset += res.generated;
 
@@ -219,9 +331,13 @@ ReadResult readWave(const Wave& wave, mcl::AudioBuffer& out, Frame start, Frame
     Frame offset, float pitch, const Resampler& resampler)
 {
 	assert(start >= 0);
-	assert(max <= wave.getBuffer().countFrames());
+	assert(max <= wave.countFrames());
 	assert(offset < out.countFrames());
 
+	if (wave.isPending())
+		return readSilence_(out, start, max, offset, pitch);
+	if (wave.isStreamed())
+		return readStreamed_(wave, out, start, max, offset, pitch, resampler);
 	if (pitch == 1.0f)
 		return readCopy_(wave, out, start, max, offset);
 	else
@@ -25,87 +25,334 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/resampler.h"
+#include "src/core/const.h"
 #include <algorithm>
 #include <cassert>
-#include <new>
-#include <utility>
-
-#include <cstdio>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
 
 namespace giada::m
 {
-Resampler::Resampler()
-: m_state(nullptr)
-, m_input(nullptr)
-, m_inputPos(0)
-, m_inputLength(0)
-, m_channels(0)
-, m_usedFrames(0)
+namespace
 {
-}
+/* Input_
+Read-only view over the input data of a process() call. Frame indexes are
+relative to the current input position: negative ones point into the history of
+past frames, the ones past 'length' point to silence. */
+
+struct Input_
+{
+	const float* getFrame(long i) const
+	{
+		if (i >= 0 && i < length)
+			return data + (i * channels);
+		if (i < 0 && i >= -historyLen)
+			return history + ((historyLen + i) * channels);
+		return silence;
+	}
+
+	const float* data;
+	long         length;
+	const float* history;
+	long         historyLen;
+	const float* silence;
+	int          channels;
+};
 
 /* -------------------------------------------------------------------------- */
 
-Resampler::Resampler(Quality quality, int channels)
-: Resampler()
+/* bessel0_
+Zeroth-order modified Bessel function of the first kind, for the Kaiser
+window. */
+
+double bessel0_(double x)
 {
-	alloc(quality, channels);
+	double sum  = 1.0;
+	double term = 1.0;
+	for (int k = 1; k < 50; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
 }
 
 /* -------------------------------------------------------------------------- */
 
-Resampler::~Resampler()
+/* makeTable_
+Samples a Kaiser-windowed sinc kernel. 'cutoff' is the low-pass frequency,
+relative to the Nyquist one. */
+
+Resampler::Table makeTable_(int halfTaps, int phases, double cutoff, double beta)
 {
-	src_delete(m_state);
+	const auto kernel = [=](double x)
+	{
+		x = std::abs(x);
+		if (x >= halfTaps)
+			return 0.0;
+		const double r      = x / halfTaps;
+		const double sinc   = x == 0.0 ? 1.0 : std::sin(std::numbers::pi * cutoff * x) / (std::numbers::pi * cutoff * x);
+		const double window = bessel0_(beta * std::sqrt(1.0 - (r * r))) / bessel0_(beta);
+		return cutoff * sinc * window;
+	};
+
+	const int size = halfTaps * phases;
+	const int taps = halfTaps * 2;
+
+	Resampler::Table table{halfTaps, phases, std::vector<float>(size * 2), std::vector<float>((phases + 1) * taps)};
+
+	/* Right half, each value followed by its difference from the next one, so
+	that interpolating between entries takes a single memory access. */
+
+	for (int i = 0; i < size; i++)
+	{
+		const double x = static_cast<double>(i) / phases;
+
+		table.data[i * 2]       = static_cast<float>(kernel(x));
+		table.data[(i * 2) + 1] = static_cast<float>(kernel(x + (1.0 / phases)) - kernel(x));
+	}
+
+	/* Whole kernel, one row per phase. Tap 'k' of row 'p' weights the input frame
+	at distance 'k - halfTaps + 1 - p / phases' from the output position. */
+
+	for (int p = 0; p <= phases; p++)
+		for (int k = 0; k < taps; k++)
+			table.rows[(p * taps) + k] = static_cast<float>(kernel(k - halfTaps + 1 - (static_cast<double>(p) / phases)));
+
+	return table;
 }
 
 /* -------------------------------------------------------------------------- */
 
-long Resampler::callback(void* self, float** audio)
+/* getTable_
+Returns the sinc table for the given quality, or nullptr if the quality doesn't
+need one. Tables are built once and shared by all Resamplers. */
+
+const Resampler::Table* getTable_(Resampler::Quality quality)
 {
-	return static_cast<Resampler*>(self)->callback(audio);
+	static const Resampler::Table best    = makeTable_(/*halfTaps=*/32, /*phases=*/512, /*cutoff=*/0.97, /*beta=*/10.0);
+	static const Resampler::Table medium  = makeTable_(/*halfTaps=*/16, /*phases=*/256, /*cutoff=*/0.94, /*beta=*/8.0);
+	static const Resampler::Table fastest = makeTable_(/*halfTaps=*/8, /*phases=*/128, /*cutoff=*/0.90, /*beta=*/6.0);
+
+	switch (quality)
+	{
+	case Resampler::Quality::SINC_BEST:
+		return &best;
+	case Resampler::Quality::SINC_MEDIUM:
+		return &medium;
+	case Resampler::Quality::SINC_FASTEST:
+		return &fastest;
+	default:
+		return nullptr;
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-long Resampler::callback(float** audio)
+/* readHold_, readLinear_, readSinc_, readPolyphase_
+Interpolation kernels: each one writes the output frame at input position
+'pos'. The number of channels is a compile-time constant, so that the inner
+loops are fully unrolled. */
+
+template <int CHANNELS>
+void readHold_(const Input_& in, float* out, double pos)
+{
+	const float* frame = in.getFrame(static_cast<long>(pos));
+
+	for (int c = 0; c < CHANNELS; c++)
+		out[c] = frame[c];
+}
+
+template <int CHANNELS>
+void readLinear_(const Input_& in, float* out, double pos)
 {
-	assert(audio != nullptr);
+	const long   i    = static_cast<long>(pos);
+	const float  frac = static_cast<float>(pos - i);
+	const float* a    = in.getFrame(i);
+	const float* b    = in.getFrame(i + 1);
 
-	/* Move pointer properly, taking into account read data and number of
-	channels in input data. */
+	for (int c = 0; c < CHANNELS; c++)
+		out[c] = a[c] + (frac * (b[c] - a[c]));
+}
 
-	*audio = m_input + (m_inputPos * m_channels);
+/* readPolyphase_
+Fast path of readSinc_ when the kernel is not stretched: taps are read straight
+from the table row of the current phase, blended with the next one. */
 
-	/* Returns how many frames have been read in this callback shot. */
+template <int CHANNELS>
+void readPolyphase_(const Input_& in, float* out, double pos, const Resampler::Table& table)
+{
+	const int    taps   = table.halfTaps * 2;
+	const long   center = static_cast<long>(pos);
+	const double phase  = (pos - center) * table.phases;
+	const int    row    = static_cast<int>(phase);
+	const float  frac   = static_cast<float>(phase - row);
+	const float* row0   = table.rows.data() + (row * taps);
+	const float* row1   = row0 + taps;
+	const long   first  = center - table.halfTaps + 1;
+	const bool   inside = first >= 0 && first + taps <= in.length;
 
-	long frames;
+	float sum[CHANNELS] = {};
 
-	/* Read in CHUNK_LEN parts, checking if there is enough data left. */
+	for (int k = 0; k < taps; k++)
+	{
+		const float  coeff = row0[k] + (frac * (row1[k] - row0[k]));
+		const float* frame = inside ? in.data + ((first + k) * CHANNELS) : in.getFrame(first + k);
+		for (int c = 0; c < CHANNELS; c++)
+			sum[c] += frame[c] * coeff;
+	}
 
-	if (m_inputPos + CHUNK_LEN < m_inputLength)
-		frames = CHUNK_LEN;
-	else
-		frames = m_inputLength - m_inputPos;
+	for (int c = 0; c < CHANNELS; c++)
+		out[c] = sum[c];
+}
+
+template <int CHANNELS>
+void readSinc_(const Input_& in, float* out, double pos, const Resampler::Table& table, double scale)
+{
+	/* Walk the table in 16.16 fixed point: cheaper than converting a floating
+	point position to an index on every tap. */
+
+	constexpr int   FRAC_BITS = 16;
+	constexpr int   FRAC_MASK = (1 << FRAC_BITS) - 1;
+	constexpr float FRAC_UNIT = 1.0f / (1 << FRAC_BITS);
+
+	/* When slowing down (scale == 1) the kernel is evaluated at the same
+	fractional offset for every tap. When speeding up (scale > 1) it is
+	stretched, to lower the cutoff below the new Nyquist frequency. */
 
-	m_usedFrames += frames;
-	m_inputPos += frames;
+	const float*       coeffs = table.data.data();
+	const double       step   = table.phases / scale; // Table entries per input frame
+	const long         center = static_cast<long>(pos);
+	const double       frac   = pos - center;
+	const std::int64_t xStep  = static_cast<std::int64_t>(step * (1 << FRAC_BITS));
+	const std::int64_t xEnd   = static_cast<std::int64_t>(table.halfTaps * table.phases) << FRAC_BITS;
+	std::int64_t       xLeft  = static_cast<std::int64_t>(frac * step * (1 << FRAC_BITS));
+	std::int64_t       xRight = static_cast<std::int64_t>((1.0 - frac) * step * (1 << FRAC_BITS));
+	const long         nLeft  = xLeft < xEnd ? ((xEnd - xLeft - 1) / xStep) + 1 : 0;
+	const long         nRight = xRight < xEnd ? ((xEnd - xRight - 1) / xStep) + 1 : 0;
+	const bool         inside = center - nLeft + 1 >= 0 && center + nRight < in.length;
 
-	return frames;
+	const auto getCoeff = [coeffs](std::int64_t x)
+	{
+		const std::int64_t xi = x >> FRAC_BITS;
+		return coeffs[xi * 2] + ((x & FRAC_MASK) * FRAC_UNIT * coeffs[(xi * 2) + 1]);
+	};
+	const auto getFrame = [&in, inside](long i)
+	{
+		return inside ? in.data + (i * CHANNELS) : in.getFrame(i);
+	};
+
+	/* Left wing (frames at or before 'pos') and right wing go in parallel, on
+	separate accumulators. */
+
+	float left[CHANNELS]  = {};
+	float right[CHANNELS] = {};
+
+	for (long k = 0; k < std::max(nLeft, nRight); k++, xLeft += xStep, xRight += xStep)
+	{
+		if (k < nLeft)
+		{
+			const float  coeff = getCoeff(xLeft);
+			const float* frame = getFrame(center - k);
+			for (int c = 0; c < CHANNELS; c++)
+				left[c] += frame[c] * coeff;
+		}
+		if (k < nRight)
+		{
+			const float  coeff = getCoeff(xRight);
+			const float* frame = getFrame(center + 1 + k);
+			for (int c = 0; c < CHANNELS; c++)
+				right[c] += frame[c] * coeff;
+		}
+	}
+
+	for (int c = 0; c < CHANNELS; c++)
+		out[c] = static_cast<float>((left[c] + right[c]) / scale);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* resample_
+Runs the kernel over a whole block, until either the output is full or the
+input is over. Returns the number of frames generated. */
+
+template <int CHANNELS>
+long resample_(const Input_& in, float* output, long outputLength, double& pos,
+    double ratio, Resampler::Quality quality, const Resampler::Table* table)
+{
+	const double scale     = std::clamp(ratio, 1.0, static_cast<double>(G_MAX_PITCH));
+	long         generated = 0;
+
+	for (; generated < outputLength && pos < in.length; generated++, pos += ratio)
+	{
+		float* out = output + (generated * CHANNELS);
+
+		switch (quality)
+		{
+		case Resampler::Quality::ZERO_ORDER_HOLD:
+			readHold_<CHANNELS>(in, out, pos);
+			break;
+		case Resampler::Quality::LINEAR:
+			readLinear_<CHANNELS>(in, out, pos);
+			break;
+		default:
+			if (scale == 1.0)
+				readPolyphase_<CHANNELS>(in, out, pos, *table);
+			else
+				readSinc_<CHANNELS>(in, out, pos, *table, scale);
+			break;
+		}
+	}
+
+	return generated;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Resampler::Resampler()
+: m_table(nullptr)
+, m_quality(Quality::LINEAR)
+, m_channels(0)
+, m_historyLen(0)
+, m_frac(0.0)
+, m_next(-1)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Resampler::Resampler(Quality quality, int channels)
+: Resampler()
+{
+	alloc(quality, channels);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Resampler::alloc(Quality quality, int channels)
 {
-	if (m_state != nullptr)
-		src_delete(m_state);
-	m_state    = src_callback_new(callback, static_cast<int>(quality), channels, nullptr, this);
+	assert(channels == 1 || channels == 2);
+
+	m_table    = getTable_(quality);
 	m_quality  = quality;
 	m_channels = channels;
-	if (m_state == nullptr)
-		throw std::bad_alloc();
-	src_reset(m_state);
+
+	/* Sinc kernels look back up to 'halfTaps' frames, stretched by the maximum
+	pitch. The other ones only look forward. */
+
+	m_historyLen = m_table != nullptr ? static_cast<long>(std::ceil(m_table->halfTaps * G_MAX_PITCH)) + 1 : 0;
+
+	m_history.assign(m_historyLen * channels, 0.0f);
+	m_scratch.assign(m_historyLen * channels, 0.0f);
+	m_silence.assign(channels, 0.0f);
+	m_frac = 0.0;
+	m_next = -1;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -113,22 +360,56 @@ void Resampler::alloc(Quality quality, int channels)
 Resampler::Result Resampler::process(float* input, long inputPos, long inputLength,
     float* output, long outputLength, float ratio) const
 {
-	assert(m_state != nullptr); // Must be initialized first!
+	assert(m_channels > 0); // Must be initialized first!
+	assert(ratio > 0.0f);
 
-	m_input       = input;
-	m_inputPos    = inputPos;
-	m_inputLength = inputLength;
-	m_usedFrames  = 0;
+	const Input_ in = {
+	    /*data=*/input + (inputPos * m_channels),
+	    /*length=*/std::max(0L, inputLength - inputPos),
+	    /*history=*/m_history.data(),
+	    /*historyLen=*/m_historyLen,
+	    /*silence=*/m_silence.data(),
+	    /*channels=*/m_channels};
 
-	long generated = src_callback_read(m_state, 1 / ratio, outputLength, output);
+	double pos = m_frac;
+	long   generated;
 
-	return {m_usedFrames, generated};
+	if (m_channels == 2)
+		generated = resample_<2>(in, output, outputLength, pos, ratio, m_quality, m_table);
+	else
+		generated = resample_<1>(in, output, outputLength, pos, ratio, m_quality, m_table);
+
+	/* Consume all input frames the position has gone past. Keep the frames right
+	before the new position, needed by the kernel on the next call. */
+
+	const long used = std::min(static_cast<long>(pos), in.length);
+
+	for (long i = 0; i < m_historyLen; i++)
+	{
+		const float* frame = in.getFrame(used - m_historyLen + i);
+		std::copy(frame, frame + m_channels, m_scratch.begin() + (i * m_channels));
+	}
+	m_history.swap(m_scratch);
+	m_frac = pos - used;
+	m_next += used;
+
+	return {used, generated};
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Resampler::last() const
 {
-	src_reset(m_state);
+	std::fill(m_history.begin(), m_history.end(), 0.0f);
+	m_frac = 0.0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Resampler::seek(long pos) const
+{
+	if (pos != m_next)
+		last();
+	m_next = pos;
 }
 } // namespace giada::m
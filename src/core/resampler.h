@@ -28,10 +28,16 @@
 #define G_RESAMPLER_H
 
 #include <cstddef>
-#include <samplerate.h>
+#include <vector>
 
 namespace giada::m
 {
+/* Resampler
+Realtime sample-rate converter for sample channels. Band-limited interpolation
+(windowed sinc) reads coefficients from precomputed tables shared by all
+instances, one table per quality tier. Whole blocks are processed in a single
+call, with no allocations. */
+
 class Resampler final
 {
 public:
@@ -53,45 +59,64 @@ public:
 		long used, generated;
 	};
 
+	/* Table
+	Windowed sinc kernel, 'halfTaps' input frames wide on each side. 'data'
+	holds its right half, sampled 'phases' times per input frame, each value
+	followed by its difference from the next one. 'rows' holds the whole kernel
+	once per phase (polyphase layout), for when it's not stretched. */
+
+	struct Table
+	{
+		int                halfTaps;
+		int                phases;
+		std::vector<float> data;
+		std::vector<float> rows;
+	};
+
 	Resampler(); // Invalid
 	Resampler(Quality quality, int channels);
 	Resampler(const Resampler& o)          = delete;
 	Resampler(Resampler&&)                 = delete;
 	Resampler& operator=(const Resampler&) = delete;
 	Resampler& operator=(Resampler&&)      = delete;
-	~Resampler();
 
 	/* process
 	Resamples a certain amount of frames from 'input' starting at 'inputPos' and
-	puts the result into 'output'. */
+	puts the result into 'output'. Frames past 'inputLength' are treated as
+	silence. The filter history is kept across calls, so that consecutive blocks
+	join seamlessly. */
 
 	Result process(float* input, long inputPos, long inputLength, float* output,
 	    long outputLength, float ratio) const;
 
 	/* last
-	Call this when you are about to process the last chunk of data. */
+	Call this when you are about to process the last chunk of data. Clears the
+	filter history. */
 
 	void last() const;
 
-private:
-	static long callback(void* self, float** audio);
-	long        callback(float** audio);
+	/* seek
+	Tells the position in the source of the next input frame. If that's not
+	where the previous process() call left off (e.g. the source has been read
+	without resampling in the meantime, or the playhead has jumped) the filter
+	history is stale, and gets cleared as in last(). */
 
-	void alloc(Quality quality, int channels);
+	void seek(long pos) const;
 
-	/* CHUNK_LEN
-	How many chunks of data to read from input in the callback. */
+private:
+	void alloc(Quality quality, int channels);
 
-	static constexpr int CHUNK_LEN = 256;
+	const Table* m_table;
+	Quality      m_quality;
+	int          m_channels;
+	long         m_historyLen; // Number of past frames needed by the kernel
 
-	SRC_STATE*     m_state;
-	Quality        m_quality;
-	mutable float* m_input;       // Pointer to input data
-	mutable long   m_inputPos;    // Where to read from input
-	mutable long   m_inputLength; // Total number of frames in input data
-	int            m_channels;    // Number of channels
-	mutable long   m_usedFrames;  // How many frames have been read from input with a process() call
+	mutable std::vector<float> m_history; // Past input frames, interleaved
+	mutable std::vector<float> m_scratch; // Temp storage for history updates
+	std::vector<float>         m_silence; // A frame of zeros
+	mutable double             m_frac;    // Position of next output, in fractions of input frame
+	mutable long               m_next;    // Position in the source of the next input frame, see seek()
 };
 } // namespace giada::m
 
-#endif
\ No newline at end of file
+#endif
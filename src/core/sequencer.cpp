@@ -35,12 +35,23 @@
 #include "src/deps/mcl-utils/src/math.hpp"
 #include "src/utils/log.h"
 #include "src/utils/time.h"
+#include <algorithm>
 
 namespace giada::m
 {
 namespace
 {
 constexpr int Q_ACTION_REWIND = 0;
+
+/* -------------------------------------------------------------------------- */
+
+/* nextMultiple_
+Returns the first multiple of 'step' strictly greater than 'f'. */
+
+Frame nextMultiple_(Frame f, Frame step)
+{
+	return (f / step + 1) * step;
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -143,11 +154,13 @@ const Sequencer::EventBuffer& Sequencer::advance(const model::Sequencer& sequenc
 	const Scene nextScene    = sequencer.a_getNextScene();
 	bool        sceneChanged = false;
 
-	/* Process events in the current block. */
+	/* Process events in the current block. Instead of scanning each frame,
+	jump from one sequencer boundary (beat, bar or loop end) to the next one and
+	fetch the actions in between with a single range query. */
 
-	for (Frame i = start, local = 0; i < end; i++, local++)
+	for (Frame local = 0; local < bufferSize;)
 	{
-		Frame global = i % framesInLoop; // wraps around 'framesInLoop'
+		const Frame global = (start + local) % framesInLoop; // wraps around 'framesInLoop'
 
 		if (global == 0)
 		{
@@ -172,13 +185,26 @@ const Sequencer::EventBuffer& Sequencer::advance(const model::Sequencer& sequenc
 			m_metronome.trigger(Metronome::Click::BEAT, local);
 		}
 
-		/* Fetch actions in the current frame. Extra care is needed if the scene
-		has changed in this block: we need to process actions that belong to the
-		next scene, not the current one (which is the old one). */
+		const Frame next = std::min({
+		    nextMultiple_(global, framesInBeat),
+		    nextMultiple_(global, framesInBar),
+		    framesInLoop,
+		    global + bufferSize - local});
+
+		/* Fetch actions in the current segment. Extra care is needed if the
+		scene has changed in this block: we need to process actions that belong
+		to the next scene, not the current one (which is the old one). */
 
-		const std::vector<Action>* as = actions.getActionsOnFrame(global);
-		if (as != nullptr)
-			m_eventBuffer.push_back({EventType::ACTIONS, global, local, as, sceneChanged ? nextScene : currentScene});
+		const std::span<const Action> as = actions.getActionsInRange(global, next);
+		for (std::size_t i = 0, j = 0; i < as.size(); i = j)
+		{
+			const Frame frame = as[i].frame;
+			while (j < as.size() && as[j].frame == frame) // Group actions on the same frame
+				j++;
+			m_eventBuffer.push_back({EventType::ACTIONS, frame, local + frame - global, as.subspan(i, j - i), sceneChanged ? nextScene : currentScene});
+		}
+
+		local += next - global;
 	}
 
 	/* Advance this and quantizer after the event parsing. */
@@ -425,6 +451,12 @@ void Sequencer::setScene(Scene scene)
 
 /* -------------------------------------------------------------------------- */
 
+void Sequencer::offline_start() { rawStart(); }
+void Sequencer::offline_stop() { rawStop(); }
+void Sequencer::offline_rewind() { rawRewind(0); }
+
+/* -------------------------------------------------------------------------- */
+
 #ifdef WITH_AUDIO_JACK
 
 void Sequencer::jack_start()
@@ -33,6 +33,7 @@
 #include "src/core/metronome.h"
 #include "src/core/quantizer.h"
 #include "src/core/ringBuffer.h"
+#include <span>
 #include <vector>
 
 namespace mcl
@@ -67,11 +68,11 @@ public:
 
 	struct Event
 	{
-		EventType                  type    = EventType::NONE;
-		Frame                      global  = 0;
-		Frame                      delta   = 0;
-		const std::vector<Action>* actions = nullptr;
-		Scene                      scene   = {};
+		EventType               type    = EventType::NONE;
+		Frame                   global  = 0;
+		Frame                   delta   = 0;
+		std::span<const Action> actions = {};
+		Scene                   scene   = {};
 	};
 
 	using EventBuffer = RingBuffer<Event, G_MAX_SEQUENCER_EVENTS>;
@@ -175,6 +176,14 @@ public:
 
 	void setScene(Scene);
 
+	/* offline_[*]
+	Same as start(), stop() and rewind(), but immediate: quantizer and JACK
+	transport are ignored. Used by offline rendering, see Bouncer. */
+
+	void offline_start();
+	void offline_stop();
+	void offline_rewind();
+
 #ifdef WITH_AUDIO_JACK
 	void jack_start();
 	void jack_stop();
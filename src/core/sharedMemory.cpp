@@ -0,0 +1,143 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/sharedMemory.h"
+#include "src/utils/log.h"
+#if G_OS_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace giada::m
+{
+#if G_OS_WINDOWS
+
+SharedMemory::SharedMemory(const std::string& name, std::size_t size, Mode mode)
+: m_name(name)
+, m_data(nullptr)
+, m_size(0)
+, m_mapping(nullptr)
+{
+	const std::string systemName = "Local\\" + name;
+	const uint64_t    size64     = static_cast<uint64_t>(size);
+
+	if (mode == Mode::CREATE)
+		m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		    static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), systemName.c_str());
+	else
+		m_mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, systemName.c_str());
+
+	if (m_mapping == nullptr)
+	{
+		u::log::print("[SharedMemory] unable to {} {}\n", mode == Mode::CREATE ? "create" : "open", name);
+		return;
+	}
+
+	m_data = static_cast<std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+	m_size = m_data != nullptr ? size : 0;
+
+	if (m_data == nullptr)
+		u::log::print("[SharedMemory] unable to map {}\n", name);
+}
+
+/* -------------------------------------------------------------------------- */
+
+SharedMemory::~SharedMemory()
+{
+	if (m_data != nullptr)
+		UnmapViewOfFile(m_data);
+	if (m_mapping != nullptr)
+		CloseHandle(m_mapping); // The name goes away with the last handle
+}
+
+#else
+
+SharedMemory::SharedMemory(const std::string& name, std::size_t size, Mode mode)
+: m_name(name)
+, m_data(nullptr)
+, m_size(0)
+, m_owner(false)
+{
+	const std::string systemName = "/" + name;
+
+	const int fd = mode == Mode::CREATE
+	                   ? shm_open(systemName.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR)
+	                   : shm_open(systemName.c_str(), O_RDWR, 0);
+	if (fd == -1)
+	{
+		u::log::print("[SharedMemory] unable to {} {}\n", mode == Mode::CREATE ? "create" : "open", name);
+		return;
+	}
+
+	m_owner = mode == Mode::CREATE;
+
+	/* A freshly truncated object is zero-filled. When opening, make sure the
+	creator has already sized it, or touching the mapping would fault. */
+
+	struct stat info;
+	const bool  sized = m_owner ? ftruncate(fd, size) == 0
+	                            : fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= size;
+	if (sized)
+	{
+		void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (data != MAP_FAILED)
+		{
+			m_data = static_cast<std::byte*>(data);
+			m_size = size;
+		}
+	}
+	close(fd); // The mapping keeps its own reference to the object
+
+	if (m_data == nullptr)
+		u::log::print("[SharedMemory] unable to map {}\n", name);
+}
+
+/* -------------------------------------------------------------------------- */
+
+SharedMemory::~SharedMemory()
+{
+	if (m_data != nullptr)
+		munmap(m_data, m_size);
+	if (m_owner)
+		shm_unlink(("/" + m_name).c_str());
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+bool               SharedMemory::isValid() const { return m_data != nullptr; }
+std::byte*         SharedMemory::getData() const { return m_data; }
+std::size_t        SharedMemory::getSize() const { return m_size; }
+const std::string& SharedMemory::getName() const { return m_name; }
+} // namespace giada::m
@@ -0,0 +1,83 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_SHARED_MEMORY_H
+#define G_SHARED_MEMORY_H
+
+#include "src/const.h"
+#include <cstddef>
+#include <string>
+
+namespace giada::m
+{
+/* SharedMemory
+Named block of memory shared between processes. The process that creates it
+owns the name, which is released when the creating object is destroyed; the
+memory itself lives on until the last process unmaps it. */
+
+class SharedMemory final
+{
+public:
+	enum class Mode
+	{
+		CREATE,
+		OPEN
+	};
+
+	/* SharedMemory
+	Creates a new zero-filled block or opens an existing one. The name must be a
+	plain identifier, without slashes: platform-specific prefixes are added
+	internally. */
+
+	SharedMemory(const std::string& name, std::size_t size, Mode);
+	SharedMemory(const SharedMemory&)            = delete;
+	SharedMemory(SharedMemory&&)                 = delete;
+	SharedMemory& operator=(const SharedMemory&) = delete;
+	SharedMemory& operator=(SharedMemory&&)      = delete;
+	~SharedMemory();
+
+	/* isValid
+	False if the memory could not be created or opened. */
+
+	bool isValid() const;
+
+	std::byte*         getData() const;
+	std::size_t        getSize() const;
+	const std::string& getName() const;
+
+private:
+	std::string m_name;
+	std::byte*  m_data;
+	std::size_t m_size;
+#if G_OS_WINDOWS
+	void* m_mapping; // HANDLE
+#else
+	bool m_owner;
+#endif
+};
+} // namespace giada::m
+
+#endif
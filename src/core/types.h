@@ -96,6 +96,14 @@ enum class InputRecMode : int
 	RIGID = 0,
 	FREE
 };
+
+enum class AutomationParam : int
+{
+	VOLUME = 0,
+	PAN,
+	PITCH,
+	PLUGIN
+};
 } // namespace giada
 
 #endif
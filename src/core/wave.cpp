@@ -25,6 +25,8 @@
  * -------------------------------------------------------------------------- */
 
 #include "src/core/wave.h"
+#include "src/core/mappedFile.h"
+#include "src/core/waveStream.h"
 #include "src/deps/mcl-utils/src/fs.hpp"
 #include <cassert>
 #include <fmt/core.h>
@@ -35,10 +37,12 @@ namespace giada::m
 {
 Wave::Wave(ID id)
 : id(id)
+, m_pendingFrames(0)
 , m_rate(0)
 , m_bits(0)
 , m_logical(false)
 , m_edited(false)
+, m_revision(0)
 {
 }
 
@@ -47,10 +51,14 @@ Wave::Wave(ID id)
 Wave::Wave(const Wave& other)
 : id(other.id)
 , m_buffer(other.getBuffer())
+, m_stream(other.m_stream)
+, m_mappedFile(other.m_mappedFile)
+, m_pendingFrames(other.m_pendingFrames)
 , m_rate(other.m_rate)
 , m_bits(other.m_bits)
 , m_logical(false)
 , m_edited(false)
+, m_revision(0)
 , m_path(other.m_path)
 {
 }
@@ -79,6 +87,25 @@ std::string Wave::getPath() const { return m_path; }
 int         Wave::getBits() const { return m_bits; }
 bool        Wave::isLogical() const { return m_logical; }
 bool        Wave::isEdited() const { return m_edited; }
+bool        Wave::isStreamed() const { return m_stream != nullptr; }
+bool        Wave::isPending() const { return m_pendingFrames > 0; }
+int         Wave::getRevision() const { return m_revision; }
+
+/* -------------------------------------------------------------------------- */
+
+Frame Wave::countFrames() const
+{
+	if (isStreamed())
+		return m_stream->countFrames();
+	if (isPending())
+		return m_pendingFrames;
+	return m_buffer.countFrames();
+}
+
+const WaveStream* Wave::getStream() const
+{
+	return m_stream.get();
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -89,7 +116,7 @@ const mcl::AudioBuffer& Wave::getBuffer() const { return m_buffer; }
 
 float Wave::getDuration() const
 {
-	return m_buffer.countFrames() / static_cast<float>(m_rate);
+	return countFrames() / static_cast<float>(m_rate);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -102,8 +129,24 @@ std::string Wave::getExtension() const
 /* -------------------------------------------------------------------------- */
 
 void Wave::setRate(int v) { m_rate = v; }
-void Wave::setLogical(bool l) { m_logical = l; }
-void Wave::setEdited(bool e) { m_edited = e; }
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setLogical(bool l)
+{
+	m_logical = l;
+	if (l)
+		m_revision++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setEdited(bool e)
+{
+	m_edited = e;
+	if (e)
+		m_revision++;
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -119,6 +162,43 @@ void Wave::setPath(const std::string& p, int wid)
 
 void Wave::replaceData(mcl::AudioBuffer&& b)
 {
-	m_buffer = std::move(b);
+	m_buffer        = std::move(b);
+	m_pendingFrames = 0;
+	m_stream.reset();
+	m_mappedFile.reset();
+	m_revision++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setStream(std::shared_ptr<WaveStream> s, int rate, int bits, const std::string& path)
+{
+	m_buffer = mcl::AudioBuffer();
+	m_stream = std::move(s);
+	m_rate   = rate;
+	m_bits   = bits;
+	m_path   = path;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setMapped(mcl::AudioBuffer&& b, std::shared_ptr<MappedFile> f, int rate, int bits, const std::string& path)
+{
+	m_buffer     = std::move(b);
+	m_mappedFile = std::move(f);
+	m_rate       = rate;
+	m_bits       = bits;
+	m_path       = path;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setPending(Frame size, int rate, int bits, const std::string& path)
+{
+	m_buffer        = mcl::AudioBuffer();
+	m_pendingFrames = size;
+	m_rate          = rate;
+	m_bits          = bits;
+	m_path          = path;
 }
 } // namespace giada::m
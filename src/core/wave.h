@@ -30,10 +30,13 @@
 #include "src/core/types.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/types.h"
+#include <memory>
 #include <string>
 
 namespace giada::m
 {
+class MappedFile;
+class WaveStream;
 class Wave
 {
 public:
@@ -52,6 +55,34 @@ public:
 	bool        isLogical() const;
 	bool        isEdited() const;
 
+	/* isStreamed
+	True if audio data is read from disk while playing, instead of living in
+	the audio buffer. The audio buffer is empty in this case. */
+
+	bool isStreamed() const;
+
+	/* isPending
+	True if audio data is still being loaded in background. A pending Wave is
+	silent and its audio buffer is empty, but it already reports the length it
+	will have once loaded. */
+
+	bool isPending() const;
+
+	/* getRevision
+	Returns a counter that grows every time the audio data is changed in place,
+	i.e. on setLogical(true), setEdited(true) and replaceData(). */
+
+	int getRevision() const;
+
+	/* countFrames
+	Returns the length of the audio data, either in memory, streamed or pending.
+	Use this instead of getBuffer().countFrames() when the Wave could be
+	streamed or pending. */
+
+	Frame countFrames() const;
+
+	const WaveStream* getStream() const;
+
 	/* getBuffer
 	Returns a (non-)const reference to the underlying audio buffer. */
 
@@ -69,21 +100,56 @@ public:
 	void setEdited(bool e);
 
 	/* replaceData
-	Replaces internal audio buffer with 'b' by moving it. */
+	Replaces internal audio buffer with 'b' by moving it. Turns a streamed or
+	pending Wave into a regular, in-memory one. */
 
 	void replaceData(mcl::AudioBuffer&& b);
 
+	/* setStream
+	Same as alloc(), for a Wave streamed from disk. */
+
+	void setStream(std::shared_ptr<WaveStream>, int rate, int bits, const std::string& path);
+
+	/* setMapped
+	Same as alloc(), for audio data living in a memory-mapped file. 'b' must be
+	a view on the mapped memory. */
+
+	void setMapped(mcl::AudioBuffer&& b, std::shared_ptr<MappedFile>, int rate, int bits, const std::string& path);
+
+	/* setPending
+	Same as alloc(), for a Wave whose audio data will be loaded later. Move a
+	fully loaded Wave into this one when ready. */
+
+	void setPending(Frame size, int rate, int bits, const std::string& path);
+
 	void alloc(Frame size, int channels, int rate, int bits, const std::string& path);
 
 	ID id;
 
 private:
 	mcl::AudioBuffer m_buffer;
-	int              m_rate;
-	int              m_bits;
-	bool             m_logical; // memory only (a take)
-	bool             m_edited;  // edited via editor
-	std::string      m_path;    // E.g. /path/to/my/sample.wav
+
+	/* m_stream
+	Disk stream, if streamed. Shared among copies of the same Wave. */
+
+	std::shared_ptr<WaveStream> m_stream;
+
+	/* m_mappedFile
+	Owner of the memory viewed by m_buffer, if loaded from the cache. */
+
+	std::shared_ptr<MappedFile> m_mappedFile;
+
+	/* m_pendingFrames
+	Length of the audio data still being loaded. 0 if not pending. */
+
+	Frame m_pendingFrames;
+
+	int         m_rate;
+	int         m_bits;
+	bool        m_logical;  // memory only (a take)
+	bool        m_edited;   // edited via editor
+	int         m_revision; // See getRevision()
+	std::string m_path;     // E.g. /path/to/my/sample.wav
 };
 } // namespace giada::m
 
@@ -0,0 +1,264 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/waveCache.h"
+#include "src/core/wave.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+namespace giada::m::waveCache
+{
+namespace
+{
+/* Header_
+Entry file header, followed by the key. Audio data starts at DATA_OFFSET_, so
+that it's page-aligned once mapped. */
+
+struct Header_
+{
+	char     magic[4];
+	uint32_t keySize;
+	int64_t  frames;
+	int32_t  channels;
+	int32_t  rate;
+	int32_t  bits;
+};
+
+constexpr char        MAGIC_[4]    = {'G', 'W', 'C', '1'};
+constexpr std::size_t DATA_OFFSET_ = 4096;
+constexpr auto        EXT_         = ".gwc";
+
+std::string path_;
+std::size_t maxSize_ = 0;
+std::mutex  evictMutex_;
+
+/* -------------------------------------------------------------------------- */
+
+std::string getEntryPath_(const std::string& key)
+{
+	return (stdfs::path(path_) / fmt::format("{:016x}{}", std::hash<std::string>{}(key), EXT_)).string();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* evict_
+Deletes the least recently used entries until the cache size is back under
+the limit. Errors are ignored: an entry might be in use by another instance. */
+
+void evict_()
+{
+	struct File
+	{
+		stdfs::path           path;
+		std::uintmax_t        size;
+		stdfs::file_time_type time;
+	};
+
+	std::vector<File> files;
+	std::uintmax_t    total = 0;
+	std::error_code   ec;
+
+	/* Entries might be stored by several threads at once while loading a
+	project. Also, iterate without exceptions: other instances might be
+	deleting files while scanning. */
+
+	std::scoped_lock lock(evictMutex_);
+
+	for (stdfs::directory_iterator it(path_, ec), end; !ec && it != end; it.increment(ec))
+	{
+		const stdfs::directory_entry& e = *it;
+		if (e.path().extension() != EXT_)
+			continue;
+		std::error_code             fileEc;
+		const std::uintmax_t        size = e.file_size(fileEc);
+		const stdfs::file_time_type time = e.last_write_time(fileEc);
+		if (fileEc)
+			continue;
+		files.push_back({e.path(), size, time});
+		total += size;
+	}
+
+	if (total <= maxSize_)
+		return;
+
+	std::sort(files.begin(), files.end(), [](const File& a, const File& b)
+	{ return a.time < b.time; });
+
+	for (const File& f : files)
+	{
+		if (total <= maxSize_)
+			break;
+		if (stdfs::remove(f.path, ec))
+			total -= f.size;
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void init(const std::string& path, std::size_t maxSize)
+{
+	path_    = path;
+	maxSize_ = maxSize;
+
+	if (path_.empty())
+		return;
+
+	std::error_code ec;
+	stdfs::create_directories(path_, ec);
+	if (ec)
+	{
+		u::log::print("[waveCache::init] unable to create {}, cache disabled\n", path_);
+		path_ = "";
+		return;
+	}
+
+	u::log::print("[waveCache::init] using {}, max {} MB\n", path_, maxSize_ / (1024 * 1024));
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::string makeKey(const std::string& path, int samplerate, Resampler::Quality quality)
+{
+	if (path_.empty())
+		return "";
+
+	std::error_code             ec;
+	const stdfs::path           absolute = stdfs::absolute(path, ec);
+	const std::uintmax_t        size     = ec ? 0 : stdfs::file_size(absolute, ec);
+	const stdfs::file_time_type time     = ec ? stdfs::file_time_type() : stdfs::last_write_time(absolute, ec);
+	if (ec)
+		return "";
+
+	return fmt::format("{}|{}|{}|{}|{}", absolute.string(), time.time_since_epoch().count(), size,
+	    samplerate, static_cast<int>(quality));
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::optional<Entry> load(const std::string& key)
+{
+	const std::string entryPath = getEntryPath_(key);
+
+	std::error_code ec;
+	if (!stdfs::exists(entryPath, ec))
+		return {};
+
+	auto file = std::make_shared<MappedFile>(entryPath);
+	if (!file->isValid() || file->getSize() < DATA_OFFSET_)
+		return {};
+
+	Header_ header;
+	std::memcpy(&header, file->getData(), sizeof(Header_));
+
+	const char*       keyData  = reinterpret_cast<const char*>(file->getData() + sizeof(Header_));
+	const std::size_t dataSize = static_cast<std::size_t>(header.frames) * header.channels * sizeof(float);
+
+	if (std::memcmp(header.magic, MAGIC_, sizeof(MAGIC_)) != 0 ||
+	    header.keySize != key.size() ||
+	    key.compare(0, key.size(), keyData, header.keySize) != 0 ||
+	    file->getSize() != DATA_OFFSET_ + dataSize)
+	{
+		u::log::print("[waveCache::load] invalid entry {}, skipped\n", entryPath);
+		return {};
+	}
+
+	/* Mark the entry as recently used, for the eviction policy. */
+
+	stdfs::last_write_time(entryPath, stdfs::file_time_type::clock::now(), ec);
+
+	float*           data = reinterpret_cast<float*>(file->getData() + DATA_OFFSET_);
+	mcl::AudioBuffer buffer(data, static_cast<int>(header.frames), header.channels);
+
+	u::log::print("[waveCache::load] cache hit for {}\n", key);
+
+	return Entry{std::move(file), std::move(buffer), header.rate, header.bits};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void store(const Wave& wave, const std::string& key)
+{
+	const mcl::AudioBuffer& buffer = wave.getBuffer();
+
+	if (sizeof(Header_) + key.size() > DATA_OFFSET_ || buffer.countFrames() == 0)
+		return;
+
+	Header_ header;
+	std::memcpy(header.magic, MAGIC_, sizeof(MAGIC_));
+	header.keySize  = static_cast<uint32_t>(key.size());
+	header.frames   = buffer.countFrames();
+	header.channels = buffer.countChannels();
+	header.rate     = wave.getRate();
+	header.bits     = wave.getBits();
+
+	std::vector<char> prefix(DATA_OFFSET_, 0);
+	std::memcpy(prefix.data(), &header, sizeof(Header_));
+	std::memcpy(prefix.data() + sizeof(Header_), key.data(), key.size());
+
+	/* Write to a temporary file first, then rename it: other instances might be
+	reading the cache at the same time. */
+
+	const std::string entryPath = getEntryPath_(key);
+	const std::string tempPath  = fmt::format("{}.{:x}.tmp", entryPath, std::random_device{}());
+
+	std::ofstream out(tempPath, std::ios::binary);
+	out.write(prefix.data(), prefix.size());
+	out.write(reinterpret_cast<const char*>(buffer[0]), static_cast<std::streamsize>(buffer.countFrames()) * buffer.countChannels() * sizeof(float));
+	out.close();
+
+	std::error_code ec;
+	if (out.fail())
+	{
+		u::log::print("[waveCache::store] unable to write {}\n", tempPath);
+		stdfs::remove(tempPath, ec);
+		return;
+	}
+
+	stdfs::rename(tempPath, entryPath, ec);
+	if (ec)
+	{
+		stdfs::remove(tempPath, ec);
+		return;
+	}
+
+	evict_();
+}
+} // namespace giada::m::waveCache
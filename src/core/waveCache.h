@@ -0,0 +1,86 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_WAVE_CACHE_H
+#define G_WAVE_CACHE_H
+
+#include "src/core/mappedFile.h"
+#include "src/core/resampler.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace giada::m
+{
+class Wave;
+}
+
+/* waveCache
+Persistent on-disk cache of decoded and resampled audio data. Each entry is a
+file of raw float frames, memory-mapped when loaded: no decoding nor sample
+rate conversion is needed, and memory pages are shared among all the Giada
+instances using the same entry. Entries are keyed by source file path,
+modification time and size, target sample rate and resampler quality. */
+
+namespace giada::m::waveCache
+{
+struct Entry
+{
+	std::shared_ptr<MappedFile> file;
+	mcl::AudioBuffer            buffer; // Non-owning view on 'file'
+	int                         rate;
+	int                         bits;
+};
+
+/* init
+Enables the cache, storing up to 'maxSize' bytes of entries in folder 'path'.
+The least recently used entries are deleted when the limit is exceeded. Pass
+an empty path to disable the cache. */
+
+void init(const std::string& path, std::size_t maxSize);
+
+/* makeKey
+Returns the key for the audio data of file 'path', once converted to
+'samplerate' with the given resampler quality. Returns an empty string if the
+cache is disabled or the file can't be inspected. */
+
+std::string makeKey(const std::string& path, int samplerate, Resampler::Quality);
+
+/* load
+Returns the cache entry for 'key', if any. */
+
+std::optional<Entry> load(const std::string& key);
+
+/* store
+Adds the audio data of 'wave' to the cache as 'key'. */
+
+void store(const Wave& wave, const std::string& key);
+} // namespace giada::m::waveCache
+
+#endif
@@ -29,15 +29,25 @@
 #include "src/core/idManager.h"
 #include "src/core/patch.h"
 #include "src/core/wave.h"
+#include "src/core/waveCache.h"
 #include "src/core/waveFx.h"
+#include "src/core/waveStream.h"
 #include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/deps/mcl-utils/src/fs.hpp"
 #include "src/utils/log.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <fmt/core.h>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <samplerate.h>
 #include <sndfile.h>
+#include <thread>
+#include <vector>
 
 namespace utils = mcl::utils;
 
@@ -85,68 +95,130 @@ bool isWavePathUnique_(const m::Wave& skip, const std::string& path,
 			return false;
 	return true;
 }
-} // namespace
 
 /* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
+
+/* getResampledSize_
+Returns the length of 'frames' frames at 'rate', once converted to 'samplerate'. */
+
+int getResampledSize_(Frame frames, int rate, int samplerate)
+{
+	const float ratio = samplerate / (float)rate;
+	return static_cast<int>(ceil(frames * ratio));
+}
+
 /* -------------------------------------------------------------------------- */
 
-std::string makeUniqueWavePath(const std::string& base, const m::Wave& w,
-    const std::vector<std::unique_ptr<Wave>>& waves)
+/* openFile_
+Opens the audio file in 'path' for reading and makes sure it can be loaded.
+Returns nullptr on failure, with the error code in 'status'. */
+
+SNDFILE* openFile_(const std::string& path, SF_INFO& header, int& status)
 {
-	std::string path = utils::fs::join(base, w.getBasename(/*ext=*/true));
-	if (isWavePathUnique_(w, path, waves))
-		return path;
+	if (path == "" || utils::fs::isDir(path))
+	{
+		u::log::print("[waveFactory::create] malformed path (was '{}')\n", path);
+		status = G_RES_ERR_NO_DATA;
+		return nullptr;
+	}
 
-	// TODO - just use a timestamp. e.g. makeWavePath_(..., ..., getTimeStamp())
-	int k = 0;
-	path  = makeWavePath_(base, w, k);
-	while (!isWavePathUnique_(w, path, waves))
-		path = makeWavePath_(base, w, k++);
+	if (path.size() > FILENAME_MAX)
+	{
+		status = G_RES_ERR_PATH_TOO_LONG;
+		return nullptr;
+	}
 
-	return path;
+	SNDFILE* file = sf_open(path.c_str(), SFM_READ, &header);
+
+	if (file == nullptr)
+	{
+		u::log::print("[waveFactory::create] unable to read {}. {}\n", path, sf_strerror(file));
+		status = G_RES_ERR_IO;
+		return nullptr;
+	}
+
+	if (header.channels > G_MAX_IO_CHANS)
+	{
+		u::log::print("[waveFactory::create] unsupported multi-channel sample\n");
+		sf_close(file);
+		status = G_RES_ERR_WRONG_DATA;
+		return nullptr;
+	}
+
+	status = G_RES_OK;
+	return file;
 }
 
-/* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-void reset()
+/* shouldStream_
+Streaming is only possible if the file doesn't need sample rate conversion
+and supports seeking. */
+
+bool shouldStream_(const SF_INFO& header, int samplerate, int streamingThreshold)
 {
-	waveId_ = IdManager();
+	return streamingThreshold > 0 &&
+	       header.seekable &&
+	       header.samplerate == samplerate &&
+	       header.frames > static_cast<sf_count_t>(streamingThreshold) * samplerate &&
+	       header.frames > WaveStream::getResidentFrames(samplerate);
 }
 
 /* -------------------------------------------------------------------------- */
 
-Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality quality)
+/* makeStream_
+Turns 'wave' into a streamed Wave. Takes ownership of 'file'. */
+
+void makeStream_(Wave& wave, SNDFILE* file, const SF_INFO& header, const std::string& path)
 {
-	if (path == "" || utils::fs::isDir(path))
-	{
-		u::log::print("[waveFactory::create] malformed path (was '{}')\n", path);
-		return {G_RES_ERR_NO_DATA};
-	}
+	auto stream = WaveStream::make(file, header.channels, header.frames, header.samplerate);
+	wave.setStream(std::move(stream), header.samplerate, getBits_(header), path);
+}
 
-	if (path.size() > FILENAME_MAX)
-		return {G_RES_ERR_PATH_TOO_LONG};
+/* -------------------------------------------------------------------------- */
+
+/* createFromFile_
+Implementation of createFromFile(). If 'ids' is nullptr, 'id' is used as-is and
+the ID generator is left untouched: used when loading files in parallel. */
 
+Result createFromFile_(const std::string& path, ID id, IdManager* ids, int samplerate,
+    Resampler::Quality quality, int streamingThreshold)
+{
+	int      status;
 	SF_INFO  header;
-	SNDFILE* fileIn = sf_open(path.c_str(), SFM_READ, &header);
+	SNDFILE* fileIn = openFile_(path, header, status);
 
 	if (fileIn == nullptr)
+		return {status};
+
+	if (ids != nullptr)
 	{
-		u::log::print("[waveFactory::create] unable to read {}. {}\n", path, sf_strerror(fileIn));
-		return {G_RES_ERR_IO};
+		ids->set(id);
+		id = ids->generate(id);
 	}
 
-	if (header.channels > G_MAX_IO_CHANS)
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(id);
+
+	if (shouldStream_(header, samplerate, streamingThreshold))
 	{
-		u::log::print("[waveFactory::create] unsupported multi-channel sample\n");
-		return {G_RES_ERR_WRONG_DATA};
+		makeStream_(*wave, fileIn, header, path);
+		u::log::print("[waveFactory::create] new streamed Wave created, {} frames\n", wave->countFrames());
+		return {G_RES_OK, std::move(wave)};
 	}
 
-	waveId_.set(id);
+	/* Skip decoding and sample rate conversion if the result is already in the
+	cache. */
+
+	const std::string cacheKey = waveCache::makeKey(path, samplerate, quality);
+
+	if (std::optional<waveCache::Entry> entry = cacheKey.empty() ? std::nullopt : waveCache::load(cacheKey))
+	{
+		sf_close(fileIn);
+		wave->setMapped(std::move(entry->buffer), std::move(entry->file), entry->rate, entry->bits, path);
+		u::log::print("[waveFactory::create] new Wave created from cache, {} frames\n", wave->countFrames());
+		return {G_RES_OK, std::move(wave)};
+	}
 
-	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate(id));
 	wave->alloc(header.frames, header.channels, header.samplerate, getBits_(header), path);
 
 	if (sf_readf_float(fileIn, wave->getBuffer()[0], header.frames) != header.frames)
@@ -165,10 +237,88 @@ Result createFromFile(const std::string& path, ID id, int samplerate, Resampler:
 			return {G_RES_ERR_PROCESSING};
 	}
 
-	u::log::print("[waveFactory::create] new Wave created, {} frames\n", wave->getBuffer().countFrames());
+	if (!cacheKey.empty())
+		waveCache::store(*wave, cacheKey);
+
+	u::log::print("[waveFactory::create] new Wave created, {} frames\n", wave->countFrames());
 
 	return {G_RES_OK, std::move(wave)};
 }
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::string makeUniqueWavePath(const std::string& base, const m::Wave& w,
+    const std::vector<std::unique_ptr<Wave>>& waves)
+{
+	std::string path = utils::fs::join(base, w.getBasename(/*ext=*/true));
+	if (isWavePathUnique_(w, path, waves))
+		return path;
+
+	// TODO - just use a timestamp. e.g. makeWavePath_(..., ..., getTimeStamp())
+	int k = 0;
+	path  = makeWavePath_(base, w, k);
+	while (!isWavePathUnique_(w, path, waves))
+		path = makeWavePath_(base, w, k++);
+
+	return path;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void reset()
+{
+	waveId_ = IdManager();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality quality,
+    int streamingThreshold)
+{
+	return createFromFile_(path, id, &waveId_, samplerate, quality, streamingThreshold);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Result createPending(const std::string& path, ID id, int samplerate)
+{
+	int      status;
+	SF_INFO  header;
+	SNDFILE* file = openFile_(path, header, status);
+
+	if (file == nullptr)
+		return {status};
+
+	sf_close(file);
+
+	if (header.frames <= 0)
+		return {G_RES_ERR_NO_DATA};
+
+	waveId_.set(id);
+
+	const Frame frames = header.samplerate == samplerate ? header.frames : getResampledSize_(header.frames, header.samplerate, samplerate);
+
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate(id));
+	wave->setPending(frames, samplerate, getBits_(header), path);
+
+	u::log::print("[waveFactory::createPending] new pending Wave created, {} frames\n", frames);
+
+	return {G_RES_OK, std::move(wave)};
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::unique_ptr<Wave> loadPending(const Wave& w, Resampler::Quality quality, int streamingThreshold)
+{
+	assert(w.isPending());
+
+	return createFromFile_(w.getPath(), w.id, nullptr, w.getRate(), quality, streamingThreshold).wave;
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -190,14 +340,38 @@ std::unique_ptr<Wave> createEmpty(int frames, int channels, int samplerate,
 std::unique_ptr<Wave> createFromWave(const Wave& src, int a, int b)
 {
 	a = a == -1 ? 0 : a;
-	b = b == -1 ? src.getBuffer().countFrames() : b;
+	b = b == -1 ? src.countFrames() : b;
 
-	const int channels = src.getBuffer().countChannels();
-	const int frames   = b - a;
+	const int frames = b - a;
 
 	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate());
-	wave->alloc(frames, channels, src.getRate(), src.getBits(), src.getPath());
-	wave->getBuffer().setAll(src.getBuffer(), frames, 0, 0);
+
+	if (src.isStreamed())
+	{
+		/* A full copy gets its own stream, so that it can be played
+		independently. A partial one is read in memory instead. */
+
+		SF_INFO  header;
+		SNDFILE* file = frames == src.countFrames() ? sf_open(src.getPath().c_str(), SFM_READ, &header) : nullptr;
+
+		if (file != nullptr && header.frames == frames)
+		{
+			makeStream_(*wave, file, header, src.getPath());
+			u::log::print("[waveFactory::createFromWave] new streamed Wave created, {} frames\n", frames);
+			return wave;
+		}
+		if (file != nullptr)
+			sf_close(file);
+
+		wave->alloc(frames, G_MAX_IO_CHANS, src.getRate(), src.getBits(), src.getPath());
+		src.getStream()->readBlocking(a, frames, wave->getBuffer()[0]);
+	}
+	else
+	{
+		wave->alloc(frames, src.getBuffer().countChannels(), src.getRate(), src.getBits(), src.getPath());
+		wave->getBuffer().setAll(src.getBuffer(), frames, 0, 0);
+	}
+
 	wave->setLogical(true);
 
 	u::log::print("[waveFactory::createFromWave] new Wave created, {} frames\n", frames);
@@ -207,9 +381,10 @@ std::unique_ptr<Wave> createFromWave(const Wave& src, int a, int b)
 
 /* -------------------------------------------------------------------------- */
 
-std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality quality)
+std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality quality,
+    int streamingThreshold)
 {
-	return createFromFile(w.path, w.id, samplerate, quality).wave;
+	return createFromFile(w.path, w.id, samplerate, quality, streamingThreshold).wave;
 }
 
 const Patch::Wave serializeWave(const Wave& w)
@@ -219,10 +394,87 @@ const Patch::Wave serializeWave(const Wave& w)
 
 /* -------------------------------------------------------------------------- */
 
+std::unique_ptr<Wave> deserializePendingWave(const Patch::Wave& w, int samplerate)
+{
+	return createPending(w.path, w.id, samplerate).wave;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<std::unique_ptr<Wave>> deserializeWaves(const std::vector<Patch::Wave>& waves, int samplerate,
+    Resampler::Quality quality, int streamingThreshold, std::function<void(float)> progress)
+{
+	const std::size_t total = waves.size();
+
+	std::vector<std::unique_ptr<Wave>> out(total);
+
+	if (total == 0)
+		return out;
+
+	/* Workers claim the next file to decode through 'next' and store the result
+	in its own slot, so that the output order doesn't depend on scheduling. IDs
+	are not touched here: the ID generator is not thread-safe. */
+
+	std::atomic<std::size_t> next = 0;
+	std::size_t              done = 0;
+	std::mutex               mutex;
+	std::condition_variable  cond;
+
+	const std::size_t numThreads = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, total);
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < numThreads; t++)
+	{
+		threads.emplace_back([&]()
+		{
+			for (std::size_t i = next++; i < total; i = next++)
+			{
+				out[i] = createFromFile_(waves[i].path, waves[i].id, nullptr, samplerate, quality, streamingThreshold).wave;
+
+				std::scoped_lock lock(mutex);
+				done++;
+				cond.notify_one();
+			}
+		});
+	}
+
+	/* Report progress from the calling thread only: the callback might touch
+	the UI. */
+
+	for (std::size_t reported = 0; reported < total;)
+	{
+		std::unique_lock lock(mutex);
+		cond.wait(lock, [&]() { return done > reported; });
+		reported = done;
+		lock.unlock();
+
+		if (progress != nullptr)
+			progress(reported / static_cast<float>(total));
+	}
+
+	for (std::thread& t : threads)
+		t.join();
+
+	/* Replay the ID bookkeeping in patch order, as deserializeWave() would have
+	done for each file. */
+
+	for (std::unique_ptr<Wave>& wave : out)
+	{
+		if (wave == nullptr)
+			continue;
+		waveId_.set(wave->id);
+		wave->id = waveId_.generate(wave->id);
+	}
+
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
 int resample(Wave& w, Resampler::Quality quality, int samplerate)
 {
 	float ratio         = samplerate / (float)w.getRate();
-	int   newSizeFrames = static_cast<int>(ceil(w.getBuffer().countFrames() * ratio));
+	int   newSizeFrames = getResampledSize_(w.getBuffer().countFrames(), w.getRate(), samplerate);
 
 	mcl::AudioBuffer newData;
 	newData.alloc(newSizeFrames, w.getBuffer().countChannels());
@@ -251,11 +503,26 @@ int resample(Wave& w, Resampler::Quality quality, int samplerate)
 
 /* -------------------------------------------------------------------------- */
 
+mcl::AudioBuffer readStream(const Wave& w)
+{
+	assert(w.isStreamed());
+
+	mcl::AudioBuffer data;
+	data.alloc(w.countFrames(), G_MAX_IO_CHANS);
+	w.getStream()->readBlocking(0, w.countFrames(), data[0]);
+
+	u::log::print("[waveFactory::readStream] Wave {} read in memory, {} frames\n", w.id.getValue(), w.countFrames());
+
+	return data;
+}
+
+/* -------------------------------------------------------------------------- */
+
 int save(const Wave& w, const std::string& path)
 {
 	SF_INFO header;
 	header.samplerate = w.getRate();
-	header.channels   = w.getBuffer().countChannels();
+	header.channels   = w.isStreamed() ? G_MAX_IO_CHANS : w.getBuffer().countChannels();
 	header.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
 
 	SNDFILE* file = sf_open(path.c_str(), SFM_WRITE, &header);
@@ -266,7 +533,22 @@ int save(const Wave& w, const std::string& path)
 		return G_RES_ERR_IO;
 	}
 
-	if (sf_writef_float(file, w.getBuffer()[0], w.getBuffer().countFrames()) != w.getBuffer().countFrames())
+	if (w.isStreamed())
+	{
+		/* Copy the file chunk by chunk, without reading it all in memory. */
+
+		constexpr Frame    CHUNK_FRAMES = 8192;
+		std::vector<float> chunk(CHUNK_FRAMES * G_MAX_IO_CHANS);
+
+		for (Frame f = 0; f < w.countFrames(); f += CHUNK_FRAMES)
+		{
+			const Frame frames = std::min(CHUNK_FRAMES, w.countFrames() - f);
+			w.getStream()->readBlocking(f, frames, chunk.data());
+			if (sf_writef_float(file, chunk.data(), frames) != frames)
+				u::log::print("[waveFactory::save] warning: incomplete write!\n");
+		}
+	}
+	else if (sf_writef_float(file, w.getBuffer()[0], w.getBuffer().countFrames()) != w.getBuffer().countFrames())
 		u::log::print("[waveFactory::save] warning: incomplete write!\n");
 
 	sf_close(file);
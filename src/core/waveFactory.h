@@ -32,8 +32,10 @@
 #include "src/core/resampler.h"
 #include "src/core/types.h"
 #include "src/core/wave.h"
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace giada::m::waveFactory
 {
@@ -51,9 +53,27 @@ void reset();
 /* create
     Creates a new Wave object with data read from file 'path'. Pass id = 0 to
     auto-generate it. The function converts the Wave sample rate if it doesn't
-    match the desired one as specified in 'samplerate'. */
+    match the desired one as specified in 'samplerate'. Files longer than
+    'streamingThreshold' seconds are streamed from disk instead, if no
+    conversion is needed. Pass streamingThreshold = 0 to always load the whole
+    file in memory. */
 
-Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality);
+Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality,
+    int streamingThreshold = 0);
+
+/* createPending
+    Creates a pending Wave (see Wave::isPending) for the audio file 'path'. Only
+    the file header is read, the audio data is left on disk: use loadPending()
+    to load it. */
+
+Result createPending(const std::string& path, ID id, int samplerate);
+
+/* loadPending
+    Decodes the audio data of a pending Wave into a new Wave, with the same ID,
+    path and length. Move the result into the pending Wave once ready. Returns
+    nullptr on failure. Thread-safe. */
+
+std::unique_ptr<Wave> loadPending(const Wave&, Resampler::Quality, int streamingThreshold = 0);
 
 /* createEmpty
     Creates a new silent Wave object. */
@@ -63,22 +83,45 @@ std::unique_ptr<Wave> createEmpty(int frames, int channels, int samplerate,
 
 /* createFromWave
     Creates a new Wave from an existing one. If specified, copying the data in
-    range a - b. Range is [0, sr.buffer.countFrames()] otherwise. */
+    range a - b. Range is [0, src.countFrames()] otherwise. A full copy of a
+    streamed Wave is streamed as well. */
 
 std::unique_ptr<Wave> createFromWave(const Wave& src, int a = -1, int b = -1);
 
 /* (de)serializeWave
     Creates a new Wave given the patch raw data and vice versa. */
 
-std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality);
+std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality,
+    int streamingThreshold = 0);
 const Patch::Wave     serializeWave(const Wave& w);
 
+/* deserializePendingWave
+    Same as deserializeWave(), but creates a pending Wave. See createPending(). */
+
+std::unique_ptr<Wave> deserializePendingWave(const Patch::Wave& w, int samplerate);
+
+/* deserializeWaves
+    Same as deserializeWave(), but decodes all the given waves in parallel on a
+    pool of worker threads. The returned vector follows the input order; missing
+    or broken files are nullptr. Wave IDs are generated as if the waves were
+    loaded one after another. The 'progress' callback, if any, is invoked on the
+    calling thread each time a file is done, with a value in [0.0, 1.0]. */
+
+std::vector<std::unique_ptr<Wave>> deserializeWaves(const std::vector<Patch::Wave>&, int samplerate,
+    Resampler::Quality, int streamingThreshold = 0, std::function<void(float)> progress = nullptr);
+
 /* resample
     Change sample rate of 'w' to the desider value. The 'quality' parameter sets
     the algorithm to use for the conversion. */
 
 int resample(Wave&, Resampler::Quality, int samplerate);
 
+/* readStream
+    Reads the whole audio data of a streamed Wave from disk. Pass the result to
+    Wave::replaceData() to turn it into a regular, in-memory Wave. */
+
+mcl::AudioBuffer readStream(const Wave&);
+
 /* save
     Writes Wave data to file 'path'. Only 'wav' format is supported for now. */
 
@@ -0,0 +1,258 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "src/core/waveLoader.h"
+#include "src/core/model/model.h"
+#include "src/core/waveFactory.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <unordered_set>
+
+namespace giada::m
+{
+WaveLoader::WaveLoader(model::Model& m)
+: onWaveReady(nullptr)
+, m_model(m)
+, m_busy(0)
+, m_applyRequested(false)
+, m_rsmpQuality(Resampler::Quality::LINEAR)
+, m_streamingThreshold(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+WaveLoader::~WaveLoader()
+{
+	cancel();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool WaveLoader::isLoading() const
+{
+	std::scoped_lock lock(m_mutex);
+	return !m_queue.empty() || m_busy > 0 || !m_ready.empty();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::start(Scene scene, Resampler::Quality quality, int streamingThreshold)
+{
+	assert(scene.isValid());
+
+	cancel();
+
+	/* Queue Waves scene by scene, starting from the given one. Any other pending
+	Wave not in use by channels goes last. */
+
+	std::unordered_set<ID> queued;
+	std::deque<Wave>       queue;
+
+	for (std::size_t i = 0; i < G_MAX_NUM_SCENES; i++)
+		for (const Wave* wave : getPendingWaves(Scene{(scene.getIndex() + i) % G_MAX_NUM_SCENES}))
+			if (queued.insert(wave->id).second)
+				queue.push_back(*wave);
+
+	for (const std::unique_ptr<Wave>& wave : m_model.getAllWaves())
+		if (wave->isPending() && queued.insert(wave->id).second)
+			queue.push_back(*wave);
+
+	if (queue.empty())
+		return;
+
+	/* Leave some cores free: audio is already being rendered while samples are
+	loading. */
+
+	const std::size_t numThreads = std::clamp<std::size_t>(std::thread::hardware_concurrency() / 2, 1, queue.size());
+
+	u::log::print("[WaveLoader::start] loading {} Waves in background, {} threads\n", queue.size(), numThreads);
+
+	m_rsmpQuality        = quality;
+	m_streamingThreshold = streamingThreshold;
+	m_queue              = std::move(queue);
+
+	for (std::size_t i = 0; i < numThreads; i++)
+		m_threads.emplace_back([this]()
+		{ run(); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::prioritize(Scene scene)
+{
+	const std::vector<const Wave*> waves = getPendingWaves(scene);
+
+	std::scoped_lock lock(m_mutex);
+
+	auto front = m_queue.begin();
+	for (const Wave* wave : waves)
+	{
+		auto it = std::find_if(front, m_queue.end(), [id = wave->id](const Wave& w)
+		{ return w.id == id; });
+		if (it == m_queue.end())
+			continue;
+		std::rotate(front, it, it + 1);
+		++front;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::cancel()
+{
+	{
+		std::scoped_lock lock(m_mutex);
+		m_queue.clear();
+	}
+
+	for (std::thread& t : m_threads)
+		t.join();
+	m_threads.clear();
+
+	std::scoped_lock lock(m_mutex);
+	m_ready.clear();
+	m_applyRequested.store(false);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::wait()
+{
+	for (std::thread& t : m_threads)
+		t.join();
+	m_threads.clear();
+
+	apply();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::apply()
+{
+	m_applyRequested.store(false);
+
+	std::vector<std::unique_ptr<Wave>> ready;
+	{
+		std::scoped_lock lock(m_mutex);
+		ready.swap(m_ready);
+	}
+
+	if (ready.empty())
+		return;
+
+	model::SharedLock lock = m_model.lockShared();
+
+	for (std::unique_ptr<Wave>& wave : ready)
+	{
+		/* The pending Wave might have been removed or replaced in the meantime,
+		e.g. a new sample has been loaded in its channel. */
+
+		Wave* pending = m_model.findWave(wave->id);
+		if (pending == nullptr || !pending->isPending() || pending->getPath() != wave->getPath())
+			continue;
+
+		/* Sample ranges in channels are based on the pending length: don't go
+		beyond it, if the file has changed on disk in the meantime. */
+
+		if (pending->countFrames() != wave->countFrames())
+		{
+			u::log::print("[WaveLoader::apply] length mismatch for {}, skipping\n", wave->getPath());
+			continue;
+		}
+
+		*pending = std::move(*wave);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<const Wave*> WaveLoader::getPendingWaves(Scene scene) const
+{
+	const model::Document& document = m_model.get();
+
+	std::vector<const Wave*> sequenced;
+	std::vector<const Wave*> others;
+
+	for (const Channel* ch : document.tracks.getChannels())
+	{
+		if (ch->type != ChannelType::SAMPLE || !ch->sampleChannel->hasPendingWave(scene))
+			continue;
+
+		const bool isSequenced = ch->sampleChannel->isAnyLoopMode() || document.actions.hasActions(ch->id);
+
+		(isSequenced ? sequenced : others).push_back(ch->sampleChannel->getWave(scene));
+	}
+
+	sequenced.insert(sequenced.end(), others.begin(), others.end());
+	return sequenced;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::run()
+{
+	while (true)
+	{
+		std::unique_ptr<Wave> pending;
+		{
+			std::scoped_lock lock(m_mutex);
+			if (m_queue.empty())
+				return;
+			pending = std::make_unique<Wave>(std::move(m_queue.front()));
+			m_queue.pop_front();
+			m_busy++;
+		}
+
+		std::unique_ptr<Wave> wave   = waveFactory::loadPending(*pending, m_rsmpQuality, m_streamingThreshold);
+		const bool            loaded = wave != nullptr;
+
+		{
+			std::scoped_lock lock(m_mutex);
+			m_busy--;
+			if (loaded)
+				m_ready.push_back(std::move(wave));
+		}
+
+		/* A Wave that can't be loaded just stays pending, i.e. silent. */
+
+		if (!loaded)
+		{
+			u::log::print("[WaveLoader::run] unable to load {}\n", pending->getPath());
+			continue;
+		}
+
+		/* Ask for a single apply() for many Waves, if they are ready close to each
+		other. */
+
+		if (onWaveReady != nullptr && !m_applyRequested.exchange(true))
+			onWaveReady();
+	}
+}
+} // namespace giada::m
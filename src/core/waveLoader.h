@@ -0,0 +1,133 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_WAVE_LOADER_H
+#define G_WAVE_LOADER_H
+
+#include "src/core/resampler.h"
+#include "src/core/wave.h"
+#include "src/scene.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace giada::m::model
+{
+class Model;
+}
+
+namespace giada::m
+{
+/* WaveLoader
+Decodes in background the audio data of pending Waves (see Wave::isPending),
+so that a project can be played before all its samples are loaded. */
+
+class WaveLoader final
+{
+public:
+	WaveLoader(model::Model&);
+	~WaveLoader();
+
+	/* isLoading
+	True if some Waves are still waiting to be decoded or applied. */
+
+	bool isLoading() const;
+
+	/* start
+	Starts loading all the pending Waves in the model. Waves used by 'scene'
+	come first, then those in the following scenes. Within a scene, Waves in
+	channels driven by the sequencer (loops, recorded actions) come first. Any
+	previous job is cancelled. */
+
+	void start(Scene, Resampler::Quality, int streamingThreshold);
+
+	/* prioritize
+	Moves the Waves used by 'scene' to the front of the queue, e.g. when the
+	scene is about to be played. */
+
+	void prioritize(Scene);
+
+	/* cancel
+	Discards all queued Waves. Blocks until the ones being decoded are done. */
+
+	void cancel();
+
+	/* wait
+	Blocks until all queued Waves have been decoded, then applies them. */
+
+	void wait();
+
+	/* apply
+	Moves decoded audio data into the pending Waves of the model. Must be called
+	by a thread that is allowed to alter the model. */
+
+	void apply();
+
+	/* onWaveReady
+	Callback fired by a worker thread when some audio data is ready to be
+	applied. */
+
+	std::function<void()> onWaveReady;
+
+private:
+	/* getPendingWaves
+	Returns the pending Waves used by 'scene', in loading order. */
+
+	std::vector<const Wave*> getPendingWaves(Scene) const;
+
+	/* run
+	Worker thread body: decodes Waves from the queue until it's empty. */
+
+	void run();
+
+	model::Model& m_model;
+
+	/* m_queue
+	Copies of the pending Waves to decode: they carry all the information
+	needed to load the actual data. */
+
+	std::deque<Wave> m_queue;
+
+	/* m_ready
+	Decoded Waves, waiting to be applied. */
+
+	std::vector<std::unique_ptr<Wave>> m_ready;
+
+	std::vector<std::thread> m_threads;
+	mutable std::mutex       m_mutex;
+	int                      m_busy;
+	std::atomic<bool>        m_applyRequested;
+	Resampler::Quality       m_rsmpQuality;
+	int                      m_streamingThreshold;
+};
+} // namespace giada::m
+
+#endif
@@ -0,0 +1,395 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "src/core/waveStream.h"
+#include "src/core/const.h"
+#include "src/utils/log.h"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m
+{
+namespace
+{
+/* HEAD_SECONDS_, WINDOW_SECONDS_
+Length of the always resident head and of the streaming window. */
+
+constexpr int HEAD_SECONDS_   = 2;
+constexpr int WINDOW_SECONDS_ = 4;
+
+/* MIRROR_FRAMES_
+Max number of contiguous frames read() can return, also across the end of the
+ring. It's also the amount of data behind the playhead the streaming thread never
+overwrites, so that the audio thread can safely read a whole block. */
+
+constexpr Frame MIRROR_FRAMES_ = 32768;
+
+/* CHUNK_FRAMES_
+How many frames to read from disk at once. */
+
+constexpr Frame CHUNK_FRAMES_ = 8192;
+
+/* registry_
+All existing streams, refilled by the streaming thread. Weak references: a
+stream being refilled is kept alive by the streaming thread until done. */
+
+std::mutex                             registryMutex_;
+std::vector<std::weak_ptr<WaveStream>> registry_;
+int                                    pastUnderruns_   = 0; // From already deleted streams
+int                                    loggedUnderruns_ = 0;
+
+/* -------------------------------------------------------------------------- */
+
+Frame getWindowLength_(int sampleRate)
+{
+	return std::max(WINDOW_SECONDS_ * sampleRate, MIRROR_FRAMES_ * 4);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* copyFrame_
+Copies a single frame from file to memory, turning mono into stereo. */
+
+void copyFrame_(const float* src, float* dest, int srcChannels)
+{
+	dest[0] = src[0];
+	dest[1] = srcChannels == 1 ? src[0] : src[1];
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+WaveStream::WaveStream(SNDFILE* file, int fileChannels, Frame length, int sampleRate)
+: m_file(file)
+, m_fileChannels(fileChannels)
+, m_length(length)
+, m_headLength(std::min(length, HEAD_SECONDS_ * sampleRate))
+, m_windowLength(getWindowLength_(sampleRate))
+, m_readBuffer(MIRROR_FRAMES_, G_MAX_IO_CHANS)
+, m_begin(m_headLength)
+, m_end(m_headLength)
+, m_epoch(0)
+, m_playhead(0)
+, m_underruns(0)
+, m_filePos(0)
+{
+	assert(fileChannels > 0 && fileChannels <= G_MAX_IO_CHANS);
+
+	m_buffer.alloc(m_headLength + m_windowLength + MIRROR_FRAMES_, G_MAX_IO_CHANS);
+	m_scratch.resize(CHUNK_FRAMES_ * fileChannels);
+
+	load(0, m_headLength);
+	fill();
+}
+
+/* -------------------------------------------------------------------------- */
+
+WaveStream::~WaveStream()
+{
+	{
+		std::scoped_lock lock(registryMutex_);
+		pastUnderruns_ += m_underruns.load();
+	}
+	sf_close(m_file);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::shared_ptr<WaveStream> WaveStream::make(SNDFILE* file, int fileChannels, Frame length, int sampleRate)
+{
+	auto stream = std::make_shared<WaveStream>(file, fileChannels, length, sampleRate);
+
+	std::scoped_lock lock(registryMutex_);
+	registry_.push_back(stream);
+	return stream;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame WaveStream::getResidentFrames(int sampleRate)
+{
+	return (HEAD_SECONDS_ * sampleRate) + getWindowLength_(sampleRate) + MIRROR_FRAMES_;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::refillAll()
+{
+	/* Take a snapshot of the live streams, then read from disk without holding
+	the lock: streams are destroyed by the main thread while the model is
+	locked, and it must not wait for disk I/O. */
+
+	std::vector<std::shared_ptr<WaveStream>> streams;
+	{
+		std::scoped_lock lock(registryMutex_);
+		std::erase_if(registry_, [](const std::weak_ptr<WaveStream>& w)
+		    { return w.expired(); });
+		for (const std::weak_ptr<WaveStream>& w : registry_)
+			if (std::shared_ptr<WaveStream> stream = w.lock(); stream != nullptr)
+				streams.push_back(std::move(stream));
+	}
+
+	int underruns = 0;
+	for (const std::shared_ptr<WaveStream>& stream : streams)
+	{
+		stream->fill();
+		underruns += stream->m_underruns.load();
+	}
+
+	/* Release the snapshot before counting: streams dropped in the meantime
+	are destroyed here and move their underruns to pastUnderruns_. */
+
+	streams.clear();
+
+	std::scoped_lock lock(registryMutex_);
+
+	underruns += pastUnderruns_;
+	if (underruns > loggedUnderruns_)
+		u::log::print("[WaveStream::refillAll] {} new underrun(s), {} total\n", underruns - loggedUnderruns_, underruns);
+	loggedUnderruns_ = std::max(loggedUnderruns_, underruns);
+}
+
+/* -------------------------------------------------------------------------- */
+
+WaveStream::Stats WaveStream::getStats()
+{
+	std::scoped_lock lock(registryMutex_);
+
+	Stats stats{0, pastUnderruns_};
+	for (const std::weak_ptr<WaveStream>& w : registry_)
+	{
+		if (const std::shared_ptr<WaveStream> stream = w.lock(); stream != nullptr)
+		{
+			stats.streams++;
+			stats.underruns += stream->m_underruns.load();
+		}
+	}
+	return stats;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame WaveStream::countFrames() const
+{
+	return m_length;
+}
+
+/* -------------------------------------------------------------------------- */
+
+const float* WaveStream::read(Frame start, Frame frames, Frame& available) const
+{
+	assert(start >= 0 && start < m_length);
+
+	m_playhead.store(start);
+
+	/* Seqlock-style read: take a snapshot of the window, copy the data, then
+	make sure the streaming thread hasn't released it in the meantime. The end
+	is loaded before the begin: fill() publishes a new end only after having
+	moved the begin, so the snapshot never pairs a stale begin with a fresh
+	end, unless a reload happened - which the epoch tells. */
+
+	const std::uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+	const Frame         end   = m_end.load(std::memory_order_acquire);
+	const Frame         begin = m_begin.load(std::memory_order_acquire);
+
+	Frame pos = 0;
+	available = 0;
+
+	if (start < m_headLength)
+	{
+		/* The window immediately follows the head in memory, as long as it
+		hasn't moved forward yet. */
+
+		pos       = start;
+		available = (begin == m_headLength ? end : m_headLength) - start;
+	}
+	else if (start >= begin && start < end)
+	{
+		pos       = toPhysical(start);
+		available = std::min(end - start, m_buffer.countFrames() - pos);
+	}
+
+	if (available < frames || frames > m_readBuffer.countFrames())
+	{
+		available = 0;
+		m_underruns.fetch_add(1);
+		return nullptr;
+	}
+
+	std::copy(m_buffer[pos], m_buffer[pos] + (frames * G_MAX_IO_CHANS), m_readBuffer[0]);
+
+	/* Frames in the window are overwritten only after begin has moved past
+	them, or after a reload. The head never changes. */
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	const bool usesWindow = start + frames > m_headLength;
+	if (usesWindow && (m_epoch.load(std::memory_order_relaxed) != epoch ||
+	                      m_begin.load(std::memory_order_relaxed) > std::max(start, m_headLength)))
+	{
+		available = 0;
+		m_underruns.fetch_add(1);
+		return nullptr;
+	}
+
+	available = frames;
+	return m_readBuffer[0];
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::readBlocking(Frame start, Frame frames, float* dest) const
+{
+	std::scoped_lock lock(m_fileMutex);
+
+	seek(start);
+	for (Frame done = 0; done < frames;)
+	{
+		const Frame chunk = std::min(frames - done, CHUNK_FRAMES_);
+		readFile(chunk);
+		for (Frame i = 0; i < chunk; i++)
+			copyFrame_(&m_scratch[i * m_fileChannels], dest + ((done + i) * G_MAX_IO_CHANS), m_fileChannels);
+		done += chunk;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::fill() const
+{
+	std::scoped_lock lock(m_fileMutex);
+
+	const Frame target = std::max(m_playhead.load(), m_headLength);
+	Frame       begin  = m_begin.load();
+	Frame       end    = m_end.load();
+
+	/* The playhead has jumped outside the window: restart the window from there.
+	Bump the epoch and shrink the window to an empty range first, so that the
+	audio thread never sees stale frames as valid in the meantime. The order of
+	the two stores keeps begin <= end at any time. */
+
+	if (target > end || target < begin)
+	{
+		m_epoch.store(m_epoch.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		if (target > end)
+		{
+			m_begin.store(target, std::memory_order_release);
+			m_end.store(target, std::memory_order_release);
+		}
+		else
+		{
+			m_end.store(target, std::memory_order_release);
+			m_begin.store(target, std::memory_order_release);
+		}
+		begin = end = target;
+	}
+
+	const Frame limit = std::min(m_length, std::max(begin, target - MIRROR_FRAMES_) + m_windowLength);
+
+	seek(end);
+	while (end < limit)
+	{
+		const Frame frames = std::min(limit - end, CHUNK_FRAMES_);
+
+		/* Release the frames that are about to be overwritten, then publish
+		the new ones once written. */
+
+		begin = std::max(begin, end + frames - m_windowLength);
+		m_begin.store(begin, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		load(end, frames);
+		end += frames;
+		m_end.store(end, std::memory_order_release);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::load(Frame start, Frame frames) const
+{
+	for (Frame done = 0; done < frames;)
+	{
+		const Frame chunk = std::min(frames - done, CHUNK_FRAMES_);
+		readFile(chunk);
+
+		for (Frame i = 0; i < chunk; i++)
+		{
+			const Frame  f   = start + done + i;
+			const float* src = &m_scratch[i * m_fileChannels];
+
+			if (f < m_headLength)
+			{
+				copyFrame_(src, m_buffer[f], m_fileChannels);
+				continue;
+			}
+
+			const Frame pos = toPhysical(f);
+			copyFrame_(src, m_buffer[pos], m_fileChannels);
+			if (pos - m_headLength < MIRROR_FRAMES_)
+				copyFrame_(src, m_buffer[pos + m_windowLength], m_fileChannels);
+		}
+		done += chunk;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::readFile(Frame frames) const
+{
+	assert(frames <= CHUNK_FRAMES_);
+
+	const sf_count_t read = std::max<sf_count_t>(0, sf_readf_float(m_file, m_scratch.data(), frames));
+	std::fill(m_scratch.begin() + (read * m_fileChannels), m_scratch.begin() + (frames * m_fileChannels), 0.0f);
+
+	/* After a short read the actual file position is unknown: force a seek on
+	the next access. */
+
+	m_filePos = read == frames ? m_filePos + frames : -1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::seek(Frame f) const
+{
+	if (f == m_filePos)
+		return;
+	if (sf_seek(m_file, f, SEEK_SET) == -1)
+		u::log::print("[WaveStream::seek] unable to seek to frame {}\n", f);
+	m_filePos = f;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame WaveStream::toPhysical(Frame f) const
+{
+	return m_headLength + ((f - m_headLength) % m_windowLength);
+}
+} // namespace giada::m
@@ -0,0 +1,188 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_WAVE_STREAM_H
+#define G_WAVE_STREAM_H
+
+#include "src/core/types.h"
+#include "src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "src/types.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sndfile.h>
+#include <vector>
+
+namespace giada::m
+{
+/* WaveStream
+Disk-backed audio data for a Wave too long to be kept in memory. Only the first
+seconds of the file (the head) are always resident. The rest is read into a
+ring-buffered window that a background thread keeps filled ahead of the last
+position read by the audio thread. Data is always stored as stereo.
+A stream follows a single playhead, so it must have a single reader: Waves
+played by more than one channel at once get a stream each (see
+waveFactory::createFromWave). */
+
+class WaveStream final
+{
+public:
+	struct Stats
+	{
+		int streams   = 0;
+		int underruns = 0;
+	};
+
+	/* make
+	Creates a new stream and registers it for refilling. Takes ownership of the
+	already opened 'file' and preloads both the head and the first window. Not
+	realtime-safe. */
+
+	static std::shared_ptr<WaveStream> make(SNDFILE* file, int fileChannels, Frame length, int sampleRate);
+
+	/* WaveStream
+	Use make() instead: a stream built directly is never refilled. */
+
+	WaveStream(SNDFILE* file, int fileChannels, Frame length, int sampleRate);
+	WaveStream(const WaveStream&)            = delete;
+	WaveStream(WaveStream&&)                 = delete;
+	WaveStream& operator=(const WaveStream&) = delete;
+	WaveStream& operator=(WaveStream&&)      = delete;
+	~WaveStream();
+
+	/* getResidentFrames
+	Returns how many frames a stream keeps in memory. Files shorter than this
+	are not worth streaming. */
+
+	static Frame getResidentFrames(int sampleRate);
+
+	/* refillAll
+	Refills the windows of all existing streams. Called periodically by the
+	streaming thread. Disk access happens without holding the registry lock,
+	so streams can be destroyed in the meantime. */
+
+	static void refillAll();
+
+	/* getStats
+	Returns the number of existing streams and the total number of underruns
+	so far. */
+
+	static Stats getStats();
+
+	Frame countFrames() const;
+
+	/* read
+	Copies 'frames' interleaved stereo frames starting at 'start' into a private
+	buffer and returns a pointer to it, valid until the next call. 'available'
+	is set to 'frames' on success. Returns nullptr and counts an underrun if the
+	data is not in memory yet, or if the streaming thread has overwritten it
+	while copying. Realtime-safe. */
+
+	const float* read(Frame start, Frame frames, Frame& available) const;
+
+	/* readBlocking
+	Reads 'frames' frames starting at 'start' straight from disk into 'dest',
+	bypassing the window. Not realtime-safe. Used to materialize or save the
+	whole file. */
+
+	void readBlocking(Frame start, Frame frames, float* dest) const;
+
+private:
+	/* fill
+	Moves the window to follow the playhead and reads the missing data from
+	disk. */
+
+	void fill() const;
+
+	/* load
+	Reads 'frames' frames from disk and stores them in memory as frames
+	[start, start + frames), either in the head or in the window. */
+
+	void load(Frame start, Frame frames) const;
+
+	/* readFile
+	Reads up to CHUNK_FRAMES_ frames from the current file position into
+	m_scratch. Missing frames are zero-filled. */
+
+	void readFile(Frame frames) const;
+
+	void seek(Frame f) const;
+
+	/* toPhysical
+	Returns the position in m_buffer of frame 'f', which must not belong to the
+	head. */
+
+	Frame toPhysical(Frame f) const;
+
+	SNDFILE* m_file;
+	int      m_fileChannels;
+	Frame    m_length;
+	Frame    m_headLength;
+	Frame    m_windowLength;
+
+	/* m_buffer
+	Head + window + mirror. The mirror repeats the first frames of the window
+	so that reads across the end of the ring are still contiguous. */
+
+	mutable mcl::AudioBuffer m_buffer;
+
+	/* m_readBuffer
+	Private copy of the last block returned by read(). */
+
+	mutable mcl::AudioBuffer m_readBuffer;
+
+	/* m_begin, m_end
+	Range of frames [begin, end) currently available in the window. fill()
+	moves begin forward before overwriting frames, and end forward after having
+	written them. */
+
+	mutable std::atomic<Frame> m_begin;
+	mutable std::atomic<Frame> m_end;
+
+	/* m_epoch
+	Bumped by fill() every time the window restarts from a new position. Lets
+	read() detect a reload happened while copying, seqlock-style. */
+
+	mutable std::atomic<std::uint32_t> m_epoch;
+
+	/* m_playhead
+	Last frame read by the audio thread. */
+
+	mutable std::atomic<Frame> m_playhead;
+	mutable std::atomic<int>   m_underruns;
+
+	/* m_fileMutex
+	Serializes disk access between the streaming thread and readBlocking(). */
+
+	mutable std::mutex         m_fileMutex;
+	mutable Frame              m_filePos;
+	mutable std::vector<float> m_scratch;
+};
+} // namespace giada::m
+
+#endif
@@ -133,6 +133,27 @@ void deleteSampleAction(const m::Action& a)
 
 /* -------------------------------------------------------------------------- */
 
+void recordAutomationAction(ID channelId, AutomationParam param, Frame f, float value)
+{
+	g_engine->getActionEditorApi().recordAutomationAction(channelId, param, f, value);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void deleteAutomationAction(const m::Action& a)
+{
+	g_engine->getActionEditorApi().deleteAutomationAction(a);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void updateAutomationAction(ID channelId, const m::Action& a, Frame f, float value)
+{
+	g_engine->getActionEditorApi().updateAutomationAction(channelId, a, f, value);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void updateVelocity(const m::Action& a, float value)
 {
 	g_engine->getActionEditorApi().updateVelocity(a, value);
@@ -91,6 +91,12 @@ void recordSampleAction(ID channelId, int type, Frame f1, Frame f2 = 0);
 void deleteSampleAction(const m::Action& a);
 void updateSampleAction(ID channelId, const m::Action& a, int type,
     Frame f1, Frame f2 = 0);
+
+/* Automation actions. Values are normalized to [0.0, 1.0]. */
+
+void recordAutomationAction(ID channelId, AutomationParam, Frame f, float value);
+void deleteAutomationAction(const m::Action& a);
+void updateAutomationAction(ID channelId, const m::Action& a, Frame f, float value);
 } // namespace giada::c::actionEditor
 
 #endif
@@ -93,6 +93,7 @@ Track makeTrack_(const m::model::Track& modelTrack, Scene scene)
 
 SampleData::SampleData(const m::Channel& ch, Scene scene)
 : waveId(ch.sampleChannel->getWaveId(scene))
+, isLoading(ch.sampleChannel->hasPendingWave(scene))
 , mode(ch.sampleChannel->mode)
 , isLoop(ch.sampleChannel->isAnyLoopMode())
 , pitch(ch.sampleChannel->getPitch(scene))
@@ -189,6 +190,13 @@ RoutingData getRoutingData(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
+m::Profiler::Stats getCpuStats(ID channelId)
+{
+	return g_engine->getMainApi().getCpuStats(m::Profiler::Section::CHANNEL, channelId);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void loadChannel(ID channelId, const std::string& fname)
 {
 	auto progress = g_ui->mainWindow->getScopedProgress(g_ui->getI18Text(v::LangMap::MESSAGE_CHANNEL_LOADINGSAMPLES));
@@ -393,10 +401,10 @@ void killChannel(ID channelId, Thread t)
 
 float setChannelVolume(ID channelId, float v, Thread t, bool repaintMainUi)
 {
-	g_engine->getChannelsApi().setVolume(channelId, v);
+	g_engine->getChannelsApi().setVolume(channelId, v, t);
 	notifyChannelForMidiIn(t, channelId);
 
-	if (t != Thread::MAIN || repaintMainUi)
+	if (g_ui != nullptr && (t != Thread::MAIN || repaintMainUi))
 		g_ui->pumpEvent([channelId, v]()
 		{ g_ui->mainWindow->keyboard->setChannelVolume(channelId, v); });
 
@@ -407,11 +415,12 @@ float setChannelVolume(ID channelId, float v, Thread t, bool repaintMainUi)
 
 float setChannelPitch(ID channelId, float v, Thread t)
 {
-	g_engine->getChannelsApi().setPitch(channelId, v);
-	g_ui->pumpEvent([v]()
-	{
-		if (auto* w = sampleEditor::getWindow(); w != nullptr)
-			w->pitchTool->update(v); });
+	g_engine->getChannelsApi().setPitch(channelId, v, t);
+	if (g_ui != nullptr)
+		g_ui->pumpEvent([v]()
+		{
+			if (auto* w = sampleEditor::getWindow(); w != nullptr)
+				w->pitchTool->update(v); });
 	notifyChannelForMidiIn(t, channelId);
 	return v;
 }
@@ -420,7 +429,7 @@ float setChannelPitch(ID channelId, float v, Thread t)
 
 float setChannelPan(ID channelId, float v)
 {
-	g_engine->getChannelsApi().setPan(channelId, v);
+	g_engine->getChannelsApi().setPan(channelId, v, Thread::MAIN);
 	notifyChannelForMidiIn(Thread::MAIN, channelId); // Currently triggered only by the main thread
 	return v;
 }
@@ -471,7 +480,9 @@ void sendMidiToChannel(ID channelId, const m::MidiEvent& e, Thread t)
 
 void notifyChannelForMidiIn(Thread t, ID channelId)
 {
-	if (t == Thread::MIDI)
+	/* g_ui is null in headless mode. */
+
+	if (t == Thread::MIDI && g_ui != nullptr)
 		g_ui->pumpEvent([channelId]()
 		{ g_ui->mainWindow->keyboard->notifyMidiIn(channelId); });
 }
@@ -27,6 +27,7 @@
 #ifndef G_GLUE_CHANNEL_H
 #define G_GLUE_CHANNEL_H
 
+#include "src/core/profiler.h"
 #include "src/core/types.h"
 #include "src/core/weakAtomic.h"
 #include "src/deps/geompp/src/line.hpp"
@@ -64,6 +65,7 @@ struct SampleData
 	Frame getTracker() const;
 
 	ID               waveId;
+	bool             isLoading;
 	SamplePlayerMode mode;
 	bool             isLoop;
 	float            pitch;
@@ -156,6 +158,12 @@ Returns a single viewModel object for the 'Routing' window. */
 
 RoutingData getRoutingData(ID channelId);
 
+/* getCpuStats
+Returns how much time the audio thread spends rendering a channel, plug-ins
+included. */
+
+m::Profiler::Stats getCpuStats(ID channelId);
+
 /* addChannel
 Adds an empty new channel to the stack. */
 
@@ -98,6 +98,25 @@ void openBrowserForSampleSave(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
+void openBrowserForCpuProfileSave()
+{
+	v::gdWindow* w = new v::gdBrowserSave(g_ui->getI18Text(v::LangMap::BROWSER_SAVECPUPROFILE),
+	    g_ui->model.patchPath, "cpu-profile", c::storage::saveCpuProfile, {}, g_ui->model);
+	g_ui->openSubWindow(w);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void openBrowserForBounce(bool stems)
+{
+	const char*  title    = g_ui->getI18Text(stems ? v::LangMap::BROWSER_BOUNCESTEMS : v::LangMap::BROWSER_BOUNCE);
+	const auto   callback = stems ? c::storage::bounceStems : c::storage::bounce;
+	v::gdWindow* w        = new v::gdBrowserSave(title, g_ui->model.patchPath, "bounce", callback, {}, g_ui->model);
+	g_ui->openSubWindow(w);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void openAboutWindow()
 {
 	g_ui->openSubWindow(new v::gdAbout());
@@ -193,6 +212,10 @@ void openSampleEditor(ID channelId)
 	resulting in a broken Editor (gdSampleEditor's destructor frees the loaded
 	sample). */
 	g_ui->closeSubWindow(WID_SAMPLE_EDITOR);
+
+	/* The Sample Editor works on the whole audio data: bring it in memory if the
+	sample is being streamed from disk or still loading. */
+	g_engine->getSampleEditorApi().loadInMemory(channelId);
 	g_ui->openSubWindow(new v::gdSampleEditor(channelId, g_ui->model));
 }
 
@@ -52,6 +52,8 @@ void openBrowserForProjectLoad();
 void openBrowserForProjectSave();
 void openBrowserForSampleLoad(ID channelId);
 void openBrowserForSampleSave(ID channelId);
+void openBrowserForCpuProfileSave();
+void openBrowserForBounce(bool stems);
 void openAboutWindow();
 void openKeyGrabberWindow(int key, std::function<bool(int)>);
 void openBpmWindow(float bpm);
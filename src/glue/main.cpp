@@ -172,6 +172,18 @@ Scenes getScenes()
 
 /* -------------------------------------------------------------------------- */
 
+DspLoad getDspLoad()
+{
+	const m::CallbackMonitor::Stats stats = g_engine->getMainApi().getCallbackStats();
+	return {
+	    stats.load,
+	    stats.peakLoad,
+	    stats.jitter,
+	    stats.getXruns()};
+}
+
+/* -------------------------------------------------------------------------- */
+
 void setBeats(int beats, int bars)
 {
 	g_engine->getMainApi().setBeats(beats, bars);
@@ -240,18 +252,18 @@ void toggleMetronome()
 
 void setMasterInVolume(float v, Thread t)
 {
-	g_engine->getMainApi().setMasterInVolume(v);
+	g_engine->getMainApi().setMasterInVolume(v, t);
 
-	if (t != Thread::MAIN)
+	if (t != Thread::MAIN && g_ui != nullptr)
 		g_ui->pumpEvent([v]()
 		{ g_ui->mainWindow->mainInput->setInVol(v); });
 }
 
 void setMasterOutVolume(float v, Thread t)
 {
-	g_engine->getMainApi().setMasterOutVolume(v);
+	g_engine->getMainApi().setMasterOutVolume(v, t);
 
-	if (t != Thread::MAIN)
+	if (t != Thread::MAIN && g_ui != nullptr)
 		g_ui->pumpEvent([v]()
 		{ g_ui->mainWindow->mainOutput->setOutVol(v); });
 }
@@ -30,6 +30,7 @@
 #include "src/core/types.h"
 #include "src/scene.h"
 #include "src/types.h"
+#include <cstdint>
 
 /* giada::c::main
 Functions to interact with the tools in the main window. */
@@ -107,6 +108,14 @@ struct Scenes
 	SceneStatus status;
 };
 
+struct DspLoad
+{
+	float    load;     // Average, 1.0 = the whole buffer period
+	float    peakLoad; // Ditto
+	float    jitter;   // In microseconds
+	uint64_t xruns;
+};
+
 /* get*
 Returns viewModel objects filled with data. */
 
@@ -115,6 +124,7 @@ IO        getIO();
 Sequencer getSequencer();
 Transport getTransport();
 Scenes    getScenes();
+DspLoad   getDspLoad();
 
 void setBeats(int beats, int bars);
 void quantize(int val);
@@ -48,6 +48,20 @@ extern giada::m::Engine* g_engine;
 
 namespace giada::c::plugin
 {
+namespace
+{
+float getSleepRatio_(const m::Plugin& p)
+{
+	const m::Plugin::SleepStats stats = p.getSleepStats();
+	const uint64_t              total = stats.processed + stats.skipped;
+	return total == 0 ? 0.0f : static_cast<float>(stats.skipped) / total;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Param::Param(const m::Plugin& p, int index, ID channelId)
 : index(index)
 , pluginId(p.id)
@@ -73,6 +87,8 @@ Plugin::Plugin(m::Plugin& p, ID channelId)
 , juceId(p.getJuceId())
 , currentProgram(p.getCurrentProgram())
 , uiScaling(g_ui->getScaling())
+, sleepRatio(getSleepRatio_(p))
+, cpuStats(g_engine->getMainApi().getCpuStats(m::Profiler::Section::PLUGIN, p.id))
 , m_plugin(p)
 {
 	for (int i = 0; i < p.getNumPrograms(); i++)
@@ -194,8 +210,9 @@ void setParameter(ID channelId, ID pluginId, int paramIndex, float value, Thread
 	g_engine->getPluginsApi().setParameter(pluginId, paramIndex, value);
 	channel::notifyChannelForMidiIn(t, channelId);
 
-	g_ui->pumpEvent([pluginId, t]()
-	{ c::plugin::updateWindow(pluginId, t); });
+	if (g_ui != nullptr)
+		g_ui->pumpEvent([pluginId, t]()
+		{ c::plugin::updateWindow(pluginId, t); });
 }
 
 /* -------------------------------------------------------------------------- */
@@ -27,6 +27,7 @@
 #ifndef G_GLUE_PLUGIN_H
 #define G_GLUE_PLUGIN_H
 
+#include "src/core/profiler.h"
 #include "src/core/types.h"
 #include "src/types.h"
 #include <functional>
@@ -84,6 +85,9 @@ struct Plugin
 	std::string juceId;
 	int         currentProgram;
 	float       uiScaling;
+	float       sleepRatio; // Fraction of blocks skipped while asleep, [0, 1]
+
+	m::Profiler::Stats cpuStats;
 
 	std::vector<Program> programs;
 	std::vector<int>     paramIndexes;
@@ -90,6 +90,48 @@ bool validateFileName_(const std::string& name)
 	}
 	return true;
 }
+
+/* -------------------------------------------------------------------------- */
+
+void bounce_(v::gdBrowserSave& browser, bool stems)
+{
+	const std::string name       = browser.getName();
+	const std::string folderPath = browser.getCurrentPath();
+
+	if (!validateFileName_(name))
+		return;
+
+	const bool        isFlac   = utils::fs::getExt(name) == ".flac";
+	const std::string filePath = utils::fs::join(folderPath, utils::fs::stripExt(name) + (isFlac ? ".flac" : ".wav"));
+
+	if (utils::fs::fileExists(filePath) &&
+	    !v::gdConfirmWin(g_ui->getI18Text(v::LangMap::COMMON_WARNING),
+	        g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_FILEEXISTS)))
+		return;
+
+	m::Bouncer::Params params;
+	params.path   = filePath;
+	params.format = isFlac ? m::Bouncer::Format::FLAC : m::Bouncer::Format::WAV;
+	params.stems  = stems;
+
+	g_ui->stopUpdater();
+
+	bool res = false;
+	{
+		auto uiProgress     = g_ui->mainWindow->getScopedProgress(g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_BOUNCING));
+		auto engineProgress = [&uiProgress](float v)
+		{ uiProgress.setProgress(v); };
+
+		res = g_engine->getStorageApi().bounce(params, engineProgress);
+	}
+
+	g_ui->startUpdater();
+
+	if (!res)
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_BOUNCEERROR));
+
+	browser.do_callback();
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -213,4 +255,39 @@ void saveSample(void* data)
 
 	browser->do_callback();
 }
-} // namespace giada::c::storage
\ No newline at end of file
+
+/* -------------------------------------------------------------------------- */
+
+void saveCpuProfile(void* data)
+{
+	v::gdBrowserSave* browser    = static_cast<v::gdBrowserSave*>(data);
+	const std::string name       = browser->getName();
+	const std::string folderPath = browser->getCurrentPath();
+
+	if (!validateFileName_(name))
+		return;
+
+	const std::string filePath = utils::fs::join(folderPath, utils::fs::stripExt(name) + ".json");
+
+	if (utils::fs::fileExists(filePath) &&
+	    !v::gdConfirmWin(g_ui->getI18Text(v::LangMap::COMMON_WARNING),
+	        g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_FILEEXISTS)))
+		return;
+
+	if (!g_engine->getMainApi().saveCpuProfile(filePath))
+		v::gdAlert(g_ui->getI18Text(v::LangMap::MESSAGE_STORAGE_SAVINGFILEERROR));
+
+	browser->do_callback();
+}
+/* -------------------------------------------------------------------------- */
+
+void bounce(void* data)
+{
+	bounce_(*static_cast<v::gdBrowserSave*>(data), /*stems=*/false);
+}
+
+void bounceStems(void* data)
+{
+	bounce_(*static_cast<v::gdBrowserSave*>(data), /*stems=*/true);
+}
+} // namespace giada::c::storage
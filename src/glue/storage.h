@@ -35,6 +35,15 @@ namespace giada::c::storage
 void loadProject(void* data);
 void saveProject(void* data);
 void saveSample(void* data);
+void saveCpuProfile(void* data);
+
+/* bounce, bounceStems
+Render the current scene to an audio file, the latter with one extra file per
+track. */
+
+void bounce(void* data);
+void bounceStems(void* data);
+
 void loadSample(void* data);
 } // namespace giada::c::storage
 
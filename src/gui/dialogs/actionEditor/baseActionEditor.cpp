@@ -58,6 +58,7 @@ gdBaseActionEditor::gdBaseActionEditor(ID channelId, const Model& model)
 , m_zoomOutBtn(new geImageButton(graphics::minusOff, graphics::minusOn))
 , m_splitScroll(new geSplitScroll(0, 0, 0, 0))
 , m_legends(new geFlexResizable(Direction::VERTICAL, geResizerBar::Mode::RESIZE))
+, m_lane(new geChoice())
 , m_ratio(model.actionEditorZoom)
 {
 	m_zoomInBtn->onClick = [this]()
@@ -67,6 +68,15 @@ gdBaseActionEditor::gdBaseActionEditor(ID channelId, const Model& model)
 	m_zoomOutBtn->onClick = [this]()
 	{ zoomOut(); };
 	m_zoomOutBtn->copy_tooltip(g_ui->getI18Text(LangMap::COMMON_ZOOMOUT));
+
+	/* Lane item 0 is for note velocities, the others map to an automation
+	parameter, offset by one. */
+
+	m_lane->addItem(g_ui->getI18Text(LangMap::ACTIONEDITOR_VELOCITY), 0);
+	m_lane->addItem(g_ui->getI18Text(LangMap::ACTIONEDITOR_VOLUME), static_cast<int>(AutomationParam::VOLUME) + 1);
+	m_lane->addItem(g_ui->getI18Text(LangMap::ACTIONEDITOR_PAN), static_cast<int>(AutomationParam::PAN) + 1);
+	m_lane->showItem(0);
+	m_lane->copy_tooltip(g_ui->getI18Text(LangMap::ACTIONEDITOR_LABEL_LANE));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -87,6 +97,21 @@ int gdBaseActionEditor::getMouseOverContent() const
 
 /* -------------------------------------------------------------------------- */
 
+std::optional<AutomationParam> gdBaseActionEditor::getLane() const
+{
+	const int id = m_lane->getSelectedId();
+	if (id <= 0)
+		return {};
+	return static_cast<AutomationParam>(id - 1);
+}
+
+std::string gdBaseActionEditor::getLaneLabel() const
+{
+	return m_lane->getSelectedLabel();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void gdBaseActionEditor::computeWidth(Frame framesInSeq, Frame framesInLoop)
 {
 	fullWidth = frameToPixel(framesInSeq);
@@ -32,6 +32,8 @@
 #include "src/gui/model.h"
 #include "src/gui/types.h"
 #include <functional>
+#include <optional>
+#include <string>
 
 namespace giada::m
 {
@@ -42,6 +44,7 @@ struct Action;
 namespace giada::v
 {
 class geGridTool;
+class geChoice;
 class geImageButton;
 class geSplitScroll;
 class geFlexResizable;
@@ -94,10 +97,22 @@ protected:
 
 	void updateTitleWithScene(Scene);
 
+	/* getLane
+	Returns the parameter edited in the bottom lane, or std::nullopt if the
+	lane shows note velocities. */
+
+	std::optional<AutomationParam> getLane() const;
+
+	/* getLaneLabel
+	Returns the label for the bottom lane legend. */
+
+	std::string getLaneLabel() const;
+
 	geImageButton*   m_zoomInBtn;
 	geImageButton*   m_zoomOutBtn;
 	geSplitScroll*   m_splitScroll;
 	geFlexResizable* m_legends;
+	geChoice*        m_lane;
 
 	c::actionEditor::Data m_data;
 
@@ -34,6 +34,7 @@
 #include "src/gui/elems/actionEditor/splitScroll.h"
 #include "src/gui/elems/actionEditor/velocityEditor.h"
 #include "src/gui/elems/basics/box.h"
+#include "src/gui/elems/basics/choice.h"
 #include "src/gui/elems/basics/flex.h"
 #include "src/gui/elems/basics/flexResizable.h"
 #include "src/gui/elems/basics/imageButton.h"
@@ -52,6 +53,7 @@ gdMidiActionEditor::gdMidiActionEditor(ID channelId, const Model& model)
 		geFlex* header = new geFlex(Direction::HORIZONTAL, G_GUI_INNER_MARGIN);
 		{
 			header->addWidget(gridTool, 80);
+			header->addWidget(m_lane, 80);
 			header->addWidget(new geBox());
 			header->addWidget(m_zoomInBtn, G_GUI_UNIT);
 			header->addWidget(m_zoomOutBtn, G_GUI_UNIT);
@@ -104,6 +106,13 @@ gdMidiActionEditor::gdMidiActionEditor(ID channelId, const Model& model)
 		m_splitScroll->resizeWidget(0, widget.h());
 	};
 
+	m_lane->onChange = [this](int)
+	{
+		m_velocityEditor->setAutomation(getLane());
+		m_legends->getWidget(1).copy_label(getLaneLabel().c_str());
+		rebuild();
+	};
+
 	if (model.actionEditorPianoRollY != -1)
 	{
 		m_splitScroll->setScrollY(model.actionEditorPianoRollY);
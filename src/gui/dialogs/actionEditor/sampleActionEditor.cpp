@@ -55,6 +55,7 @@ gdSampleActionEditor::gdSampleActionEditor(ID channelId, const Model& model)
 			m_actionType = new geChoice();
 			header->addWidget(m_actionType, 120);
 			header->addWidget(gridTool, 80);
+			header->addWidget(m_lane, 80);
 			header->addWidget(new geBox());
 			header->addWidget(m_zoomInBtn, G_GUI_UNIT);
 			header->addWidget(m_zoomOutBtn, G_GUI_UNIT);
@@ -92,6 +93,8 @@ gdSampleActionEditor::gdSampleActionEditor(ID channelId, const Model& model)
 	m_actionType->showItem(0);
 	m_actionType->copy_tooltip(g_ui->getI18Text(LangMap::ACTIONEDITOR_LABEL_ACTIONTYPE));
 
+	m_lane->addItem(g_ui->getI18Text(LangMap::ACTIONEDITOR_PITCH), static_cast<int>(AutomationParam::PITCH) + 1);
+
 	m_sampleActionEditor = new geSampleActionEditor(0, 0, this);
 	m_velocityEditor     = new geVelocityEditor(0, 0, this);
 	m_splitScroll->addWidgets(*m_sampleActionEditor, *m_velocityEditor, model.actionEditorSplitH);
@@ -108,6 +111,13 @@ gdSampleActionEditor::gdSampleActionEditor(ID channelId, const Model& model)
 		m_splitScroll->resizeWidget(0, widget.h());
 	};
 
+	m_lane->onChange = [this](int)
+	{
+		m_velocityEditor->setAutomation(getLane());
+		m_legends->getWidget(1).copy_label(getLaneLabel().c_str());
+		rebuild();
+	};
+
 	prepareWindow();
 	rebuild();
 }
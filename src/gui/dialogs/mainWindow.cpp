@@ -29,6 +29,7 @@
 #include "src/gui/dialogs/warnings.h"
 #include "src/gui/elems/basics/boxtypes.h"
 #include "src/gui/elems/basics/flex.h"
+#include "src/gui/elems/mainWindow/dspMeter.h"
 #include "src/gui/elems/mainWindow/keyboard/keyboard.h"
 #include "src/gui/elems/mainWindow/mainInput.h"
 #include "src/gui/elems/mainWindow/mainMenu.h"
@@ -112,8 +113,16 @@ gdMainWindow::gdMainWindow(geompp::Rect<int> r, const char* title)
 					zoneTimer->end();
 				}
 
+				geFlex* zoneDsp = new geFlex(Direction::VERTICAL, G_GUI_INNER_MARGIN, {2, 0, 3, 0});
+				{
+					dspMeter = new v::geDspMeter();
+					zoneDsp->addWidget(dspMeter);
+					zoneDsp->end();
+				}
+
 				zone2->addWidget(mainTransport, 400);
 				zone2->addWidget(new geBox());
+				zone2->addWidget(zoneDsp, 80);
 				zone2->addWidget(zoneTimer, 237);
 				zone2->end();
 			}
@@ -183,6 +192,7 @@ void gdMainWindow::refresh()
 	mainInput->refresh();
 	mainOutput->refresh();
 	scenes->refresh();
+	dspMeter->refresh();
 }
 
 /* -------------------------------------------------------------------------- */
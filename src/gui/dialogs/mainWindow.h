@@ -33,6 +33,7 @@
 
 namespace giada::v
 {
+class geDspMeter;
 class geKeyboard;
 class geMainInput;
 class geMainOutput;
@@ -71,6 +72,7 @@ public:
 	geMainInput*     mainInput;
 	geMainOutput*    mainOutput;
 	geScenes*        scenes;
+	geDspMeter*      dspMeter;
 
 private:
 	class ScopedProgress
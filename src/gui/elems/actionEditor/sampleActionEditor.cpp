@@ -59,7 +59,7 @@ void geSampleActionEditor::rebuild(c::actionEditor::Data& d)
 
 	for (const m::Action& a1 : m_data->actions)
 	{
-		if (a1.event.getStatus() == m::MidiEvent::CHANNEL_CC || isNoteOffSinglePress(a1))
+		if (a1.event.getStatus() == m::MidiEvent::CHANNEL_CC || a1.isAutomation() || isNoteOffSinglePress(a1))
 			continue;
 
 		const m::Action& a2 = a1.nextId.isValid() ? *c::actionEditor::findAction(a1.nextId) : m::Action{};
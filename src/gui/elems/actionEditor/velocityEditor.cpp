@@ -33,6 +33,7 @@
 #include "src/gui/elems/actionEditor/envelopePoint.h"
 #include <FL/Fl.H>
 #include <FL/fl_draw.H>
+#include <algorithm>
 
 namespace math = mcl::utils::math;
 
@@ -60,11 +61,35 @@ void geVelocityEditor::draw()
 		geEnvelopePoint* p = static_cast<geEnvelopePoint*>(child(i));
 		if (m_action == nullptr)
 			p->position(p->x(), valueToY(p->a1.event.getVelocityFloat()));
-		const Pixel x1 = p->x() + (geEnvelopePoint::SIDE / 2);
-		const Pixel y1 = p->y();
-		const Pixel y2 = y() + h();
-		fl_color(p->hovered ? G_COLOR_LIGHT_2 : G_COLOR_LIGHT_1);
-		fl_line(x1, y1, x1, y2);
+	}
+
+	if (m_automation)
+	{
+		/* Automation curve: a polyline joining the breakpoints, holding the
+		first value before the first point and the last one up to the end of
+		the loop - the same way the engine evaluates it. */
+
+		const Pixel half = geEnvelopePoint::SIDE / 2;
+
+		fl_color(G_COLOR_LIGHT_1);
+		fl_begin_line();
+		fl_vertex(x(), child(0)->y() + half);
+		for (int i = 0; i < children(); i++)
+			fl_vertex(child(i)->x() + half, child(i)->y() + half);
+		fl_vertex(x() + m_base->loopWidth, child(children() - 1)->y() + half);
+		fl_end_line();
+	}
+	else
+	{
+		for (int i = 0; i < children(); i++)
+		{
+			geEnvelopePoint* p  = static_cast<geEnvelopePoint*>(child(i));
+			const Pixel      x1 = p->x() + (geEnvelopePoint::SIDE / 2);
+			const Pixel      y1 = p->y();
+			const Pixel      y2 = y() + h();
+			fl_color(p->hovered ? G_COLOR_LIGHT_2 : G_COLOR_LIGHT_1);
+			fl_line(x1, y1, x1, y2);
+		}
 	}
 
 	draw_children();
@@ -84,6 +109,22 @@ float geVelocityEditor::yToValue(Pixel px) const
 
 /* -------------------------------------------------------------------------- */
 
+bool geVelocityEditor::isVisible(const m::Action& a) const
+{
+	if (m_automation)
+		return a.isAutomation() && a.getAutomationParam() == *m_automation;
+	return a.event.getStatus() == m::MidiEvent::CHANNEL_NOTE_ON;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void geVelocityEditor::setAutomation(std::optional<AutomationParam> param)
+{
+	m_automation = param;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void geVelocityEditor::rebuild(c::actionEditor::Data& d)
 {
 	m_data = &d;
@@ -96,7 +137,7 @@ void geVelocityEditor::rebuild(c::actionEditor::Data& d)
 
 	for (const m::Action& action : m_data->actions)
 	{
-		if (action.event.getStatus() != m::MidiEvent::CHANNEL_NOTE_ON)
+		if (!isVisible(action))
 			continue;
 
 		const Pixel px = x() + m_base->frameToPixel(action.frame) - (geEnvelopePoint::SIDE / 2);
@@ -111,6 +152,39 @@ void geVelocityEditor::rebuild(c::actionEditor::Data& d)
 
 /* -------------------------------------------------------------------------- */
 
+void geVelocityEditor::onAddAction()
+{
+	if (!m_automation)
+		return;
+
+	const Pixel ex = Fl::event_x() - x();
+	const Pixel ey = Fl::event_y() - y() - (geEnvelopePoint::SIDE / 2);
+
+	if (ex >= m_base->loopWidth)
+		return;
+
+	const Frame f = m_base->pixelToFrame(ex, m_data->framesInBeat);
+	const float v = std::clamp(yToValue(ey), 0.0f, G_MAX_VELOCITY_FLOAT);
+
+	c::actionEditor::recordAutomationAction(m_data->channelId, *m_automation, f, v);
+
+	m_base->rebuild();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void geVelocityEditor::onDeleteAction()
+{
+	if (!m_automation)
+		return;
+
+	c::actionEditor::deleteAutomationAction(m_action->a1);
+
+	m_base->rebuild();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void geVelocityEditor::onMoveAction()
 {
 	Pixel ey = Fl::event_y() - (geEnvelopePoint::SIDE / 2);
@@ -123,7 +197,18 @@ void geVelocityEditor::onMoveAction()
 	else if (ey > y2)
 		ey = y2;
 
-	m_action->position(m_action->x(), ey);
+	/* Automation points can be moved in time as well, within the loop. */
+
+	Pixel ex = m_action->x();
+	if (m_automation)
+	{
+		const Pixel x1 = x() - (geEnvelopePoint::SIDE / 2);
+		const Pixel x2 = x() + m_base->loopWidth - (geEnvelopePoint::SIDE / 2) - 1;
+
+		ex = std::clamp(Fl::event_x() - m_action->pick, x1, x2);
+	}
+
+	m_action->position(ex, ey);
 	redraw();
 }
 
@@ -131,7 +216,16 @@ void geVelocityEditor::onMoveAction()
 
 void geVelocityEditor::onRefreshAction()
 {
-	c::actionEditor::updateVelocity(m_action->a1, yToValue(m_action->y() - y()));
+	const float value = yToValue(m_action->y() - y());
+
+	if (m_automation)
+	{
+		const Pixel px = m_action->x() + (geEnvelopePoint::SIDE / 2) - x();
+		const Frame f  = m_base->pixelToFrame(px, m_data->framesInBeat);
+		c::actionEditor::updateAutomationAction(m_data->channelId, m_action->a1, f, value);
+	}
+	else
+		c::actionEditor::updateVelocity(m_action->a1, value);
 
 	m_base->rebuild(); // Rebuild pianoRoll as well
 }
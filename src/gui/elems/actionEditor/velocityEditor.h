@@ -27,7 +27,9 @@
 #ifndef GE_VELOCITY_EDITOR_H
 #define GE_VELOCITY_EDITOR_H
 
+#include "src/core/types.h"
 #include "src/gui/elems/actionEditor/baseActionEditor.h"
+#include <optional>
 
 namespace giada::v
 {
@@ -40,15 +42,28 @@ public:
 
 	void rebuild(c::actionEditor::Data& d) override;
 
+	/* setAutomation
+	Switches the editor between note velocities (std::nullopt) and the
+	automation curve of the given parameter. Call rebuild() afterwards. */
+
+	void setAutomation(std::optional<AutomationParam>);
+
 private:
 	void onMoveAction() override;
 	void onRefreshAction() override;
-	void onAddAction() override {};
-	void onDeleteAction() override {};
+	void onAddAction() override;
+	void onDeleteAction() override;
 	void onResizeAction() override {};
 
+	bool isVisible(const m::Action&) const;
+
 	Pixel valueToY(float v) const;
 	float yToValue(Pixel y) const;
+
+	/* m_automation
+	Parameter currently displayed, or std::nullopt for note velocities. */
+
+	std::optional<AutomationParam> m_automation;
 };
 } // namespace giada::v
 
@@ -0,0 +1,76 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "src/gui/elems/mainWindow/dspMeter.h"
+#include "src/gui/const.h"
+#include "src/gui/drawing.h"
+#include "src/gui/ui.h"
+#include <algorithm>
+#include <fmt/core.h>
+#include <string>
+
+extern giada::v::Ui* g_ui;
+
+namespace giada::v
+{
+geDspMeter::geDspMeter()
+: Fl_Box(0, 0, 0, 0)
+, m_dspLoad{}
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void geDspMeter::draw()
+{
+	const geompp::Rect outline(x(), y(), w(), h());
+	const geompp::Rect body(outline.reduced(1));
+
+	const int loadPx = std::clamp(m_dspLoad.load, 0.0f, 1.0f) * body.w;
+	const int color  = m_dspLoad.peakLoad > 1.0f ? G_COLOR_BLUE : G_COLOR_GREY_4;
+
+	drawRectf(body, G_COLOR_GREY_2); // Cleanup
+	drawRectf(body.withW(loadPx), color);
+	drawRect(outline, G_COLOR_GREY_4);
+	drawText(fmt::format(fmt::runtime(g_ui->getI18Text(LangMap::MAIN_DSPMETER_LABEL)), m_dspLoad.load * 100.0f),
+	    body, FL_HELVETICA, G_GUI_FONT_SIZE_BASE, G_COLOR_LIGHT_2);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void geDspMeter::refresh()
+{
+	m_dspLoad = c::main::getDspLoad();
+
+	const std::string tooltip = fmt::format(fmt::runtime(g_ui->getI18Text(LangMap::MAIN_DSPMETER_STATS)),
+	    m_dspLoad.load * 100.0f, m_dspLoad.peakLoad * 100.0f, m_dspLoad.jitter, m_dspLoad.xruns);
+
+	copy_tooltip(tooltip.c_str());
+	redraw();
+}
+} // namespace giada::v
@@ -0,0 +1,53 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2025 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GE_DSP_METER_H
+#define GE_DSP_METER_H
+
+#include "src/glue/main.h"
+#include <FL/Fl_Box.H>
+
+namespace giada::v
+{
+/* geDspMeter
+Shows how much of the buffer period the audio processing takes. Turns red when
+the processing can't keep up with the audio device. */
+
+class geDspMeter : public Fl_Box
+{
+public:
+	geDspMeter();
+
+	void draw() override;
+
+	void refresh();
+
+private:
+	c::main::DspLoad m_dspLoad;
+};
+} // namespace giada::v
+
+#endif
@@ -34,6 +34,7 @@
 #include "src/gui/elems/midiActivity.h"
 #include "src/gui/ui.h"
 #include <FL/fl_draw.H>
+#include <fmt/core.h>
 
 extern giada::v::Ui* g_ui;
 
@@ -133,4 +134,15 @@ const c::channel::Data& geChannel::getData() const
 {
 	return m_channel;
 }
+
+/* -------------------------------------------------------------------------- */
+
+std::string geChannel::getCpuStatsText() const
+{
+	const m::Profiler::Stats stats = c::channel::getCpuStats(m_channel.id);
+
+	if (stats.count == 0)
+		return g_ui->getI18Text(LangMap::COMMON_NOCPUSTATS);
+	return fmt::format(fmt::runtime(g_ui->getI18Text(LangMap::COMMON_CPUSTATS)), stats.avg, stats.p99, stats.max);
+}
 } // namespace giada::v
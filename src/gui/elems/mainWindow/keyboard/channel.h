@@ -92,6 +92,12 @@ protected:
 	static void cb_changeVol(Fl_Widget* /*w*/, void* p);
 	void        cb_changeVol();
 
+	/* getCpuStatsText
+	Returns a readable summary of the time spent by the audio thread on this
+	channel, for the context menu. */
+
+	std::string getCpuStatsText() const;
+
 	/* m_channel
 	Channel's data. */
 
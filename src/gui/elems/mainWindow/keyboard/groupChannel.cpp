@@ -54,7 +54,8 @@ enum class Menu
 	COPY_CHANNEL_TO_SCENE_4,
 	COPY_CHANNEL_TO_SCENE_5,
 	COPY_CHANNEL_TO_SCENE_6,
-	COPY_CHANNEL_TO_SCENE_7
+	COPY_CHANNEL_TO_SCENE_7,
+	CPU_STATS
 };
 } // namespace
 
@@ -128,6 +129,8 @@ geGroupChannel::geGroupChannel(c::channel::Data d)
 void geGroupChannel::openMenu()
 {
 	geMenu menu;
+
+	menu.addItem(ID{Menu::CPU_STATS}, getCpuStatsText(), FL_MENU_INACTIVE | FL_MENU_DIVIDER);
 	menu.addItem(ID{Menu::SETUP_MIDI_INPUT}, g_ui->getI18Text(LangMap::MAIN_CHANNEL_MENU_MIDIINPUT));
 	menu.addItem(ID{Menu::EDIT_ROUTING}, g_ui->getI18Text(LangMap::MAIN_CHANNEL_MENU_EDITROUTING));
 	menu.addItem(ID{Menu::RENAME_CHANNEL}, g_ui->getI18Text(LangMap::MAIN_CHANNEL_MENU_RENAME));
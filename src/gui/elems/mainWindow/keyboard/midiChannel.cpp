@@ -62,7 +62,8 @@ enum class Menu
 	COPY_CHANNEL_TO_SCENE_5,
 	COPY_CHANNEL_TO_SCENE_6,
 	COPY_CHANNEL_TO_SCENE_7,
-	DELETE_CHANNEL
+	DELETE_CHANNEL,
+	CPU_STATS
 };
 } // namespace
 
@@ -143,6 +144,8 @@ void geMidiChannel::openMenu()
 {
 	geMenu menu;
 
+	menu.addItem(ID{Menu::CPU_STATS}, getCpuStatsText(), FL_MENU_INACTIVE | FL_MENU_DIVIDER);
+
 	menu.addItem(ID{Menu::EDIT_ACTIONS}, g_ui->getI18Text(LangMap::MAIN_CHANNEL_MENU_EDITACTIONS));
 
 	geMenu clearActionsSubMenu;
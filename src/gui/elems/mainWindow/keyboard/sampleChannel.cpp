@@ -71,7 +71,8 @@ enum class Menu
 	COPY_CHANNEL_TO_SCENE_7,
 	FREE_CHANNEL_THIS_SCENE,
 	FREE_CHANNEL_ALL_SCENES,
-	DELETE_CHANNEL
+	DELETE_CHANNEL,
+	CPU_STATS
 };
 } // namespace
 
@@ -173,6 +174,8 @@ void geSampleChannel::openMenu()
 
 	geMenu menu;
 
+	menu.addItem(ID{Menu::CPU_STATS}, getCpuStatsText(), FL_MENU_INACTIVE | FL_MENU_DIVIDER);
+
 	menu.addItem(ID{Menu::INPUT_MONITOR}, g_ui->getI18Text(LangMap::MAIN_CHANNEL_MENU_INPUTMONITOR),
 	    FL_MENU_TOGGLE | (m_channel.sample->inputMonitor ? FL_MENU_VALUE : 0));
 	menu.addItem(ID{Menu::OVERDUB_PROTECTION}, g_ui->getI18Text(LangMap::MAIN_CHANNEL_MENU_OVERDUBPROTECTION),
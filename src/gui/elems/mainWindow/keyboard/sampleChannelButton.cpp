@@ -50,7 +50,12 @@ geSampleChannelButton::geSampleChannelButton(const c::channel::Data& d)
 		label(g_ui->getI18Text(LangMap::MAIN_CHANNEL_SAMPLENOTFOUND));
 		break;
 	default:
-		label(!m_channel.sample->waveId.isValid() ? g_ui->getI18Text(LangMap::MAIN_CHANNEL_NOSAMPLE) : m_channel.name.c_str());
+		if (!m_channel.sample->waveId.isValid())
+			label(g_ui->getI18Text(LangMap::MAIN_CHANNEL_NOSAMPLE));
+		else if (m_channel.sample->isLoading)
+			label(g_ui->getI18Text(LangMap::MAIN_CHANNEL_LOADING));
+		else
+			label(m_channel.name.c_str());
 		break;
 	}
 }
@@ -84,6 +84,12 @@ geMainMenu::geMainMenu()
 	{ c::layout::openBrowserForProjectSave(); }),
 	    makeMenuItem_(LangMap::MAIN_MENU_FILE_CLOSEPROJECT, [](Fl_Widget*, void*)
 	{ c::main::closeProject(); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_BOUNCE, [](Fl_Widget*, void*)
+	{ c::layout::openBrowserForBounce(/*stems=*/false); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_BOUNCESTEMS, [](Fl_Widget*, void*)
+	{ c::layout::openBrowserForBounce(/*stems=*/true); }),
+	    makeMenuItem_(LangMap::MAIN_MENU_FILE_EXPORTCPUSTATS, [](Fl_Widget*, void*)
+	{ c::layout::openBrowserForCpuProfileSave(); }),
 #if G_DEBUG_MODE
 	    makeMenuItem_(LangMap::MAIN_MENU_FILE_DEBUGSTATS, [](Fl_Widget*, void*)
 	{ c::main::printDebugInfo(); }),
@@ -38,6 +38,7 @@
 #include "src/utils/gui.h"
 #include "src/utils/log.h"
 #include <cassert>
+#include <fmt/core.h>
 #include <string>
 
 extern giada::v::Ui* g_ui;
@@ -76,6 +77,11 @@ gePluginElement::gePluginElement(int x, int y, int w, int h, c::plugin::Plugin d
 	}
 
 	button->copy_label(m_plugin.name.c_str());
+
+	const std::string sleepRatio = fmt::format(fmt::runtime(g_ui->getI18Text(LangMap::PLUGINLIST_SLEEPRATIO)),
+	    static_cast<int>(m_plugin.sleepRatio * 100));
+	button->copy_tooltip(fmt::format("{}\n{}", getCpuStatsText(), sleepRatio).c_str());
+
 	button->onClick = [this]()
 	{ openPluginWindow(); };
 
@@ -111,6 +117,17 @@ gePluginElement::gePluginElement(int x, int y, int w, int h, c::plugin::Plugin d
 
 /* -------------------------------------------------------------------------- */
 
+std::string gePluginElement::getCpuStatsText() const
+{
+	const m::Profiler::Stats& stats = m_plugin.cpuStats;
+
+	if (stats.count == 0)
+		return g_ui->getI18Text(LangMap::COMMON_NOCPUSTATS);
+	return fmt::format(fmt::runtime(g_ui->getI18Text(LangMap::COMMON_CPUSTATS)), stats.avg, stats.p99, stats.max);
+}
+
+/* -------------------------------------------------------------------------- */
+
 ID gePluginElement::getPluginId() const
 {
 	return m_plugin.id;
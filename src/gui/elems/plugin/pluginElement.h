@@ -52,6 +52,12 @@ public:
 	geImageButton* remove;
 
 private:
+	/* getCpuStatsText
+	Returns a readable summary of the time spent by the audio thread on this
+	plug-in. */
+
+	std::string getCpuStatsText() const;
+
 	void openPluginWindow();
 	void removePlugin();
 	void shiftUp();
@@ -61,6 +61,8 @@ LangMap::LangMap()
 	m_data[COMMON_NONE]       = "None";
 	m_data[COMMON_APPLY]      = "Apply";
 	m_data[COMMON_SCENE]      = "Scene";
+	m_data[COMMON_CPUSTATS]   = "CPU: avg {:.0f} µs, p99 {:.0f} µs, max {:.0f} µs";
+	m_data[COMMON_NOCPUSTATS] = "CPU: not measured yet";
 
 	m_data[MESSAGE_MAIN_FREEALLSAMPLES]           = "Free all Sample channels: are you sure?";
 	m_data[MESSAGE_MAIN_CLEARALLACTIONS]          = "Clear all actions: are you sure?";
@@ -92,12 +94,17 @@ LangMap::LangMap()
 	m_data[MESSAGE_STORAGE_FILEHASINVALIDCHARS] = "The file name contains invalid characters.";
 	m_data[MESSAGE_STORAGE_FILEEXISTS]          = "File exists: overwrite?";
 	m_data[MESSAGE_STORAGE_SAVINGFILEERROR]     = "Unable to save this sample!";
+	m_data[MESSAGE_STORAGE_BOUNCING]            = "Exporting audio...";
+	m_data[MESSAGE_STORAGE_BOUNCEERROR]         = "Unable to export audio!";
 
 	m_data[MAIN_MENU_FILE]                 = "File";
 	m_data[MAIN_MENU_FILE_OPENPROJECT]     = "Open project...";
 	m_data[MAIN_MENU_FILE_SAVEPROJECT]     = "Save project...";
 	m_data[MAIN_MENU_FILE_CLOSEPROJECT]    = "Close project";
 	m_data[MAIN_MENU_FILE_DEBUGSTATS]      = "Debug stats";
+	m_data[MAIN_MENU_FILE_EXPORTCPUSTATS]  = "Export CPU stats...";
+	m_data[MAIN_MENU_FILE_BOUNCE]          = "Export audio...";
+	m_data[MAIN_MENU_FILE_BOUNCESTEMS]     = "Export stems...";
 	m_data[MAIN_MENU_FILE_QUIT]            = "Quit Giada";
 	m_data[MAIN_MENU_EDIT]                 = "Edit";
 	m_data[MAIN_MENU_EDIT_FREEALLSAMPLES]  = "Free all Sample channels";
@@ -126,6 +133,9 @@ LangMap::LangMap()
 
 	m_data[MAIN_SEQUENCER_LABEL] = "Main sequencer";
 
+	m_data[MAIN_DSPMETER_LABEL] = "DSP {:.0f}%";
+	m_data[MAIN_DSPMETER_STATS] = "Audio processing load\n\nAverage {:.0f}%, peak {:.0f}%\nJitter {:.0f} µs\nXruns {}";
+
 	m_data[MAIN_TRANSPORT_LABEL_REWIND]         = "Rewind";
 	m_data[MAIN_TRANSPORT_LABEL_PLAY]           = "Play/Stop";
 	m_data[MAIN_TRANSPORT_LABEL_RECTRIGGERMODE] = "Record-on-signal mode\n\nAction and audio recording will start only when a signal (key press or audio) "
@@ -146,6 +156,7 @@ LangMap::LangMap()
 	m_data[MAIN_CHANNEL_NOSAMPLE]                  = "-- no sample --";
 	m_data[MAIN_CHANNEL_DEFAULTGROUPNAME]          = "-- group --";
 	m_data[MAIN_CHANNEL_SAMPLENOTFOUND]            = "* file not found! *";
+	m_data[MAIN_CHANNEL_LOADING]                   = "-- loading --";
 	m_data[MAIN_CHANNEL_LABEL_PLAY]                = "Play/stop";
 	m_data[MAIN_CHANNEL_LABEL_ARM]                 = "Arm for recording";
 	m_data[MAIN_CHANNEL_LABEL_STATUS]              = "Progress bar";
@@ -201,6 +212,7 @@ LangMap::LangMap()
 	m_data[PLUGINLIST_TITLE_CHANNEL]   = "Channel Plug-ins";
 	m_data[PLUGINLIST_ADDPLUGIN]       = "-- add new plugin --";
 	m_data[PLUGINLIST_NOPROGRAMS]      = "-- no programs --";
+	m_data[PLUGINLIST_SLEEPRATIO]      = "Asleep on silence: {}% of processing saved";
 
 	m_data[CHANNELNAME_TITLE] = "New channel name";
 
@@ -238,13 +250,19 @@ LangMap::LangMap()
 	m_data[ACTIONEDITOR_STOPSAMPLE]       = "Stop sample";
 	m_data[ACTIONEDITOR_STARTSTOP]        = "Start/stop";
 	m_data[ACTIONEDITOR_VELOCITY]         = "Velocity";
+	m_data[ACTIONEDITOR_PAN]              = "Pan";
+	m_data[ACTIONEDITOR_PITCH]            = "Pitch";
 	m_data[ACTIONEDITOR_LABEL_ACTIONTYPE] = "Action type to add";
+	m_data[ACTIONEDITOR_LABEL_LANE]       = "Parameter to edit in the bottom lane";
 
 	m_data[BROWSER_SHOWHIDDENFILES] = "Show hidden files";
 	m_data[BROWSER_OPENPROJECT]     = "Open project";
 	m_data[BROWSER_SAVEPROJECT]     = "Save project";
 	m_data[BROWSER_OPENSAMPLE]      = "Open sample";
 	m_data[BROWSER_SAVESAMPLE]      = "Save sample";
+	m_data[BROWSER_SAVECPUPROFILE]  = "Export CPU stats";
+	m_data[BROWSER_BOUNCE]          = "Export audio";
+	m_data[BROWSER_BOUNCESTEMS]     = "Export stems";
 	m_data[BROWSER_OPENPLUGINSDIR]  = "Open plug-ins directory";
 
 	m_data[MIDIINPUT_MASTER_TITLE]           = "MIDI Input Setup (global)";
@@ -66,6 +66,8 @@ public:
 	static constexpr auto COMMON_NONE       = "common_none";
 	static constexpr auto COMMON_APPLY      = "common_apply";
 	static constexpr auto COMMON_SCENE      = "common_scene";
+	static constexpr auto COMMON_CPUSTATS   = "common_cpuStats";
+	static constexpr auto COMMON_NOCPUSTATS = "common_noCpuStats";
 
 	static constexpr auto MESSAGE_MAIN_FREEALLSAMPLES           = "message_main_freeAllSamples";
 	static constexpr auto MESSAGE_MAIN_CLEARALLACTIONS          = "message_main_clearAllActions";
@@ -97,12 +99,17 @@ public:
 	static constexpr auto MESSAGE_STORAGE_FILEHASINVALIDCHARS = "message_storage_fileHasInvalidChars";
 	static constexpr auto MESSAGE_STORAGE_FILEEXISTS          = "message_storage_fileExists";
 	static constexpr auto MESSAGE_STORAGE_SAVINGFILEERROR     = "message_storage_savingFileError";
+	static constexpr auto MESSAGE_STORAGE_BOUNCING            = "message_storage_bouncing";
+	static constexpr auto MESSAGE_STORAGE_BOUNCEERROR         = "message_storage_bounceError";
 
 	static constexpr auto MAIN_MENU_FILE                 = "main_menu_file";
 	static constexpr auto MAIN_MENU_FILE_OPENPROJECT     = "main_menu_file_openProject";
 	static constexpr auto MAIN_MENU_FILE_SAVEPROJECT     = "main_menu_file_saveProject";
 	static constexpr auto MAIN_MENU_FILE_CLOSEPROJECT    = "main_menu_file_closeProject";
 	static constexpr auto MAIN_MENU_FILE_DEBUGSTATS      = "main_menu_file_debugStats";
+	static constexpr auto MAIN_MENU_FILE_EXPORTCPUSTATS  = "main_menu_file_exportCpuStats";
+	static constexpr auto MAIN_MENU_FILE_BOUNCE          = "main_menu_file_bounce";
+	static constexpr auto MAIN_MENU_FILE_BOUNCESTEMS     = "main_menu_file_bounceStems";
 	static constexpr auto MAIN_MENU_FILE_QUIT            = "main_menu_file_quit";
 	static constexpr auto MAIN_MENU_EDIT                 = "main_menu_edit";
 	static constexpr auto MAIN_MENU_EDIT_FREEALLSAMPLES  = "main_menu_edit_freeAllSamples";
@@ -130,6 +137,9 @@ public:
 
 	static constexpr auto MAIN_SEQUENCER_LABEL = "main_sequencer_label";
 
+	static constexpr auto MAIN_DSPMETER_LABEL = "main_dspMeter_label";
+	static constexpr auto MAIN_DSPMETER_STATS = "main_dspMeter_stats";
+
 	static constexpr auto MAIN_TRANSPORT_LABEL_REWIND         = "main_transport_label_rewind";
 	static constexpr auto MAIN_TRANSPORT_LABEL_PLAY           = "main_transport_label_play";
 	static constexpr auto MAIN_TRANSPORT_LABEL_RECTRIGGERMODE = "main_transport_label_recTriggerMode";
@@ -148,6 +158,7 @@ public:
 	static constexpr auto MAIN_CHANNEL_NOSAMPLE                  = "main_channel_noSample";
 	static constexpr auto MAIN_CHANNEL_DEFAULTGROUPNAME          = "main_channel_defaultGroupName";
 	static constexpr auto MAIN_CHANNEL_SAMPLENOTFOUND            = "main_channel_sampleNotFound";
+	static constexpr auto MAIN_CHANNEL_LOADING                   = "main_channel_loading";
 	static constexpr auto MAIN_CHANNEL_LABEL_PLAY                = "main_channel_label_play";
 	static constexpr auto MAIN_CHANNEL_LABEL_ARM                 = "main_channel_label_arm";
 	static constexpr auto MAIN_CHANNEL_LABEL_STATUS              = "main_channel_label_status";
@@ -201,6 +212,7 @@ public:
 	static constexpr auto PLUGINLIST_TITLE_CHANNEL   = "pluginList_title_channel";
 	static constexpr auto PLUGINLIST_ADDPLUGIN       = "pluginList_addPlugin";
 	static constexpr auto PLUGINLIST_NOPROGRAMS      = "pluginList_noPrograms";
+	static constexpr auto PLUGINLIST_SLEEPRATIO      = "pluginList_sleepRatio";
 
 	static constexpr auto CHANNELNAME_TITLE = "channelName_title";
 
@@ -238,13 +250,19 @@ public:
 	static constexpr auto ACTIONEDITOR_STOPSAMPLE       = "actionEditor_stopSample";
 	static constexpr auto ACTIONEDITOR_STARTSTOP        = "actionEditor_startStop";
 	static constexpr auto ACTIONEDITOR_VELOCITY         = "actionEditor_velocity";
+	static constexpr auto ACTIONEDITOR_PAN              = "actionEditor_pan";
+	static constexpr auto ACTIONEDITOR_PITCH            = "actionEditor_pitch";
 	static constexpr auto ACTIONEDITOR_LABEL_ACTIONTYPE = "actionEditor_label_actionType";
+	static constexpr auto ACTIONEDITOR_LABEL_LANE       = "actionEditor_label_lane";
 
 	static constexpr auto BROWSER_SHOWHIDDENFILES = "browser_showHiddenFiles";
 	static constexpr auto BROWSER_OPENPROJECT     = "browser_openProject";
 	static constexpr auto BROWSER_SAVEPROJECT     = "browser_saveProject";
 	static constexpr auto BROWSER_OPENSAMPLE      = "browser_openSample";
 	static constexpr auto BROWSER_SAVESAMPLE      = "browser_saveSample";
+	static constexpr auto BROWSER_SAVECPUPROFILE  = "browser_saveCpuProfile";
+	static constexpr auto BROWSER_BOUNCE          = "browser_bounce";
+	static constexpr auto BROWSER_BOUNCESTEMS     = "browser_bounceStems";
 	static constexpr auto BROWSER_OPENPLUGINSDIR  = "browser_openPluginsDir";
 
 	static constexpr auto MIDIINPUT_MASTER_TITLE           = "midiInput_master_title";
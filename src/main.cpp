@@ -34,14 +34,21 @@ int main(int argc, char** argv)
 {
 	using namespace giada;
 
+	if (int ret = m::init::sandbox(argc, argv); ret != -1)
+		return ret;
 	if (int ret = m::init::tests(argc, argv); ret != -1)
 		return ret;
 
 	auto enginePtr = std::make_unique<m::Engine>();
-	auto uiPtr     = std::make_unique<v::Ui>();
+	g_engine       = enginePtr.get();
+
+	/* No v::Ui in headless mode: g_ui stays null for the whole session. */
+
+	if (int ret = m::init::headless(argc, argv); ret != -1)
+		return ret;
 
-	g_engine = enginePtr.get();
-	g_ui     = uiPtr.get();
+	auto uiPtr = std::make_unique<v::Ui>();
+	g_ui       = uiPtr.get();
 
 	m::init::startup();
 	m::init::run();
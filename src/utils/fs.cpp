@@ -60,6 +60,11 @@ std::string getLangMapsPath()
 	return utils::fs::join(getConfigDirPath(), "langmaps");
 }
 
+std::string getWaveCachePath()
+{
+	return utils::fs::join(getConfigDirPath(), "cache");
+}
+
 /* -------------------------------------------------------------------------- */
 
 bool createConfigFolder()
@@ -0,0 +1,113 @@
+#include "../src/core/model/actions.h"
+#include "../src/core/actions/actionFactory.h"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("model::Actions")
+{
+	const ID        channelID1 = ID{1};
+	const ID        channelID2 = ID{2};
+	const MidiEvent noteOn     = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x00, 0x00, 0);
+	const MidiEvent noteOff    = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_OFF, 0x00, 0x00, 0);
+
+	model::Actions actions;
+
+	const Action a1 = actions.rec(channelID1, Scene{0}, 300, noteOn);
+	const Action a2 = actions.rec(channelID2, Scene{0}, 100, noteOn);
+	const Action a3 = actions.rec(channelID1, Scene{0}, 100, noteOff);
+
+	SECTION("Test timeline is sorted by frame and insertion order")
+	{
+		const std::vector<Action>& all = actions.getAll();
+
+		REQUIRE(all.size() == 3);
+		REQUIRE(all[0].id == a2.id);
+		REQUIRE(all[1].id == a3.id);
+		REQUIRE(all[2].id == a1.id);
+	}
+
+	SECTION("Test duplicates are skipped")
+	{
+		REQUIRE(!actions.rec(channelID1, Scene{0}, 300, noteOn).isValid());
+		REQUIRE(actions.getAll().size() == 3);
+	}
+
+	SECTION("Test batch recording")
+	{
+		const Action b1 = actionFactory::makeAction({}, channelID1, Scene{0}, 200, noteOn);
+		const Action b2 = actionFactory::makeAction({}, channelID2, Scene{0}, 100, noteOff);
+
+		std::vector<Action> batch = {
+		    b1,
+		    b2,
+		    actionFactory::makeAction({}, channelID1, Scene{0}, 300, noteOn), // Same event as a1
+		    actionFactory::makeAction({}, channelID1, Scene{0}, 200, noteOn), // Same event as b1
+		    b2,                                                               // Same ID as b2
+		};
+
+		actions.rec(batch, Scene{0});
+
+		const std::vector<Action>& all = actions.getAll();
+
+		REQUIRE(all.size() == 5);
+		REQUIRE(all[0].id == a2.id);
+		REQUIRE(all[1].id == a3.id);
+		REQUIRE(all[2].id == b2.id);
+		REQUIRE(all[3].id == b1.id);
+		REQUIRE(all[4].id == a1.id);
+		REQUIRE(actions.findAction(b1.id)->frame == 200);
+	}
+
+	SECTION("Test range queries")
+	{
+		REQUIRE(actions.getActionsOnFrame(100).size() == 2);
+		REQUIRE(actions.getActionsOnFrame(200).empty());
+		REQUIRE(actions.getActionsInRange(0, 300).size() == 2);
+		REQUIRE(actions.getActionsInRange(101, 301).size() == 1);
+		REQUIRE(actions.getActionsInRange(101, 301)[0].id == a1.id);
+	}
+
+	SECTION("Test lookup by ID and channel")
+	{
+		REQUIRE(actions.findAction(a3.id)->frame == 100);
+		REQUIRE(actions.findAction(ID{}) == nullptr);
+		REQUIRE(actions.getActionsOnChannel(channelID1, Scene{0}).size() == 2);
+		REQUIRE(actions.hasActions(channelID2, MidiEvent::CHANNEL_NOTE_ON) == true);
+		REQUIRE(actions.hasActions(channelID2, MidiEvent::CHANNEL_NOTE_OFF) == false);
+	}
+
+	SECTION("Test update key frames")
+	{
+		actions.updateKeyFrames([](Frame old)
+		{ return 1000 - old; });
+
+		REQUIRE(actions.getAll()[0].id == a1.id);
+		REQUIRE(actions.getActionsOnFrame(900).size() == 2);
+		REQUIRE(actions.findAction(a1.id)->frame == 700);
+	}
+
+	SECTION("Test delete")
+	{
+		actions.clearChannel(channelID1, Scene{0});
+
+		REQUIRE(actions.getAll().size() == 1);
+		REQUIRE(actions.findAction(a1.id) == nullptr);
+		REQUIRE(actions.findAction(a2.id) != nullptr);
+		REQUIRE(actions.hasActions(channelID1) == false);
+	}
+
+	SECTION("Test copies share the timeline until altered")
+	{
+		model::Actions copy = actions;
+
+		REQUIRE(&copy.getAll() == &actions.getAll());
+
+		copy.updateEvent(a1.id, noteOff);
+
+		REQUIRE(&copy.getAll() != &actions.getAll());
+		REQUIRE(copy.findAction(a1.id)->event.getStatus() == MidiEvent::CHANNEL_NOTE_OFF);
+		REQUIRE(actions.findAction(a1.id)->event.getStatus() == MidiEvent::CHANNEL_NOTE_ON);
+	}
+}
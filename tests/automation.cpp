@@ -0,0 +1,77 @@
+#include "../src/core/actions/automationCurve.h"
+#include "../src/core/model/actions.h"
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <span>
+#include <vector>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("AutomationCurve")
+{
+	const ID    channelID   = ID{1};
+	const Frame FRAMES_LOOP = 1000;
+	const auto  toVector    = [](const AutomationCurve::Segments& s)
+	{ return std::vector<AutomationCurve::Segment>(s.begin(), s.end()); };
+
+	model::Actions actions;
+
+	actions.rec(channelID, Scene{0}, 400, AutomationCurve::makeEvent(AutomationParam::VOLUME, 1.0f));
+	actions.rec(channelID, Scene{0}, 200, AutomationCurve::makeEvent(AutomationParam::VOLUME, 0.0f));
+	actions.rec(channelID, Scene{0}, 100, AutomationCurve::makeEvent(AutomationParam::PAN, 0.5f));
+	actions.rec(channelID, Scene{0}, 100, MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x00, 0x00, 0));
+
+	SECTION("Test curves are built from automation actions")
+	{
+		const std::span<const AutomationCurve> curves = actions.getCurvesOnChannel(channelID);
+
+		REQUIRE(curves.size() == 2);
+		REQUIRE(actions.getCurvesOnChannel(ID{2}).empty());
+	}
+
+	const AutomationCurve& volume = *std::find_if(actions.getCurvesOnChannel(channelID).begin(),
+	    actions.getCurvesOnChannel(channelID).end(), [](const AutomationCurve& c)
+	    { return c.param == AutomationParam::VOLUME; });
+
+	SECTION("Test interpolation and hold")
+	{
+		REQUIRE(volume.valueAt(0) == 0.0f);
+		REQUIRE(volume.valueAt(200) == 0.0f);
+		REQUIRE(volume.valueAt(300) == 0.5f);
+		REQUIRE(volume.valueAt(400) == 1.0f);
+		REQUIRE(volume.valueAt(900) == 1.0f);
+	}
+
+	SECTION("Test segments are split at breakpoints")
+	{
+		AutomationCurve::Segments segments;
+		volume.getSegments(150, 300, FRAMES_LOOP, segments);
+
+		const auto s = toVector(segments);
+
+		REQUIRE(s.size() == 3);
+		REQUIRE((s[0].a == 0 && s[0].b == 50 && s[0].from == 0.0f && s[0].to == 0.0f));
+		REQUIRE((s[1].a == 50 && s[1].b == 250 && s[1].from == 0.0f && s[1].to == 1.0f));
+		REQUIRE((s[2].a == 250 && s[2].b == 300 && s[2].from == 1.0f && s[2].to == 1.0f));
+	}
+
+	SECTION("Test segments wrap around the loop")
+	{
+		AutomationCurve::Segments segments;
+		volume.getSegments(900, 200, FRAMES_LOOP, segments);
+
+		const auto s = toVector(segments);
+
+		REQUIRE(s.size() == 2);
+		REQUIRE((s[0].a == 0 && s[0].b == 100 && s[0].to == 1.0f));
+		REQUIRE((s[1].a == 100 && s[1].b == 200 && s[1].from == 0.0f));
+	}
+
+	SECTION("Test pitch mapping")
+	{
+		REQUIRE(AutomationCurve::toParamValue(AutomationParam::PITCH, 0.0f) == G_MIN_PITCH);
+		REQUIRE(AutomationCurve::toParamValue(AutomationParam::PITCH, 1.0f) == G_MAX_PITCH);
+		REQUIRE(AutomationCurve::toParamValue(AutomationParam::VOLUME, 0.3f) == 0.3f);
+	}
+}
@@ -0,0 +1,97 @@
+#include "../src/core/callbackMonitor.h"
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace giada;
+using namespace giada::m;
+using namespace std::chrono_literals;
+
+TEST_CASE("callbackMonitor")
+{
+	static const int SAMPLE_RATE = 48000;
+	static const int BUFFER_SIZE = 480; // 10 ms
+
+	CallbackMonitor monitor;
+	monitor.reset(SAMPLE_RATE);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	SECTION("test load")
+	{
+		monitor.record(start, start + 2ms, BUFFER_SIZE, false, false);
+		monitor.record(start + 10ms, start + 16ms, BUFFER_SIZE, false, false);
+
+		const CallbackMonitor::Stats stats = monitor.getStats();
+
+		REQUIRE(stats.callbacks == 2);
+		REQUIRE(std::abs(stats.load - 0.4f) < 1e-3);
+		REQUIRE(std::abs(stats.peakLoad - 0.6f) < 1e-3);
+		REQUIRE(stats.getXruns() == 0);
+	}
+
+	SECTION("test jitter")
+	{
+		monitor.record(start, start + 1ms, BUFFER_SIZE, false, false);
+		monitor.record(start + 13ms, start + 14ms, BUFFER_SIZE, false, false);
+
+		REQUIRE(std::abs(monitor.getStats().jitter - 3000.0f) < 1e-1);
+	}
+
+	SECTION("test xruns")
+	{
+		monitor.notifyModelSwap();
+		monitor.record(start, start + 12ms, BUFFER_SIZE, false, false);
+		monitor.record(start + 12ms, start + 13ms, BUFFER_SIZE, true, true);
+
+		const CallbackMonitor::Stats stats = monitor.getStats();
+
+		REQUIRE(stats.overruns == 1);
+		REQUIRE(stats.inputOverflows == 1);
+		REQUIRE(stats.outputUnderflows == 1);
+		REQUIRE(stats.getXruns() == 3);
+		REQUIRE(monitor.getHistory()[1].modelSwaps == 1);
+	}
+
+	SECTION("test history")
+	{
+		for (int i = 0; i < G_CALLBACK_HISTORY_SIZE * 2; i++)
+			monitor.record(start + i * 10ms, start + i * 10ms + 1ms, BUFFER_SIZE, false, false);
+
+		const std::vector<CallbackMonitor::Callback> history = monitor.getHistory();
+
+		REQUIRE(history.size() == G_CALLBACK_HISTORY_SIZE);
+		REQUIRE(history.front().time == G_CALLBACK_HISTORY_SIZE * 10000);
+		REQUIRE(history.back().time == (G_CALLBACK_HISTORY_SIZE * 2 - 1) * 10000);
+	}
+
+	SECTION("test history while recording")
+	{
+		static const int CALLBACKS = G_CALLBACK_HISTORY_SIZE * 64;
+
+		/* Each record carries its index in both time and duration: a torn read
+		would mix up two of them. */
+
+		std::thread writer([&monitor, start]()
+		{
+			for (int i = 0; i < CALLBACKS; i++)
+				monitor.record(start + i * 1ms, start + i * 1ms + i * 1us, BUFFER_SIZE, false, false);
+		});
+
+		bool consistent = true;
+		while (monitor.getStats().callbacks < CALLBACKS)
+		{
+			int64_t prev = -1;
+			for (const CallbackMonitor::Callback& callback : monitor.getHistory())
+			{
+				consistent &= callback.time > prev && std::lround(callback.duration) == callback.time / 1000;
+				prev = callback.time;
+			}
+		}
+
+		writer.join();
+
+		REQUIRE(consistent);
+	}
+}
@@ -0,0 +1,100 @@
+#include "src/core/channels/channelManager.h"
+#include "src/core/channels/channelFactory.h"
+#include "src/core/kernelMidi.h"
+#include "src/core/midiMapper.h"
+#include "src/core/model/model.h"
+#include "src/core/types.h"
+#include <catch2/catch_test_macros.hpp>
+#include <utility>
+
+TEST_CASE("ChannelManager")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	const ID channelId = ID{1};
+
+	model::Model model;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+
+	channelFactory::Data channel = channelFactory::create(channelId, ChannelType::SAMPLE, 1024, Resampler::Quality::LINEAR, false);
+
+	model.get().tracks.add(0, false);
+	model.get().tracks.get(0).getChannels().add(std::move(channel.channel));
+	model.addChannelShared(std::move(channel.shared));
+	model.swap(model::SwapType::NONE);
+
+	KernelMidi             kernelMidi(model);
+	MidiMapper<KernelMidi> midiMapper(kernelMidi);
+	ChannelManager         channelManager(model, midiMapper, kernelMidi);
+
+	const Channel& ch = std::as_const(model.get().tracks).getChannel(channelId);
+
+	SECTION("Test continuous controls from the main thread")
+	{
+		channelManager.setVolume(channelId, 0.3f, Thread::MAIN);
+
+		const Channel& edited = std::as_const(model.get().tracks).getChannel(channelId);
+
+		REQUIRE(edited.volume == 0.3f);
+		REQUIRE(edited.shared->volume.get() == 0.3f);
+		REQUIRE(edited.shared->lanesEdited.load() == false);
+	}
+
+	SECTION("Test continuous controls from the MIDI thread")
+	{
+		channelManager.setVolume(channelId, 0.3f, Thread::MIDI);
+
+		REQUIRE(ch.volume == G_DEFAULT_VOL);
+		REQUIRE(ch.shared->volume.get() == 0.3f);
+		REQUIRE(ch.shared->lanesEdited.load() == true);
+
+		model.swap(model::SwapType::SOFT);
+
+		const Channel& synced = std::as_const(model.get().tracks).getChannel(channelId);
+
+		REQUIRE(synced.volume == 0.3f);
+		REQUIRE(synced.shared->volume.get() == 0.3f);
+		REQUIRE(synced.shared->lanesEdited.load() == false);
+	}
+
+	SECTION("Test MIDI thread control in the middle of a swap")
+	{
+		/* Same steps as Model::swap(), with a MIDI-thread control change between
+		the lanes being copied into the Document and the Document being copied
+		into the lanes. */
+
+		for (const Channel* c : std::as_const(model.get().tracks).getChannels())
+			if (c->shared->lanesEdited.load())
+				model.get().tracks.getChannel(c->id).syncFromLanes();
+
+		channelManager.setPan(channelId, 0.1f, Thread::MIDI);
+		channelManager.setVolume(channelId, 0.3f, Thread::MIDI);
+
+		for (const Channel* c : std::as_const(model.get().tracks).getChannels())
+			c->syncChangedLanes();
+
+		REQUIRE(ch.shared->volume.get() == 0.3f);
+		REQUIRE(ch.shared->pan.get() == 0.1f);
+
+		/* The next swap brings the change into the Document. */
+
+		model.swap(model::SwapType::SOFT);
+
+		const Channel& synced = std::as_const(model.get().tracks).getChannel(channelId);
+
+		REQUIRE(synced.volume == 0.3f);
+		REQUIRE(synced.pan.asFloat() == 0.1f);
+		REQUIRE(synced.shared->volume.get() == 0.3f);
+	}
+
+	SECTION("Test Document changes reach the lanes")
+	{
+		model.get().tracks.getChannel(channelId).volume = 0.7f;
+		model.swap(model::SwapType::SOFT);
+
+		REQUIRE(std::as_const(model.get().tracks).getChannel(channelId).shared->volume.get() == 0.7f);
+	}
+}
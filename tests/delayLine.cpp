@@ -0,0 +1,59 @@
+#include "../src/core/delayLine.h"
+#include "../src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("delayLine")
+{
+	static const int BUFFER_SIZE = 16;
+	static const int MAX_DELAY   = 64;
+
+	DelayLine        delayLine(MAX_DELAY);
+	mcl::AudioBuffer buffer(BUFFER_SIZE, 2);
+
+	buffer.clear();
+	buffer[0][0] = 1.0f;
+	buffer[0][1] = -1.0f;
+
+	SECTION("test zero delay")
+	{
+		delayLine.process(buffer);
+
+		REQUIRE(buffer[0][0] == 1.0f);
+		REQUIRE(buffer[0][1] == -1.0f);
+	}
+
+	SECTION("test delay within a block")
+	{
+		delayLine.setDelay(5);
+		delayLine.process(buffer);
+
+		REQUIRE(buffer[0][0] == 0.0f);
+		REQUIRE(buffer[5][0] == 1.0f);
+		REQUIRE(buffer[5][1] == -1.0f);
+	}
+
+	SECTION("test delay across blocks")
+	{
+		delayLine.setDelay(BUFFER_SIZE + 3);
+		delayLine.process(buffer);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(buffer[i][0] == 0.0f);
+
+		buffer.clear();
+		delayLine.process(buffer);
+
+		REQUIRE(buffer[3][0] == 1.0f);
+		REQUIRE(buffer[3][1] == -1.0f);
+	}
+
+	SECTION("test delay clamped to capacity")
+	{
+		delayLine.setDelay(MAX_DELAY * 2);
+
+		REQUIRE(delayLine.getDelay() == MAX_DELAY);
+	}
+}
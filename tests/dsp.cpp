@@ -0,0 +1,240 @@
+#include "../src/core/dsp.h"
+#include "../src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <string>
+#include <vector>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("dsp")
+{
+	/* Odd number of frames, so that both the vectorized and the scalar
+	leftover paths get exercised. */
+
+	static const int BUFFER_SIZE = 37;
+
+	mcl::AudioBuffer src(BUFFER_SIZE, 2);
+	mcl::AudioBuffer dest(BUFFER_SIZE, 2);
+
+	for (int i = 0; i < BUFFER_SIZE; i++)
+	{
+		src[i][0]  = (i % 2 == 0 ? 1.0f : -1.0f) * i * 0.01f;
+		src[i][1]  = (i % 2 == 0 ? -1.0f : 1.0f) * i * 0.02f;
+		dest[i][0] = 0.5f;
+		dest[i][1] = 0.5f;
+	}
+
+	SECTION("test sum with pan and gain")
+	{
+		const Peak peak = dsp::sumAll(dest, src, {1.0f, 0.5f}, 2.0f);
+
+		/* Samples grow in magnitude: the last frame holds the peak. */
+
+		REQUIRE(peak.left == std::abs(src[BUFFER_SIZE - 1][0]));
+		REQUIRE(peak.right == std::abs(src[BUFFER_SIZE - 1][1]));
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(dest[i][0] == 0.5f + src[i][0] * 2.0f);
+			REQUIRE(dest[i][1] == 0.5f + src[i][1] * 1.0f);
+		}
+	}
+
+	SECTION("test sum with channel offset")
+	{
+		mcl::AudioBuffer wide(BUFFER_SIZE, 4);
+
+		dsp::sumAll(wide, src, {1.0f, 1.0f}, 1.0f, 2);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(wide[i][0] == 0.0f);
+			REQUIRE(wide[i][1] == 0.0f);
+			REQUIRE(wide[i][2] == src[i][0]);
+			REQUIRE(wide[i][3] == src[i][1]);
+		}
+
+		/* Out of bounds channels are skipped. */
+
+		dsp::sumAll(wide, src, {1.0f, 1.0f}, 1.0f, 3);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(wide[i][3] == src[i][1] + src[i][0]);
+	}
+
+	SECTION("test planar sums")
+	{
+		juce::AudioBuffer<float> planar(2, BUFFER_SIZE);
+		planar.clear();
+
+		/* Interleaved -> planar, then back to interleaved: same result as a
+		plain interleaved sum with the product of the two gains. */
+
+		const Peak peakIn = dsp::sumAll(planar, src, {1.0f, 0.5f}, 2.0f);
+
+		REQUIRE(peakIn.left == std::abs(src[BUFFER_SIZE - 1][0]));
+		REQUIRE(peakIn.right == std::abs(src[BUFFER_SIZE - 1][1]));
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(planar.getReadPointer(0)[i] == src[i][0] * 2.0f);
+			REQUIRE(planar.getReadPointer(1)[i] == src[i][1] * 1.0f);
+		}
+
+		dsp::sumAll(dest, planar, {1.0f, 1.0f}, 1.0f);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(dest[i][0] == 0.5f + src[i][0] * 2.0f);
+			REQUIRE(dest[i][1] == 0.5f + src[i][1] * 1.0f);
+		}
+
+		/* Planar -> planar. */
+
+		juce::AudioBuffer<float> bus(2, BUFFER_SIZE);
+		bus.clear();
+
+		const Peak peakBus = dsp::sumAll(bus, planar, {0.5f, 1.0f}, 1.0f);
+
+		REQUIRE(peakBus.left == std::abs(planar.getReadPointer(0)[BUFFER_SIZE - 1]));
+		REQUIRE(peakBus.right == std::abs(planar.getReadPointer(1)[BUFFER_SIZE - 1]));
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(bus.getReadPointer(0)[i] == planar.getReadPointer(0)[i] * 0.5f);
+			REQUIRE(bus.getReadPointer(1)[i] == planar.getReadPointer(1)[i]);
+		}
+
+		/* Planar -> interleaved, with channel offset. */
+
+		mcl::AudioBuffer wide(BUFFER_SIZE, 4);
+
+		dsp::sumAll(wide, planar, {1.0f, 1.0f}, 1.0f, 2);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(wide[i][0] == 0.0f);
+			REQUIRE(wide[i][2] == planar.getReadPointer(0)[i]);
+			REQUIRE(wide[i][3] == planar.getReadPointer(1)[i]);
+		}
+	}
+
+	SECTION("test sum with gain ramp")
+	{
+		/* Flat ramps match a constant pan and gain. */
+
+		mcl::AudioBuffer flat(BUFFER_SIZE, 2);
+
+		dsp::sumAll(flat, src, dsp::GainRamp{{1.0f, 0.5f}, {1.0f, 0.5f}});
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(flat[i][1] == src[i][1] * 0.5f);
+
+		/* Others move linearly across the block, reaching the target gain on
+		the frame right after the last one. */
+
+		const Peak peak = dsp::sumAll(dest, src, dsp::GainRamp{{0.0f, 1.0f}, {1.0f, 1.0f}});
+
+		REQUIRE(peak.left == std::abs(src[BUFFER_SIZE - 1][0]));
+		REQUIRE(dest[0][0] == 0.5f);
+		REQUIRE(dest[BUFFER_SIZE - 1][0] > 0.5f + src[BUFFER_SIZE - 1][0] * 0.9f);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(dest[i][1] == 0.5f + src[i][1]);
+	}
+
+	SECTION("test gain, clamp and peak")
+	{
+		dsp::applyGain(src, 100.0f);
+		dsp::clamp(src, -1.0f, 1.0f);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(src[i][0] >= -1.0f);
+			REQUIRE(src[i][0] <= 1.0f);
+			REQUIRE(src[i][1] >= -1.0f);
+			REQUIRE(src[i][1] <= 1.0f);
+		}
+
+		const Peak peak = dsp::getPeak(src);
+
+		REQUIRE(peak.left == 1.0f);
+		REQUIRE(peak.right == 1.0f);
+	}
+}
+
+TEST_CASE("dsp - planar buses", "[.benchmark]")
+{
+	/* Per-block cost of moving a track through the mixer: NUM_TRACKS channels
+	with plug-ins, summed into a group bus with plug-ins, summed into the master
+	bus with plug-ins, summed into the device output. Plug-ins themselves are
+	left out, only format conversions and sums are measured. Hidden: run it
+	with 'giada --run-tests "[benchmark]"'. */
+
+	constexpr int NUM_TRACKS = 8;
+
+	using Format = juce::AudioData::Format<juce::AudioData::Float32, juce::AudioData::NativeEndian>;
+
+	const auto deinterleave = [](const mcl::AudioBuffer& src, juce::AudioBuffer<float>& dest)
+	{
+		juce::AudioData::deinterleaveSamples(
+		    juce::AudioData::InterleavedSource<Format>{src[0], src.countChannels()},
+		    juce::AudioData::NonInterleavedDest<Format>{dest.getArrayOfWritePointers(), dest.getNumChannels()},
+		    src.countFrames());
+	};
+
+	const auto interleave = [](const juce::AudioBuffer<float>& src, mcl::AudioBuffer& dest)
+	{
+		juce::AudioData::interleaveSamples(
+		    juce::AudioData::NonInterleavedSource<Format>{src.getArrayOfReadPointers(), src.getNumChannels()},
+		    juce::AudioData::InterleavedDest<Format>{dest[0], dest.countChannels()},
+		    dest.countFrames());
+	};
+
+	for (const int bufferSize : {64, 128, 256})
+	{
+		std::vector<mcl::AudioBuffer> channels(NUM_TRACKS, mcl::AudioBuffer(bufferSize, 2));
+		mcl::AudioBuffer              bus(bufferSize, 2);
+		mcl::AudioBuffer              master(bufferSize, 2);
+		mcl::AudioBuffer              out(bufferSize, 2);
+		juce::AudioBuffer<float>      work(2, bufferSize);
+		juce::AudioBuffer<float>      planarBus(2, bufferSize);
+		juce::AudioBuffer<float>      planarMaster(2, bufferSize);
+
+		for (mcl::AudioBuffer& ch : channels)
+			for (int i = 0; i < bufferSize; i++)
+				ch[i][0] = ch[i][1] = (i % 2 == 0 ? 0.5f : -0.5f);
+
+		BENCHMARK("interleaved buses, " + std::to_string(bufferSize) + " frames")
+		{
+			bus.clear();
+			master.clear();
+			out.clear();
+			for (mcl::AudioBuffer& ch : channels)
+			{
+				deinterleave(ch, work);
+				interleave(work, ch);
+				dsp::sumAll(bus, ch, {1.0f, 1.0f}, 1.0f);
+			}
+			deinterleave(bus, work);
+			interleave(work, bus);
+			dsp::sumAll(master, bus, {1.0f, 1.0f}, 1.0f);
+			deinterleave(master, work);
+			interleave(work, master);
+			return dsp::sumAll(out, master, {1.0f, 1.0f}, 1.0f);
+		};
+
+		BENCHMARK("planar buses, " + std::to_string(bufferSize) + " frames")
+		{
+			planarBus.clear();
+			planarMaster.clear();
+			out.clear();
+			for (mcl::AudioBuffer& ch : channels)
+			{
+				deinterleave(ch, work);
+				dsp::sumAll(planarBus, work, {1.0f, 1.0f}, 1.0f);
+			}
+			dsp::sumAll(planarMaster, planarBus, {1.0f, 1.0f}, 1.0f);
+			return dsp::sumAll(out, planarMaster, {1.0f, 1.0f}, 1.0f);
+		};
+	}
+}
@@ -0,0 +1,54 @@
+#include "../src/core/limiter.h"
+#include "../src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("Limiter")
+{
+	static const int SAMPLE_RATE = 44100;
+	static const int BUFFER_SIZE = 256;
+	static const int CHANNELS    = 2;
+
+	Limiter limiter;
+	limiter.reset(SAMPLE_RATE, CHANNELS);
+
+	mcl::AudioBuffer buffer(BUFFER_SIZE, CHANNELS);
+
+	SECTION("Test latency")
+	{
+		buffer[0][0] = 0.5f;
+		buffer[0][1] = 0.5f;
+
+		limiter.process(buffer);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(buffer[i][0] == (i == limiter.getLatency() ? 0.5f : 0.0f));
+	}
+
+	SECTION("Test limiting")
+	{
+		/* Loud sine wave, tuned so that most peaks fall between samples. */
+
+		float phase = 0.0f;
+		for (int block = 0; block < 20; block++)
+		{
+			for (int i = 0; i < BUFFER_SIZE; i++)
+			{
+				buffer[i][0] = 4.0f * std::sin(phase);
+				buffer[i][1] = -4.0f * std::sin(phase);
+				phase += 0.3f;
+			}
+
+			limiter.process(buffer);
+
+			for (int i = 0; i < BUFFER_SIZE; i++)
+			{
+				REQUIRE(std::abs(buffer[i][0]) <= 1.0f);
+				REQUIRE(std::abs(buffer[i][1]) <= 1.0f);
+			}
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#include "../src/core/paramLane.h"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("ParamLane")
+{
+	ParamLane lane(1.0f);
+
+	lane.advance();
+
+	SECTION("test ramp is flat without changes")
+	{
+		REQUIRE(lane.getRamp().isFlat());
+		REQUIRE(lane.getRamp().to == 1.0f);
+	}
+
+	SECTION("test ramp to a new value")
+	{
+		lane.set(0.5f);
+
+		REQUIRE(lane.get() == 0.5f);
+		REQUIRE(lane.getRamp().to == 1.0f); // Nothing changes until the next block
+
+		lane.advance();
+
+		REQUIRE(lane.getRamp().from == 1.0f);
+		REQUIRE(lane.getRamp().to == 0.5f);
+
+		lane.advance();
+
+		REQUIRE(lane.getRamp().isFlat());
+		REQUIRE(lane.getRamp().to == 0.5f);
+	}
+
+	SECTION("test only the last value set is reached")
+	{
+		lane.set(0.2f);
+		lane.set(0.8f);
+		lane.advance();
+
+		REQUIRE(lane.getRamp().from == 1.0f);
+		REQUIRE(lane.getRamp().to == 0.8f);
+	}
+}
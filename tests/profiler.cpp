@@ -0,0 +1,83 @@
+#include "../src/core/profiler.h"
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("Profiler")
+{
+	using namespace std::chrono_literals;
+
+	Profiler profiler;
+
+	SECTION("Test stats")
+	{
+		for (int i = 1; i <= 100; i++)
+			profiler.record(Profiler::Section::CHANNEL, ID{1}, std::chrono::microseconds(i));
+		profiler.collect();
+
+		const Profiler::Stats stats = profiler.getStats(Profiler::Section::CHANNEL, ID{1});
+
+		REQUIRE(stats.count == 100);
+		REQUIRE(stats.min == 1.0f);
+		REQUIRE(stats.max == 100.0f);
+		REQUIRE(stats.avg == 50.5f);
+		REQUIRE(stats.p99 == 100.0f);
+	}
+
+	SECTION("Test sections are kept apart")
+	{
+		profiler.record(Profiler::Section::CHANNEL, ID{1}, 10us);
+		profiler.record(Profiler::Section::PLUGIN, ID{1}, 20us);
+		profiler.collect();
+
+		REQUIRE(profiler.getStats(Profiler::Section::CHANNEL, ID{1}).max == 10.0f);
+		REQUIRE(profiler.getStats(Profiler::Section::PLUGIN, ID{1}).max == 20.0f);
+		REQUIRE(profiler.getStats(Profiler::Section::MIXER).count == 0);
+	}
+
+	SECTION("Test multiple threads")
+	{
+		std::thread t([&profiler]()
+		{ profiler.record(Profiler::Section::PLUGIN, ID{2}, 5us); });
+		t.join();
+
+		profiler.record(Profiler::Section::PLUGIN, ID{2}, 15us);
+		profiler.collect();
+
+		REQUIRE(profiler.getStats(Profiler::Section::PLUGIN, ID{2}).count == 2);
+	}
+
+	SECTION("Test idle sections expire")
+	{
+		profiler.record(Profiler::Section::CHANNEL, ID{1}, 10us);
+		profiler.collect();
+
+		for (int i = 0; i < G_PROFILER_EXPIRY - 1; i++)
+		{
+			profiler.record(Profiler::Section::CHANNEL, ID{2}, 10us);
+			profiler.collect();
+		}
+
+		REQUIRE(profiler.getStats(Profiler::Section::CHANNEL, ID{1}).count == 1);
+
+		profiler.collect();
+
+		REQUIRE(profiler.getStats(Profiler::Section::CHANNEL, ID{1}).count == 0);
+		REQUIRE(profiler.getStats(Profiler::Section::CHANNEL, ID{2}).count == G_PROFILER_EXPIRY - 1);
+	}
+
+	SECTION("Test rolling window")
+	{
+		for (int i = 0; i < G_PROFILER_WINDOW; i++)
+			profiler.record(Profiler::Section::MIXER, {}, 100us);
+		profiler.collect();
+		for (int i = 0; i < G_PROFILER_WINDOW; i++)
+			profiler.record(Profiler::Section::MIXER, {}, 1us);
+		profiler.collect();
+
+		REQUIRE(profiler.getStats(Profiler::Section::MIXER).max == 1.0f);
+	}
+}
@@ -0,0 +1,60 @@
+#include "../src/core/quantizer.h"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("quantizer")
+{
+	static const Frame STEP = 100;
+
+	Quantizer quantizer;
+	Frame     delta = -1;
+
+	quantizer.schedule(0, [&delta](Frame d)
+	{ delta = d; });
+
+	SECTION("test nothing happens if not triggered")
+	{
+		quantizer.advance(SampleRange(0, 256), STEP);
+
+		REQUIRE(delta == -1);
+		REQUIRE(quantizer.hasBeenTriggered() == false);
+	}
+
+	SECTION("test trigger on block start")
+	{
+		quantizer.trigger(0);
+		quantizer.advance(SampleRange(200, 456), STEP);
+
+		REQUIRE(delta == 0);
+		REQUIRE(quantizer.hasBeenTriggered() == false);
+	}
+
+	SECTION("test trigger within block")
+	{
+		quantizer.trigger(0);
+		quantizer.advance(SampleRange(130, 386), STEP);
+
+		REQUIRE(delta == 70);
+		REQUIRE(quantizer.hasBeenTriggered() == false);
+	}
+
+	SECTION("test trigger in a later block")
+	{
+		quantizer.trigger(0);
+		quantizer.advance(SampleRange(101, 150), STEP);
+
+		REQUIRE(delta == -1);
+		REQUIRE(quantizer.hasBeenTriggered() == true);
+
+		quantizer.advance(SampleRange(150, 199), STEP);
+
+		REQUIRE(delta == -1);
+
+		quantizer.advance(SampleRange(199, 248), STEP);
+
+		REQUIRE(delta == 1);
+		REQUIRE(quantizer.hasBeenTriggered() == false);
+	}
+}
@@ -0,0 +1,45 @@
+#include "../src/core/rendering/renderPool.h"
+#include <array>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("RenderPool")
+{
+	using namespace giada;
+
+	constexpr std::size_t NUM_JOBS = 64;
+
+	m::rendering::RenderPool               pool;
+	std::array<std::atomic<int>, NUM_JOBS> counters{};
+
+	const auto runJobs = [&pool, &counters]()
+	{
+		pool.run(NUM_JOBS, [&counters](std::size_t i)
+		{ counters[i].fetch_add(1); });
+	};
+
+	SECTION("Test serial run (no workers)")
+	{
+		REQUIRE(pool.countWorkers() == 0);
+
+		runJobs();
+
+		for (const std::atomic<int>& c : counters)
+			REQUIRE(c.load() == 1);
+	}
+
+	SECTION("Test parallel run")
+	{
+		pool.start(3);
+		REQUIRE(pool.countWorkers() == 3);
+
+		for (int i = 0; i < 100; i++)
+			runJobs();
+
+		for (const std::atomic<int>& c : counters)
+			REQUIRE(c.load() == 100);
+
+		pool.stop();
+		REQUIRE(pool.countWorkers() == 0);
+	}
+}
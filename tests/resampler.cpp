@@ -0,0 +1,130 @@
+#include "../src/core/resampler.h"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("Resampler")
+{
+	static const int    INPUT_LEN   = 8192;
+	static const int    BUFFER_SIZE = 256;
+	static const int    CHANNELS    = 2;
+	static const double FREQ        = 1000.0 / 44100.0; // Cycles per frame
+
+	/* Stereo sine wave, cosine on the right channel. */
+
+	std::vector<float> input(INPUT_LEN * CHANNELS);
+	for (int i = 0; i < INPUT_LEN; i++)
+	{
+		input[i * CHANNELS]       = static_cast<float>(std::sin(2.0 * std::numbers::pi * FREQ * i));
+		input[(i * CHANNELS) + 1] = static_cast<float>(std::cos(2.0 * std::numbers::pi * FREQ * i));
+	}
+
+	/* Renders 'len' frames in blocks of 'blockSize', like sample channels do. */
+
+	const auto render = [&input](Resampler& resampler, float pitch, long len, long blockSize)
+	{
+		std::vector<float> output(len * CHANNELS);
+		long               used      = 0;
+		long               generated = 0;
+		while (generated < len)
+		{
+			Resampler::Result res = resampler.process(input.data(), used, INPUT_LEN,
+			    output.data() + (generated * CHANNELS), std::min(blockSize, len - generated), pitch);
+			REQUIRE(res.generated > 0);
+			used += res.used;
+			generated += res.generated;
+		}
+		return output;
+	};
+
+	for (const Resampler::Quality quality : {Resampler::Quality::SINC_BEST, Resampler::Quality::SINC_MEDIUM,
+	         Resampler::Quality::SINC_FASTEST})
+	{
+		for (const float pitch : {0.5f, 1.7f})
+		{
+			SECTION("Test accuracy, pitch " + std::to_string(pitch))
+			{
+				Resampler          resampler(quality, CHANNELS);
+				const long         len    = static_cast<long>(INPUT_LEN / pitch) - BUFFER_SIZE;
+				std::vector<float> output = render(resampler, pitch, len, BUFFER_SIZE);
+
+				/* Skip the beginning, where the filter history is still empty. */
+
+				for (long i = BUFFER_SIZE; i < len; i++)
+				{
+					const double t = i * static_cast<double>(pitch);
+					REQUIRE(std::abs(output[i * CHANNELS] - std::sin(2.0 * std::numbers::pi * FREQ * t)) < 1e-3);
+					REQUIRE(std::abs(output[(i * CHANNELS) + 1] - std::cos(2.0 * std::numbers::pi * FREQ * t)) < 1e-3);
+				}
+			}
+
+			SECTION("Test block size independence, pitch " + std::to_string(pitch))
+			{
+				Resampler a(quality, CHANNELS);
+				Resampler b(quality, CHANNELS);
+
+				const long len = BUFFER_SIZE * 8;
+				REQUIRE(render(a, pitch, len, len) == render(b, pitch, len, 37));
+			}
+		}
+	}
+
+	SECTION("Test seek")
+	{
+		const long         start = INPUT_LEN / 2;
+		std::vector<float> a(BUFFER_SIZE * CHANNELS);
+		std::vector<float> b(BUFFER_SIZE * CHANNELS);
+
+		/* Reading from where the last block left off keeps the history: same
+		output as with no seek at all. */
+
+		Resampler          contiguous(Resampler::Quality::SINC_MEDIUM, CHANNELS);
+		Resampler          reference(Resampler::Quality::SINC_MEDIUM, CHANNELS);
+		std::vector<float> expected = render(reference, 0.5f, BUFFER_SIZE * 4, BUFFER_SIZE);
+		std::vector<float> output(BUFFER_SIZE * 4 * CHANNELS);
+		long               used = 0;
+
+		for (long generated = 0; generated < BUFFER_SIZE * 4;)
+		{
+			contiguous.seek(used);
+			Resampler::Result res = contiguous.process(input.data(), used, INPUT_LEN,
+			    output.data() + (generated * CHANNELS), BUFFER_SIZE, 0.5f);
+			used += res.used;
+			generated += res.generated;
+		}
+		REQUIRE(output == expected);
+
+		/* Jumping somewhere else (e.g. after a read with no resampling) clears the
+		history: same output as a fresh resampler. */
+
+		Resampler jumped(Resampler::Quality::SINC_MEDIUM, CHANNELS);
+		Resampler fresh(Resampler::Quality::SINC_MEDIUM, CHANNELS);
+
+		jumped.seek(0);
+		jumped.process(input.data(), 0, INPUT_LEN, a.data(), BUFFER_SIZE, 0.5f);
+		jumped.seek(start);
+		jumped.process(input.data(), start, INPUT_LEN, a.data(), BUFFER_SIZE, 0.5f);
+
+		fresh.seek(start);
+		fresh.process(input.data(), start, INPUT_LEN, b.data(), BUFFER_SIZE, 0.5f);
+
+		REQUIRE(a == b);
+	}
+
+	SECTION("Test end of input")
+	{
+		Resampler          resampler(Resampler::Quality::SINC_MEDIUM, CHANNELS);
+		std::vector<float> output(BUFFER_SIZE * CHANNELS);
+
+		Resampler::Result res = resampler.process(input.data(), INPUT_LEN - 10, INPUT_LEN,
+		    output.data(), BUFFER_SIZE, /*ratio=*/0.5f);
+
+		REQUIRE(res.used == 10);
+		REQUIRE(res.generated == 20);
+	}
+}
@@ -41,9 +41,47 @@ TEST_CASE("rendering::sampleRendering")
 		REQUIRE(channelShared.tracker.load() == 0);
 		REQUIRE(channelShared.playStatus.load() == ChannelStatus::OFF);
 
+		SECTION("Pre-rendered pitch")
+		{
+			constexpr float PITCH = 0.5f;
+
+			channel.sampleChannel->setPitch(PITCH, Scene{0});
+			channel.syncLanes(); // Realtime pitch is read from the parameter lanes
+
+			// Pre-rendered values: [-1..-BUFFERSIZE*8], to tell them apart
+			auto pitched = std::make_unique<m::Wave>(wave.id);
+			pitched->getBuffer().alloc(BUFFER_SIZE * 8, NUM_CHANNELS);
+			pitched->getBuffer().forEachFrame([](float* f, int i)
+			{
+				f[0] = -static_cast<float>(i + 1);
+				f[1] = -static_cast<float>(i + 1);
+			});
+			channelShared.pitchedWave = {std::move(pitched), wave.id, wave.getRevision(), PITCH, Resampler::Quality::LINEAR};
+
+			channelShared.renderQueue->enqueue({m::rendering::RenderInfo::Mode::NORMAL, 0});
+			m::rendering::renderSampleChannel(channel, Scene{0}, /*seqIsRunning=*/false);
+
+			REQUIRE(channelShared.audioBuffer[0][0] == -1.0f);
+			REQUIRE(channelShared.audioBuffer[BUFFER_SIZE - 1][0] == -BUFFER_SIZE);
+			REQUIRE(channelShared.tracker.load() == BUFFER_SIZE * PITCH);
+
+			SECTION("Pitch changed")
+			{
+				channel.sampleChannel->setPitch(PITCH * 2, Scene{0});
+				channel.syncLanes();
+
+				channelShared.renderQueue->enqueue({m::rendering::RenderInfo::Mode::NORMAL, 0});
+				m::rendering::renderSampleChannel(channel, Scene{0}, /*seqIsRunning=*/false);
+
+				// Back to live resampling
+				REQUIRE(channelShared.audioBuffer[0][0] > 0.0f);
+			}
+		}
+
 		for (const float pitch : {1.0f, 0.5f})
 		{
 			channel.sampleChannel->setPitch(pitch, Scene{0});
+			channel.syncLanes();
 
 			SECTION("Sub-range [M, N), pitch == " + std::to_string(pitch))
 			{
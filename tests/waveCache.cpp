@@ -0,0 +1,63 @@
+#include "../src/core/waveCache.h"
+#include "../src/core/const.h"
+#include "../src/core/wave.h"
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace giada;
+using namespace giada::m;
+
+TEST_CASE("waveCache")
+{
+	constexpr int SAMPLE_RATE = 44100;
+	constexpr int BUFFER_SIZE = 4096;
+
+	const auto dir    = std::filesystem::temp_directory_path() / "giada-test-cache";
+	const auto source = (std::filesystem::temp_directory_path() / "giada-test-cache.wav").string();
+
+	std::filesystem::remove_all(dir);
+	std::ofstream(source) << "data";
+
+	waveCache::init(dir.string(), /*maxSize=*/1024 * 1024);
+
+	Wave wave(ID{});
+	wave.alloc(BUFFER_SIZE, G_MAX_IO_CHANS, SAMPLE_RATE, G_DEFAULT_BIT_DEPTH, source);
+	for (int i = 0; i < BUFFER_SIZE; i++)
+		wave.getBuffer()[i][1] = i / static_cast<float>(BUFFER_SIZE);
+
+	const std::string key = waveCache::makeKey(source, SAMPLE_RATE, Resampler::Quality::LINEAR);
+
+	SECTION("test miss")
+	{
+		REQUIRE(key != "");
+		REQUIRE(waveCache::load(key).has_value() == false);
+	}
+
+	SECTION("test store and load")
+	{
+		waveCache::store(wave, key);
+
+		std::optional<waveCache::Entry> entry = waveCache::load(key);
+
+		REQUIRE(entry.has_value());
+		REQUIRE(entry->rate == SAMPLE_RATE);
+		REQUIRE(entry->bits == G_DEFAULT_BIT_DEPTH);
+		REQUIRE(entry->buffer.countFrames() == BUFFER_SIZE);
+		REQUIRE(entry->buffer.countChannels() == G_MAX_IO_CHANS);
+		REQUIRE(entry->buffer[BUFFER_SIZE - 1][1] == wave.getBuffer()[BUFFER_SIZE - 1][1]);
+	}
+
+	SECTION("test key")
+	{
+		waveCache::store(wave, key);
+
+		REQUIRE(waveCache::load(waveCache::makeKey(source, SAMPLE_RATE * 2, Resampler::Quality::LINEAR)).has_value() == false);
+		REQUIRE(waveCache::load(waveCache::makeKey(source, SAMPLE_RATE, Resampler::Quality::SINC_BEST)).has_value() == false);
+	}
+
+	waveCache::init("", 0);
+
+	std::filesystem::remove_all(dir);
+	std::filesystem::remove(source);
+}
@@ -1,9 +1,14 @@
 #include "../src/core/waveFactory.h"
 #include "../src/core/const.h"
+#include "../src/core/patch.h"
 #include "../src/core/resampler.h"
 #include "../src/core/wave.h"
+#include "../src/core/waveStream.h"
 #include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <vector>
 
+using namespace giada;
 using namespace giada::m;
 
 TEST_CASE("waveFactory")
@@ -51,4 +56,156 @@ TEST_CASE("waveFactory")
 		REQUIRE(res.wave->isLogical() == false);
 		REQUIRE(res.wave->isEdited() == false);
 	}
+
+	SECTION("test streaming")
+	{
+		/* Write a sample long enough to be streamed, then read it back. */
+
+		const Frame frames = WaveStream::getResidentFrames(SAMPLE_RATE) + SAMPLE_RATE;
+		const auto  path   = (std::filesystem::temp_directory_path() / "giada-test-stream.wav").string();
+
+		std::unique_ptr<Wave> source = waveFactory::createEmpty(frames, G_MAX_IO_CHANS, SAMPLE_RATE, path);
+		for (Frame i = 0; i < frames; i++)
+		{
+			source->getBuffer()[i][0] = (i % 1000) / 1000.0f;
+			source->getBuffer()[i][1] = -(i % 1000) / 1000.0f;
+		}
+		REQUIRE(waveFactory::save(*source, path) == G_RES_OK);
+
+		waveFactory::Result res = waveFactory::createFromFile(path,
+		    /*ID=*/{}, /*sampleRate=*/SAMPLE_RATE, Resampler::Quality::LINEAR, /*streamingThreshold=*/1);
+
+		REQUIRE(res.status == G_RES_OK);
+		REQUIRE(res.wave->isStreamed() == true);
+		REQUIRE(res.wave->countFrames() == frames);
+		REQUIRE(res.wave->getBuffer().countFrames() == 0);
+
+		Frame        available = 0;
+		const float* data      = res.wave->getStream()->read(0, BUFFER_SIZE, available);
+
+		REQUIRE(data != nullptr);
+		REQUIRE(available >= BUFFER_SIZE);
+		REQUIRE(data[(999 * G_MAX_IO_CHANS) + 1] == source->getBuffer()[999][1]);
+
+		res.wave->replaceData(waveFactory::readStream(*res.wave));
+
+		REQUIRE(res.wave->isStreamed() == false);
+		REQUIRE(res.wave->getBuffer().countFrames() == frames);
+		REQUIRE(res.wave->getBuffer()[frames - 1][0] == source->getBuffer()[frames - 1][0]);
+
+		std::filesystem::remove(path);
+	}
+
+	SECTION("test streaming window")
+	{
+		/* Read past the initially resident data, then jump back: the window
+		must follow the playhead once refilled, counting underruns meanwhile. */
+
+		const Frame frames = WaveStream::getResidentFrames(SAMPLE_RATE) + (SAMPLE_RATE * 4);
+		const auto  path   = (std::filesystem::temp_directory_path() / "giada-test-stream-window.wav").string();
+
+		std::unique_ptr<Wave> source = waveFactory::createEmpty(frames, G_MAX_IO_CHANS, SAMPLE_RATE, path);
+		for (Frame i = 0; i < frames; i++)
+		{
+			source->getBuffer()[i][0] = i / static_cast<float>(frames);
+			source->getBuffer()[i][1] = -i / static_cast<float>(frames);
+		}
+		REQUIRE(waveFactory::save(*source, path) == G_RES_OK);
+
+		waveFactory::Result res = waveFactory::createFromFile(path,
+		    /*ID=*/{}, /*sampleRate=*/SAMPLE_RATE, Resampler::Quality::LINEAR, /*streamingThreshold=*/1);
+
+		REQUIRE(res.status == G_RES_OK);
+		REQUIRE(res.wave->isStreamed() == true);
+
+		const WaveStream& stream    = *res.wave->getStream();
+		const auto        readCheck = [&](Frame start)
+		{
+			Frame        available = 0;
+			const float* data      = stream.read(start, BUFFER_SIZE, available);
+			if (data == nullptr)
+				return false;
+			REQUIRE(available == BUFFER_SIZE);
+			for (Frame i = 0; i < BUFFER_SIZE; i++)
+			{
+				REQUIRE(data[i * G_MAX_IO_CHANS] == source->getBuffer()[start + i][0]);
+				REQUIRE(data[(i * G_MAX_IO_CHANS) + 1] == source->getBuffer()[start + i][1]);
+			}
+			return true;
+		};
+
+		const Frame far       = WaveStream::getResidentFrames(SAMPLE_RATE) + (SAMPLE_RATE * 2);
+		const Frame back      = SAMPLE_RATE * 3; // Past the head, before 'far'
+		const int   underruns = WaveStream::getStats().underruns;
+
+		/* Forward jump outside the window. */
+
+		REQUIRE(readCheck(far) == false);
+		REQUIRE(WaveStream::getStats().underruns == underruns + 1);
+
+		WaveStream::refillAll();
+
+		REQUIRE(readCheck(far) == true);
+		REQUIRE(readCheck(far + BUFFER_SIZE) == true);
+
+		/* Backward jump, behind the window. */
+
+		REQUIRE(readCheck(back) == false);
+		REQUIRE(WaveStream::getStats().underruns == underruns + 2);
+
+		WaveStream::refillAll();
+
+		REQUIRE(readCheck(back) == true);
+
+		/* The head is always available. */
+
+		REQUIRE(readCheck(0) == true);
+
+		std::filesystem::remove(path);
+	}
+
+	SECTION("test parallel deserialization")
+	{
+		const std::vector<Patch::Wave> pwaves = {
+		    {ID{10}, TEST_WAV_PATH},
+		    {ID{20}, "missing.wav"},
+		    {ID{30}, TEST_WAV_PATH},
+		};
+
+		float      lastProgress = 0.0f;
+		const auto progress     = [&lastProgress](float p)
+		{
+			REQUIRE(p >= lastProgress);
+			lastProgress = p;
+		};
+
+		std::vector<std::unique_ptr<Wave>> waves = waveFactory::deserializeWaves(pwaves, SAMPLE_RATE,
+		    Resampler::Quality::LINEAR, /*streamingThreshold=*/0, progress);
+
+		REQUIRE(waves.size() == pwaves.size());
+		REQUIRE(waves[0] != nullptr);
+		REQUIRE(waves[0]->id == ID{10});
+		REQUIRE(waves[1] == nullptr);
+		REQUIRE(waves[2] != nullptr);
+		REQUIRE(waves[2]->id == ID{30});
+		REQUIRE(lastProgress == 1.0f);
+	}
+
+	SECTION("test pending")
+	{
+		waveFactory::Result res = waveFactory::createPending(TEST_WAV_PATH, ID{42}, SAMPLE_RATE * 2);
+
+		REQUIRE(res.status == G_RES_OK);
+		REQUIRE(res.wave->isPending() == true);
+		REQUIRE(res.wave->getBuffer().countFrames() == 0);
+
+		std::unique_ptr<Wave> loaded = waveFactory::loadPending(*res.wave, Resampler::Quality::LINEAR);
+
+		REQUIRE(loaded != nullptr);
+		REQUIRE(loaded->isPending() == false);
+		REQUIRE(loaded->id == ID{42});
+		REQUIRE(loaded->getRate() == SAMPLE_RATE * 2);
+		REQUIRE(loaded->countFrames() == res.wave->countFrames());
+		REQUIRE(loaded->getBuffer().countFrames() == res.wave->countFrames());
+	}
 }